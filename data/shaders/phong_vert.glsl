@@ -5,7 +5,7 @@ uniform mat4 ModelViewMatrix;
 uniform mat4 NormalMatrix;
 
 attribute vec4 in_Position;
-attribute vec4 in_Normal;
+attribute vec2 in_Normal; // Octahedral encoding (see CResource_Mesh::Format())
 attribute vec4 in_Color;
 attribute vec3 in_TexCoords;
 
@@ -15,12 +15,20 @@ varying vec3 frag_TexCoords;
 varying vec3 frag_diffuseColor; 
 varying vec3 frag_specularColor; 
  
+vec3 DecodeNormal(vec2 e)
+{
+  vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+  if(n.z < 0.0)
+    n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+  return normalize(n);
+}
+
 void main()
 {
   //mat4 NormalMatrix = transpose(inverse(modelView));
   mat4 MVPMatrix = ProjMatrix * ModelViewMatrix;
 
-  vec3 normalDirection =  normalize(NormalMatrix * in_Normal);
+  vec3 normalDirection =  normalize(vec3(NormalMatrix * vec4(DecodeNormal(in_Normal), 0.0)));
   vec3 viewDirection = -normalize(vec3(ModelViewMatrix * in_Position)); 
   vec3 lightDirection;
   float attenuation;
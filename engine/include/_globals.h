@@ -1,6 +1,6 @@
 /**
  * @file
- * @brief Estructuras y mtodos globales.
+ * @brief Estructuras y métodos globales.
  */
 
 #ifndef __GLOBALS_H_
@@ -27,26 +27,26 @@
 #include <vector>
 
 /**
- * @brief Definicin de excepcin para devolver una excepcin en una determinada lnea.
+ * @brief Definición de excepción para devolver una excepción en una determinada línea.
  */
 #define THROW(exceptionClass, message) throw exceptionClass(__FILE__, __LINE__, (message) )
 
 /**
- * @brief Tipo personalizado de excepcin. Se caracteriza por almacenar el fichero y la lnea desde el lugar en el que se lanz la excepcin.
+ * @brief Tipo personalizado de excepción. Se caracteriza por almacenar el fichero y la línea desde el lugar en el que se lanzó la excepción.
  */
 class general_exception: public std::exception
 {
   private:
-    int line; /**< Lnea del lanzamiento de la excepcin.*/
-    std::string file; /**< Fichero de cdigo fuente del lanzamiento de la excepcin." */
-    std::string reason; /**< Razn del lanzamiento de la excepcin. */
+    int line; /**< Línea del lanzamiento de la excepción.*/
+    std::string file; /**< Fichero de código fuente del lanzamiento de la excepción." */
+    std::string reason; /**< Razón del lanzamiento de la excepción. */
 
   public:
     /**
-     * @brief Constructor principal de la excepcin.
+     * @brief Constructor principal de la excepción.
      * @param FILE Fichero descriptor del lugar del error.
-     * @param LINE Lnea descriptora del lugar error.
-     * @param REASON Razn descriptora del error.
+     * @param LINE Línea descriptora del lugar error.
+     * @param REASON Razón descriptora del error.
      */
     general_exception(const char* FILE, int LINE, const char* REASON): line(LINE), file(FILE), reason(REASON){ }
     /**
@@ -55,8 +55,8 @@ class general_exception: public std::exception
     ~general_exception() throw(){};
 
     /**
-     * @brief Chivato de la excepcin. Nos indica un mensaje descriptivo del error.
-     * @return Devuelve una descripcin en una string del error generado.
+     * @brief Chivato de la excepción. Nos indica un mensaje descriptivo del error.
+     * @return Devuelve una descripción en una string del error generado.
      */
     virtual const char* what() const throw()
     {
@@ -66,7 +66,7 @@ class general_exception: public std::exception
     }
 };
 
-/** Usar defines de la librera &lt;cmath&gt;.*/
+/** Usar defines de la librería &lt;cmath&gt;.*/
 #define _USE_MATH_DEFINES
 /**
  * @brief Macro para pasar de radianes a grados.
@@ -139,31 +139,31 @@ extern SDL_Event event;
 /*_____ERRORS_CHARS____*/
 
 /**
- * @brief Ttulo de error de renderizado para "message boxes".
+ * @brief Título de error de renderizado para "message boxes".
  *
  * @see CSystem_Debug::msg_box()
  */
 const char ERROR_RENDER[] = "Render error";
 /**
- * @brief Ttulo de error de inicializacin para "message boxes".
+ * @brief Título de error de inicialización para "message boxes".
  *
  * @see CSystem_Debug::msg_box()
  */
 const char ERROR_INIT[] = "Init error";
 /**
- * @brief Ttulo de error fatal de inicializacin para "message boxes".
+ * @brief Título de error fatal de inicialización para "message boxes".
  *
  * @see CSystem_Debug::msg_box()
  */
 const char ERROR_FATAL_INIT[] = "Init fatal error";
 /**
- * @brief Ttulo de error fatal para "message boxes".
+ * @brief Título de error fatal para "message boxes".
  *
  * @see CSystem_Debug::msg_box()
  */
 const char ERROR_FATAL[] = "Fatal error";
 /**
- * @brief Ttulo de error de fichero para "message boxes".
+ * @brief Título de error de fichero para "message boxes".
  *
  * @see CSystem_Debug::msg_box()
  */
@@ -174,15 +174,15 @@ const char ERROR_FILE[] = "File error";
 
 /*______Typedef_______*/
 
-typedef void* input_t;  /**< Tipo para representar una entrada genrica.*/
-typedef void* output_t; /**< Tipo para representar una salida genrica.*/
+typedef void* input_t;  /**< Tipo para representar una entrada genérica.*/
+typedef void* output_t; /**< Tipo para representar una salida genérica.*/
 
 typedef unsigned int flags_t;  /**< Tipo para representar flags u opciones.*/
 typedef unsigned int uint;     /**< Tipo para representar un entero sin signo.*/
 typedef unsigned char ubyte;   /**< Tipo para representar un byte sin signo.*/
 
-typedef void (*fpointer)(void);     /**< Tipo para representar un puntero a funcin del tipo "void f()".*/
-typedef bool (*fboolpointer)(void); /**< Tipo para representar un puntero a funcin del tipo "bool f()".*/
+typedef void (*fpointer)(void);     /**< Tipo para representar un puntero a función del tipo "void f()".*/
+typedef bool (*fboolpointer)(void); /**< Tipo para representar un puntero a función del tipo "bool f()".*/
 
 /*_____Namespaces_____*/
 
@@ -190,13 +190,13 @@ typedef bool (*fboolpointer)(void); /**< Tipo para representar un puntero a func
 
 /*______Structs_______*/
 
-// Estara muy bien definir un tipo de excepcin propia
-// Causante, objetivo, razn, instancia, etc...
+// Estaría muy bien definir un tipo de excepción propia
+// Causante, objetivo, razón, instancia, etc...
 
 /**
  * @brief Estructura de datos para representar un color.<br>
  *
- * El contenido ser representado como un color en el espacio RGB, con formato "RGBA", siendo cada componente un byte sin signo (0...255).
+ * El contenido será representado como un color en el espacio RGB, con formato "RGBA", siendo cada componente un byte sin signo (0...255).
  */
 typedef struct color_t
 {
@@ -210,13 +210,13 @@ typedef struct color_t
 /**
  * @brief Estructura de datos para representar un color.<br>
  *
- * El contenido ser representado como un color en el espacio RGB, con formato "RGBA", siendo cada componente un flotante sin signo (0...1).
+ * El contenido será representado como un color en el espacio RGB, con formato "RGBA", siendo cada componente un flotante sin signo (0...1).
  *
- * No se comprobarn valores de entrada, asumiendo que se colocan de manera correcta (0...1).
+ * No se comprobarán valores de entrada, asumiendo que se colocan de manera correcta (0...1).
  */
 typedef struct colorf_t
 {
-  // ->PorHacer Aadir a la estructura colorf_t varios valores static, con colores comunes como rojo, azul, verde, etc...
+  // ->PorHacer Añadir a la estructura colorf_t varios valores static, con colores comunes como rojo, azul, verde, etc...
   GLfloat r; /**< Componente roja del color. Valor flotante entre 0 y 1. */
   GLfloat g; /**< Componente verde del color. Valor flotante entre 0 y 1. */
   GLfloat b; /**< Componente azul del color. Valor flotante entre 0 y 1. */
@@ -224,7 +224,7 @@ typedef struct colorf_t
 
   //colorf_t(): r(1.f), g(1.f), b(1.f), a(1.f){};
   /**
-   * @brief Constructor principal del color. No se comprobarn valores de entrada, asumiendo que se colocan de manera correcta (0...1).
+   * @brief Constructor principal del color. No se comprobarán valores de entrada, asumiendo que se colocan de manera correcta (0...1).
    * @param R Componente roja del color.
    * @param G Componente verde del color.
    * @param B Componente azul del color.
@@ -233,7 +233,7 @@ typedef struct colorf_t
   colorf_t(GLfloat R = 1.f, GLfloat G = 1.f, GLfloat B = 1.f, GLfloat A = 1.f): r(R), g(G), b(B), a(A){};
 
   /**
-   * @brief Operador parntesis. Se usa para cambiar el contenido del color (esttica). No se comprobarn valores de entrada, asumiendo que se colocan de manera correcta (0...1).
+   * @brief Operador paréntesis. Se usa para cambiar el contenido del color (estética). No se comprobarán valores de entrada, asumiendo que se colocan de manera correcta (0...1).
    * @param _r Componente roja del color.
    * @param _g Componente verde del color.
    * @param _b Componente azul del color.
@@ -248,7 +248,7 @@ typedef struct colorf_t
   }
 
   /**
-   * @brief Multiplicador de un color. Multiplica el color por un valor flotante dado, multiplicando todas las componentes por el valor. No se comprobarn valores de entrada, asumiendo que se colocan de manera correcta (0...1).
+   * @brief Multiplicador de un color. Multiplica el color por un valor flotante dado, multiplicando todas las componentes por el valor. No se comprobarán valores de entrada, asumiendo que se colocan de manera correcta (0...1).
    * @param c
    * @return
    */
@@ -258,9 +258,9 @@ typedef struct colorf_t
   }
 
   /**
-   * @brief Operador asignacin-suma. Suma y asigna al color el valor c, sumando a todas las componentes el valor "c".  No se comprobarn valores de entrada, asumiendo que se colocan de manera correcta (0...1).
+   * @brief Operador asignación-suma. Suma y asigna al color el valor c, sumando a todas las componentes el valor "c".  No se comprobarán valores de entrada, asumiendo que se colocan de manera correcta (0...1).
    * @param c Valor flotante a sumar.
-   * @return Devuelve el color en s (referencia).
+   * @return Devuelve el color en sí (referencia).
    */
   colorf_t& operator+=(colorf_t c)
   {
@@ -273,9 +273,9 @@ typedef struct colorf_t
   }
 
   /**
-   * @brief Transforma el color en un array de tamao 4 de valores flotantes.
+   * @brief Transforma el color en un array de tamaño 4 de valores flotantes.
    *
-   * Se podrn acceder a los elementos de la siguiente manera:
+   * Se podrán acceder a los elementos de la siguiente manera:
    *
    * @code
     colorf_t color(1.0, 1.0, 1.0, 1.0);
@@ -285,7 +285,7 @@ typedef struct colorf_t
     color.to_a()[2] = 1.0f; // Componente alpha
    * @endcode
    *
-   * @return float* de tamao 4, siendo una referencia al color.
+   * @return float* de tamaño 4, siendo una referencia al color.
    */
   float* to_a()
   {
@@ -295,7 +295,7 @@ typedef struct colorf_t
   /**
    * @brief Color a cadena.
    *
-   * Devuelve una representacin en forma de std::string del color.
+   * Devuelve una representación en forma de std::string del color.
    * @return std::string que almacena el color con el formato "r g b a", con cada elemento como un valor flotante.
    */
   std::string str()
@@ -307,9 +307,9 @@ typedef struct colorf_t
   }
 
   /**
-   * @brief Operador de redireccin de salida.
+   * @brief Operador de redirección de salida.
    *
-   * Escribir el color de la misma manera que en la funcin colorf_t::str()
+   * Escribirá el color de la misma manera que en la función colorf_t::str()
    * @param os Flujo de salida.
    * @param c Color.
    * @return Referencia al flujo de salida.
@@ -321,9 +321,9 @@ typedef struct colorf_t
   }
 
   /**
-   * @brief Operador de redireccin de entrada.
+   * @brief Operador de redirección de entrada.
    *
-   * leer el color de la misma manera que en la funcin colorf_t::str()
+   * leerá el color de la misma manera que en la función colorf_t::str()
    * @param is Flujo de entrada.
    * @param c Color.
    * @return Referencia al flujo de entrada.
@@ -337,14 +337,14 @@ typedef struct colorf_t
 } colorf_t;
 
 /**
- * @brief Estructura para representar un "viewport" o una fraccin de pantalla.
+ * @brief Estructura para representar un "viewport" o una fracción de pantalla.
  *
  * http://en.wikipedia.org/wiki/Viewport
  *
- * Un viewport no es ms que una abstraccin de una "ventana" o portal desde la ventana de nuestro programa hasta el mundo en 3D de la aplicacin.
- * Bsicamente, es una porcin de pantalla (definida por una posicin y un tamao) en la que se dibujarn ciertos elementos del juego.
+ * Un viewport no es más que una abstracción de una "ventana" o portal desde la ventana de nuestro programa hasta el mundo en 3D de la aplicación.
+ * Básicamente, es una porción de pantalla (definida por una posición y un tamaño) en la que se dibujarán ciertos elementos del juego.
  *
- * En una ventana, un viewport se define ms o menos as:
+ * En una ventana, un viewport se define más o menos así:
  *
  * <pre>
  *  ______________________________
@@ -362,15 +362,15 @@ typedef struct colorf_t
  */
 typedef struct viewport_t
 {
-    int x;      /**< Posicin en el eje x de la pantalla del viewport. */
-    int y;      /**< Posicin en el eje y de la pantalla del viewport. */
-    int width;  /**< Ancho del viewport, expresado en pxeles. */
-    int height; /**< Alto del viewport, expresado en pxeles. */
+    int x;      /**< Posición en el eje x de la pantalla del viewport. */
+    int y;      /**< Posición en el eje y de la pantalla del viewport. */
+    int width;  /**< Ancho del viewport, expresado en píxeles. */
+    int height; /**< Alto del viewport, expresado en píxeles. */
 
     /**
-     * @brief Operador de redireccin de salida.
+     * @brief Operador de redirección de salida.
      *
-     * Escribir el viewport de la misma manera que en la funcin viewport_t::str()
+     * Escribirá el viewport de la misma manera que en la función viewport_t::str()
      * @param os Flujo de salida.
      * @param v Viewport.
      * @return Referencia al flujo de salida.
@@ -382,9 +382,9 @@ typedef struct viewport_t
     }
 
     /**
-     * @brief Operador de redireccin de entrada.
+     * @brief Operador de redirección de entrada.
      *
-     * Leer el viewport de la misma manera que en la funcin viewport_t::str()
+     * Leerá el viewport de la misma manera que en la función viewport_t::str()
      * @param is Flujo de entrada.
      * @param v Viewport.
      * @return Referencia al flujo de entrada.
@@ -398,7 +398,7 @@ typedef struct viewport_t
     /**
      * @brief Viewport a cadena.
      *
-     * Devuelve una representacin en forma de std::string del viewport.
+     * Devuelve una representación en forma de std::string del viewport.
      * @return std::string que almacena el los datos del viewport con el formato "x y width height", manteniendo su tipo original.
      */
     std::string str()
@@ -412,14 +412,14 @@ typedef struct viewport_t
 } viewport_t;
 
 /**
- * @brief Estructura para representar un "viewport" o una fraccin de pantalla.
+ * @brief Estructura para representar un "viewport" o una fracción de pantalla.
  *
  * @see http://en.wikipedia.org/wiki/Viewport
  *
- * Un viewport no es ms que una abstraccin de una "ventana" o portal desde la ventana de nuestro programa hasta el mundo en 3D de la aplicacin.
- * Bsicamente, es una porcin de pantalla (definida por una posicin y un tamao) en la que se dibujarn ciertos elementos del juego.
+ * Un viewport no es más que una abstracción de una "ventana" o portal desde la ventana de nuestro programa hasta el mundo en 3D de la aplicación.
+ * Básicamente, es una porción de pantalla (definida por una posición y un tamaño) en la que se dibujarán ciertos elementos del juego.
  *
- * En una ventana, un viewport se define ms o menos as:
+ * En una ventana, un viewport se define más o menos así:
  *
  * <pre>
  *  ______________________________
@@ -432,7 +432,7 @@ typedef struct viewport_t
  * |__>___________________________|
  * </pre>
  *
- * Se diferencia de viewport_t en que esta no usa pxeles para el tamao, sino un valor flotante entre 0 y 1, siendo, para el ancho, "1" el ancho de la ventana, y para el alto, "1" el alto de la ventana.
+ * Se diferencia de viewport_t en que esta no usa píxeles para el tamaño, sino un valor flotante entre 0 y 1, siendo, para el ancho, "1" el ancho de la ventana, y para el alto, "1" el alto de la ventana.
  *
  * @see CComponent_Camera
  * @see CSystem_Render.
@@ -440,15 +440,15 @@ typedef struct viewport_t
 typedef struct viewportf_t
 {
     // Values between 0.f and 1.f
-    GLfloat x;      /**< Posicin en el eje x de la pantalla del viewport. Vara entre 0 y 1. Para el valor 0, el punto empieza en la parte derecha de la ventana, y para 1, se encuentra en la parte izquierda. */
-    GLfloat y;      /**< Posicin en el eje y de la pantalla del viewport. Vara entre 0 y 1. Para el valor 0, el punto empieza en la parte inferior de la ventana, y para 1, se encuentra en la parte superior. */
-    GLfloat width;  /**< Ancho del viewport, expresado en un valor del rango [0,1], siendo "1" el ancho de la ventana (vase gSystem_Render.GetWindowSize()). */
-    GLfloat height; /**< Alto del viewport, expresado en un valor del rango [0,1], siendo "1" el alto de la ventana (vase gSystem_Render.GetWindowSize()). */
+    GLfloat x;      /**< Posición en el eje x de la pantalla del viewport. Varía entre 0 y 1. Para el valor 0, el punto empieza en la parte derecha de la ventana, y para 1, se encuentra en la parte izquierda. */
+    GLfloat y;      /**< Posición en el eje y de la pantalla del viewport. Varía entre 0 y 1. Para el valor 0, el punto empieza en la parte inferior de la ventana, y para 1, se encuentra en la parte superior. */
+    GLfloat width;  /**< Ancho del viewport, expresado en un valor del rango [0,1], siendo "1" el ancho de la ventana (véase gSystem_Render.GetWindowSize()). */
+    GLfloat height; /**< Alto del viewport, expresado en un valor del rango [0,1], siendo "1" el alto de la ventana (véase gSystem_Render.GetWindowSize()). */
 
     /**
-     * @brief Operador de redireccin de salida.
+     * @brief Operador de redirección de salida.
      *
-     * Escribir el viewport de la misma manera que en la funcin viewportf_t::str()
+     * Escribirá el viewport de la misma manera que en la función viewportf_t::str()
      * @param os Flujo de salida.
      * @param v Viewport.
      * @return Referencia al flujo de salida.
@@ -460,9 +460,9 @@ typedef struct viewportf_t
     }
 
     /**
-     * @brief Operador de redireccin de entrada.
+     * @brief Operador de redirección de entrada.
      *
-     * Leer el viewport de la misma manera que en la funcin viewportf_t::str()
+     * Leerá el viewport de la misma manera que en la función viewportf_t::str()
      * @param is Flujo de entrada.
      * @param v Viewport.
      * @return Referencia al flujo de entrada.
@@ -476,7 +476,7 @@ typedef struct viewportf_t
     /**
      * @brief Viewport a cadena.
      *
-     * Devuelve una representacin en forma de std::string del viewport.
+     * Devuelve una representación en forma de std::string del viewport.
      * @return std::string que almacena el los datos del viewport con el formato "x y width height", manteniendo su tipo original.
      */
     std::string str()
@@ -503,7 +503,7 @@ typedef struct viewportf_t
  * @see http://es.wikipedia.org/wiki/Vector
  * @see CSystem_Math
  */
-typedef struct vector3f_t // ->NOTA La clase vector3f_t debera ir en CSystem_Math, no en mbito global. Difcil decisin...
+typedef struct vector3f_t // ->NOTA La clase vector3f_t debería ir en CSystem_Math, no en ámbito global. Difícil decisión...
 {
   GLfloat x; /**< Componente "x" del vector, del tipo flotante, siendo la primera componente. */
   GLfloat y; /**< Componente "y" del vector, del tipo flotante, siendo la segunda componente. */
@@ -544,9 +544,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   vector3f_t(glm::vec3 v): x(v.x), y(v.y), z(v.z) { };
 
   /**
-   * @brief Transformacin a formato glm.
+   * @brief Transformación a formato glm.
    *
-   * Transforma el vector al tipo glm::vec3 para que pueda ser procesado por la librera GLM.
+   * Transforma el vector al tipo glm::vec3 para que pueda ser procesado por la librería GLM.
    *
    * @see http://glm.g-truc.net/0.9.5/index.html
    * @return Devuelve un vector tridimensional de tipo glm::vec3 con el mismo contenido que el vector.
@@ -559,7 +559,7 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   /**
    * @brief Operador suma.
    *
-   * Realiza la suma componente a componente del vector ms el vector "v", dando como resultado (x + v.x, y + v.y, z + v.z).
+   * Realiza la suma componente a componente del vector más el vector "v", dando como resultado (x + v.x, y + v.y, z + v.z).
    * @param v Vector a sumar.
    * @return Suma de los vectores.
    */
@@ -572,9 +572,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
 
 
   /**
-   * @brief Operador asignacin-suma.
+   * @brief Operador asignación-suma.
    *
-   * Realiza la suma componente a componente del vector ms el vector "v", dando como resultado (x + v.x, y + v.y, z + v.z), y le asigna el valor al vector.
+   * Realiza la suma componente a componente del vector más el vector "v", dando como resultado (x + v.x, y + v.y, z + v.z), y le asigna el valor al vector.
    * @param v Vector a sumar.
    * @return Referencia al vector modificado.
    */
@@ -604,7 +604,7 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Operador asignacin-resta.
+   * @brief Operador asignación-resta.
    *
    * Realiza la resta componente a componente del vector menos el vector "v", dando como resultado (x + v.x, y + v.y, z + v.z), y le asigna el valor al vector.
    * @param v Vector a restar.
@@ -619,7 +619,7 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Operador de asignacin.
+   * @brief Operador de asignación.
    *
    * Le asigna al vector actual los valores del vector "v", dando como resultado (v.x, v.y, v.z).
    * @param v Vector a copiar.
@@ -637,7 +637,7 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   /**
    * @brief Operador producto (producto por un escalar).
    *
-   * Realiza la multiplicacin componente a componente del vector por el escalar "value", dando como resultado (x*value, y*value, z*value).
+   * Realiza la multiplicación componente a componente del vector por el escalar "value", dando como resultado (x*value, y*value, z*value).
    * @param value Escalar a multiplicar.
    * @return Vector resultado.
    */
@@ -652,9 +652,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Operador asingacin-producto (producto por un escalar).
+   * @brief Operador asingación-producto (producto por un escalar).
    *
-   * Realiza la multiplicacin componente a componente del vector por el escalar "value", dando como resultado (x*value, y*value, z*value), y le asigna el valor al vector.
+   * Realiza la multiplicación componente a componente del vector por el escalar "value", dando como resultado (x*value, y*value, z*value), y le asigna el valor al vector.
    * @param value Escalar a multiplicar.
    * @return Referencia al vector modificado.
    */
@@ -680,9 +680,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Operador divisin (divisin por un escalar).
+   * @brief Operador división (división por un escalar).
    *
-   * Realiza la disivin componente a componente del vector entre el escalar "value", dando como resultado (x/value, y/value, z/value).
+   * Realiza la disivión componente a componente del vector entre el escalar "value", dando como resultado (x/value, y/value, z/value).
    * @param value Escalar a dividir.
    * @return Vector resultado.
    */
@@ -697,10 +697,10 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Operador asingacin-divisn (divisn por un escalar).
+   * @brief Operador asingación-divisón (divisón por un escalar).
    *
-   * Realiza la divisin componente a componente del vector por el escalar "value", dando como resultado (x/value, y/value, z/value), y le asigna el valor al vector.
-   * @param value Escalar a realizar la divisin.
+   * Realiza la división componente a componente del vector por el escalar "value", dando como resultado (x/value, y/value, z/value), y le asigna el valor al vector.
+   * @param value Escalar a realizar la división.
    * @return Referencia al vector modificado.
    */
   vector3f_t& operator/=(double value)
@@ -725,9 +725,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Operador parntesis.
+   * @brief Operador paréntesis.
    *
-   * Por esttica, modifica los valores de un vector de manera sencilla, tal que:
+   * Por estética, modifica los valores de un vector de manera sencilla, tal que:
    *
    * @code
     vector3f_t v1;
@@ -748,7 +748,7 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   /**
    * @brief Operador de acceso.
    *
-   * Sirve para acceder a las componentes por ndice. La asignacin es:
+   * Sirve para acceder a las componentes por índice. La asignación es:
    *
    * <pre>
    * 0:     x
@@ -757,7 +757,7 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
    * resto: x
    * </pre>
    *
-   * @param pos Posicin o ndice de la componente.
+   * @param pos Posición o índice de la componente.
    * @return Valor de la componente. Devuelve "x" en caso de error.
    */
   float& operator[](int pos)
@@ -802,13 +802,13 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
     return out;
   }
 
-  /** Mdulo del vector
+  /** Módulo del vector
    *
-   * Devuelve el mdulo del vector actual.
+   * Devuelve el módulo del vector actual.
    *
    * @see http://es.wikipedia.org/wiki/M%C3%B3dulo_(vector)
    *
-   * @return Valor del mdulo del vector. Si el valor es "1", se dice que el vector est <b>normalizado</b> o que es un vector <b>unitario</b>.
+   * @return Valor del módulo del vector. Si el valor es "1", se dice que el vector está <b>normalizado</b> o que es un vector <b>unitario</b>.
    */
   GLfloat length()
   {
@@ -816,9 +816,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Operador de redireccin de salida.
+   * @brief Operador de redirección de salida.
    *
-   * Escribir el vector de la misma manera que en la funcin vector3f_t::str()
+   * Escribirá el vector de la misma manera que en la función vector3f_t::str()
    * @param os Flujo de salida.
    * @param v Vector.
    * @return Referencia al flujo de salida.
@@ -830,9 +830,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Operador de redireccin de entrada.
+   * @brief Operador de redirección de entrada.
    *
-   * Leer el vector de la misma manera que en la funcin vector3f_t::str()
+   * Leerá el vector de la misma manera que en la función vector3f_t::str()
    * @param is Flujo de entrada.
    * @param v Vector.
    * @return Referencia al flujo de entrada.
@@ -846,7 +846,7 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   /**
    * @brief Normalizar el vector
    *
-   * Hace que el mdulo del vector valga "1" modifcando sus componentes.
+   * Hace que el módulo del vector valga "1" modifcando sus componentes.
    *
    * @see http://es.wikipedia.org/wiki/Vector_unitario
    * @return Vector unitario del vector actual.
@@ -894,10 +894,10 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Precisin.
+   * @brief Precisión.
    *
-   * Se utiliza para comparar si 2 puntos son equivalentes, dada una precisin decimal para cada componente.
-   * As, si el valor absoluto de la diferencia entre 2 vectores es menor que la precisin para cada componente, se dice que son iguales.
+   * Se utiliza para comparar si 2 puntos son equivalentes, dada una precisión decimal para cada componente.
+   * Así, si el valor absoluto de la diferencia entre 2 vectores es menor que la precisión para cada componente, se dice que son iguales.
    */
   static GLfloat precision;
 
@@ -921,7 +921,7 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   /**
    * @brief Operador de igualdad.
    *
-   * Compara si dos vectores son iguales dada la precisin vector3f_t::precision
+   * Compara si dos vectores son iguales dada la precisión vector3f_t::precision
    * @param other Otro vector a comparar.
    * @return true si son iguales, false en otro caso.
    */
@@ -937,7 +937,7 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   /**
     * @brief Operador de desigualdad.
     *
-    * Compara si dos vectores son distintos dada la precisin vector3f_t::precision
+    * Compara si dos vectores son distintos dada la precisión vector3f_t::precision
     * @param other Otro vector a comparar.
     * @return true si son dinstitos, false en otro caso.
     */
@@ -947,9 +947,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Comparador de mdulo.
+   * @brief Comparador de módulo.
    * @param other Vector a comparar.
-   * @return true si el mdulo del vector actual es menor que el mdulo de other. false en otro caso.
+   * @return true si el módulo del vector actual es menor que el módulo de other. false en otro caso.
    */
   bool operator<(vector3f_t other)
   {
@@ -957,9 +957,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Comparador de mdulo.
+   * @brief Comparador de módulo.
    * @param other Vector a comparar.
-   * @return true si el mdulo del vector actual es menor o igual que el mdulo de other. false en otro caso.
+   * @return true si el módulo del vector actual es menor o igual que el módulo de other. false en otro caso.
    */
   bool operator <=(vector3f_t other)
   {
@@ -967,9 +967,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Comparador de mdulo.
+   * @brief Comparador de módulo.
    * @param other Vector a comparar.
-   * @return true si el mdulo del vector actual es mayor que el mdulo de other. false en otro caso.
+   * @return true si el módulo del vector actual es mayor que el módulo de other. false en otro caso.
    */
   bool operator>(vector3f_t other)
   {
@@ -977,9 +977,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Comparador de mdulo.
+   * @brief Comparador de módulo.
    * @param other Vector a comparar.
-   * @return true si el mdulo del vector actual es mayor o igual que el mdulo de other. false en otro caso.
+   * @return true si el módulo del vector actual es mayor o igual que el módulo de other. false en otro caso.
    */
   bool operator>=(vector3f_t other)
   {
@@ -989,11 +989,11 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   /**
    * @brief Vector "arriba" rotado.
    *
-   * Data una rotacin expresada por un cuaternin (vase), devuelve el vector "arriba" rotado por dicho cuaternin.
+   * Data una rotación expresada por un cuaternión (véase), devuelve el vector "arriba" rotado por dicho cuaternión.
    *
    * @see vector3f_t::up()
    * @see http://es.wikipedia.org/wiki/Cuaterni%C3%B3n
-   * @param angle Cuaternin para aplicar la rotacin.
+   * @param angle Cuaternión para aplicar la rotación.
    * @return Vector "arriba" rotado.
    */
   vector3f_t up(glm::quat angle)
@@ -1007,11 +1007,11 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   /**
    * @brief Vector "izquierda" rotado.
    *
-   * Data una rotacin expresada por un cuaternin (vase), devuelve el vector "izquierda" rotado por dicho cuaternin.
+   * Data una rotación expresada por un cuaternión (véase), devuelve el vector "izquierda" rotado por dicho cuaternión.
    *
    * @see vector3f_t::left()
    * @see http://es.wikipedia.org/wiki/Cuaterni%C3%B3n
-   * @param angle Cuaternin para aplicar la rotacin.
+   * @param angle Cuaternión para aplicar la rotación.
    * @return Vector "izquierda" rotado.
    */
   vector3f_t left(glm::quat angle)
@@ -1025,11 +1025,11 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   /**
    * @brief Vector "adelante" rotado.
    *
-   * Data una rotacin expresada por un cuaternin (vase), devuelve el vector "adelante" rotado por dicho cuaternin.
+   * Data una rotación expresada por un cuaternión (véase), devuelve el vector "adelante" rotado por dicho cuaternión.
    *
    * @see vector3f_t::forward()
    * @see http://es.wikipedia.org/wiki/Cuaterni%C3%B3n
-   * @param angle Cuaternin para aplicar la rotacin.
+   * @param angle Cuaternión para aplicar la rotación.
    * @return Vector "adelante" rotado.
    */
   vector3f_t forward(glm::quat angle)
@@ -1055,7 +1055,7 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   /**
    * @brief Vector a cadena
    *
-   * Devuelve una representacin en forma de std::string del vectorviewport.
+   * Devuelve una representación en forma de std::string del vectorviewport.
    * @return std::string que almacena el los datos del vector con el formato "x y z", manteniendo su tipo original.
    */
   std::string str()
@@ -1067,9 +1067,9 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
   }
 
   /**
-   * @brief Transforma el vector en un array de tamao 3 de valores flotantes.
+   * @brief Transforma el vector en un array de tamaño 3 de valores flotantes.
    *
-   * Se podrn acceder a los elementos de la siguiente manera:
+   * Se podrán acceder a los elementos de la siguiente manera:
    *
    * @code
     vector3f v(1.0, 1.0, 1.0, 1.0);
@@ -1078,52 +1078,52 @@ typedef struct vector3f_t // ->NOTA La clase vector3f_t deber
     v.to_a()[2] = 0.3f; // Componente z
    * @endcode
    *
-   * @return float* de tamao 3, siendo una referencia al vector.
+   * @return float* de tamaño 3, siendo una referencia al vector.
    */
   float* to_a()
   {
     return (float*)this;
   }
 
-} vector3f; /**< Sinnimo para vector3f_t */
+} vector3f; /**< Sinónimo para vector3f_t */
 
 
 /*_____Functions______*/
 
-//! Espacio de nombres de algunas utilidades del motor grfico.
+//! Espacio de nombres de algunas utilidades del motor gráfico.
 namespace Utils
 {
   /**
    * @brief Generador de cadenas aleatorias.
    *
-   * Genera una cadena de caracteres alfanumricos ([0-9a-zA-Z]) de tamao "n".
-   * @param n Tamao de la cadena a generar.
+   * Genera una cadena de caracteres alfanuméricos ([0-9a-zA-Z]) de tamaño "n".
+   * @param n Tamaño de la cadena a generar.
    * @return Cadena generada.
    */
   std::string string_generate_random_alphanumeric(uint n = 4);
 
   /**
-   * @brief Cadena a minsculas.
+   * @brief Cadena a minúsculas.
    *
-   * Transforma los caracteres de una cadena de maysculas a minsculas.
+   * Transforma los caracteres de una cadena de mayúsculas a minúsculas.
    * @param str Cadena a transformar.
    * @return Cadena transformada.
    */
   std::string string_to_lower(std::string& str);
 
   /**
-   * @brief Cadena a maysculas.
+   * @brief Cadena a mayúsculas.
    *
-   * Transforma los caracteres de una cadena de minsculas a maysculas.
+   * Transforma los caracteres de una cadena de minúsculas a mayúsculas.
    * @param str Cadena a transformar.
    * @return Cadena transformada.
    */
   std::string string_to_upper(std::string& str);
 
   /**
-   * @brief Carga de imgenes con SDL.
+   * @brief Carga de imágenes con SDL.
    *
-   * Carga una imagen en formato SDL. Se usa solo para cargar el icono de la aplicacin.
+   * Carga una imagen en formato SDL. Se usa solo para cargar el icono de la aplicación.
    *
    * @see CEngine::SetIcon()
    * @param s Fichero que contiene la imagen.
@@ -1134,9 +1134,9 @@ namespace Utils
   /**
    * @brief Comprobador de validez de identificadores.
    *
-   * Comprueba si un identificador es vlido. Esto es, debe contener slo caracteres alfanumricos o guiones bajos ([0-9a-zA-Z_]).
+   * Comprueba si un identificador es válido. Esto es, debe contener sólo caracteres alfanuméricos o guiones bajos ([0-9a-zA-Z_]).
    * @param identifier Cadena que representa un identificador a valida.
-   * @return true si el identificador es vlido, false en caso contrario.
+   * @return true si el identificador es válido, false en caso contrario.
    */
   bool validateIdentifier(std::string identifier);
 
@@ -1205,20 +1205,20 @@ namespace Utils
 
 } matrixf;*/
 
-/*___Mdulos_Doxygen__*/
+/*___Módulos_Doxygen__*/
 
 /** @defgroup GameObjects GameObjects
- *  @brief Mdulo que engloba los gameObjects. */
+ *  @brief Módulo que engloba los gameObjects. */
 
 /** @defgroup Componentes Componentes
- *  @brief Mdulo que engloba todos los componentes del motor.
+ *  @brief Módulo que engloba todos los componentes del motor.
  *  @addtogroup GameObjects */
 
 /** @defgroup Sistemas Sistemas
- *  @brief Mdulo que engloba todos los sistemas del motor. */
+ *  @brief Módulo que engloba todos los sistemas del motor. */
 
 /** @defgroup Otros Otros
- *  @brief Mdulo que engloba otros elementos del motor. */
+ *  @brief Módulo que engloba otros elementos del motor. */
 
 
 
@@ -10,12 +10,14 @@
 #include "_components.h"
 #include "systems/_debug.h"
 
+class CRender_Queue;
+
 /** @addtogroup GameObjects */
 /*@{*/
 
 //namespace GO {
 
-// Intil (de momento)
+// Inútil (de momento)
 /**
  * @brief Enum sin uso.
  */
@@ -26,12 +28,12 @@ enum gameObject_flags { gof_none = 0x00, gof_render = 0x01, gof_event = 0x02, go
 enum gameObject_type {gameObject_empty = 0};//!< gameObject_empty
 
 /**
- * @brief Puntero a funcin miembro de un game object.
+ * @brief Puntero a función miembro de un game object.
  *
- * El puntero se usar para funciones del tipo "void f(CGameObject* g)".
+ * El puntero se usará para funciones del tipo "void f(CGameObject* g)".
  *
- * Se usar para guardar en el game object una serie de punteros a funciones externas para ser llamadas en determinados momentos,
- * usando como referencia al objeto el parmetro "self".
+ * Se usará para guardar en el game object una serie de punteros a funciones externas para ser llamadas en determinados momentos,
+ * usando como referencia al objeto el parámetro "self".
  *
  * @see CGameObject::start
  * @see CGameObject::behaviour
@@ -43,51 +45,85 @@ enum gameObject_type {gameObject_empty = 0};//!< gameObject_empty
  */
 typedef void (*function_t)(CGameObject* self);
 
-// Nota: aadir "CGameObject_NULL" que no haga nada en sus operaciones. As, si el manager devuelve un NULL, y se trata de acceder a un mtodo de ese NULL, no se har nada
-// -> Ya que devolver CGameObject_NULL, y no NULL
+/**
+ * @brief Manejador (handle) de un game object registrado en el sistema.
+ *
+ * Está formado por el índice del slot que ocupa el objeto en la tabla de CSystem_GameObject_Manager y por la generación de dicho slot.
+ * Cada vez que se libera un slot, su generación aumenta, por lo que un handle de un objeto ya borrado deja de ser válido aunque el slot se reutilice.
+ *
+ * @see CSystem_GameObject_Manager::Get(gameObject_handle_t)
+ * @see CSystem_GameObject_Manager::IsValid()
+ */
+struct gameObject_handle_t
+{
+  int index;
+  uint generation;
+
+  gameObject_handle_t(): index(-1), generation(0) {}
+  gameObject_handle_t(int i, uint g): index(i), generation(g) {}
+
+  inline bool operator==(const gameObject_handle_t& h) const
+  {
+    return index == h.index and generation == h.generation;
+  }
+
+  inline bool operator!=(const gameObject_handle_t& h) const
+  {
+    return !(*this == h);
+  }
+
+  // Para usarlo como clave de std::map
+  inline bool operator<(const gameObject_handle_t& h) const
+  {
+    return index != h.index ? index < h.index : generation < h.generation;
+  }
+};
+
+// Nota: añadir "CGameObject_NULL" que no haga nada en sus operaciones. Así, si el manager devuelve un NULL, y se trata de acceder a un método de ese NULL, no se hará nada
+// -> Ya que devolverá CGameObject_NULL, y no NULL
 // -> Si no, crear una instancia de CGameObject llamado "GAMEOBJECT_NULL", o algo por el estilo
 // -> O un flag tipo "null_object" en los objetos actuales que no haga nada en las funciones si el objeto es nulo.
 
 /**
  * @brief Clase que representa a un objeto de juego.
  *
- * Para entender mejor esta parte que voy a explicar, recomiendo leer el artculo siguiente: http://www.genbetadev.com/programacion-de-videojuegos/diseno-de-videojuegos-orientado-a-entidades-y-componentes
+ * Para entender mejor esta parte que voy a explicar, recomiendo leer el artículo siguiente: http://www.genbetadev.com/programacion-de-videojuegos/diseno-de-videojuegos-orientado-a-entidades-y-componentes
  *
  * @image html gameObjects/diagrama1.png
  *
- * La unidad bsica con la que trabajar nuestro motor grfico de cara al usuario que desarrollar el juego ser los objectos que realizarn una abstraccin de cualquier cosa, a los que hemos llamado cariosamente Game Objects. Un Game Object, por consiguiente, es la representacin de una entidad en el mundo real. Cada objeto debe tener un nombre para referirnos a l ("coche1", "coche1_rueda1", etc.) y un identificador (que ser usado de cara al sistema). Por ejemplo, un coche sera uno, y las ruedas que lo componen, tambin.
+ * La unidad básica con la que trabajará nuestro motor gráfico de cara al usuario que desarrollará el juego será los objectos que realizarán una abstracción de cualquier cosa, a los que hemos llamado cariñosamente Game Objects. Un Game Object, por consiguiente, es la representación de una entidad en el mundo real. Cada objeto debe tener un nombre para referirnos a él ("coche1", "coche1_rueda1", etc.) y un identificador (que será usado de cara al sistema). Por ejemplo, un coche sería uno, y las ruedas que lo componen, también.
  *
- * Ahora bien, si el coche se mueve, se deben mover las ruedas, las luces, los ejes por lo que diremos que esos objetos estn emparentados (apartado 1 en la imagen adjunta). Creando esta jerarqua, conseguimos agrupar de forma lgica los objetos, dndose el caso de que los objetos puedan tener varios hijos (o children) y un nico o ningn padre, creando una relacin bidireccional entre el padre y sus hijos por medio de una lista de punteros y un nico puntero, respectivamente. Evidentemente, no es posible que un padre sea padre de s mismo, directa o indirectamente.
+ * Ahora bien, si el coche se mueve, se deben mover las ruedas, las luces, los ejes por lo que diremos que esos objetos están emparentados (apartado 1 en la imagen adjunta). Creando esta jerarquía, conseguimos agrupar de forma lógica los objetos, dándose el caso de que los objetos puedan tener varios hijos (o children) y un único o ningún padre, creando una relación bidireccional entre el padre y sus hijos por medio de una lista de punteros y un único puntero, respectivamente. Evidentemente, no es posible que un padre sea padre de sí mismo, directa o indirectamente.
  *
- * De todas formas, no todos los objetos son iguales, verdad?. Algunos estn definidos con una serie de valores y propiedades distintas a los dems. Por ejemplo, una pelota tiene un modelo de una pelota 3D (una esfera), un material (plstico), una esfera de colisin mientras que un temporizador slo posee una parte lgica que determina si ha transcurrido un lapso de tiempo. Cmo distinguimos pues unos objetos de otros? Lo haremos mediante componentes. Cada objeto puede tener, a lo sumo, un componente de cada tipo. Por ejemplo, podemos definir varios componentes:
+ * De todas formas, no todos los objetos son iguales, ¿verdad?. Algunos están definidos con una serie de valores y propiedades distintas a los demás. Por ejemplo, una pelota tiene un modelo de una pelota 3D (una esfera), un material (plástico), una esfera de colisión mientras que un temporizador sólo posee una parte lógica que determina si ha transcurrido un lapso de tiempo. ¿Cómo distinguimos pues unos objetos de otros? Lo haremos mediante componentes. Cada objeto puede tener, a lo sumo, un componente de cada tipo. Por ejemplo, podemos definir varios componentes:
  * <ul>
- * <li><b>Transformacin:</b> Posicin, rotacin y escala de un objeto en el mundo 3D.
- * <li><b>Cmara:</b> Define una cmara desde la cual se har un renderizado de una escena.
- * <li><b>Texto de interfaz grfica de usuario</b> (GUI Text).
- * <li><b>Luz esttica:</b> Usada para iluminar el escenario
+ * <li><b>Transformación:</b> Posición, rotación y escala de un objeto en el mundo 3D.
+ * <li><b>Cámara:</b> Define una cámara desde la cual se hará un renderizado de una escena.
+ * <li><b>Texto de interfaz gráfica de usuario</b> (GUI Text).
+ * <li><b>Luz estática:</b> Usada para iluminar el escenario
  * </ul>
- * Y as, se puede crear una lista muy larga de componentes que nos servir para personalizar nuestros componentes. En el apartado 2 se pueden ver algunas formas de invocar funciones desde el objeto para obtener o modificar datos de los componentes. Intentar dedicar un post a ello.
+ * Y así, se puede crear una lista muy larga de componentes que nos servirá para personalizar nuestros componentes. En el apartado 2 se pueden ver algunas formas de invocar funciones desde el objeto para obtener o modificar datos de los componentes. Intentaré dedicar un post a ello.
  *
- * Por si fuera poco, vamos a definir 4 nuevos punteros para personalizar los objetos, que sern punteros a funciones que nos permitirn hacer llamadas a funciones dependiendo de su tipo:
+ * Por si fuera poco, vamos a definir 4 nuevos punteros para personalizar los objetos, que serán punteros a funciones que nos permitirán hacer llamadas a funciones dependiendo de su tipo:
  * <ul>
- * <li><b>start:</b> Se llama al inicio, cuando se crea el objeto y se aade al sistema.
- * <li><b>behaviour:</b> Se llama en cada iteracin, y determina el prximo estado del objeto.
- * <li><b>event:</b> Se llama cada vez que se ejecute un evento (movimiento del ratn, reescalado de ventana, etc.).
- * <li><b>input:</b> Se llama cada vez que se produce una entrada de teclado, joystick, ratn, etc. Usar antes que "event".
+ * <li><b>start:</b> Se llama al inicio, cuando se crea el objeto y se añade al sistema.
+ * <li><b>behaviour:</b> Se llama en cada iteración, y determina el próximo estado del objeto.
+ * <li><b>event:</b> Se llama cada vez que se ejecute un evento (movimiento del ratón, reescalado de ventana, etc.).
+ * <li><b>input:</b> Se llama cada vez que se produce una entrada de teclado, joystick, ratón, etc. Usar antes que "event".
  * <li><b>rener:</b> Se llama cada vez que se va a redenderizar  una tecla del teclado.
  * </ul>
- * Por ejemplo, se define una funcin behaviour para un objeto de la siguiente forma:
+ * Por ejemplo, se define una función behaviour para un objeto de la siguiente forma:
  *
  @code
   void GO1_movimiento(CGameObject* gameObject)
   {
-    // Operaciones para el objeto que vaya a usar esta funcin irn aqu.
+    // Operaciones para el objeto que vaya a usar esta función irán aquí.
   }
 
   CGameObject* GO1 = gSystem_GameObject_Manager.AddGameObject("GO1"); // Crear objeto
-  GO1->SetKeyEventBehaviourFunction(&GO1_movimiento);                 // Cargar funcin behaviour
+  GO1->SetKeyEventBehaviourFunction(&GO1_movimiento);                 // Cargar función behaviour
 @endcode
- * Que ser llamada en cada iteracin de la ejecucin de nuestra aplicacin, pasando como parmetro el puntero del objeto que apunta a s mismo (this, bsicamente). El objeto llamado gSystem_GameObject_Manager ser el sistema que se encargar de gestionar nuestros objetos, del que me encargar de explicar en el prximo post.
+ * Que será llamada en cada iteración de la ejecución de nuestra aplicación, pasando como parámetro el puntero del objeto que apunta a sí mismo (this, básicamente). El objeto llamado gSystem_GameObject_Manager será el sistema que se encargará de gestionar nuestros objetos, del que me encargaré de explicar en el próximo post.
  */
 class CGameObject
 {
@@ -102,13 +138,17 @@ class CGameObject
     bool inited;
     bool enabled;
     bool preserve;
+    bool parallel;
+    bool is_static;
     //bool DontDeleteOnLoad y void DontDeleteOnLoad();
 
     std::string name;
     int id;
+    uint generation;
 
-    std::map<int, CComponent*> components;
-    std::map<std::string, CGameObject*> children;
+    CComponent* components[Components::__component_not_defined]; // Tabla indexada por Components::components_t, NULL si no existe el componente
+    Components::signature_t signature;                           // Bit "i" activado si existe el componente "i"
+    std::vector<CGameObject*> children;                          // En orden de inserción
 
     CGameObject* Parent;
 
@@ -135,29 +175,32 @@ class CGameObject
       //ar & start & behaviour & event_behaviour & keyevent_behaviour;
     }*/
 
+    // Los objetos se reservan en bloques (véase CComponent_Pool)
+    __COMPONENT_POOL_DECLARE(CGameObject)
+
   public:
     /**
      * @brief Constructor principal.
      *
-     * Construye un objeto "vaco" dado un nombre. Crear un objeto no implica que se aada al sistema gestor de objetos CSystem_GameObject_Manager.
+     * Construye un objeto "vacío" dado un nombre. Crear un objeto no implica que se añada al sistema gestor de objetos CSystem_GameObject_Manager.
      *
-     * El objeto poseer un nombre especificado por "name" y tendr un componente inicial, CComponent_Transform, que indicar su siutacin, orientacin y tamao en el espacio.
+     * El objeto poseerá un nombre especificado por "name" y tendrá un componente inicial, CComponent_Transform, que indicará su siutación, orientación y tamaño en el espacio.
      *
      * @param name Nombre del game object.
      */
     CGameObject(std::string name);
 
     /**
-     * @brief Constructor vaco.
+     * @brief Constructor vacío.
      *
-     * Crea un objeto vaco, sin propiedades y sin usar atributos. Usado principalmente para copias y pruebas.
+     * Crea un objeto vacío, sin propiedades y sin usar atributos. Usado principalmente para copias y pruebas.
      */
     CGameObject();
 
     /**
      * @brief Destructor principal.
      *
-     * Desactiva por completo el objeto, adems de eliminar todos sus componentes y atributos.
+     * Desactiva por completo el objeto, además de eliminar todos sus componentes y atributos.
      */
     virtual ~CGameObject()
     {
@@ -167,8 +210,8 @@ class CGameObject
     /**
      * @brief Iniciar el objeto.
      *
-     * Inicializa el gameObject, haciendo que pase a estar activado, adems de aadir el componente CComponent_Transform (por si no ha sido aadido, claro).
-     * Adems, el objeto queda marcado como <b>iniciado</b> y como <b>activo.</b> Slo podr ser iniciado si no ha sido iniciado previamente, osi ha sido cerrado.
+     * Inicializa el gameObject, haciendo que pase a estar activado, además de añadir el componente CComponent_Transform (por si no ha sido añadido, claro).
+     * Además, el objeto queda marcado como <b>iniciado</b> y como <b>activo.</b> Sólo podrá ser iniciado si no ha sido iniciado previamente, osi ha sido cerrado.
      */
     void Init();
       /** @brief @no_use */
@@ -176,7 +219,7 @@ class CGameObject
     /**
      * @brief Cerrar el objeto.
      *
-     * Una vez iniciado, el gameObject puede ser cerrado, eliminando todos sus <b>componentes</b> e <b>hijos</b>.  Adems, el objeto es marcado como
+     * Una vez iniciado, el gameObject puede ser cerrado, eliminando todos sus <b>componentes</b> e <b>hijos</b>.  Además, el objeto es marcado como
      * <b>no iniciado</b> y como <b>desactivado</b>.
      */
     void Close();
@@ -184,29 +227,30 @@ class CGameObject
       virtual void CloseCustom(){};
 
     /** @brief @no_use */
-    flags_t Get_flags() {return flags; } // Los flags slo deberan ser maniplados por el objeto, no por el usuario
+    flags_t Get_flags() {return flags; } // Los flags sólo deberían ser maniplados por el objeto, no por el usuario
 
     /**
-     * @brief Aadir un nuevo hijo.
+     * @brief Añadir un nuevo hijo.
      *
-     * Aade un nuevo hijo al objeto actual dado otro objeto existente, siempre y cuando sea posible.
-     * Slo se podr aadir un hijo si el padre no es hijo de alguno de los hijos del objeto a aadir, o si el onjeto no es idntico al objeto a aadir.
-     * Esto significa que no puede haber ciclos en la jerarqua de gameObjects. Finalmente, asigna al hijo aadido, si todo ha funcionado correctamente, un padre tal que sea el objeto actual.
+     * Añade un nuevo hijo al objeto actual dado otro objeto existente, siempre y cuando sea posible.
+     * Sólo se podrá añadir un hijo si el padre no es hijo de alguno de los hijos del objeto a añadir, o si el onjeto no es idéntico al objeto a añadir.
+     * Esto significa que no puede haber ciclos en la jerarquía de gameObjects. Finalmente, asigna al hijo añadido, si todo ha funcionado correctamente, un padre tal que sea el objeto actual.
      *
-     * @warning En caso de aadir un objeto con un nombre ya existente, se perder la referencia al objeto aadido anteriormente. Asegrese primero de que el objeto no es hijo del padre antes de aadirlo.
+     * La comprobación de ciclos sube por la cadena de padres del objeto actual, por lo que su coste depende sólo de la profundidad de la jerarquía.
+     * Si el hijo ya tenía otro padre, se quita de la lista de hijos de éste.
      *
-     * @param child Puntero a gameObject a aadir. Debe estar inicializado correctamente.
-     * @return true si aade el hijo correctamente, false en cualquier otro caso.
+     * @param child Puntero a gameObject a añadir. Debe estar inicializado correctamente.
+     * @return true si añade el hijo correctamente, false en cualquier otro caso.
      */
     bool AddChild(CGameObject* child);
     /**
-     * @brief Aadir una lista de hijos.
+     * @brief Añadir una lista de hijos.
      *
-     * Dada una lista de hijos, se pueden aadir al objeto actual todos los hijos de la lista.
-     * Se intentar aadir hijo a hijo todos los posibles que esten en la lista, siempre y cuando cumplan las condiciones de CGameObject::AddChild().
-     * A todo objeto aadido, se le asignar como padre el objeto actual.
+     * Dada una lista de hijos, se pueden añadir al objeto actual todos los hijos de la lista.
+     * Se intentará añadir hijo a hijo todos los posibles que esten en la lista, siempre y cuando cumplan las condiciones de CGameObject::AddChild().
+     * A todo objeto añadido, se le asignará como padre el objeto actual.
      *
-     * Por ejemplo, se podr usar este mtodo de la siguiente manera:
+     * Por ejemplo, se podrá usar este método de la siguiente manera:
      *
      @code
      CGameObject* go1  = new CGameObject("go1");
@@ -215,10 +259,10 @@ class CGameObject
 
      go1->AddChildren({go11, go12});
      @endcode
-     * @bug Para listas de objetos de tamao menor que 2, es posible que haya que especificar el tipo, tal que se represente como <span><i>std::vector<CGameObject*>{go11, go12}</i></span>
+     * @bug Para listas de objetos de tamaño menor que 2, es posible que haya que especificar el tipo, tal que se represente como <span><i>std::vector<CGameObject*>{go11, go12}</i></span>
      *
-     * @param children Array que contendr los punteros a los hijos a aadir.
-     * @return En caso de xtio, devuelve el valor "1". En caso de fallo, devuelve el ndice de la ltima posicin en la que fall, con valor negativo (0, -1, -2, ..., -(n-1)).
+     * @param children Array que contendrá los punteros a los hijos a añadir.
+     * @return En caso de éxtio, devuelve el valor "1". En caso de fallo, devuelve el índice de la última posición en la que falló, con valor negativo (0, -1, -2, ..., -(n-1)).
      */
     short int AddChildren(const std::vector<CGameObject*>& children); // Returns 1 on succes. Otherwise, returns the negative index of the last element which failed at AddChild (0, -1, -2, ..., -N)
     //bool AddChildren(const std::initializer_list<CGameObject*>& init) { return }
@@ -227,7 +271,7 @@ class CGameObject
      * @brief Eliminar un hijo.
      *
      * Elimina un hijo del objeto de juego.
-     * @warning El hijo ser eliminado de la lista de hijos, pero no ser borrado del sistema. Esto es, no se llamar a CGameObject::Close() ni se har un **delete**.
+     * @warning El hijo será eliminado de la lista de hijos, pero no será borrado del sistema. Esto es, no se llamará a CGameObject::Close() ni se hará un **delete**.
      * @param name Nombre del hijo a eliminar.
      * @return En caso de borrarlo correctamente, devuelve true. En otro caso, retorna false.
      */
@@ -236,7 +280,7 @@ class CGameObject
      * @brief Eliminar a todos los hijos.
      *
      * Elimina a todos los hijos del objeto actual.
-     * @warning Los hijos serm eliminados de la lista de hijos, pero no serm borrados del sistema. Esto es, no se llamar a CGameObject::Close() ni se harn **delete**.
+     * @warning Los hijos serám eliminados de la lista de hijos, pero no serám borrados del sistema. Esto es, no se llamará a CGameObject::Close() ni se harán **delete**.
      */
     void RemoveChildren();
 
@@ -251,25 +295,25 @@ class CGameObject
     /**
      * @brief Obtiene un puntero a un hijo.
      *
-     * Dado un ndice, se acceder a un hijo que ocupe dicho ndice. Los hijos sern ordenados por orden alfabtico (funcionamiento de un std::map).
+     * Dado un índice, se accederá a un hijo que ocupe dicho índice. Los hijos se ordenan por orden de inserción (véase CGameObject::AddChild()).
      *
      * @see CGameObject::GetNumChildren()
-     * @param index Valor entre 0 y el nmero de hijos actual. Vase CGameObject::GetNumChildren().
+     * @param index Valor entre 0 y el número de hijos actual. Véase CGameObject::GetNumChildren().
      * @return Devuelve el puntero al objeto si es un hijo del objeto actual. En otro caso, devuelve NULL.
      */
     CGameObject* GetChild(uint index);
     /**
-     * @brief Nmero de hijos.
+     * @brief Número de hijos.
      *
-     * Retorna el nmero de hijos del objeto actual.
-     * @return Nmero de hijos del objeto actual (tamao de la lista de hijos).
+     * Retorna el número de hijos del objeto actual.
+     * @return Número de hijos del objeto actual (tamaño de la lista de hijos).
      */
     inline uint GetNumChildren(){return children.size();}
 
     /**
      * @brief Obtener el padre.
      *
-     * @return Retorna un puntero al padre que lleva a este hijo. Si es hurfano, devolver NULL.
+     * @return Retorna un puntero al padre que lleva a este hijo. Si es huérfano, devolverá NULL.
      */
     inline CGameObject* GetParent()
     {
@@ -279,18 +323,19 @@ class CGameObject
     /**
      * @brief Elimina el padre.
      *
-     * Si el objeto tiene un padre, tratar de volverse hurfano, eliminando el puntero a su padre, y limpiando la referencia del padre al hijo en el padre.
+     * Si el objeto tiene un padre, tratará de volverse huérfano, eliminando el puntero a su padre, y limpiando la referencia del padre al hijo en el padre.
      */
     inline void RemoveParent()
     {
-      Parent->RemoveChild(name);
+      if(Parent)
+        Parent->RemoveChild(name);
     }
 
     /**
      * @brief Cambiar el callback "start".
      *
-     * Cambia el puntero del callback **Start**, que ser una funcin que se llamar al iniciar el objeto.
-     * @param f Puntero a funcin externa. Si es NULL, suponemos que no se usar ningn callback.
+     * Cambia el puntero del callback **Start**, que será una función que se llamará al iniciar el objeto.
+     * @param f Puntero a función externa. Si es NULL, suponemos que no se usará ningún callback.
      */
     inline void SetStartFunction(function_t f)
     {
@@ -300,8 +345,8 @@ class CGameObject
     /**
      * @brief Cambiar el callback "behaviour".
      *
-     * Cambia el puntero del callback **Behaviour**, que ser una funcin que se llamar en cada iteracin del juego (actualizacin constante).
-     * @param f Puntero a funcin externa. Si es NULL, suponemos que no se usar ningn callback.
+     * Cambia el puntero del callback **Behaviour**, que será una función que se llamará en cada iteración del juego (actualización constante).
+     * @param f Puntero a función externa. Si es NULL, suponemos que no se usará ningún callback.
      */
     inline void SetBehaviourFunction(function_t f)
     {
@@ -311,8 +356,8 @@ class CGameObject
     /**
      * @brief Cambiar el callback "event".
      *
-     * Cambia el puntero del callback **Event**, que ser una funcin que se llamar cada vez que se produzca un evento.
-     * @param f Puntero a funcin externa. Si es NULL, suponemos que no se usar ningn callback.
+     * Cambia el puntero del callback **Event**, que será una función que se llamará cada vez que se produzca un evento.
+     * @param f Puntero a función externa. Si es NULL, suponemos que no se usará ningún callback.
      */
     inline void SetEventFunction(function_t f)
     {
@@ -322,9 +367,9 @@ class CGameObject
     /**
      * @brief Cambiar el callback "input".
      *
-     * Cambia el puntero del callback **Event**, que ser una funcin que se llamar en cada iteracin del juego, que procesar datos de entrada (teclado, retn, joystick...).
+     * Cambia el puntero del callback **Event**, que será una función que se llamará en cada iteración del juego, que procesará datos de entrada (teclado, retón, joystick...).
      * @see CSystem_UserInput.
-     * @param f Puntero a funcin externa. Si es NULL, suponemos que no se usar ningn callback.
+     * @param f Puntero a función externa. Si es NULL, suponemos que no se usará ningún callback.
      */
     inline void SetInputFunction(function_t f)
     {
@@ -334,16 +379,28 @@ class CGameObject
     /**
      * @brief Cambiar el callback "render".
      *
-     * Cambia el puntero del callback **Render**, que ser una funcin que se llamar en cada iteracin del juego, a la hora de dibujar el objeto por pantalla.
-     * @param f Puntero a funcin externa. Si es NULL, suponemos que no se usar ningn callback.
+     * Cambia el puntero del callback **Render**, que será una función que se llamará en cada iteración del juego, a la hora de dibujar el objeto por pantalla.
+     * @param f Puntero a función externa. Si es NULL, suponemos que no se usará ningún callback.
      */
     inline void SetRenderFunction(function_t f)
     {
       render = f;
+
+      // CSystem_Spatial nunca descarta los objetos con callback de render
+      if(Transform())
+        Transform()->BoundsChanged();
+    }
+
+    /**
+     * @brief Comprobar si el objeto tiene callback "render".
+     */
+    inline bool HasRenderFunction()
+    {
+      return render != NULL;
     }
 
     /**
-     * @brief LLama al callback **Start**, siempre y cuando no sea NULL. Ser llamado de manera automtica desde CGameObject.Init().
+     * @brief LLama al callback **Start**, siempre y cuando no sea NULL. Será llamado de manera automática desde CGameObject.Init().
      */
     inline void CallStartFunction()
     {
@@ -351,7 +408,7 @@ class CGameObject
     }
 
     /**
-     * @brief LLama al callback **Behaviour**, siempre y cuando no sea NULL. Ser llamado de manera automtica desde CGameObject.OnLoop().
+     * @brief LLama al callback **Behaviour**, siempre y cuando no sea NULL. Será llamado de manera automática desde CGameObject.OnLoop().
      */
     inline void CallBehaviourFunction()
     {
@@ -360,7 +417,7 @@ class CGameObject
 
 
     /**
-     * @brief LLama al callback *Event**, siempre y cuando no sea NULL. Ser llamado de manera automtica desde CGameObject.OnEvent().
+     * @brief LLama al callback *Event**, siempre y cuando no sea NULL. Será llamado de manera automática desde CGameObject.OnEvent().
      */
     inline void CallEventFunction()
     {
@@ -369,7 +426,7 @@ class CGameObject
 
 
     /**
-     * @brief LLama al callback **Input**, siempre y cuando no sea NULL. Ser llamado de manera automtica desde CGameObject.OnInput().
+     * @brief LLama al callback **Input**, siempre y cuando no sea NULL. Será llamado de manera automática desde CGameObject.OnInput().
      */
     inline void CallInputFunction()
     {
@@ -377,7 +434,7 @@ class CGameObject
     }
 
     /**
-     * @brief LLama al callback **Render**, siempre y cuando no sea NULL. Ser llamado de manera automtica desde CGameObject.OnRender().
+     * @brief LLama al callback **Render**, siempre y cuando no sea NULL. Será llamado de manera automática desde CGameObject.OnRender().
      */
     inline void CallRenderFunction()
     {
@@ -389,17 +446,17 @@ class CGameObject
      * @brief Registrar un objeto en el sistema.
      *
      * Registra un objeto de juego en la lista de objetos globales, administrado por el sistema CSystem_GameObject_Manager.
-     * Un objeto no podr ser aadido si ya existe un objeto con su nombre, o si su identificador es invlido.
+     * Un objeto no podrá ser añadido si ya existe un objeto con su nombre, o si su identificador es inválido.
      *
      * @see Utils::validateIdentifier
-     * @return Si se registra correctamente, devuelve un identificador numrico del objeto. En caso contrario, devuelve -1.
+     * @return Si se registra correctamente, devuelve un identificador numérico del objeto. En caso contrario, devuelve -1.
      */
     int AddToSystem();
     /**
      * @brief Elimina un objeto del sistema.
      *
      * Elimina un objeto de la lista de objetos globales, administrado por el sistema CSystem_GameObject_Manager.
-     * Un objeto no podr ser eliminado si no est registrado.
+     * Un objeto no podrá ser eliminado si no está registrado.
      * @return Devuelve true si se ha eliminado del sistema correctamente, false en cualquier otro caso.
      */
     bool RemoveFromSystem();
@@ -407,71 +464,96 @@ class CGameObject
     /**
      * @brief Gestor de eventos.
      *
-     * Funcin para gestionar los eventos del objeto y de todos sus componentes. Ser llamado desde CSystem_GameObject_Manager::OnEvent(), al principio de cada iteracin.
+     * Función para gestionar los eventos del objeto y de todos sus componentes. Será llamado desde CSystem_GameObject_Manager::OnEvent(), al principio de cada iteración.
      *
-     * Si el objeto no est en modo **activo** e **iniciado**, no se llamar a esta funcin.
+     * Si el objeto no está en modo **activo** e **iniciado**, no se llamará a esta función.
      *
-     * @warning Esta funcin no debe ser llamada de manera explcita.
+     * @warning Esta función no debe ser llamada de manera explícita.
      */
     void OnEvent();
     /**
      * @brief Gestor de entrada.
      *
-     * Funcin para gestionar la entrada (ratn, teclado, etc.) y de todos sus componentes. Ser llamado desde CSystem_GameObject_Manager::OnInput(), despus de CSystem_GameObject_Manager::OnEvent().
+     * Función para gestionar la entrada (ratón, teclado, etc.) y de todos sus componentes. Será llamado desde CSystem_GameObject_Manager::OnInput(), después de CSystem_GameObject_Manager::OnEvent().
      *
-     * Si el objeto no est en modo **activo** e **iniciado**, no se llamar a esta funcin.
+     * Si el objeto no está en modo **activo** e **iniciado**, no se llamará a esta función.
      *
-     * @warning Esta funcin no debe ser llamada de manera explcita.
+     * @warning Esta función no debe ser llamada de manera explícita.
      */
     void OnInput();
     /**
      * @brief Gestor de comportamientos.
      *
-     * Funcin para gestionar el comportamiento del objeto y de todos sus componentesen cada iteracin. Ser llamado desde CSystem_GameObject_Manager::OnLoop(), despus de CSystem_GameObject_Manager::OnInput().
+     * Función para gestionar el comportamiento del objeto y de todos sus componentesen cada iteración. Será llamado desde CSystem_GameObject_Manager::OnLoop(), después de CSystem_GameObject_Manager::OnInput().
      *
-     * Si el objeto no est en modo **activo** e **iniciado**, no se llamar a esta funcin.
+     * Si el objeto no está en modo **activo** e **iniciado**, no se llamará a esta función.
      *
-     * @warning Esta funcin no debe ser llamada de manera explcita.
+     * @param components Máscara de los componentes cuyo OnLoop se llamará. Los componentes que tienen un sistema propio en CSystem_Scheduler se excluyen.
+     * @warning Esta función no debe ser llamada de manera explícita.
      */
-    void OnLoop();
+    void OnLoop(Components::signature_t components = ~(Components::signature_t)0);
     /**
      * @brief Gestor de renderizado.
      *
-     * Funcin para gestionar el dibujado del objeto y de todos sus componentes. Ser llamado desde CSystem_GameObject_Manager::OnRender(), despus de CSystem_GameObject_Manager::OnLoop().
+     * Función para gestionar el dibujado del objeto y de todos sus componentes. Será llamado desde CSystem_GameObject_Manager::OnRender(), después de CSystem_GameObject_Manager::OnLoop().
      *
-     * Si el objeto no est en modo **activo** e **iniciado**, no se llamar a esta funcin.
+     * Si el objeto no está en modo **activo** e **iniciado**, no se llamará a esta función.
      *
-     * @param projMatrix       Matriz de proyeccin actual (interno al sistema).
+     * @param projMatrix       Matriz de proyección actual (interno al sistema).
      * @param modelViewMatrix  Matriz de modelo-vista (modelview) actual (interno al sistema).
+     * @param frustum          Frustum de la cámara actual. Si no es NULL, no se dibujan los componentes cuyo volumen envolvente queda fuera (véase Culling).
+     * @param queue            Cola de dibujo de la cámara actual. Si no es NULL, los componentes se añaden a la cola en lugar de dibujarse (véase CRender_Queue).
      *
-     * @warning Esta funcin no debe ser llamada de manera explcita.
+     * @warning Esta función no debe ser llamada de manera explícita.
      */
-    void OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix);
+    void OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix, const Culling::frustum_t* frustum = NULL, CRender_Queue* queue = NULL);
+    /**
+     * @brief Dibujar los dummys del objeto y llamar al callback **Render**.
+     *
+     * Es la parte de OnRender() que no pasa por CRender_Queue. La cola lo llama después de dibujar los modelos opacos.
+     *
+     * @warning Esta función no debe ser llamada de manera explícita.
+     */
+    void OnRenderCallbacks(glm::mat4 projMatrix, glm::mat4 modelViewMatrix);
     //void OnRenderDebug();
 
   protected:
-    void Register(uint ID)
+    // Los componentes cambian el volumen envolvente del objeto en CSystem_Spatial
+    inline void SetComponent(int c, CComponent* component)
     {
-      id = ID;
+      components[c] = component;
+      signature |= Components::bit((Components::components_t)c);
+
+      if(c != Components::transform and Transform())
+        Transform()->BoundsChanged();
     }
 
-    inline void SetParent(CGameObject* parent)
+    inline void ClearComponent(int c)
     {
-      if(parent != NULL)
-        Parent = parent;
+      components[c] = NULL;
+      signature &= ~Components::bit((Components::components_t)c);
+
+      if(c != Components::transform and Transform())
+        Transform()->BoundsChanged();
     }
 
-    inline void UnParent() // no usar nunca desde fuera
+    void Register(int ID, uint gen = 0)
     {
-      //Parent->RemoveChild(name);
-      Parent = NULL;
+      id = ID;
+      generation = gen;
     }
 
+    void SetParent(CGameObject* parent);
+    void UnParent(); // no usar nunca desde fuera
+
+    void SetRecursive(bool CGameObject::* attribute, bool state);
+    void SetRecursive_Untransformed(bool CGameObject::* attribute, bool state); // Hijos sin transformación, fuera de la jerarquía plana
+
   public:
 
     /**
      * @brief Getter del nombre del objeto.
-     * @return Nombre del objeto. Si est registrado en el sistema, se asegura de que es un identificador vlido.
+     * @return Nombre del objeto. Si está registrado en el sistema, se asegura de que es un identificador válido.
      */
     inline std::string GetName()
     {
@@ -479,25 +561,41 @@ class CGameObject
     }
     /**
      * @brief Getter del identificador del objeto en el sistema.
-     * @return Si est registrado, el identificador tiene un valor mayor o igual que 0. En otro caso, vale -1.
+     * @return Si está registrado, el identificador tiene un valor mayor o igual que 0. En otro caso, vale -1.
      */
     inline int GetID()
     {
       return id;
     }
 
+    /**
+     * @brief Getter del handle del objeto en el sistema.
+     *
+     * A diferencia de un puntero, el handle puede guardarse y comprobarse más tarde con CSystem_GameObject_Manager::IsValid(), aunque el objeto haya sido borrado.
+     *
+     * @return Handle del objeto. Si no está registrado, su índice vale -1.
+     */
+    inline gameObject_handle_t GetHandle()
+    {
+      return gameObject_handle_t(id, generation);
+    }
+
     /**
      * @brief Activa el objeto.
      *
      * Cambia el estado del objeto actual por **activo**.
-     * @param recursive Si es true, se activarn todos sus hijos de manera recursiva. En caso contrario, slo se activar el objeto actual.
+     * @param recursive Si es true, se activarán todos sus hijos de manera recursiva. En caso contrario, sólo se activará el objeto actual.
+     *
+     * Las operaciones recursivas (también Disable(), SetState(), Preserve(), etc.) recorren el rango contiguo de descendientes de la jerarquía plana
+     * (véase CComponent_Transform_Data::Subtree()), en vez de bajar hijo a hijo. Si la jerarquía ha cambiado en esta iteración (objetos nuevos,
+     * cambios de padre), se baja hijo a hijo, para no reconstruirla en cada llamada.
      */
     void Enable(bool recursive = false);
     /**
      * @brief Desactiva el objeto.
      *
      * Cambia el estado del objeto actual por **desactivado**.
-     * @param recursive Si es true, se desactivarn todos sus hijos de manera recursiva. En caso contrario, slo se desactivar el objeto actual.
+     * @param recursive Si es true, se desactivarán todos sus hijos de manera recursiva. En caso contrario, sólo se desactivará el objeto actual.
      */
     void Disable(bool recursive = false);
     /**
@@ -506,33 +604,33 @@ class CGameObject
      * Cambia el estado del objeto actual por el estado especificado por "state" (true -> **activo**, false -> **desactivado**.
      *
      * @param state Nuevo estado de los objetos.
-     * @param recursive Si es true, se cambiar el estado todos sus hijos de manera recursiva. En caso contrario, slo se cambiar el objeto actual.
+     * @param recursive Si es true, se cambiará el estado todos sus hijos de manera recursiva. En caso contrario, sólo se cambiará el objeto actual.
      */
     void SetState(bool state, bool recursive = false);
 
     /**
      * @brief Preservar el objeto entre estancias.
      *
-     * Un objeto se conoce como que est preservado si mantiene sus datos intactos entre los cambios de estancia. Bsicamente, son objetos que
-     * no ser borrados al cambiar de estancia o nivel, y que permanecer con el mismo nombre y el mismo contenido que en su ltima estancia.
+     * Un objeto se conoce como que está preservado si mantiene sus datos intactos entre los cambios de estancia. Básicamente, son objetos que
+     * no será borrados al cambiar de estancia o nivel, y que permanecerá con el mismo nombre y el mismo contenido que en su última estancia.
      *
      * @see CEngine
      * @see CInstance
-     * @param recursive  Si es true, se marcarn como ***preservar*** todos sus hijos de manera recursiva. En caso contrario, slo se cambiar el objeto actual.
+     * @param recursive  Si es true, se marcarán como ***preservar*** todos sus hijos de manera recursiva. En caso contrario, sólo se cambiará el objeto actual.
      */
     void Preserve(bool recursive = false);
     /**
      * @brief No preservar el objeto entre estancias.
      *
-     * Antnimo de CGameObject::Preserve().
+     * Antónimo de CGameObject::Preserve().
      *
      * @see CEngine
      * @see CInstance
-     * @param recursive  Si es true, se marcarn como ***no preservar*** todos sus hijos de manera recursiva. En caso contrario, slo se cambiar el objeto actual.
+     * @param recursive  Si es true, se marcarán como ***no preservar*** todos sus hijos de manera recursiva. En caso contrario, sólo se cambiará el objeto actual.
      */
     void UnPreserve(bool recursive = false);
     /**
-     * @brief Cambiar preservacin del objeto entre estancias.
+     * @brief Cambiar preservación del objeto entre estancias.
      *
      * Combina CGameObject::Preserve() y CGameObject::UnPreserve().
      *
@@ -540,23 +638,54 @@ class CGameObject
      * @see CInstance
      *
      * @param state Nuevo estado (true -> **preservar**, false -> **no preservar**)
-     * @param recursive  Si es true, se marcarn como el estado indicado a todos sus hijos de manera recursiva. En caso contrario, slo se cambiar el objeto actual.
+     * @param recursive  Si es true, se marcarán como el estado indicado a todos sus hijos de manera recursiva. En caso contrario, sólo se cambiará el objeto actual.
      */
     void SetPreserve(bool state, bool recursive = false);
 
     /**
-     * @brief Preguntar si el objeto est **activado**.
+     * @brief Cambiar la ejecución en paralelo del objeto.
+     *
+     * Si un objeto está marcado como **paralelo**, CSystem_GameObject_Manager ejecutará su callback "behaviour" y el OnLoop de sus componentes
+     * en los hilos de CSystem_Jobs, junto al resto de objetos paralelos, antes que los objetos no paralelos.
+     *
+     * Un objeto paralelo sólo debe modificar su propio estado: no debe añadir, borrar ni reemparentar objetos, ni añadir o quitar componentes,
+     * ni llamar a OpenGL. Sí puede leer el estado de otros objetos que no cambien durante la iteración.
+     *
+     * @see CSystem_Jobs
+     * @param state Nuevo estado (true -> **paralelo**, false -> **en el hilo principal**)
+     * @param recursive  Si es true, se cambiará el estado de todos sus hijos de manera recursiva. En caso contrario, sólo se cambiará el objeto actual.
+     */
+    void SetParallel(bool state, bool recursive = false);
+
+    /**
+     * @brief Marcar el objeto como **estático**.
+     *
+     * Un objeto estático no se mueve ni cambia su modelo, textura, shader o color después de que termine el callback de carga de la estancia.
+     * Al terminar la carga, CSystem_Static_Batching junta los modelos de los objetos estáticos en unos pocos modelos ya transformados, de forma
+     * que se dibujan con una llamada por celda, shader, textura y color en lugar de una por objeto.
+     *
+     * Si se borra un objeto estático (o su CComponent_Mesh_Render), los demás de su grupo vuelven a dibujarse uno a uno. Los objetos creados
+     * después de la carga no se juntan hasta la siguiente llamada a CSystem_Static_Batching::Bake().
+     *
+     * @see CSystem_Static_Batching
+     * @param state Nuevo estado (true -> **estático**, false -> **dinámico**)
+     * @param recursive  Si es true, se cambiará el estado de todos sus hijos de manera recursiva. En caso contrario, sólo se cambiará el objeto actual.
+     */
+    void SetStatic(bool state, bool recursive = false);
+
+    /**
+     * @brief Preguntar si el objeto está **activado**.
      *
-     * @return Retorna true si el objeto est **activado**. false en caso contrario.
+     * @return Retorna true si el objeto está **activado**. false en caso contrario.
      */
     inline bool IsEnabled()
     {
       return enabled;
     }
     /**
-     * @brief Preguntar si el objeto est **iniciado**.
+     * @brief Preguntar si el objeto está **iniciado**.
      *
-     * @return Retorna true si el objeto est **iniciado**. false en caso contrario.
+     * @return Retorna true si el objeto está **iniciado**. false en caso contrario.
      */
     inline bool IsInited()
     {
@@ -564,9 +693,9 @@ class CGameObject
     }
 
     /**
-     * @brief Preguntar si el objeto est marcado como **preservado**.
+     * @brief Preguntar si el objeto está marcado como **preservado**.
      *
-     * @return Retorna true si el objeto est marcado como **preservado**. false en caso contrario.
+     * @return Retorna true si el objeto está marcado como **preservado**. false en caso contrario.
      */
     inline bool IsPreserved()
     {
@@ -574,20 +703,53 @@ class CGameObject
     }
 
     /**
-     * @brief Comprobador de cercana.
+     * @brief Preguntar si el objeto está marcado como **paralelo**.
+     *
+     * @return Retorna true si el objeto está marcado como **paralelo**. false en caso contrario.
+     */
+    inline bool IsParallel()
+    {
+      return parallel;
+    }
+
+    /**
+     * @brief Preguntar si el objeto está marcado como **estático**.
+     *
+     * @return Retorna true si el objeto está marcado como **estático**. false en caso contrario.
+     */
+    inline bool IsStatic()
+    {
+      return is_static;
+    }
+
+    /**
+     * @brief Comprobador de cercanía.
      *
-     * Dado otro objeto, el objeto actual y una distancia, se comprobar si la distancia entre el origen de ambos objetos es menor a la distancia propuesta. Se usar la funcin de distancia eucldea.
+     * Dado otro objeto, el objeto actual y una distancia, se comprobará si la distancia entre el origen de ambos objetos es menor a la distancia propuesta. Se usará la función de distancia euclídea.
      * @param go Otro objeto.
      * @param distance Distancia entre ambos objetos.
-     * @return Devuelve true si la distancia eucldea entre los 2 objetos es menor que "distance". false en caso contrario.
+     * @return Devuelve true si la distancia euclídea entre los 2 objetos es menor que "distance". false en caso contrario.
      */
     bool NearBy(CGameObject* go, double distance);
 
+    /**
+     * @brief Objetos cercanos.
+     *
+     * Busca en el índice espacial (CSystem_Spatial) los objetos cuyo volumen envolvente está a menos de "distance" del origen del objeto actual.
+     * El coste depende del número de objetos cercanos, no del número total de objetos. El índice se actualiza una vez por iteración,
+     * después de los callbacks, así que refleja las posiciones de la iteración anterior.
+     * @param distance Distancia máxima.
+     * @param output Vector al que se añaden los objetos encontrados (sin incluir el objeto actual).
+     * @param components Si no es 0, sólo se devuelven los objetos que tengan todos estos componentes (véase Components::bit()).
+     * @return Número de objetos añadidos.
+     */
+    uint NearBy(double distance, std::vector<CGameObject*>& output, Components::signature_t components = 0);
+
     /* PLANTILLAS */
     /**
      * @brief Obtener componente.
      *
-     * Dada la funcin plantilla actual, se podr obtener un componente seleccionado, siempre y cuando exista.
+     * Dada la función plantilla actual, se podrá obtener un componente seleccionado, siempre y cuando exista.
      *
      * Por ejemplo, podemos usar:
      @code
@@ -602,7 +764,7 @@ class CGameObject
     Type* GetComponent();
 
     /**
-     * @brief Obtener componente (genrico).
+     * @brief Obtener componente (genérico).
      *
      * Obtiene un componente del tipo "CComponent*", siempre y cuando exista el identificador del componente asociado.
      *
@@ -613,27 +775,55 @@ class CGameObject
      */
     CComponent* GetComponent(Components::components_t c)
     {
-      if(components.find(c) != components.end())
+      if(c >= 0 and c < Components::__component_not_defined)
         return components[c];
 
       return NULL;
     }
 
     /**
-     * @brief Aadir un componente.
+     * @brief Obtener la firma de componentes.
+     *
+     * @see Components::signature_t
+     * @return Máscara de bits con los componentes que tiene el objeto.
+     */
+    inline Components::signature_t GetSignature()
+    {
+      return signature;
+    }
+
+    /**
+     * @brief Comprobar si el objeto tiene una serie de componentes.
+     *
+     * Por ejemplo, podemos usar:
+     @code
+     if(go1->HasComponents(Components::bit(Components::transform) | Components::bit(Components::mesh_render)))
+       ...
+     @endcode
+     *
+     * @param mask Máscara con los bits de los componentes a comprobar (véase Components::bit()).
+     * @return Devuelve true si el objeto tiene todos los componentes indicados en "mask". false en caso contrario.
+     */
+    inline bool HasComponents(Components::signature_t mask)
+    {
+      return (signature & mask) == mask;
+    }
+
+    /**
+     * @brief Añadir un componente.
      *
-     * Dada la funcin plantilla actual, se podr aadir un componente del tipo indicado, siempre y cuando exista.
+     * Dada la función plantilla actual, se podrá añadir un componente del tipo indicado, siempre y cuando exista.
      *
      * @warning Solo puede haber un componente de cada tipo.
      *
      * Por ejemplo, podemos usar:
      @code
      CGameObject go1 = new CGameObject("go1");
-     go1->AddComponent<CComponent_Camera*>(); // Aade el componente "camera".
+     go1->AddComponent<CComponent_Camera*>(); // Añade el componente "camera".
      @endcode
      *
      * @see CComponent
-     * @return Retorna true si se ha aadido el componente, false en caso contrario.
+     * @return Retorna true si se ha añadido el componente, false en caso contrario.
      */
     template <class Type>
     bool AddComponent();
@@ -641,7 +831,7 @@ class CGameObject
     /**
      * @brief Eliminar un componente.
      *
-     * Dada la funcin plantilla actual, se podr eliminar un componente seleccionado, siempre y cuando exista en el objeto. El componente ser destruido por completo.
+     * Dada la función plantilla actual, se podrá eliminar un componente seleccionado, siempre y cuando exista en el objeto. El componente será destruido por completo.
      *
      * @warning No se puede eliminar el componente CComponent_Transform.
      *
@@ -660,12 +850,12 @@ class CGameObject
     /**
      * @brief Cambiar el estado de un componente.
      *
-     * Dada la funcin plantilla actual, se podr cambiar el estado de un componente seleccionado, siempre y cuando exista, por **activado** o **desactivado**.
+     * Dada la función plantilla actual, se podrá cambiar el estado de un componente seleccionado, siempre y cuando exista, por **activado** o **desactivado**.
      *
      * Por ejemplo, podemos usar:
      @code
      CGameObject go1 = new CGameObject("go1");
-     go1->SetComponentState<CComponent_Camera*>(true); // Activar el componente cmara.
+     go1->SetComponentState<CComponent_Camera*>(true); // Activar el componente cámara.
      @endcode
      *
      * @see CComponent
@@ -681,11 +871,11 @@ class CGameObject
     /** @brief @no_use **/
     template <class Type>
     output_t GetData();
-    /* Funciones para acceso directo a los componentes aqu: */
+    /* Funciones para acceso directo a los componentes aquí: */
 
     /* CComponent_Transform* transform() {return (CComponent_Transform*) components[components::transform]; }
      *
-     * Y as para los componentes principales.
+     * Y así para los componentes principales.
      * Si no existe un componente, se crea. A diferencia de GetComponent<...>(), si el componente no existe, devuelve NULL.
      */
 
@@ -724,7 +914,7 @@ class CGameObject
      go1->Camera()->field_of_view; // Acceder a un atributo del componente.
      @endcode
      *
-     * Si el componente no existe, ser creado, y luego ser retornado.
+     * Si el componente no existe, será creado, y luego será retornado.
      *
      * @see CComponent_Camera
      *
@@ -732,8 +922,8 @@ class CGameObject
      */
     inline CComponent_Camera* Camera()
     {
-      if(components.find(Components::camera) == components.end())
-        components.insert(std::pair<int, CComponent*>(Components::camera, new CComponent_Camera(this)));
+      if(!components[Components::camera])
+        SetComponent(Components::camera, new CComponent_Camera(this));
 
       return (CComponent_Camera*)components[Components::camera];
     }
@@ -750,7 +940,7 @@ class CGameObject
      go1->Camera()->field_of_view; // Acceder a un atributo del componente.
      @endcode
      *
-     * Si el componente no existe, ser creado, y luego ser retornado.
+     * Si el componente no existe, será creado, y luego será retornado.
      *
      * @see CComponent_Mesh_Render
      *
@@ -758,8 +948,8 @@ class CGameObject
      */
     inline CComponent_Mesh_Render* MeshRender()
     {
-      if(components.find(Components::mesh_render) == components.end())
-        components.insert(std::pair<int, CComponent*>(Components::mesh_render, new CComponent_Mesh_Render(this)));
+      if(!components[Components::mesh_render])
+        SetComponent(Components::mesh_render, new CComponent_Mesh_Render(this));
 
       return (CComponent_Mesh_Render*)components[Components::mesh_render];
     }
@@ -776,7 +966,7 @@ class CGameObject
      go1->ParticleEmitter()->color; // Acceder a un atributo del componente.
      @endcode
      *
-     * Si el componente no existe, ser creado, y luego ser retornado.
+     * Si el componente no existe, será creado, y luego será retornado.
      *
      * @see CComponent_Particle_Emitter
      *
@@ -784,8 +974,8 @@ class CGameObject
      */
     inline CComponent_Particle_Emitter* ParticleEmitter()
     {
-      if(components.find(Components::particle_emitter) == components.end())
-        components.insert(std::pair<int, CComponent*>(Components::particle_emitter, new CComponent_Particle_Emitter(this)));
+      if(!components[Components::particle_emitter])
+        SetComponent(Components::particle_emitter, new CComponent_Particle_Emitter(this));
 
       return (CComponent_Particle_Emitter*)components[Components::particle_emitter];
     }
@@ -802,7 +992,7 @@ class CGameObject
      go1->GUITexture()->width; // Acceder a un atributo del componente.
      @endcode
      *
-     * Si el componente no existe, ser creado, y luego ser retornado.
+     * Si el componente no existe, será creado, y luego será retornado.
      *
      * @see CComponent_GUI_Texture
      *
@@ -810,8 +1000,8 @@ class CGameObject
      */
     inline CComponent_GUI_Texture* GUITexture()
     {
-      if(components.find(Components::gui_texture) == components.end())
-        components.insert(std::pair<int, CComponent*>(Components::gui_texture, new CComponent_GUI_Texture(this)));
+      if(!components[Components::gui_texture])
+        SetComponent(Components::gui_texture, new CComponent_GUI_Texture(this));
 
       return (CComponent_GUI_Texture*)components[Components::gui_texture];
     }
@@ -828,7 +1018,7 @@ class CGameObject
      go1->AudioSource()->volume; // Acceder a un atributo del componente.
      @endcode
      *
-     * Si el componente no existe, ser creado, y luego ser retornado.
+     * Si el componente no existe, será creado, y luego será retornado.
      *
      * @see CComponent_Audio_Source
      *
@@ -836,8 +1026,8 @@ class CGameObject
      */
     inline CComponent_Audio_Source* AudioSource()
     {
-      if(components.find(Components::audio_source) == components.end())
-        components.insert(std::pair<int, CComponent*>(Components::audio_source, new CComponent_Audio_Source(this)));
+      if(!components[Components::audio_source])
+        SetComponent(Components::audio_source, new CComponent_Audio_Source(this));
 
       return (CComponent_Audio_Source*)components[Components::audio_source];
     }
@@ -846,22 +1036,18 @@ class CGameObject
 template <class Type>
 Type* CGameObject::GetComponent()
 {
-  if(components.find(Type::GetID()) != components.end())
-  {
-    return (Type*)components[Type::GetID()];
-  }
+  return (Type*)components[Type::GetID()];
   //gSystem_Debug.console_error_msg("From CGameObject \"%s\": Could not find component \"%s\"", name.c_str(), components::component_to_string((components::components)Type::GetID()));
-  return NULL;
 }
 
 template <class Type>
 bool CGameObject::AddComponent()
 {
   int id = Type::GetID();
-  if(components.find(id) != components.end())
+  if(components[id])
     return false;
 
-  components.insert(std::pair<int, CComponent*>(id, new Type(this)));
+  SetComponent(id, new Type(this));
   return true;
 }
 
@@ -872,11 +1058,10 @@ bool CGameObject::RemoveComponent()
   if(id == Components::transform)
 	  return false;
 	
-  std::map<int, CComponent*>::iterator it = components.find(id);
-  if(it != components.end())
+  if(components[id])
   {
-    delete it->second;
-    components.erase(it);
+    delete components[id];
+    ClearComponent(id);
 
     return true;
   }
@@ -887,7 +1072,7 @@ bool CGameObject::RemoveComponent()
 template <class Type>
 void CGameObject::SetComponentStateComponent(bool state)
 {
-  if(components.find(Type::GetID()) != components.end())
+  if(components[Type::GetID()])
     components[Type::GetID()]->SetState(state);
 }
 
@@ -895,7 +1080,7 @@ template <class Type>
 void CGameObject::SetData(input_t data)
 {
   int id = Type::GetID();
-  if(components.find(id) != components.end() && data)
+  if(components[id] && data)
     components[id]->Set(data);
 }
 
@@ -903,7 +1088,7 @@ template <class Type>
 output_t CGameObject::GetData()
 {
   int id = Type::GetID();
-  if(components.find(id) != components.end())
+  if(components[id])
     return components[id]->Get();
   else
     return NULL;
@@ -14,25 +14,32 @@
 #include "systems/_other.h"
 #include "systems/_mixer.h"
 #include "systems/_shader.h"
+#include "systems/_gl_state.h"
+#include "systems/_stream_buffer.h"
 #include "systems/_input.h"
+#include "systems/_jobs.h"
+#include "systems/_scheduler.h"
+#include "systems/_memory.h"
+#include "systems/_spatial.h"
+#include "systems/_static_batching.h"
 
 /**
  * @brief Iniciar sistemas.
  *
- * LLamado automticamente desde gEngine.
+ * LLamado automáticamente desde gEngine.
  * @return true si todos se inician correctamente, false en caso contrario.
  */
 bool Systems_Init();
 /**
  * @brief Cerrar sistemas.
  *
- * LLamado automticamente desde gEngine.
+ * LLamado automáticamente desde gEngine.
  */
 void Systems_Close();
 /**
  * @brief Reiniciar sistemas.
  *
- * LLamado automticamente desde gEngine.
+ * LLamado automáticamente desde gEngine.
  * @return true si todos se reinician correctamente, false en caso contrario.
  */
 bool Systems_Reset();
@@ -40,25 +47,25 @@ bool Systems_Reset();
 /**
  * @brief Gestionar eventos de sistemas.
  *
- * LLamado automticamente desde gEngine.
+ * LLamado automáticamente desde gEngine.
  */
 void Systems_OnEvent();
 /**
  * @brief Gestionar entrada para los sistemas.
  *
- * LLamado automticamente desde gEngine.
+ * LLamado automáticamente desde gEngine.
  */
 void Systems_OnKeyEvent();
 /**
  * @brief Gestionar comportamiento de sistemas.
  *
- * LLamado automticamente desde gEngine.
+ * LLamado automáticamente desde gEngine.
  */
 void Systems_OnLoop();
 /**
  * @brief Gestionar renderizado de sistemas.
  *
- * LLamado automticamente desde gEngine.
+ * LLamado automáticamente desde gEngine.
  */
 void Systems_OnRender();
 
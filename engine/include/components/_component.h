@@ -7,6 +7,7 @@
 #define __COMPONENT_H_
 
 #include "_globals.h"
+#include "components/_component_pool.h"
 
 /** @addtogroup Componentes */
 /*@{*/
@@ -14,24 +15,43 @@
 /**
  * @brief Componentes.
  *
- * Espacio de nombres para guardar enumeraciones, variables y mtodos referentes a los componentes.
+ * Espacio de nombres para guardar enumeraciones, variables y métodos referentes a los componentes.
  *
- * @warning Esto debera en otro sitio ms generico, no en el fichero de definicin del componente abstracto.
+ * @warning Esto debería en otro sitio más generico, no en el fichero de definición del componente abstracto.
  */
-namespace Components // ->Nota El namespace Components debera ir en un lugar ms genrico.
+namespace Components // ->Nota El namespace Components debería ir en un lugar más genérico.
 {
   /**
-   * @brief Enumeracin o identificadores de componentes.
+   * @brief Enumeración o identificadores de componentes.
    *
-   * Enum para identificar a todos los tipos de componentes. Cada clase heredada de CComponent debe tener un valor en esta enumeracin.
+   * Enum para identificar a todos los tipos de componentes. Cada clase heredada de CComponent debe tener un valor en esta enumeración.
    */
   enum components_t { base = 0, camera, mesh_render, particle_emitter, gui_texture, audio_source, transform, dummy, __component_not_defined};
 
+  /**
+   * @brief Firma de componentes.
+   *
+   * Máscara de bits en la que el bit "i" indica si un game object tiene el componente con identificador "i" (véase components_t).
+   * Comprobar si un objeto tiene varios componentes a la vez se reduce a una operación AND.
+   */
+  typedef flags_t signature_t;
+
+  /**
+   * @brief Bit de un componente.
+   *
+   * @param c Valor del enum.
+   * @return Máscara con el bit del componente activado, para combinar con el operador | (p.ej. "bit(transform) | bit(mesh_render)").
+   */
+  inline signature_t bit(components_t c)
+  {
+    return (signature_t)1 << c;
+  }
+
   /**
    * @brief Nombres de componentes.
    *
-   * Array de strings que contienen, por cada enum de components_t, una representacin con caracteres.
-   * La representacin como cadena de caracteres ser idntica al nombre del valor del enum, salvo para el caso especial *__component_not_defined*, que ser *"not_defined"*.
+   * Array de strings que contienen, por cada enum de components_t, una representación con caracteres.
+   * La representación como cadena de caracteres será idéntica al nombre del valor del enum, salvo para el caso especial *__component_not_defined*, que será *"not_defined"*.
    */
   extern const char* components_s[];
 
@@ -40,7 +60,7 @@ namespace Components // ->Nota El namespace Components deber
    *
    * Dado un enum de un componente, transforma dicho valor a un string.
    * @param c Valor del enum.
-   * @return Representacin textual del componente.
+   * @return Representación textual del componente.
    */
   const char* component_to_string(components_t c);
 
@@ -57,9 +77,9 @@ namespace Components // ->Nota El namespace Components deber
 class CGameObject;
 
 /**
- * @brief Puntero a funcin miembro de un game object.
+ * @brief Puntero a función miembro de un game object.
  *
- * El puntero se usar para funciones del tipo "void f(CGameObject* g)".
+ * El puntero se usará para funciones del tipo "void f(CGameObject* g)".
  *
  * @see CGameObject::start
  * @see CGameObject::behaviour
@@ -67,8 +87,8 @@ class CGameObject;
  * @see CGameObject::input_behaviour
  * @see CGameObject::render
  *
- * Se usar para guardar en el game object una serie de punteros a funciones externas para ser llamadas en determinados momentos,
- * usando como referencia al objeto el parmetro "self".
+ * Se usará para guardar en el game object una serie de punteros a funciones externas para ser llamadas en determinados momentos,
+ * usando como referencia al objeto el parámetro "self".
  *
  * @param self Referencia a un objeto dado.
  */
@@ -77,30 +97,30 @@ typedef void (*function_t)(CGameObject* self);
 /**
  * @brief Clase abstracta de un componente.
  *
- * Se usar para representar y hacer de base a la hora de definir un componente.
+ * Se usará para representar y hacer de base a la hora de definir un componente.
  *
  * @see CGameObject.
  *
- * Un componente estar asociado a un nico objeto de juego, ignorando completamente componentes compartidos (imposible implementarlos por la asociacin bidireccional entre objeto y componente).
+ * Un componente estará asociado a un único objeto de juego, ignorando completamente componentes compartidos (imposible implementarlos por la asociación bidireccional entre objeto y componente).
  *
- * Con respecto a la asociacin de los componentes con un objeto de juego, usamos polimorfimos para ello.
- * De cara a poder tener una gran variedad de componentes, sera lgico usar un vector de componentes (o CComponentes) con el fin de almacenar nuestros componentes nicos en un Game Object.
+ * Con respecto a la asociación de los componentes con un objeto de juego, usamos polimorfimos para ello.
+ * De cara a poder tener una gran variedad de componentes, sería lógico usar un vector de componentes (o CComponentes) con el fin de almacenar nuestros componentes únicos en un Game Object.
  *
  * @image html components/componentes.png
  *
  * Como se puede apreciar, cada componente tiene 3 partes:
  *
  * - Contenido o atributos del componente.
- * - Mtodos del componente.
- * - Identificador nico para ese componente.
+ * - Métodos del componente.
+ * - Identificador único para ese componente.
  *
- * Para facilitar el acceso, puesto que un objeto de nuestro juego podra llegar a tener una cantidad elevada de componentes (dependiendo del nmero de componentes implementados),
- * hemos decidido usar un std::map de la librera estndar de plantillas de C++. Adems, como se ha mencionado en el post anterior, un objeto slo puede tener un componente de cada tipo.
- * En este caso, para nuestro mapa, las claves seran unos identificadores numricos, mientras que el valor contenido sern punteros a dichos componentes,
+ * Para facilitar el acceso, puesto que un objeto de nuestro juego podría llegar a tener una cantidad elevada de componentes (dependiendo del número de componentes implementados),
+ * hemos decidido usar un std::map de la librería estándar de plantillas de C++. Además, como se ha mencionado en el post anterior, un objeto sólo puede tener un componente de cada tipo.
+ * En este caso, para nuestro mapa, las claves serían unos identificadores numéricos, mientras que el valor contenido serán punteros a dichos componentes,
  * que a su vez guardan un objeto al puntero que los contiene, intentando garantizar que los componentes no puedan ser compartidos
- * (tal vez interese implementar algo por el estilo ms adelante).
- * Por tanto, tendremos un std::map con una lista de punteros del tipo CComponent que, por medio de polimorfismo y herencia,
- * crearemos una gama de clases hijas con distintas propiedades y ejecuciones de mtodos distintos. Se pueden realizar una serie de operaciones sobre los componentes desde
+ * (tal vez interese implementar algo por el estilo más adelante).
+ * Por tanto, tendremos una tabla de punteros del tipo CComponent, indexada por el identificador del componente (Components::components_t), que, por medio de polimorfismo y herencia,
+ * crearemos una gama de clases hijas con distintas propiedades y ejecuciones de métodos distintos. Se pueden realizar una serie de operaciones sobre los componentes desde
  * los Game Objects, entre ellas, las siguientes:
  *
  @code
@@ -125,25 +145,25 @@ typedef void (*function_t)(CGameObject* self);
 
     inline CComponent_Camera* camera()
     {
-      if(components.find(components::camera) == components.end())
-        components.insert(pair<int, CComponent*>(components::camera, new CComponent_Camera(this)));
+      if(!components[components::camera])
+        SetComponent(components::camera, new CComponent_Camera(this));
 
       return (CComponent_Camera*)components[components::camera];
     }
 
   @endcode
   *
-  * - Obtener componente: Devuelve un puntero al componente del tipo seleccionado. Si no existe, devolver NULL.
-  * - Aadir componente:  Intenta aadir un componente. Si no existe, se crear y devolver true. Si existe, no se har nada y devolver false.
-  * - Eliminar componente:  Intenta eliminar un componente. Si existe, lo elimina y devuelve true. Si no existe, no se har nada y devolver false.
-  * - Cambiar estado:  Cambia el estado del componente (activado o desactivado) en funcin del argumento state.
-  * - Accesos directos: Permiten acceder de forma rpida y cmoda al componente. Si el componente no existe, lo crea.
+  * - Obtener componente: Devuelve un puntero al componente del tipo seleccionado. Si no existe, devolverá NULL.
+  * - Añadir componente:  Intenta añadir un componente. Si no existe, se creará y devolverá true. Si existe, no se hará nada y devolverá false.
+  * - Eliminar componente:  Intenta eliminar un componente. Si existe, lo elimina y devuelve true. Si no existe, no se hará nada y devolverá false.
+  * - Cambiar estado:  Cambia el estado del componente (activado o desactivado) en función del argumento state.
+  * - Accesos directos: Permiten acceder de forma rápida y cómoda al componente. Si el componente no existe, lo crea.
   *
-  * Adems, se crear un acceso directo en la clase GameObject (por ejemplo, CComponente_Transform* Transform() )
-  * para cada componente, declarado, que actuar de la siguiente forma: si el componente existe, devuelve un puntero.
-  * Si no, crea el componente y lo devuelve. As podemos garantizar que no se produzcan accesos indebidos a memoria por no comprobar la existencia de los componentes.
+  * Además, se creará un acceso directo en la clase GameObject (por ejemplo, CComponente_Transform* Transform() )
+  * para cada componente, declarado, que actuará de la siguiente forma: si el componente existe, devuelve un puntero.
+  * Si no, crea el componente y lo devuelve. Así podemos garantizar que no se produzcan accesos indebidos a memoria por no comprobar la existencia de los componentes.
   *
-  * @warning Un componente debe crearse usando los mtodos expuestos en la clase CGameObject. En principio, no deberan usarse de manera explcita a la hora de operar (no hacemos un *new* de un componente).
+  * @warning Un componente debe crearse usando los métodos expuestos en la clase CGameObject. En principio, no deberían usarse de manera explícita a la hora de operar (no hacemos un *new* de un componente).
  */
 class CComponent
 {
@@ -179,7 +199,7 @@ class CComponent
     /** Constructor con objeto asociado.
      *
      * Asocia al objeto pasado como argumento el componente creado.
-     * @param container Objeto que guardar el componente.
+     * @param container Objeto que guardará el componente.
      */
     CComponent(CGameObject* container);
 
@@ -199,12 +219,12 @@ class CComponent
     /**
      * @brief Getter del estado del componente.
      *
-     * Un componente puede estar marcado como **activado** como **desactivado**. En el primer caso, el componente se tratar con normalidad, mientras
-     * que en el segundo caso, en la mayora de componentes, se har como que el componente no existe.
+     * Un componente puede estar marcado como **activado** como **desactivado**. En el primer caso, el componente se tratará con normalidad, mientras
+     * que en el segundo caso, en la mayoría de componentes, se hará como que el componente no existe.
      *
-     * @warning En algunos componentes es necesario que se actualicen algunos valores, por lo que el componente seguir ejecutando ciertas funciones aunque est desactivado.
+     * @warning En algunos componentes es necesario que se actualicen algunos valores, por lo que el componente seguirá ejecutando ciertas funciones aunque esté desactivado.
      *
-     * @return Retorna true si est activado, false en caso contrario.
+     * @return Retorna true si está activado, false en caso contrario.
      */
     inline bool GetState()
     {
@@ -246,9 +266,9 @@ class CComponent
     /**
      * @brief Obtener el gameObject que encapsula este componente.
      *
-     * Existe una relacin bidireccional entre los gameObjects y los componentes que tienen. Por tanto, puede ser de utilidad obtener
-     * el objeto que tiene un componente actualmente, ya sea para acceder a algunos atributos del objeto en cuestin, o para acceder a otro componente.
-     * @return Devuelve un puntero a un gameObject que tenga el componente. No debera ser NULL en ningn momento.
+     * Existe una relación bidireccional entre los gameObjects y los componentes que tienen. Por tanto, puede ser de utilidad obtener
+     * el objeto que tiene un componente actualmente, ya sea para acceder a algunos atributos del objeto en cuestión, o para acceder a otro componente.
+     * @return Devuelve un puntero a un gameObject que tenga el componente. No debería ser NULL en ningún momento.
      */
     inline CGameObject* GetGameObject()
     {
@@ -259,43 +279,43 @@ class CComponent
     /**
      * @brief Renderizar el componente.
      *
-     * Funcin de renderizado. Renderiza el componente.
+     * Función de renderizado. Renderiza el componente.
      *
      * @see CGameObject::OnRender().
-     * @param projMatrix       Matriz de proyeccin. Interna al sistema.
+     * @param projMatrix       Matriz de proyección. Interna al sistema.
      * @param modelViewMatrix  Matriz de modelview. Interna al sistema.
      *
-     * @warning Esta funcin no debe ser llamada de manera explcita.
+     * @warning Esta función no debe ser llamada de manera explícita.
      */
     inline virtual void OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix){};
     /**
-     * @brief Gestin del comportamiento.
+     * @brief Gestión del comportamiento.
      *
-     * Funcin de comportamiento. Actualiza el componente.
+     * Función de comportamiento. Actualiza el componente.
      *
      * @see CGameObject::OnLoop().
      *
-     * @warning Esta funcin no debe ser llamada de manera explcita.
+     * @warning Esta función no debe ser llamada de manera explícita.
      */
     inline virtual void OnLoop(){};
     /**
-     * @brief Gestin de eventos.
+     * @brief Gestión de eventos.
      *
-     * Funcin de gestin de eventos. Gestiona eventos de entrada importantes para el componente.
+     * Función de gestión de eventos. Gestiona eventos de entrada importantes para el componente.
      *
      * @see CGameObject::OnEvent().
      *
-     * @warning Esta funcin no debe ser llamada de manera explcita.
+     * @warning Esta función no debe ser llamada de manera explícita.
      */
     inline virtual void OnEvent(){};
     /**
-     * @brief Gestin de entrada.
+     * @brief Gestión de entrada.
      *
-     * Funcin de gestin de entrada. Gestiona entradas importantes para el componente.
+     * Función de gestión de entrada. Gestiona entradas importantes para el componente.
      *
      * @see CGameObject::OnInput().
      *
-     * @warning Esta funcin no debe ser llamada de manera explcita.
+     * @warning Esta función no debe ser llamada de manera explícita.
      */
     inline virtual void OnInput(){};
 };
@@ -15,7 +15,7 @@
  * @brief Modos de vista o *viewmodes*.
  *
  * Espacio de nombres usado para guardar las constantes y valores de los distintos
- * tipos de modos de vista (perspectiva, ortografica, ortografica a tamao de pantalla, etc).
+ * tipos de modos de vista (perspectiva, ortografica, ortografica a tamaño de pantalla, etc).
  */
 namespace Viewmode
 {
@@ -24,11 +24,11 @@ namespace Viewmode
    *
    * Cada modo de vista tiene un valor asociado. Principalmente, 3 modos de vista:
    *
-   * - **Perspectiva**: Se dibujar con una proyeccin en perspectiva.
-   * - **Ortogrfica**: Se dibujar con una proyeccin ortogrfica. Los rangos sern [0, 1] para el eje vertical (de abajo a arriba), y [0, 1] para el eje horizontal (de derecha a izquierda).
-   * - **ortogrfica a tamao de pantalla**: Se dibujar con una proyeccin ortogrfica. Los rangos sern [0, ALTO_VENTANA] para el eje vertical (de abajo a arriba), y [0, ANCHO_VENTANA] para el eje horizontal (de derecha a izquierda).
+   * - **Perspectiva**: Se dibujará con una proyección en perspectiva.
+   * - **Ortográfica**: Se dibujará con una proyección ortográfica. Los rangos serán [0, 1] para el eje vertical (de abajo a arriba), y [0, 1] para el eje horizontal (de derecha a izquierda).
+   * - **ortográfica a tamaño de pantalla**: Se dibujará con una proyección ortográfica. Los rangos serán [0, ALTO_VENTANA] para el eje vertical (de abajo a arriba), y [0, ANCHO_VENTANA] para el eje horizontal (de derecha a izquierda).
    *
-   * @see gSystem_Render (cmara GUI).
+   * @see gSystem_Render (cámara GUI).
    * @see http://es.wikipedia.org/wiki/Proyecci%C3%B3n_gr%C3%A1fica
    * @see http://es.wikipedia.org/wiki/Proyecci%C3%B3n_ortogonal
    * @see http://en.wikipedia.org/wiki/Perspective_(graphical)
@@ -38,8 +38,8 @@ namespace Viewmode
   /**
    * @brief Nombres de viewmodes.
    *
-   * Array de strings que contienen, por cada enum de viewmodes_t, una representacin con caracteres.
-   * La representacin como cadena de caracteres ser idntica al nombre del valor del enum, salvo para el caso especial *__viewmode_not_defined*, que ser *"not_defined"*.
+   * Array de strings que contienen, por cada enum de viewmodes_t, una representación con caracteres.
+   * La representación como cadena de caracteres será idéntica al nombre del valor del enum, salvo para el caso especial *__viewmode_not_defined*, que será *"not_defined"*.
    */
   extern const char* viewmode_s[];
 
@@ -47,7 +47,7 @@ namespace Viewmode
   *
   * Dado un enum de un modo de vista, transforma dicho valor a un string.
   * @param c Valor del enum.
-  * @return Representacin textual del componente.
+  * @return Representación textual del componente.
   */
   const char* viewmode_to_string(viewmodes_t c);
 
@@ -62,7 +62,7 @@ namespace Viewmode
 }
 
 /**
- * @brief Componente cmara
+ * @brief Componente cámara
  *
  * Dado un escenario tridimensional en nuestro programa, es necesario crear una manera de observar lo que ocurre dentro de dicho escenario.
  * El objetivo principal de este componente es actuar como una **ventana** a nuestro mundo. Esto es, observar el espacio y dibujarlo
@@ -71,19 +71,19 @@ namespace Viewmode
  * @image html components/camera/camera.jpg
  *
  * A este proceso se le conoce como renderizado. Cada objeto es dibujado a su manera, bajo sus componentes y sus funciones de dibujado. Por ello,
- * la cmara se encargar de dibujar el mundo tal y como es percibido por ella. Por tanto, asignada una cmara a un objeto, bajo las propiedades del componente
- * CComponent_Transform, se dibujar, segn la posicin y la orientacin de la cmara, el mundo tal y como es observado.
+ * la cámara se encargará de dibujar el mundo tal y como es percibido por ella. Por tanto, asignada una cámara a un objeto, bajo las propiedades del componente
+ * CComponent_Transform, se dibujará, según la posición y la orientación de la cámara, el mundo tal y como es observado.
  *
- * No obstante, existen varios tipos de cmara, enumerados en Viewmode::viewmodes_t. Dependiendo del tipo de vista, el escenario se dibujar de una forma o de otra.
+ * No obstante, existen varios tipos de cámara, enumerados en Viewmode::viewmodes_t. Dependiendo del tipo de vista, el escenario se dibujará de una forma o de otra.
  *
- * Adems, cabe destacar que se puede escoger una poricin de la pantalla sobre la que dibujar la cmara. Esta ser nuestra *ventana* o **viewport**, que no ser
- * ms que un rectngulo dentro de nuestra ventana.
+ * Además, cabe destacar que se puede escoger una porición de la pantalla sobre la que dibujará la cámara. Esta será nuestra *ventana* o **viewport**, que no será
+ * más que un rectángulo dentro de nuestra ventana.
  *
- * Adems, toda cmara debe estar registrada en el sistema CSystem_Render para poder escribir datos en pantalla.
+ * Además, toda cámara debe estar registrada en el sistema CSystem_Render para poder escribir datos en pantalla.
  *
- * @warning No se eliminar el objeto de la lista de cmaras. Deber hacerse de manera manual desde el sistema CSystem_Render.
+ * @warning No se eliminará el objeto de la lista de cámaras. Deberá hacerse de manera manual desde el sistema CSystem_Render.
  *
- * Por ejemplo, creamos y registramos una cmara de la siguiente manera:
+ * Por ejemplo, creamos y registramos una cámara de la siguiente manera:
  *
  @code
  CGameObject* camara_main = gGameObjects.AddGameObject("camara_main");
@@ -92,15 +92,15 @@ namespace Viewmode
  camara_main->Transform()->position.z = -10.f;
  camara_main->Camera()->far_clip = 500.f;
  camara_main->Preserve();                                   // Preservar entre escenas.
- camara_main->SetInputFunction(&Camara_main_movimiento);    // Cambiar el callback por una funcin dada.
+ camara_main->SetInputFunction(&Camara_main_movimiento);    // Cambiar el callback por una función dada.
  gRender.AddCamera(camara_main);                            // Registrar en el sistema render.
 
  camara_main->Camera()->skybox_texture = "skybox1";
  @endcode
  *
- * Finalmente, cabe destacar que la cmara puede definir un color o un cielo (*skybox*) de fondo, que servir para dibujar contenido en el fondo de nuestro escenario.
+ * Finalmente, cabe destacar que la cámara puede definir un color o un cielo (*skybox*) de fondo, que servirá para dibujar contenido en el fondo de nuestro escenario.
  *
- * @warning Si se realizan cambios despus de aadir la cmara al sistema CSystem_Render, se debern aplicar los cambios con ApplyChanges(). Si no, no se mostrarn los cambios.
+ * @warning Si se realizan cambios después de añadir la cámara al sistema CSystem_Render, se deberán aplicar los cambios con ApplyChanges(). Si no, no se mostrarán los cambios.
  *
  * @see CSystem_Render
  */
@@ -113,38 +113,41 @@ class CComponent_Camera: public CComponent
     //GLdouble projMatrix[16];
     glm::mat4 projMatrix;
     glm::mat4 modelViewMatrix;
+    glm::mat4 normalMatrix;     // Inversa traspuesta de modelViewMatrix, calculada una vez por iteración en SetUp()
 
-    CGameObject* pivot;  // Si no, se usar un pivote en la posicin local (0, 0, -1)
+    CGameObject* pivot;  // Si no, se usará un pivote en la posición local (0, 0, -1)
 
   public:
-    // ->PORHACER Qu se supone que hace CComponent_Camera::disable_gui?
+    // ->PORHACER ¿Qué se supone que hace CComponent_Camera::disable_gui?
     bool disable_gui; /**< @no_use */
 
     Viewmode::viewmodes_t viewmode; /**< Modo de vista. @see Viewmode::viewmodes_t*/
-    viewportf_t viewport; /**< Ventana a dibujar en pantalla de la cmara. Expresada en tamao de pantalla con valores desde 0 hasta 1, ancho y alto. @see viewportf_t*/
+    viewportf_t viewport; /**< Ventana a dibujar en pantalla de la cámara. Expresada en tamaño de pantalla con valores desde 0 hasta 1, ancho y alto. @see viewportf_t*/
 
-    GLfloat field_of_view; /**< Campo de visin, expresado en grados. @see http://en.wikipedia.org/wiki/Field_of_view **/
-    GLfloat near_clip;     /**< Distancia mnima de separacin de dibujado frente a la cmara. No se dibujar nada que no sobrepase este valor con respecto a la cmara. @see http://en.wikipedia.org/wiki/Viewing_frustum*/
-    GLfloat far_clip;      /**< Distancia mxima de dibujado frente a la cmara. No se dibujar nada que sobrepase este valor con respecto a la cmara. @see http://en.wikipedia.org/wiki/Viewing_frustum*/
+    GLfloat field_of_view; /**< Campo de visión, expresado en grados. @see http://en.wikipedia.org/wiki/Field_of_view **/
+    GLfloat near_clip;     /**< Distancia mínima de separación de dibujado frente a la cámara. No se dibujará nada que no sobrepase este valor con respecto a la cámara. @see http://en.wikipedia.org/wiki/Viewing_frustum*/
+    GLfloat far_clip;      /**< Distancia máxima de dibujado frente a la cámara. No se dibujará nada que sobrepase este valor con respecto a la cámara. @see http://en.wikipedia.org/wiki/Viewing_frustum*/
 
-    colorf_t background_color; /**< Color con el que se recubrir la ventana antes de dibujar. Si clear vale false, no se utilizar este valor, y no se "limpiar" el contenido de la ventana con nuevos valores. */
-    bool clear;                /**< Saber si debe limpiarse la ventana antes de dibujar con el color de fondo. Si vale true, se limpiar con background_color. Si no, no se har nada, pudiendo dibujar encima. til para un fondo transparente, pero puede darse el caso de dejar basura.*/
+    colorf_t background_color; /**< Color con el que se recubrirá la ventana antes de dibujar. Si clear vale false, no se utilizará este valor, y no se "limpiará" el contenido de la ventana con nuevos valores. */
+    bool clear;                /**< Saber si debe limpiarse la ventana antes de dibujar con el color de fondo. Si vale true, se limpiará con background_color. Si no, no se hará nada, pudiendo dibujar encima. Útil para un fondo transparente, pero puede darse el caso de dejar basura.*/
 
-    std::string skybox_texture; /**< Nombre de la imagen a mostrar como *skybox*. Si es "", no se usar ningn skybox. No es el nombre del fichero, sino del recurso. @see CSystem_Resources @see CResource_Texture @see http://en.wikipedia.org/wiki/Skybox_(video_games) */
+    bool occlusion_culling;    /**< No dibujar los modelos tapados por otros, según consultas de oclusión de la iteración anterior. Necesita la cola de dibujo (opción "__RENDER_QUEUE") y GL_ARB_occlusion_query2. Útil en escenas con muchos objetos unos detrás de otros; en escenas abiertas sólo añade trabajo. @see COcclusion_Culling */
+
+    std::string skybox_texture; /**< Nombre de la imagen a mostrar como *skybox*. Si es "", no se usará ningún skybox. No es el nombre del fichero, sino del recurso. @see CSystem_Resources @see CResource_Texture @see http://en.wikipedia.org/wiki/Skybox_(video_games) */
 
     // Fallo: no apunta correctamente a hijos de padres
-    // solucin? calcular la nueva posicin o quitar esta opcin
-    std::string target;         /**< Nombre del objeto CGameObject al que apuntar la cmara. Debe estar registrado en el sistema CSystem_GameObject_Manager. Si es "" o no se encuentra, se usar la orientacin de la cmara para calcular el punto al que se debe mirar. Funciona incluso si el objetivo es hijo de algun objeto, ya que se coge su posicin global. */
+    // ¿solución? calcular la nueva posición o quitar esta opción
+    std::string target;         /**< Nombre del objeto CGameObject al que apuntará la cámara. Debe estar registrado en el sistema CSystem_GameObject_Manager. Si es "" o no se encuentra, se usará la orientación de la cámara para calcular el punto al que se debe mirar. Funciona incluso si el objetivo es hijo de algun objeto, ya que se coge su posición global. */
 
-    function_t before_render;   /**< Callback antes de renderizar todos los objetos con la cmara actual. Si es null, no se har nada. Puede ser til para dibujar la misma escena de distintas maneras con varias cmaras. */
-    function_t after_render;    /**< Callback posterior al renderizado de todos los objetos con la cmara actual. Si es null, no se har nada. Puede ser til para dibujar la misma escena de distintas maneras con varias cmaras, pudiendo variar los datos, o deshacer modificaciones hechas con el callback before_render.*/
+    function_t before_render;   /**< Callback antes de renderizar todos los objetos con la cámara actual. Si es null, no se hará nada. Puede ser útil para dibujar la misma escena de distintas maneras con varias cámaras. */
+    function_t after_render;    /**< Callback posterior al renderizado de todos los objetos con la cámara actual. Si es null, no se hará nada. Puede ser útil para dibujar la misma escena de distintas maneras con varias cámaras, pudiendo variar los datos, o deshacer modificaciones hechas con el callback before_render.*/
 
-    // Aadir fog, niebla, hdr, cosas por el estilo aqu
+    // Añadir fog, niebla, hdr, cosas por el estilo aquí
 
     /**
      * @brief LLama al callback before_render, siempre y cuando no sea NULL.
      *
-     * Ser llamado de manera automtica desde CSystem_Render.OnRender(), antes de dibujar todos los objetos de la escena desde la cmara.
+     * Será llamado de manera automática desde CSystem_Render.OnRender(), antes de dibujar todos los objetos de la escena desde la cámara.
      */
     inline void BeforeRender()
     {
@@ -154,7 +157,7 @@ class CComponent_Camera: public CComponent
     /**
      * @brief LLama al callback after_render, siempre y cuando no sea NULL.
      *
-     * Ser llamado de manera automtica desde CSystem_Render.OnRender(), despus de dibujar todos los objetos de la escena desde la cmara.
+     * Será llamado de manera automática desde CSystem_Render.OnRender(), después de dibujar todos los objetos de la escena desde la cámara.
      */
     inline void AfterRender()
     {
@@ -164,18 +167,22 @@ class CComponent_Camera: public CComponent
   private:
     static int GetID() { return Components::camera; }
 
+  __COMPONENT_POOL_DECLARE(CComponent_Camera)
+
+  private:
+
     void parseDebug(std::string command);
     void printDebug();
 
   public:
     /**
-     * @brief Constructor vaco.
+     * @brief Constructor vacío.
      */
     CComponent_Camera(){};
 
     /** @brief Constructor con objeto asociado.
      *
-     * Asocia al objeto pasado como argumento el componente creado. Adems, inicializa los atributos de la clase a unos ciertos valores:
+     * Asocia al objeto pasado como argumento el componente creado. Además, inicializa los atributos de la clase a unos ciertos valores:
      *
      @code
      viewmode = perspective;
@@ -184,8 +191,9 @@ class CComponent_Camera: public CComponent
      far_clip = 200.f;
      clear = true;
      target = "";
+     occlusion_culling = false;
 
-     disable_gui = false; // ?
+     disable_gui = false; // ¿?
 
      viewport.x = viewport.y = 0;
      viewport.width = viewport.height = 1.f;
@@ -198,14 +206,14 @@ class CComponent_Camera: public CComponent
      skybox_texture = "";
      @endcode
      *
-     * @param gameObject Objeto que guardar el componente.
+     * @param gameObject Objeto que guardará el componente.
      */
     CComponent_Camera(CGameObject* gameObject);
 
     /**
      * @brief Destructor.
      *
-     * @warning No se eliminar el objeto de la lista de cmaras. Deber hacerse de manera manual desde el sistema CSystem_Render.
+     * @warning No se eliminará el objeto de la lista de cámaras. Deberá hacerse de manera manual desde el sistema CSystem_Render.
      *
      * @see CSystem_Render
      */
@@ -218,7 +226,7 @@ class CComponent_Camera: public CComponent
     inline virtual output_t Get();
 
     /**
-     * @brief Cambiar el objetivo de la cmara.
+     * @brief Cambiar el objetivo de la cámara.
      *
      * Modifica el valor almacenado en target con el nuevo nombre del objeto a seguir. En caso de no querer seguir un objetivo, el target debe ser "".
      * @param t Nombre del nuevo objeto a seguir. Debe eestar registrado en el sistema CSystem_GameObject_Manager.
@@ -229,7 +237,7 @@ class CComponent_Camera: public CComponent
 	  }
 
     /**
-     * @brief Cambiar el objetivo de la cmara.
+     * @brief Cambiar el objetivo de la cámara.
      *
      * Modifica el valor almacenado en target con el nuevo nombre del objeto a seguir, a partir de un puntero a un CGameObject.
      * @param obj Puntero del objeto a seguir. Debe estar registrado en el sistema CSystem_GameObject_Manager.
@@ -237,9 +245,9 @@ class CComponent_Camera: public CComponent
     void SetTarget(CGameObject* obj);
 
     /**
-     * @brief Quita el objetivo de la cmara.
+     * @brief Quita el objetivo de la cámara.
      *
-     * Si no se quiere usar un objetivo que la cmara deba seguir, se puede usar este mtodo para evitarlo. Es idntico a hacer que el target valga "".
+     * Si no se quiere usar un objetivo que la cámara deba seguir, se puede usar este método para evitarlo. Es idéntico a hacer que el target valga "".
      */
 	  void UnSetTarget()
 	  {
@@ -249,10 +257,21 @@ class CComponent_Camera: public CComponent
 	  /**
 	   * @brief Aplicar cambios.
 	   *
-	   * Si se han realizado cambios importantes en la cmara, se deben aplicar los cambios con esta funcin.
+	   * Si se han realizado cambios importantes en la cámara, se deben aplicar los cambios con esta función.
 	   */
     void ApplyChanges();
 
+    /**
+     * @brief Matriz normal de la vista.
+     *
+     * Inversa traspuesta de la matriz de vista de la cámara, calculada una vez por iteración. Multiplicada por CComponent_Transform::NormalMatrix()
+     * da la matriz normal de un objeto visto desde esta cámara, sin invertir una matriz por cada objeto dibujado.
+     */
+    inline const glm::mat4& NormalMatrix()
+    {
+      return normalMatrix;
+    }
+
   private:
     void SetViewport();
     void SetUp();
@@ -17,7 +17,7 @@
 /**
  * @brief Componente de pruebas.
  *
- * Componente de pruebas. Usado para testear cosas rpidas sin necesidad de definir nuevos componentes.
+ * Componente de pruebas. Usado para testear cosas rápidas sin necesidad de definir nuevos componentes.
  */
 class CComponent_Dummy: public CComponent
 {
@@ -27,6 +27,10 @@ class CComponent_Dummy: public CComponent
   private:
     static int GetID() { return Components::dummy; }
 
+  __COMPONENT_POOL_DECLARE(CComponent_Dummy)
+
+  private:
+
     vector3f direction;
     vector3f current_random;
     vector3f another_random;
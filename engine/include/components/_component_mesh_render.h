@@ -8,57 +8,68 @@
 
 #include "_globals.h"
 #include "components/_component.h"
+#include "systems/_culling.h"
+
+class CResource_Mesh;
+class CShader;
 
 /** @addtogroup Componentes */
 /*@{*/
 
+/**
+ * @brief Cámaras (posiciones de la lista de CSystem_Render) para las que cada modelo recuerda su último nivel de detalle.
+ *
+ * Con las demás, el nivel se elige cada vez sin tener en cuenta el anterior.
+ */
+#define __MESH_RENDER_LOD_CAMERAS 8
+
 /**
  * @brief Componente textura GUI
  *
- * Un componente muy til y necesario para la representacin grfica son los modelos o
- * objetos grficos.
+ * Un componente muy útil y necesario para la representación gráfica son los modelos o
+ * objetos gráficos.
  *
  * @image html crate.png
  *
  * Un modelo es un elemento externo (un objeto 3d de Blender, Maya, 3DMax...)
- * que ha sido cargado en el motor grfico como un recurso.
+ * que ha sido cargado en el motor gráfico como un recurso.
  *
- * Por ejemplo, supngase que se ha creado un objeto desde un programa externo, en un
- * formato soportado por la librera de *Assimp* (.3ds, .obj, etc.). Sencillamente,
- * se deber cargar el recurso con el sistema CSystem_Resources, y utilizando el nombre del
- * recurso de modelo como el objetivo a dibujar (CComponent_Mesh_Render::mesh_name). Se extraer
- * del componente de transformacin la posicin, orientacin y escala para dibujar el modelo.
+ * Por ejemplo, supóngase que se ha creado un objeto desde un programa externo, en un
+ * formato soportado por la librería de *Assimp* (.3ds, .obj, etc.). Sencillamente,
+ * se deberá cargar el recurso con el sistema CSystem_Resources, y utilizando el nombre del
+ * recurso de modelo como el objetivo a dibujar (CComponent_Mesh_Render::mesh_name). Se extraerá
+ * del componente de transformación la posición, orientación y escala para dibujar el modelo.
  *
- * Adems, se debe aadir un nombre de una textura y un shader (se usar uno por defecto si no se especifica)
+ * Además, se debe añadir un nombre de una textura y un shader (se usará uno por defecto si no se especifica)
  * para dibujar el modelo.
  *
- * Por tanto, si se quisiera dibujar una caja, habra que:
+ * Por tanto, si se quisiera dibujar una caja, habría que:
  *
  * 1. Obtener un modelo (crearlo o descargarlo) desde un programa externo.
- * 2. Cargar el modelo en el motor grfico (mediante ficheros .rc de recursos, vase CSystem_Resources).
+ * 2. Cargar el modelo en el motor gráfico (mediante ficheros .rc de recursos, véase CSystem_Resources).
  * 3. Asociar el componente *Mesh Render* a un objeto, junto con el nombre del modelo, su textura, y su shader.
- * 4. Dejar que el sistema dibuje el objeto segn crea.
+ * 4. Dejar que el sistema dibuje el objeto según crea.
  *
  * Por ejemplo, para usar un modelo, usamos:
  *
  * **Fichero *recursos.rc**:*
  @code
- # Esto lnea es un comentario.
+ # Esto línea es un comentario.
  # Formato de resource:
  # tipo: nombre_recurso ruta_al_fichero: [argumentos]
 
  mesh: mdl_hada1 data/resources/models/faerie.md2:
- # Un "mesh" no es ms que un modelo.
+ # Un "mesh" no es más que un modelo.
  @endcode
  *
- * Cdigo fuente del programa:
+ * Código fuente del programa:
  @code
  CGameObject* hada1 = gGameObjects.Add("hada1"); // Crear objeto
 
- // Cambiar atributos de transformacin.
- hada1->Transform()->SetScale(0.1f, 0.1f, 0.1f);            // Reducir tamao
+ // Cambiar atributos de transformación.
+ hada1->Transform()->SetScale(0.1f, 0.1f, 0.1f);            // Reducir tamaño
  hada1->Transform()->Translate(0.f, 0.f, 10.f);             // Trasladar
- hada1->Transform()->Rotate(0.f, 90.f, 0.f);                // Rotar sobre el eje Y (guiada o *yaw*)
+ hada1->Transform()->Rotate(0.f, 90.f, 0.f);                // Rotar sobre el eje Y (guiñada o *yaw*)
 
  hada1->MeshRender()->mesh_name = "mdl_hada1";              // Especificar el modelo
  hada1->MeshRender()->material_name = "texture_mdl_hada1";  // Especificar la textura
@@ -78,35 +89,51 @@ class CComponent_Mesh_Render: public CComponent
 {
   friend class CSystem_Render;
   friend class CGameObject;
+  friend class CRender_Queue;
+  friend class CSystem_Static_Batching;
 
   public:
-    std::string mesh_name;      /**< Nombre del recurso-modelo a usar. @see CSystem_Resources @see CResource_Model */
-    std::string material_name;  /**< Nombre del recurso-textura a usar. Se usar el mapa UV del modelo para mapear la textura. @see CSystem_Resources @see CResource_Texture */
+    std::string mesh_name;      /**< Nombre del recurso-modelo a usar. Si se cambia en un objeto que no se mueve, hay que llamar a CComponent_Transform::BoundsChanged() para actualizar CSystem_Spatial. @see CSystem_Resources @see CResource_Model */
+    std::string material_name;  /**< Nombre del recurso-textura a usar. Se usará el mapa UV del modelo para mapear la textura. @see CSystem_Resources @see CResource_Texture */
     std::string shader_name;    /**< Nombre del shader o *programa* a usar. @see CSystem_Shader_Manager */
 
     //vector<string> materials;
     // Guardar colores en un vector, o algo por el estilo...
-    colorf_t color;             /**< Color a aplicar sobre el modelo. Afectado incluso por la transparencia. Se trata de una aplicacin aditiva (simplemente colocar el color encima).*/
-    GLfloat color_apply_force;  /**< Fuerza con la que se aplica el color. Si vale 1, el modelo ser inundada por el color. Si vale 0, se aadir el color al modelo (adicin).*/
+    colorf_t color;             /**< Color a aplicar sobre el modelo. Afectado incluso por la transparencia. Se trata de una aplicación aditiva (simplemente colocar el color encima).*/
+    GLfloat color_apply_force;  /**< Fuerza con la que se aplica el color. Si vale 1, el modelo será inundada por el color. Si vale 0, se añadirá el color al modelo (adición).*/
 
-    // Puede ser til para
-    function_t before_render;   /**< Callback a ejecutar antes de renderizar el modelo. Se usar por si se quieren hacer modificaciones a bajo nivel (OpenGL). Si es NULL, no se ejecutar nada. */
-    function_t after_render;    /**< Callback a ejecutar despus de renderizar el modelo. Se usar por si se quieren hacer modificaciones a bajo nivel (OpenGL). Si es NULL, no se ejecutar nada. */
+    // Puede ser útil para
+    function_t before_render;   /**< Callback a ejecutar antes de renderizar el modelo. Se usará por si se quieren hacer modificaciones a bajo nivel (OpenGL). Si es NULL, no se ejecutará nada. */
+    function_t after_render;    /**< Callback a ejecutar después de renderizar el modelo. Se usará por si se quieren hacer modificaciones a bajo nivel (OpenGL). Si es NULL, no se ejecutará nada. */
 
     // Modo difuso, etc etc
 
   private:
     static int GetID() { return Components::mesh_render; }
 
+  __COMPONENT_POOL_DECLARE(CComponent_Mesh_Render)
+
+  private:
+    // Volumen envolvente en espacio de mundo, válido mientras no cambien el modelo ni la matriz de mundo
+    Culling::bounds_t world_bounds;
+    CResource_Mesh* bounds_mesh;
+    uint bounds_version;
+
+    // Último nivel de detalle elegido con cada cámara. Cada posición sólo la escribe la tarea que graba esa cámara
+    ubyte lod[__MESH_RENDER_LOD_CAMERAS];
+
+    // Grupo de CSystem_Static_Batching en el que está el modelo (desactivado), o el que dibuja el propio componente. -1 si no está en ninguno
+    int static_batch;
+
     void parseDebug(std::string command);
     void printDebug();
 
   public:
-    /** @brief Constructor vaco. */
-    CComponent_Mesh_Render(){};
+    /** @brief Constructor vacío. */
+    CComponent_Mesh_Render(): static_batch(-1){};
     /** @brief Constructor con objeto asociado.
      *
-     * Asocia al objeto pasado como argumento el componente creado. Adems, inicializa los atributos de la clase a unos ciertos valores:
+     * Asocia al objeto pasado como argumento el componente creado. Además, inicializa los atributos de la clase a unos ciertos valores:
      *
      @code
      mesh_name = material_name = "";
@@ -117,15 +144,55 @@ class CComponent_Mesh_Render: public CComponent
      color_apply_force = 0.f;
      @endcode
      *
-     * @param gameObject Objeto que guardar el componente.
+     * @param gameObject Objeto que guardará el componente.
      */
     CComponent_Mesh_Render(CGameObject* gameObject);
     /** @brief Destructor.
      * Destruye el componente. */
     ~CComponent_Mesh_Render();
 
+    /**
+     * @brief Volumen envolvente en espacio de mundo.
+     *
+     * Es el volumen del modelo (CResource_Mesh::Bounds()) transformado por la matriz de mundo del objeto. Se guarda en caché hasta que cambie alguna de las dos.
+     */
+    const Culling::bounds_t& WorldBounds();
+
+    /**
+     * @brief Volumen envolvente de la última llamada a WorldBounds(), sin actualizarlo.
+     *
+     * No escribe nada, así que se puede llamar desde las tareas de grabación de CSystem_Render, que actualiza antes todos los volúmenes.
+     */
+    inline const Culling::bounds_t& CachedWorldBounds()
+    {
+      return world_bounds;
+    }
+
+    /**
+     * @brief Comprobar si el modelo puede verse desde una cámara.
+     *
+     * Usa CachedWorldBounds(), así que no modifica el componente.
+     *
+     * @param frustum Frustum de la cámara.
+     * @return Devuelve false si el volumen envolvente queda completamente fuera del frustum.
+     */
+    bool IsVisible(const Culling::frustum_t& frustum);
+
   protected:
     void OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix);
+
+    // Uniforms propios del objeto (matrices, color). ProjMatrix y "texture" dependen sólo del programa. La matriz de modelo-vista incluye
+    // CResource_Mesh::DequantizeMatrix(); la normal no
+    void SetUniforms(CShader* shader, const glm::mat4& modelViewMatrix, CResource_Mesh* mesh, bool error_mesh);
+    // Lo mismo, con los valores ya calculados (CRender_Queue los guarda al grabar, y no vuelve a leer el componente al dibujar)
+    static void SetUniforms(CShader* shader, const glm::mat4& modelViewMatrix, const glm::mat4& normalMatrix, const glm::vec4& color, float texture_flag);
+    // Nivel de detalle del modelo para una cámara (véase CResource_Mesh::SelectLOD()). Los píxeles por unidad salen de la proyección (campo de visión,
+    // o alto en ortográfica), la escala del objeto y la distancia a su esfera envolvente. Con max_error <= 0, siempre el modelo original.
+    // "camera" es la posición de la cámara en la lista de CSystem_Render: el nivel anterior que se tiene en cuenta es el de esa cámara
+    uint SelectLOD(CResource_Mesh* mesh, uint camera, const glm::mat4& projMatrix, const glm::mat4& modelViewMatrix, float viewport_height, float max_error);
+
+    // Color y textureFlag con los que se dibuja el modelo. No modifica el componente, así que se puede llamar desde varios hilos
+    void GetColor(bool error_mesh, glm::vec4& out_color, float& texture_flag);
 };
 
 /*@}*/
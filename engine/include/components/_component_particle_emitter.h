@@ -8,6 +8,7 @@
 
 #include "_globals.h"
 #include "components/_component.h"
+#include "systems/_culling.h"
 
 // Ver http://www.opengl-tutorial.org/intermediate-tutorials/billboards-particles/particles-instancing/ para VBOs
 
@@ -16,31 +17,31 @@
 /*@{*/
 
 /**
- * @brief Componente emisor de partculas
+ * @brief Componente emisor de partículas
  *
- * El componente de emisin de partculas se encarga de crear efectos visuales tales como pantallas de humo,
+ * El componente de emisión de partículas se encarga de crear efectos visuales tales como pantallas de humo,
  * fuegos artificiales, disparos, etc.
  *
- * <a href="http://www.youtube.com/watch?v=MWXn0I2ib0o">Enlace a vdeo.</a>
+ * <a href="http://www.youtube.com/watch?v=MWXn0I2ib0o">Enlace a vídeo.</a>
  *
- * Para ello, hemos optado por un diseo bastante sencillo compuesto de 2 partes:
+ * Para ello, hemos optado por un diseño bastante sencillo compuesto de 2 partes:
  *
- * - Una cantidad determinada de partculas: cada una se tratar como una entidad (OJO, entidad, no objeto)
- *    que tendr su posicin, su velocidad, su aceleracin, su velocidad angular, etc.
- * - Un contenedor que gestionar dichas partculas en cada iteracin del bucle principal,
- *    calculando sus nuevas propiedades (posicin, velocidad, color, vida) y mostrndolas
- *    por pantalla en funcin de dichas propiedades.
+ * - Una cantidad determinada de partículas: cada una se tratará como una entidad (OJO, entidad, no objeto)
+ *    que tendrá su posición, su velocidad, su aceleración, su velocidad angular, etc.
+ * - Un contenedor que gestionará dichas partículas en cada iteración del bucle principal,
+ *    calculando sus nuevas propiedades (posición, velocidad, color, vida) y mostrándolas
+ *    por pantalla en función de dichas propiedades.
  *
  * @image html components/particle_emitter/particle_emitter.png
  *
- * Una partcula, en este caso, es una textura en el mundo 3D que siempre mira a la cmara (billboard).
- * Por tanto, una partcula se define con las siguientes propiedades:
- * - Una posicin en el espacio.
+ * Una partícula, en este caso, es una textura en el mundo 3D que siempre mira a la cámara (billboard).
+ * Por tanto, una partícula se define con las siguientes propiedades:
+ * - Una posición en el espacio.
  * - Una velocidad.
- * - Una aceleracin.
- * - Un ngulo de rotacin.
+ * - Una aceleración.
+ * - Un ángulo de rotación.
  * - Una velocidad angular.
- * - Una aceleracin angular (no implementado).
+ * - Una aceleración angular (no implementado).
  * - Una escala.
  * - Un factor de escala.
  * - Un color.
@@ -48,19 +49,19 @@
  * - Un tiempo de vida.
  * - Etc.
  *
- * Estos valores vendrn definidos por el componente que gestionar dichas partculas, con propiedades como:
+ * Estos valores vendrán definidos por el componente que gestionará dichas partículas, con propiedades como:
  *
- * - Valores mximos y mnimos actuales (restricciones).
- * - Valores mximos y mnimos iniciales (aleatorio).
- * - Numero mximo de partculas.
+ * - Valores máximos y mínimos actuales (restricciones).
+ * - Valores máximos y mínimos iniciales (aleatorio).
+ * - Numero máximo de partículas.
  * - Etc.
  *
- * Finalmente, el funcionamiento del emisor de partculas es el siguiente:
+ * Finalmente, el funcionamiento del emisor de partículas es el siguiente:
  *
  * Para iniciar:
  @code
  Desde i = 0 hasta max_particles
-     Crear partcula i con propiedades aleatorias.
+     Crear partícula i con propiedades aleatorias.
  @endcode
  *
  * Para mostrar por pantalla
@@ -68,7 +69,7 @@
  Para cada p en particles:Si (p.life > 0) saltamos al siguiente p
      Aplicar textura y color a opengl
      Trasladarse a p.position
-     Hacer que la partcula se genere como un sprite o billboard
+     Hacer que la partícula se genere como un sprite o billboard
      Rotar p.angle
      Escalar p.scale
      Dibujar p
@@ -76,19 +77,19 @@
  *
  * Para iterar:
  @code
- Si est congelado (freeze), salir.
+ Si está congelado (freeze), salir.
  Para cada p en particles:Incrementar p.position a partir de p.velocity
      Incrementar p.velocity a partir de p.acceleration
-     // Idem para los ngulos y similar para la escala, y otro tipo de valores (color, etc).
-     Decrementar el tiempo de vida de p con el tiempo delta (diferencia de tiempo entre ltima iteracin e iteracin actual).
-     Si la vida es < 0 y no est en modo parado (stop, sin generar nuevas partculas)
-       Generar nueva partcula p.
+     // Idem para los ángulos y similar para la escala, y otro tipo de valores (color, etc).
+     Decrementar el tiempo de vida de p con el tiempo delta (diferencia de tiempo entre última iteración e iteración actual).
+     Si la vida es < 0 y no está en modo parado (stop, sin generar nuevas partículas)
+       Generar nueva partícula p.
  @endcode
  *
- * Dicho funcionamiento se realizar de manera automtica desde el componente.
+ * Dicho funcionamiento se realizará de manera automática desde el componente.
  *
- * @warning Algunos atributos estn sin usar. Vase cdigo fuente.
- * @warning El movimiento de las partculas depende siempre del tiempo.
+ * @warning Algunos atributos están sin usar. Véase código fuente.
+ * @warning El movimiento de las partículas depende siempre del tiempo.
  *
  * @see http://en.wikipedia.org/wiki/Particle_system
  */
@@ -96,6 +97,7 @@ class CComponent_Particle_Emitter: public CComponent
 {
   friend class CGameObject;
   friend class CSystem_Render;
+  friend class CRender_Queue;
 
   private:
     class CParticle
@@ -118,7 +120,11 @@ class CComponent_Particle_Emitter: public CComponent
         ~CParticle();
     };
 
-    std::vector<CParticle> particles;
+    // Los buffers de partículas salen de la arena de la estancia (véase CSystem_Memory)
+    typedef std::vector<CParticle, Memory::allocator<CParticle> > particle_list_t;
+    typedef std::vector<GLfloat, Memory::allocator<GLfloat> > float_list_t;
+
+    particle_list_t particles;
 
     static bool InitRenderVBO();
     static void CloseRenderVBO();
@@ -129,99 +135,112 @@ class CComponent_Particle_Emitter: public CComponent
     float new_particles;
 
       // VertexArray
-    // Esto lo voy a intentar hacer esttico, por lo que reducir enormemente el nmero de VBOs en escena
+    // Esto lo voy a intentar hacer estático, por lo que reducirá enormemente el número de VBOs en escena
     static GLuint m_ParticlesVAO;
 
       // For all (divisor = 0)
     static GLuint m_ParticlesVBOVertices;
 
+    // Los tres atributos seguidos, para copiarlos al buffer circular de una vez (véase UpdateVBO()). Fuera de la arena: dura entre estancias
+    static std::vector<GLfloat> stream_data;
+
       // Per particle (divisor = 1)
-    // Estara bien, si funciona, usar un mat3 para guardar esto (9 elementos), usando as un nico VBO
-    static GLuint m_ParticlesVBOPosition;   // vec3
-    static GLuint m_ParticlesVBOAngleScale; // vec2
-    static GLuint m_ParticlesVBOColor;      // vec4
+    // Posición (vec3), ángulo y escala (vec2) y color (vec4) se escriben en cada iteración en CSystem_Stream_Buffer
 
       // Used to store update info.
-    std::vector<GLfloat> v_ParticlePosition_data;
-    std::vector<GLfloat> v_ParticlesAngleScale_data;
-    std::vector<GLfloat> v_ParticlesColor_data;
+    float_list_t v_ParticlePosition_data;
+    float_list_t v_ParticlesAngleScale_data;
+    float_list_t v_ParticlesColor_data;
+
+    // Copia los datos de las partículas al buffer circular y apunta los atributos 1 a 3 del VAO a ellos. false si no caben
+    static bool UpdateVBO(const GLfloat* positions, const GLfloat* angle_scale, const GLfloat* colors, uint count);
 
-    void UpdateVBO();
+    // Dibuja "count" partículas con "__particlesShader". No lee el componente: CRender_Queue lo llama con una copia de los datos
+    static void Draw(const glm::mat4& projMatrix, const glm::mat4& modelViewMatrix, GLuint texture, const GLfloat* positions, const GLfloat* angle_scale, const GLfloat* colors, uint count);
+
+    // Textura con la que se dibujan las partículas
+    GLuint GetTexture();
 
     vector3f last_pos;
 
+    Culling::aabb_t local_bounds;  // Partículas vivas en la última iteración, en espacio local
+
   protected:
     void parseDebug(std::string command);
     void printDebug();
 
   public:
-    // Se podran usar varios materiales, con una probabilidad P(X)c[0.f, 1.f] de que una particula use el material X
-    uint max_particles;            /**< Cantidad mxima de partculas a emitir. @warning No debe cambiarse una vez iniciado el emisor. Debe pararse y ejecutarse. */
-    GLfloat particles_per_second;  /**< Ratio de emisin (partculas por segundo). Puede cambiarse de manera dinmica. */
-    std::string material_name;     /**< Nombre de la textura a usar para las partculas. Puede cambiarse de manera dinmica. @see CSystem_Resources @see CResource_Texture */
-    //vector<string> materials; // random materials, pero esto se podra conseguir con 2 emisores de partculas...
+    // Se podrían usar varios materiales, con una probabilidad P(X)c[0.f, 1.f] de que una particula use el material X
+    uint max_particles;            /**< Cantidad máxima de partículas a emitir. @warning No debe cambiarse una vez iniciado el emisor. Debe pararse y ejecutarse. */
+    GLfloat particles_per_second;  /**< Ratio de emisión (partículas por segundo). Puede cambiarse de manera dinámica. */
+    std::string material_name;     /**< Nombre de la textura a usar para las partículas. Puede cambiarse de manera dinámica. @see CSystem_Resources @see CResource_Texture */
+    //vector<string> materials; // random materials, pero esto se podría conseguir con 2 emisores de partículas...
 
     // Usado para CSystem_Math::random_vector(direction, angle_spreed);
     //CSystem_Math::cone_t spread_cone;
 
-    // Propiedades del "emisor" de partculas
-    bool freeze; /**< Congelar partculas (Inmovilizar, Inmortalizar). */
-    bool stop;   /**< Dejar de emitir partculas. Las partculas vivas seguirn su trayectoria hasta morir. */
+    // Propiedades del "emisor" de partículas
+    bool freeze; /**< Congelar partículas (Inmovilizar, Inmortalizar). */
+    bool stop;   /**< Dejar de emitir partículas. Las partículas vivas seguirán su trayectoria hasta morir. */
 
     // Cono
-    vector3f_t direction;            /**< Direccin de emisin de partculas. Se usa para saber donde apunta la base del cono del emisor (plano de la base del cono perpendicular al vector, siendo un plano al mismo).*/
-    GLfloat angle_spread;            /**< ngulo de dispersin. Ampliacin del cono de generacin de partculas para generar vectores aleatorios. Representa el ngulo total, no desde un borde al centro. */
-
-    GLfloat max_vel,                 /**< Mxima velocidad de una partcula mientras est viva.*/
-            min_vel;                 /**< Mnima velocidad de una partcula mientras est viva. */
-    GLfloat max_angle_vel,           /**< Mxima velocidad angular de una partcula mientras est viva. */
-            min_angle_vel;           /**< Mnima velocidad angular de una partcula mientras est viva. */
-    GLfloat max_scale,               /**< Mxima escala de una partcula mientras est viva. */
-            min_scale;               /**< Mnima escala de una partcula mientras est viva. */
+    vector3f_t direction;            /**< Dirección de emisión de partículas. Se usa para saber donde apunta la base del cono del emisor (plano de la base del cono perpendicular al vector, siendo un plano al mismo).*/
+    GLfloat angle_spread;            /**< Ángulo de dispersión. Ampliación del cono de generación de partículas para generar vectores aleatorios. Representa el ángulo total, no desde un borde al centro. */
+
+    GLfloat max_vel,                 /**< Máxima velocidad de una partícula mientras esté viva.*/
+            min_vel;                 /**< Mínima velocidad de una partícula mientras esté viva. */
+    GLfloat max_angle_vel,           /**< Máxima velocidad angular de una partícula mientras esté viva. */
+            min_angle_vel;           /**< Mínima velocidad angular de una partícula mientras esté viva. */
+    GLfloat max_scale,               /**< Máxima escala de una partícula mientras esté viva. */
+            min_scale;               /**< Mínima escala de una partícula mientras esté viva. */
     //GLfloat max_live_time, min_live_time;
-    colorf_t max_color,              /**< Mximo color RGBA de una partcula mientras est viva. */
-             min_color;              /**< Mnimo color RGBA de una partcula mientras est viva. */
+    colorf_t max_color,              /**< Máximo color RGBA de una partícula mientras esté viva. */
+             min_color;              /**< Mínimo color RGBA de una partícula mientras esté viva. */
 
     // Start values
-    GLfloat start_max_life_time,     /**< Tiempo mximo de vida asignado a la partcula una vez nacida. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-            start_min_life_time;     /**< Tiempo mnimo de vida asignado a la partcula una vez nacida. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-    GLfloat start_max_distance,      /**< Ditancia mxima desde el origen (punta del cono, posicin del objeto ) hasta el punto sobre el vector del cono que se le ha asignado a la partcula una vez nacida. Cuanto mayor sea, ms alejada del origen podr estar la partcula al nacer. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-            start_min_distance;      /**< Ditancia mnima desde el origen (punta del cono, posicin del objeto ) hasta el punto sobre el vector del cono que se le ha asignado a la partcula una vez nacida. Cuanto mayor sea, ms cerca al origen podr estar la partcula al nacer. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-    GLfloat start_max_angle,         /**< Mximo ngulo con el que nace la partcula. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-            start_min_angle;         /**< Mnimo ngulo con el que nace la partcula. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-    GLfloat start_max_angle_vel,     /**< Mxima velocidad angular con la que nace la partcula. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-            start_min_angle_vel;     /**< Mnima velocidad angular con la que nace la partcula. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-    GLfloat start_max_vel,           /**< Mxima velocidad con la que saldr la partcula, en direccin de un vector perteneciente al cono definido por el componente. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-            start_min_vel;           /**< Mnima velocidad con la que saldr la partcula, en direccin de un vector perteneciente al cono definido por el componente. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-    GLfloat start_max_scale,         /**< Mxima escala con la que nacern las nuevas partculas. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-            start_min_scale;         /**< Mnima escala con la que nacern las nuevas partculas. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-    GLfloat start_max_scale_factor,  /**< Mximo factor de escala con la que nacern las nuevas partculas. A medida que avance el tiempo, las partculas se veran afectadas por este factor. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-            start_min_scale_factor;  /**< Mnimo factor de escala con la que nacern las nuevas partculas. A medida que avance el tiempo, las partculas se veran afectadas por este factor. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
+    GLfloat start_max_life_time,     /**< Tiempo máximo de vida asignado a la partícula una vez nacida. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+            start_min_life_time;     /**< Tiempo mínimo de vida asignado a la partícula una vez nacida. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+    GLfloat start_max_distance,      /**< Ditancia máxima desde el origen (punta del cono, posición del objeto ) hasta el punto sobre el vector del cono que se le ha asignado a la partícula una vez nacida. Cuanto mayor sea, más alejada del origen podrá estar la partícula al nacer. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+            start_min_distance;      /**< Ditancia mínima desde el origen (punta del cono, posición del objeto ) hasta el punto sobre el vector del cono que se le ha asignado a la partícula una vez nacida. Cuanto mayor sea, más cerca al origen podrá estar la partícula al nacer. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+    GLfloat start_max_angle,         /**< Máximo ángulo con el que nace la partícula. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+            start_min_angle;         /**< Mínimo ángulo con el que nace la partícula. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+    GLfloat start_max_angle_vel,     /**< Máxima velocidad angular con la que nace la partícula. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+            start_min_angle_vel;     /**< Mínima velocidad angular con la que nace la partícula. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+    GLfloat start_max_vel,           /**< Máxima velocidad con la que saldrá la partícula, en dirección de un vector perteneciente al cono definido por el componente. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+            start_min_vel;           /**< Mínima velocidad con la que saldrá la partícula, en dirección de un vector perteneciente al cono definido por el componente. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+    GLfloat start_max_scale,         /**< Máxima escala con la que nacerán las nuevas partículas. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+            start_min_scale;         /**< Mínima escala con la que nacerán las nuevas partículas. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+    GLfloat start_max_scale_factor,  /**< Máximo factor de escala con la que nacerán las nuevas partículas. A medida que avance el tiempo, las partículas se veran afectadas por este factor. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+            start_min_scale_factor;  /**< Mínimo factor de escala con la que nacerán las nuevas partículas. A medida que avance el tiempo, las partículas se veran afectadas por este factor. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
 
     // Radio de la base
-    GLfloat start_max_base_radius,   /**< Mximo radio desde el que se empezarn a emitir partculas. Hace que el emisor se comporte como un embudo, siendo la "punta" del cono una circunferencia. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-            start_min_base_radius;   /**< Mnimo radio desde el que se empezarn a emitir partculas. Hace que el emisor se comporte como un embudo, siendo la "punta" del cono una circunferencia. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
+    GLfloat start_max_base_radius,   /**< Máximo radio desde el que se empezarán a emitir partículas. Hace que el emisor se comporte como un embudo, siendo la "punta" del cono una circunferencia. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+            start_min_base_radius;   /**< Mínimo radio desde el que se empezarán a emitir partículas. Hace que el emisor se comporte como un embudo, siendo la "punta" del cono una circunferencia. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
 
     //colorf_t color;
-    colorf_t start_max_color,        /**< Mximo color RGBA con el que nacern las nuevas partculas. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-             start_min_color;        /**< Mnimo color RGBA con el que nacern las nuevas partculas. Usado para generar valores aleatorios en un rango a la hora de crear partculas. */
-    vector3f gravity;                /**< Gravedad que afectar a las partculas como una aceleracin. Si no se quiere usar gravedad, basta con que el vector sea *(0, 0, 0)*  */
+    colorf_t start_max_color,        /**< Máximo color RGBA con el que nacerán las nuevas partículas. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+             start_min_color;        /**< Mínimo color RGBA con el que nacerán las nuevas partículas. Usado para generar valores aleatorios en un rango a la hora de crear partículas. */
+    vector3f gravity;                /**< Gravedad que afectará a las partículas como una aceleración. Si no se quiere usar gravedad, basta con que el vector sea *(0, 0, 0)*  */
 
-    colorf_t color_adder;            /**< Adicionador de color. Se aadir una cierta cantidad de color por segundo al color actual, creando efectos de degradado. Puede ser tanto positivo como negativo. */
+    colorf_t color_adder;            /**< Adicionador de color. Se añadirá una cierta cantidad de color por segundo al color actual, creando efectos de degradado. Puede ser tanto positivo como negativo. */
 
 
   private:
     static int GetID() { return Components::particle_emitter; }
 
+  __COMPONENT_POOL_DECLARE(CComponent_Particle_Emitter)
+
+  private:
+
   public:
     /**
-     * @brief Constructor vaco.
+     * @brief Constructor vacío.
      */
     CComponent_Particle_Emitter(){};
 
     /** @brief Constructor con objeto asociado.
      *
-     * Asocia al objeto pasado como argumento el componente creado. Adems, inicializa los atributos de la clase a unos ciertos valores:
+     * Asocia al objeto pasado como argumento el componente creado. Además, inicializa los atributos de la clase a unos ciertos valores:
      *
      @code
      material_name = "";
@@ -270,7 +289,7 @@ class CComponent_Particle_Emitter: public CComponent
      new_particles = 0;
      @endcode
      *
-     * @param gameObject Objeto que guardar el componente.
+     * @param gameObject Objeto que guardará el componente.
      */
     CComponent_Particle_Emitter(CGameObject* gameObject);
 
@@ -281,47 +300,65 @@ class CComponent_Particle_Emitter: public CComponent
      */
     ~CComponent_Particle_Emitter();
     /**
-     * @brief Inicia la emisin de partculas.
+     * @brief Inicia la emisión de partículas.
      *
-     * Empiez a expulsar partculas, respetando los lmites y los criterios establecidos en los atributos del componente.
+     * Empiez a expulsar partículas, respetando los límites y los criterios establecidos en los atributos del componente.
      *
-     * @warning Elimina todas las partculas y las crea de nuevo, quitando las que estaban vivas. Para este caso, use Resume().
+     * @warning Elimina todas las partículas y las crea de nuevo, quitando las que estaban vivas. Para este caso, use Resume().
      */
     void Start();
 
     /**
-     * @brief Para la emisin de partculas.
+     * @brief Para la emisión de partículas.
      *
-     * Una vez se esten emitiendo partculas, se puede parar la emisin.
+     * Una vez se esten emitiendo partículas, se puede parar la emisión.
      * Por ejemplo, en la vida real, cuando se cierra un grifo, el agua que estaba saliendo
-     * y que no ha caido a la baera, terminar de caer, y quedar combinada junto con el resto.
+     * y que no ha caido a la bañera, terminará de caer, y quedará combinada junto con el resto.
      *
-     * En este caso, las partculas emitidas que sigan con vida seguirn viviendo, hasta que mueran,
-     * y no se emitirn nuevas partculas.
+     * En este caso, las partículas emitidas que sigan con vida seguirán viviendo, hasta que mueran,
+     * y no se emitirán nuevas partículas.
      */
     void Stop();
     /**
-     * @brief Reanudar la emisin de partculas.
+     * @brief Reanudar la emisión de partículas.
      *
-     * Si se ha parado la emisin de partculas, con este mtodo se podr reanudar la emisin de partculas,
-     * sin destruir partculas que pudiesen estar vivas mientras se generan las nuevas.
+     * Si se ha parado la emisión de partículas, con este método se podrá reanudar la emisión de partículas,
+     * sin destruir partículas que pudiesen estar vivas mientras se generan las nuevas.
      */
     void Resume();
 
     /**
-     * @brief Congelar las partculas.
+     * @brief Congelar las partículas.
      *
-     * Hace inmortales a las partculas (no mueren) y permanecen inmutables mientras el emisor se considere como "congelado".
+     * Hace inmortales a las partículas (no mueren) y permanecen inmutables mientras el emisor se considere como "congelado".
      */
     void Freeze();
 
     /**
-     * @brief Descongelar las partculas.
+     * @brief Descongelar las partículas.
      *
-     * Hace mortales a las partculas (mueren) y dejan de ser inmutables, pasando a estar no-congelado.
+     * Hace mortales a las partículas (mueren) y dejan de ser inmutables, pasando a estar no-congelado.
      */
     void UnFreeze();
 
+    /**
+     * @brief Volumen envolvente en espacio de mundo.
+     *
+     * Caja conservadora que contiene las partículas vivas en la última iteración (ampliada con su escala), transformada por la matriz de mundo del objeto.
+     * Si no hay partículas vivas, está vacía.
+     */
+    Culling::bounds_t WorldBounds();
+
+    /**
+     * @brief Comprobar si las partículas pueden verse desde una cámara.
+     *
+     * Usa la matriz de mundo en caché (véase CComponent_Transform::CachedWorldMatrix()), así que no modifica el componente ni la transformación.
+     *
+     * @param frustum Frustum de la cámara.
+     * @return Devuelve false si no hay partículas vivas o si todas quedan fuera del frustum.
+     */
+    bool IsVisible(const Culling::frustum_t& frustum);
+
   protected:
     void OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix);
     void OnLoop();
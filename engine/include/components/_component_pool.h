@@ -0,0 +1,236 @@
+/**
+ * @file
+ * @brief Fichero que incluye los pools (almacenes contiguos) de componentes.
+ */
+
+#ifndef __COMPONENT_POOL_H_
+#define __COMPONENT_POOL_H_
+
+#include "_globals.h"
+#include "systems/_memory.h"
+
+#include <type_traits>
+#include <algorithm>
+#include <utility>
+
+/** @addtogroup Componentes */
+/*@{*/
+
+/**
+ * @brief Número de componentes por bloque de un pool.
+ */
+#define __COMPONENT_POOL_CHUNK_SIZE 256
+
+/**
+ * @brief Pool de componentes de un tipo.
+ *
+ * Reserva los componentes de un mismo tipo en bloques contiguos de memoria de tamaño fijo, en vez de hacer un **new** por componente.
+ * Los bloques nunca se mueven ni se liberan hasta que se cierra el programa, por lo que los punteros a los componentes siguen siendo válidos mientras el componente exista.
+ * Los huecos que dejan los componentes borrados se reutilizan en las siguientes reservas.
+ *
+ * Recorrer el pool por índice (de 0 a Capacity()) recorre la memoria en orden, bloque a bloque, por lo que los sistemas que tengan que
+ * iterar sobre todos los componentes de un tipo pueden hacerlo sin pasar por cada game object.
+ *
+ * Reservar y liberar está protegido por un spinlock, así que se puede crear un componente desde una tarea de CSystem_Jobs. CGameObject usa también un pool.
+ *
+ * @see __COMPONENT_POOL_DECLARE
+ * @see __COMPONENT_POOL_IMPLEMENT
+ */
+template <class Type, uint chunk_size = __COMPONENT_POOL_CHUNK_SIZE>
+class CComponent_Pool
+{
+  protected:
+    struct chunk_t
+    {
+      typename std::aligned_storage<sizeof(Type), alignof(Type)>::type data[chunk_size];
+      bool used[chunk_size];
+    };
+
+    std::vector<chunk_t*> chunks;
+    std::vector<std::pair<char*, uint> > sorted_chunks;  // Dirección de inicio y posición en "chunks" de cada bloque, ordenados por dirección
+    std::vector<uint> free_list;
+    uint num_used;
+    SDL_SpinLock lock;  // Se puede reservar desde los hilos de CSystem_Jobs
+
+    void AddChunk()
+    {
+      chunk_t* chunk = new chunk_t;
+      uint base = chunks.size() * chunk_size;
+
+      std::pair<char*, uint> entry((char*)&chunk->data[0], chunks.size());
+      sorted_chunks.insert(std::upper_bound(sorted_chunks.begin(), sorted_chunks.end(), entry), entry);
+      chunks.push_back(chunk);
+
+      // Se añaden al revés, para que se usen primero los índices más bajos
+      for(int i = chunk_size - 1; i >= 0; i--)
+      {
+        chunk->used[i] = false;
+        free_list.push_back(base + i);
+      }
+    }
+
+  public:
+    CComponent_Pool(): num_used(0), lock(0) {};
+
+    ~CComponent_Pool()
+    {
+      for(typename std::vector<chunk_t*>::iterator it = chunks.begin(); it != chunks.end(); ++it)
+        delete (*it);
+    }
+
+    /**
+     * @brief Reservar memoria para un componente.
+     *
+     * @return Puntero a memoria sin construir, con tamaño y alineación de "Type".
+     */
+    void* Allocate()
+    {
+      SDL_AtomicLock(&lock);
+
+      if(free_list.empty())
+        AddChunk();
+
+      uint index = free_list.back();
+      free_list.pop_back();
+
+      chunk_t* chunk = chunks[index / chunk_size];
+      chunk->used[index % chunk_size] = true;
+      num_used++;
+
+      SDL_AtomicUnlock(&lock);
+
+      return &chunk->data[index % chunk_size];
+    }
+
+    /**
+     * @brief Reservar espacio para varios elementos de una vez.
+     *
+     * Añade los bloques necesarios para que las próximas "n" reservas no tengan que pedir memoria.
+     *
+     * @param n Número de elementos.
+     */
+    void Reserve(uint n)
+    {
+      SDL_AtomicLock(&lock);
+
+      while(free_list.size() < n)
+        AddChunk();
+
+      SDL_AtomicUnlock(&lock);
+    }
+
+    /**
+     * @brief Liberar la memoria de un componente.
+     *
+     * El componente ya debe haber sido destruido. El bloque se busca por dirección, con una búsqueda binaria sobre los bloques ordenados.
+     *
+     * @param p Puntero devuelto por Allocate().
+     * @return Devuelve true si la memoria pertenecía al pool, false en caso contrario.
+     */
+    bool Free(void* p)
+    {
+      SDL_AtomicLock(&lock);
+
+      // Búsqueda binaria del último bloque que empieza antes de "p"
+      std::pair<char*, uint> key((char*)p, (uint)-1);
+      typename std::vector<std::pair<char*, uint> >::iterator it = std::upper_bound(sorted_chunks.begin(), sorted_chunks.end(), key);
+      if(it != sorted_chunks.begin())
+      {
+        --it;
+        uint c = it->second;
+        char* begin = it->first;
+        char* end   = (char*)&chunks[c]->data[chunk_size];
+        if((char*)p < end)
+        {
+          uint i = ((char*)p - begin) / sizeof(chunks[c]->data[0]);
+          chunks[c]->used[i] = false;
+          free_list.push_back(c * chunk_size + i);
+          num_used--;
+
+          SDL_AtomicUnlock(&lock);
+          return true;
+        }
+      }
+
+      SDL_AtomicUnlock(&lock);
+      return false;
+    }
+
+    /**
+     * @brief Número de posiciones del pool (usadas y libres).
+     */
+    inline uint Capacity()
+    {
+      return chunks.size() * chunk_size;
+    }
+
+    /**
+     * @brief Número de componentes vivos en el pool.
+     */
+    inline uint Size()
+    {
+      return num_used;
+    }
+
+    /**
+     * @brief Acceder a una posición del pool.
+     *
+     * @param index Valor entre 0 y Capacity().
+     * @return Puntero al componente de esa posición, o NULL si la posición está libre.
+     */
+    inline Type* At(uint index)
+    {
+      chunk_t* chunk = chunks[index / chunk_size];
+      if(!chunk->used[index % chunk_size])
+        return NULL;
+
+      return (Type*)&chunk->data[index % chunk_size];
+    }
+};
+
+/**
+ * @brief Declarar el pool de un componente.
+ *
+ * Se coloca dentro de la declaración de la clase del componente. Sobrecarga los operadores **new** y **delete** de la clase,
+ * de forma que "new CComponent_X(go)" y "delete component" usan el pool de su tipo sin cambiar el código que los crea.
+ */
+#define __COMPONENT_POOL_DECLARE(Type) \
+  public: \
+    static CComponent_Pool<Type>& Pool(); \
+    static void* operator new(size_t size); \
+    static void operator delete(void* p, size_t size);
+
+/**
+ * @brief Implementar el pool de un componente.
+ *
+ * Se coloca en el fichero de implementación del componente. Si se reserva un tamaño distinto al de la clase (una clase hija), se usa la arena de
+ * la estancia (véase CSystem_Memory).
+ */
+#define __COMPONENT_POOL_IMPLEMENT(Type) \
+  CComponent_Pool<Type>& Type::Pool() \
+  { \
+    static CComponent_Pool<Type> pool; \
+    return pool; \
+  } \
+  void* Type::operator new(size_t size) \
+  { \
+    if(size != sizeof(Type)) \
+      return gSystem_Memory.Allocate(size); \
+    return Pool().Allocate(); \
+  } \
+  void Type::operator delete(void* p, size_t size) \
+  { \
+    if(!p) \
+      return; \
+    if(size != sizeof(Type)) \
+    { \
+      if(!gSystem_Memory.Free(p, size)) \
+        ::operator delete(p); \
+    } \
+    else if(!Pool().Free(p)) \
+      ::operator delete(p); \
+  }
+
+/*@}*/
+
+#endif /* __COMPONENT_POOL_H_ */
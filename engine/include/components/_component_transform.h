@@ -13,10 +13,223 @@
 /** @addtogroup Componentes */
 /*@{*/
 
+class CComponent_Transform;
+
+/**
+ * @brief Datos de los componentes de transformación.
+ *
+ * Guarda la posición, la orientación y la escala de todos los CComponent_Transform como una estructura de arrays (SoA), en bloques de
+ * __COMPONENT_POOL_CHUNK_SIZE elementos. Así, los sistemas que recorren todas las transformaciones (matrices de mundo, gizmos, etc.) leen
+ * arrays contiguos de posiciones, cuaterniones y escalas en vez de saltar de objeto en objeto.
+ *
+ * Los bloques no se mueven nunca, por lo que cada componente guarda referencias fijas a sus datos (CComponent_Transform::position, etc.).
+ *
+ * Además de la posición, la orientación y la escala, cada bloque guarda las matrices local y de mundo ya calculadas (véase CComponent_Transform::WorldMatrix()).
+ *
+ * También guarda la jerarquía de objetos de forma plana: un array con todas las transformaciones en preorden (los padres siempre antes que sus hijos),
+ * la posición del padre de cada una y el tamaño de su subárbol. Así, las matrices de mundo se calculan en una sola pasada lineal, y los descendientes
+ * de un objeto son un rango contiguo del array (véase Subtree()). La jerarquía se reconstruye, en tiempo lineal, sólo cuando ha cambiado.
+ */
+class CComponent_Transform_Data
+{
+  friend class CComponent_Transform;
+
+  protected:
+    struct chunk_t
+    {
+      vector3f position[__COMPONENT_POOL_CHUNK_SIZE];
+      glm::quat angle[__COMPONENT_POOL_CHUNK_SIZE];
+      vector3f scale[__COMPONENT_POOL_CHUNK_SIZE];
+      CComponent_Transform* owner[__COMPONENT_POOL_CHUNK_SIZE];
+      glm::mat4 local[__COMPONENT_POOL_CHUNK_SIZE];  // Posición * orientación * escala
+      glm::mat4 world[__COMPONENT_POOL_CHUNK_SIZE];  // Matriz del padre * local
+      glm::mat4 normal[__COMPONENT_POOL_CHUNK_SIZE]; // Inversa traspuesta de world
+      uint order_index[__COMPONENT_POOL_CHUNK_SIZE]; // Posición en "order"
+    };
+
+    // Tabla de bloques. Al crecer se copia a una tabla nueva, y las anteriores se conservan hasta el destructor: una tabla nunca cambia ni se
+    // libera mientras se usa, así que se lee sin lock. Sólo Allocate() toma el lock, porque se puede reservar desde los hilos de CSystem_Jobs
+    chunk_t** chunks;
+    uint num_chunks;
+    uint chunks_capacity;
+    std::vector<chunk_t**> old_chunks;
+    std::vector<uint> free_list;
+    SDL_SpinLock lock;
+
+    // Jerarquía plana, en preorden
+    std::vector<uint> order;                        // Índice de datos de cada elemento
+    std::vector<CComponent_Transform*> order_owner; // Componente de cada elemento
+    std::vector<int> order_parent;                  // Posición del padre en "order", o -1 si no tiene
+    std::vector<uint> order_size;                   // Tamaño del subárbol, incluido el propio elemento
+    bool hierarchy_dirty;
+
+    std::vector<int> first_child;   // Auxiliares de BuildHierarchy(), por índice de datos
+    std::vector<int> next_sibling;
+    std::vector<uint> stack;
+
+    std::vector<char> changed;                      // Auxiliares de CComponent_Transform::UpdateWorldMatrices(), por posición en "order"
+    std::vector<uint> indices;
+    std::vector<const glm::mat4*> batch_left;
+    std::vector<const glm::mat4*> batch_right;
+    std::vector<glm::mat4*> batch_output;
+    std::vector<const glm::mat4*> normal_input;
+    std::vector<glm::mat4*> normal_output;
+
+    std::vector<uint> moved;                        // Índices de datos cuya matriz de mundo ha cambiado, para CSystem_Spatial
+
+    void FlushBatch();
+
+    inline chunk_t* Chunk(uint chunk)
+    {
+      return chunks[chunk];
+    }
+
+  public:
+    CComponent_Transform_Data(): chunks(NULL), num_chunks(0), chunks_capacity(0), lock(0), hierarchy_dirty(true) {};
+    ~CComponent_Transform_Data();
+
+    uint Allocate(CComponent_Transform* owner);
+    void Free(uint index);
+
+    inline uint Capacity()
+    {
+      return num_chunks * __COMPONENT_POOL_CHUNK_SIZE;
+    }
+
+    inline uint NumChunks()
+    {
+      return num_chunks;
+    }
+
+    inline vector3f& position(uint index)
+    {
+      return Chunk(index / __COMPONENT_POOL_CHUNK_SIZE)->position[index % __COMPONENT_POOL_CHUNK_SIZE];
+    }
+
+    inline glm::quat& angle(uint index)
+    {
+      return Chunk(index / __COMPONENT_POOL_CHUNK_SIZE)->angle[index % __COMPONENT_POOL_CHUNK_SIZE];
+    }
+
+    inline vector3f& scale(uint index)
+    {
+      return Chunk(index / __COMPONENT_POOL_CHUNK_SIZE)->scale[index % __COMPONENT_POOL_CHUNK_SIZE];
+    }
+
+    inline glm::mat4& local(uint index)
+    {
+      return Chunk(index / __COMPONENT_POOL_CHUNK_SIZE)->local[index % __COMPONENT_POOL_CHUNK_SIZE];
+    }
+
+    inline glm::mat4& world(uint index)
+    {
+      return Chunk(index / __COMPONENT_POOL_CHUNK_SIZE)->world[index % __COMPONENT_POOL_CHUNK_SIZE];
+    }
+
+    inline glm::mat4& normal(uint index)
+    {
+      return Chunk(index / __COMPONENT_POOL_CHUNK_SIZE)->normal[index % __COMPONENT_POOL_CHUNK_SIZE];
+    }
+
+    /** @return Componente que usa la posición "index", o NULL si está libre. */
+    inline CComponent_Transform* owner(uint index)
+    {
+      return Chunk(index / __COMPONENT_POOL_CHUNK_SIZE)->owner[index % __COMPONENT_POOL_CHUNK_SIZE];
+    }
+
+    /** @brief Arrays de un bloque, para recorrerlos de forma lineal. */
+    inline vector3f* Positions(uint chunk) { return Chunk(chunk)->position; }
+    inline glm::quat* Angles(uint chunk) { return Chunk(chunk)->angle; }
+    inline vector3f* Scales(uint chunk) { return Chunk(chunk)->scale; }
+    inline CComponent_Transform** Owners(uint chunk) { return Chunk(chunk)->owner; }
+    inline glm::mat4* Worlds(uint chunk) { return Chunk(chunk)->world; }
+    inline glm::mat4* Normals(uint chunk) { return Chunk(chunk)->normal; }
+
+    /**
+     * @brief Anotar que una transformación ha cambiado de matriz de mundo (o de volumen envolvente).
+     *
+     * Puede llamarse desde cualquier hilo.
+     */
+    inline void Moved(uint index)
+    {
+      SDL_AtomicLock(&lock);
+      moved.push_back(index);
+      SDL_AtomicUnlock(&lock);
+    }
+
+    /**
+     * @brief Obtener y vaciar la lista de transformaciones cambiadas desde la última llamada.
+     *
+     * Puede contener índices repetidos, o de transformaciones ya liberadas.
+     */
+    inline void TakeMoved(std::vector<uint>& output)
+    {
+      output.clear();
+
+      SDL_AtomicLock(&lock);
+      moved.swap(output);
+      SDL_AtomicUnlock(&lock);
+    }
+
+    /**
+     * @brief Marcar la jerarquía para reconstruirla.
+     *
+     * Se llama al cambiar el padre de un objeto, y al reservar o liberar una transformación.
+     */
+    inline void SetHierarchyDirty()
+    {
+      hierarchy_dirty = true;
+    }
+
+    /**
+     * @brief Comprobar si la jerarquía ha cambiado desde la última reconstrucción.
+     */
+    inline bool HierarchyDirty()
+    {
+      return hierarchy_dirty;
+    }
+
+    /**
+     * @brief Reconstruir la jerarquía plana, si ha cambiado.
+     *
+     * Recorre una vez todas las transformaciones para obtener su padre, y otra vez para ordenarlas en preorden. Coste lineal.
+     */
+    void BuildHierarchy();
+
+    /**
+     * @brief Número de elementos de la jerarquía plana.
+     */
+    inline uint HierarchySize()
+    {
+      return order.size();
+    }
+
+    /**
+     * @brief Componente que ocupa una posición de la jerarquía plana.
+     */
+    inline CComponent_Transform* HierarchyOwner(uint position)
+    {
+      return order_owner[position];
+    }
+
+    /**
+     * @brief Rango de descendientes de una transformación.
+     *
+     * No reconstruye la jerarquía: se reconstruye una vez por iteración, en CComponent_Transform::UpdateWorldMatrices(). Reconstruirla aquí haría
+     * cuadrático un bucle que alterne cambios de padre y operaciones recursivas.
+     *
+     * @param index Índice de datos de la transformación (véase CComponent_Transform::GetDataIndex()).
+     * @param begin Primera posición de la jerarquía plana con un descendiente.
+     * @param end Posición siguiente al último descendiente. Si no hay descendientes, begin == end.
+     * @return Devuelve false si la transformación no está en la jerarquía, o si la jerarquía ha cambiado (véase HierarchyDirty()).
+     */
+    bool Subtree(uint index, uint& begin, uint& end);
+};
+
 /**
- * @brief Componente de transformacin.
+ * @brief Componente de transformación.
  *
- * El componente de transformacin representa la posicin, la orientacin y la escala de nuestro objeto en el mundo.
+ * El componente de transformación representa la posición, la orientación y la escala de nuestro objeto en el mundo.
  *
  * @image html components/transform/transform.jpg
  *
@@ -26,39 +239,41 @@
  vector3f angle;
  vector3f scale;
  @endcode
- * Esto nos permite operar de forma sencilla sobre esos valores, con operaciones del tipo traslacin, rotacin y escalado (locales al eje actual del objeto, y globales (con respecto al eje X, Y, Z).
+ * Esto nos permite operar de forma sencilla sobre esos valores, con operaciones del tipo traslación, rotación y escalado (locales al eje actual del objeto, y globales (con respecto al eje X, Y, Z).
  *
- * No obstante, la representacin de estos valores (en concreto, la orientacin con "angle") daba una serie de problemas.
+ * No obstante, la representación de estos valores (en concreto, la orientación con "angle") daba una serie de problemas.
  * Uno de ellos era un manejo lento, complicado, pesado y poco eficiente. De cara al usuario, trabajar con grados sobre los ejes X, Y, Z
- * (ngulos de Euler) era muy cmodo, pero de cara al sistema, lento. Adems, hay un fenmeno muy molesto llamado "Gimbal lock",
- * que, dada una combinacin de rotaciones en los ejes X, Y, Z, se anula una componente de las rotaciones (es decir, rotando en 2 ejes distintos,
- * el objeto rota sobre el mismo eje en nuestro mundo). Como esto es chapuza problemtica, he decidido buscar una mejor solucin.
+ * (ángulos de Euler) era muy cómodo, pero de cara al sistema, lento. Además, hay un fenómeno muy molesto llamado "Gimbal lock",
+ * que, dada una combinación de rotaciones en los ejes X, Y, Z, se anula una componente de las rotaciones (es decir, rotando en 2 ejes distintos,
+ * el objeto rota sobre el mismo eje en nuestro mundo). Como esto es chapuza problemática, he decidido buscar una mejor solución.
  *
  * @image html components/transform/gimbal-2.gif
  *
  * En todos los sitios relacionados al desarrollo de videojuegos hablaban de los cuaterniones, y lo
  * peor es que hablaban mal de ellos, como una pesadilla, lo cual me empujaba a buscar otras soluciones.
- * Despus de numerosos intentos fallidos, he decidido usar los cuaterniones para la representacin interna de la orientacin de un objeto.
- * As, evitamos el efecto Gimbal lock y ganamos en eficiencia para hacer rotaciones (simplemente toca multiplicar la matriz MODELVIEW actual por la matriz generada por el cuaternin actual).
+ * Después de numerosos intentos fallidos, he decidido usar los cuaterniones para la representación interna de la orientación de un objeto.
+ * Así, evitamos el efecto Gimbal lock y ganamos en eficiencia para hacer rotaciones (simplemente toca multiplicar la matriz MODELVIEW actual por la matriz generada por el cuaternión actual).
  *
- * No obstante, como esta representacin es bastante confusa, tenemos una simple solucin:
+ * No obstante, como esta representación es bastante confusa, tenemos una simple solución:
  *
- * - De cara al sistema, se trabajar con cuaterniones con pura eficiencia.
- * - De cara al usuario (el que programar sus juegos), se le dar la posibilidad de trabajar con ngulos de Euler
- *    (intuitivos y lentos) o cuaterniones (rpidos). No obstante, en ambos casos se trabajar de manera indirecta con el segundo sistema
- *    (en el primer caso, se pasar de ngulos de Euler a cuaterniones).
+ * - De cara al sistema, se trabajará con cuaterniones con pura eficiencia.
+ * - De cara al usuario (el que programará sus juegos), se le dará la posibilidad de trabajar con ángulos de Euler
+ *    (intuitivos y lentos) o cuaterniones (rápidos). No obstante, en ambos casos se trabajará de manera indirecta con el segundo sistema
+ *    (en el primer caso, se pasará de ángulos de Euler a cuaterniones).
  *
- * Como estos clculos son complejos, hemos decidido ampliar nuestro repositorio de libreras y utilizar "GLM"
- * (Graphics Library Maths), una librera de slo cabeceras para hacer operaciones matemticas con grficos 3D (lo usaremos para los cuaterniones, bsicamente).
- * Seguramente, usemos varias funciones de esta librera para "inflar" nuestro sistema "CSystem_Math".
+ * Como estos cálculos son complejos, hemos decidido ampliar nuestro repositorio de librerías y utilizar "GLM"
+ * (Graphics Library Maths), una librería de sólo cabeceras para hacer operaciones matemáticas con gráficos 3D (lo usaremos para los cuaterniones, básicamente).
+ * Seguramente, usemos varias funciones de esta librería para "inflar" nuestro sistema "CSystem_Math".
  *
- * Por ende, ahora se representar el componente como:
+ * Por ende, ahora se representará el componente como:
  @code
  vector3f position;
  vector3f scale;
  glm::quat angle;
  @endcode
  *
+ * Estos 3 atributos son referencias a los datos guardados en CComponent_Transform_Data, por lo que se pueden seguir usando como atributos normales.
+ *
  * @see http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-17-quaternions/
  * @see http://en.wikipedia.org/wiki/Gimbal_lock
  * @see http://es.wikipedia.org/wiki/%C3%81ngulos_de_Euler
@@ -69,44 +284,64 @@ class CComponent_Transform: public CComponent
   friend class CGameObject;
   friend class CSystem_Render;
   friend class CSystem_Debug;
+  friend class CComponent_Transform_Data;
 
   friend const char* Components::component_to_string(components_t c);
   friend Components::components_t Components::string_to_component(const std::string& c);
 
+  private:
+    uint data_index; // Posición de los datos en CComponent_Transform_Data. Debe declararse antes que las referencias.
+
   public:
-    vector3f position; /**< Posicin en el espacio tridimensional. Es la posicin **local** con respecto al padre del objeto que tiene el componente. La posicin global vendr dada por la aplicacin de mtodos como ApplyParentTransform(), entre otras operaciones. */
-    vector3f scale;    /**< Escala en el espacio tridimensional. Es la escala **local** con respecto al padre del objeto que tiene el componente. La escala global vendr dada por la aplicacin de mtodos como ApplyParentTransform(), entre otras operaciones. */
-    glm::quat angle;   /**< Rotacin en el espacio tridimensional, representada por un cuaternin. Es la rotacin **local** con respecto al padre del objeto que tiene el componente. La escala global vendr dada por la aplicacin de mtodos como ApplyParentTransform(), entre otras operaciones. @warning Se recomienda no modificar este valor de manera directa a no ser que se sepa lo que est haciendo. Use SetAngle(), LRotation(), Rotate() en su defecto. @see http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-17-quaternions/ */
+    vector3f& position; /**< Posición en el espacio tridimensional. Es la posición **local** con respecto al padre del objeto que tiene el componente. La posición global vendrá dada por la aplicación de métodos como WorldMatrix(), entre otras operaciones. */
+    vector3f& scale;    /**< Escala en el espacio tridimensional. Es la escala **local** con respecto al padre del objeto que tiene el componente. La escala global vendrá dada por la aplicación de métodos como WorldMatrix(), entre otras operaciones. */
+    glm::quat& angle;   /**< Rotación en el espacio tridimensional, representada por un cuaternión. Es la rotación **local** con respecto al padre del objeto que tiene el componente. La escala global vendrá dada por la aplicación de métodos como WorldMatrix(), entre otras operaciones. @warning Se recomienda no modificar este valor de manera directa a no ser que se sepa lo que está haciendo. Use SetAngle(), LRotation(), Rotate() en su defecto. @see http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-17-quaternions/ */
 
   private:
+    glm::mat4& local_matrix;  // Caché en CComponent_Transform_Data
+    glm::mat4& world_matrix;
+    glm::mat4& normal_matrix;
+
+    // Valores con los que se calculó local_matrix. Como position, angle y scale se pueden modificar directamente,
+    // se comparan con éstos para saber si la caché sigue siendo válida.
+    vector3f last_position;
+    glm::quat last_angle;
+    vector3f last_scale;
+    bool dirty;
+
+    uint world_version;                 // Se incrementa cada vez que cambia world_matrix
+    uint parent_version;                // world_version del padre al calcular world_matrix
+    CComponent_Transform* last_parent;  // Padre al calcular world_matrix
+    uint normal_version;                // world_version al calcular normal_matrix
+
     static GLuint m_TransformVBOVertices;
     static GLuint m_TransformVBOColors;
     static GLuint m_TransformVAO;
 
     static int GetID() { return Components::transform; }
 
+    CComponent_Transform(const CComponent_Transform&) = delete;
+    CComponent_Transform& operator=(const CComponent_Transform&) = delete;
+
     void parseDebug(std::string command);
     void printDebug();
 
-  protected:
-    void ApplyParentTransform(CGameObject* parent, glm::mat4& transformMatrix);
-
   public:
     /**
-     * @brief Constructor vaco.
+     * @brief Constructor vacío.
      */
-    CComponent_Transform(){};
+    CComponent_Transform(): CComponent_Transform(NULL) {};
     /** @brief Constructor con objeto asociado.
      *
-     * Asocia al objeto pasado como argumento el componente creado. Adems, inicializa los atributos de la clase a unos ciertos valores:
+     * Asocia al objeto pasado como argumento el componente creado. Además, inicializa los atributos de la clase a unos ciertos valores:
      *
      @code
      position.x = position.y = position.z = 0;
      scale.x = scale.y = scale.z = 1.f;
-     // cuaternin iniciado por glm (sin rotacin).
+     // cuaternión iniciado por glm (sin rotación).
      @endcode
      *
-     * @param gameObject Objeto que guardar el componente.
+     * @param gameObject Objeto que guardará el componente.
      */
     CComponent_Transform(CGameObject* gameObject);
     /**
@@ -131,23 +366,35 @@ class CComponent_Transform: public CComponent
      */
     inline virtual output_t Get();
 
+    /**
+     * @brief Datos SoA de todas las transformaciones.
+     */
+    static CComponent_Transform_Data& Data();
+
+    inline uint GetDataIndex()
+    {
+      return data_index;
+    }
+
+  __COMPONENT_POOL_DECLARE(CComponent_Transform)
+
   public:
     // Movimientos locales o globales al eje x,y,z
     // Cambia mucha la cosa:
-    //    Por ejemplo, mover rotar un objeto con hijos... dnde acaban los hijos?
-    //      -> Posicin de los hijos LOCAL al padre (calculada o guardada) <- DECISIN
-    //          -> Se deber calcular de manera recursiva hacia arriba hasta llegar al mayor padre sin hijos.
-    //          -> No hace falta calcular la posicin y luego hacer la transformacin
-    //              -> Se realizarn las transformaciones recursivamente desde arriba hasta abajo, sin calcular posiciones
-    // qu tal un booleano para saber cuando se ha renderizado un hijo? As, las transformaciones se realizan en cascada de arriba a abajo, pasando por todos los hijos
-    //    -> Problematico? Y si no usamos DEPTH_TEST? Mejor dejarlo as
+    //    Por ejemplo, mover rotar un objeto con hijos... ¿dónde acaban los hijos?
+    //      -> Posición de los hijos LOCAL al padre (calculada o guardada) <- DECISIÓN
+    //          -> Se deberá calcular de manera recursiva hacia arriba hasta llegar al mayor padre sin hijos.
+    //          -> No hace falta calcular la posición y luego hacer la transformación
+    //              -> Se realizarán las transformaciones recursivamente desde arriba hasta abajo, sin calcular posiciones
+    // ¿qué tal un booleano para saber cuando se ha renderizado un hijo? Así, las transformaciones se realizan en cascada de arriba a abajo, pasando por todos los hijos
+    //    -> Problematico? Y si no usamos DEPTH_TEST? Mejor dejarlo así
 
-    // Transformaciones locales ?
+    // Transformaciones locales ¿?
     /**
-     * @brief Traslacin local.
+     * @brief Traslación local.
      *
-     * Traslada el objeto de manera local a su padre, vindose afectada por la transformacin de sus ancestros.
-     * En caso de no tener padre, se considerar traslacin global.
+     * Traslada el objeto de manera local a su padre, viéndose afectada por la transformación de sus ancestros.
+     * En caso de no tener padre, se considerará traslación global.
      *
      * @param x Unidades a trasladar en el eje x local al objeto.
      * @param y Unidades a trasladar en el eje y local al objeto.
@@ -155,10 +402,10 @@ class CComponent_Transform: public CComponent
      */
     void LTranslate(GLfloat x = 0, GLfloat y = 0, GLfloat z = 0);
     /**
-     * @brief Rotacin local.
+     * @brief Rotación local.
      *
-     * Rota el objeto de manera local a su padre, vindose afectada por la transformacin de sus ancestros.
-     * En caso de no tener padre, se considerar rotacin global.
+     * Rota el objeto de manera local a su padre, viéndose afectada por la transformación de sus ancestros.
+     * En caso de no tener padre, se considerará rotación global.
      *
      * @param x Unidades a rotar en el eje x local al objeto, expresada en grados.
      * @param y Unidades a rotar en el eje y local al objeto, expresada en grados.
@@ -169,40 +416,40 @@ class CComponent_Transform: public CComponent
 
     //vector3f AxisAngles();
     /**
-     * @brief ngulos de euler.
+     * @brief Ángulos de euler.
      *
-     * Devuelve una representacin, en ngulos de Euler, del cuaternin almacenado en angle.
+     * Devuelve una representación, en ángulos de Euler, del cuaternión almacenado en angle.
      *
-     * @warning Se recomienda usar LRotation() en vez de EulerAngles(), ya que es ms intuitivo.
+     * @warning Se recomienda usar LRotation() en vez de EulerAngles(), ya que es más intuitivo.
      *
-     * @return Valor almacenado en angle como un vector de 3 componentes, siendo los ngulos de Euler.
+     * @return Valor almacenado en angle como un vector de 3 componentes, siendo los ángulos de Euler.
      *
      * @see http://es.wikipedia.org/wiki/%C3%81ngulos_de_Euler
      */
     vector3f EulerAngles();
 
-    // Problemtica: Rotaciones locales y globales: las rotaciones "globales" funcionan como pseudolocales
-    //  -> Usar cuaterniones, ya que la rotacin de un eje altera el resto de ejes.
-    // Problemtica: Gimbal Lock
-    //  -> Usar cuaterniones en vez de ngulos de eulers, y mostrar al usuario los ngulos como ngulos de euler
+    // Problemática: Rotaciones locales y globales: las rotaciones "globales" funcionan como pseudolocales
+    //  -> Usar cuaterniones, ya que la rotación de un eje altera el resto de ejes.
+    // Problemática: Gimbal Lock
+    //  -> Usar cuaterniones en vez de ángulos de eulers, y mostrar al usuario los ángulos como ángulos de euler
     //  -> Set: Euler a Cuaterniones
     //  -> Get: Cuaterniones a Euler
-    //  -> Se trabaja internamente con cuaterniones. No se podr modificar los ngulos de euler a mano (angle.x ...), ya que internamente no existen. Se usar el set y el get exclusivamente.
+    //  -> Se trabaja internamente con cuaterniones. No se podrá modificar los ángulos de euler a mano (angle.x ...), ya que internamente no existen. Se usará el set y el get exclusivamente.
     //  -> http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-17-quaternions/
     //     - Nota: se puede usar glRotatef con un cuaternion?
 
     /**
-     * @brief Traslacin global.
+     * @brief Traslación global.
      *
-     * Traslada el objeto de manera global, movindose sobre los ejes x,y,z globales (movimiento libre por el mundo), con respecto al padre.
+     * Traslada el objeto de manera global, moviéndose sobre los ejes x,y,z globales (movimiento libre por el mundo), con respecto al padre.
      *
      * @param v Vector de unidades a trasladar en los ejes globales.
      */
     void Translate(vector3f v);
     /**
-     * @brief Traslacin global.
+     * @brief Traslación global.
      *
-     * Traslada el objeto de manera global, movindose sobre los ejes x,y,z globales (movimiento libre por el mundo), con respecto al padre.
+     * Traslada el objeto de manera global, moviéndose sobre los ejes x,y,z globales (movimiento libre por el mundo), con respecto al padre.
      *
      * @param x Unidades a trasladar en el eje x global.
      * @param y Unidades a trasladar en el eje y global.
@@ -210,27 +457,27 @@ class CComponent_Transform: public CComponent
      */
     void Translate(GLfloat x = 0, GLfloat y = 0, GLfloat z = 0);
     /**
-     * @brief Cambiar posicin global, con respecto al padre.
+     * @brief Cambiar posición global, con respecto al padre.
      *
-     * Cambia la posicin del objeto, que depende de la transformacin de sus ancestros. Por ejemplo, si se cambiase a *(0, 0, 0)*, se colocara en el mismo sitio en el que su padre.
-     * En caso de no tener padre, se considerar posicin global.
+     * Cambia la posición del objeto, que depende de la transformación de sus ancestros. Por ejemplo, si se cambiase a *(0, 0, 0)*, se colocaría en el mismo sitio en el que su padre.
+     * En caso de no tener padre, se considerará posición global.
      *
-     * @param v Vector que representa la nueva posicin local al padre.
+     * @param v Vector que representa la nueva posición local al padre.
      */
     void SetPosition(vector3f v);
     /**
-     * @brief Cambiar posicin global, con respecto al padre.
+     * @brief Cambiar posición global, con respecto al padre.
      *
-     * Cambia la posicin del objeto, que depende de la transformacin de sus ancestros. Por ejemplo, si se cambiase a *(0, 0, 0)*, se colocara en el mismo sitio en el que su padre.
-     * En caso de no tener padre, se considerar posicin global.
+     * Cambia la posición del objeto, que depende de la transformación de sus ancestros. Por ejemplo, si se cambiase a *(0, 0, 0)*, se colocaría en el mismo sitio en el que su padre.
+     * En caso de no tener padre, se considerará posición global.
      *
-     * @param x Nueva posicin en el eje x, local al padre.
-     * @param y Nueva posicin en el eje y, local al padre.
-     * @param z Nueva posicin en el eje z, local al padre.
+     * @param x Nueva posición en el eje x, local al padre.
+     * @param y Nueva posición en el eje y, local al padre.
+     * @param z Nueva posición en el eje z, local al padre.
      */
     void SetPosition(GLfloat x = 0, GLfloat y = 0, GLfloat z = 0);
     /**
-     * @brief Rotacin global.
+     * @brief Rotación global.
      *
      * Rota el objeto de manera global, rotando sobre los ejes x,y,z globales (movimiento libre por el mundo), con respecto al padre.
      *
@@ -238,7 +485,7 @@ class CComponent_Transform: public CComponent
      */
     void Rotate(vector3f v);
     /**
-     * @brief Rotacin global.
+     * @brief Rotación global.
      *
      * Rota el objeto de manera global, rotando sobre los ejes x,y,z globales (movimiento libre por el mundo), con respecto al padre.
      *
@@ -248,23 +495,23 @@ class CComponent_Transform: public CComponent
      */
     void Rotate(GLfloat x = 0, GLfloat y = 0, GLfloat z = 0);
     /**
-     * @brief Cambiar rotacin  global, con respecto al padre.
+     * @brief Cambiar rotación  global, con respecto al padre.
      *
-     * Cambia la rotacin del objeto, que depende de la rotacin de sus ancestros. Por ejemplo, si se cambiase a *(0, 0, 0)*, se rotara a la misma orientacin que su padre.
-     * En caso de no tener padre, se considerar rotacin global.
+     * Cambia la rotación del objeto, que depende de la rotación de sus ancestros. Por ejemplo, si se cambiase a *(0, 0, 0)*, se rotaría a la misma orientación que su padre.
+     * En caso de no tener padre, se considerará rotación global.
      *
-     * @param v Vector que representa la nueva rotacin local al padre.
+     * @param v Vector que representa la nueva rotación local al padre.
      */
     void SetAngle(vector3f v);
     /**
-     * @brief Cambiar rotacin  global, con respecto al padre.
+     * @brief Cambiar rotación  global, con respecto al padre.
      *
-     * Cambia la rotacin del objeto, que depende de la rotacin de sus ancestros. Por ejemplo, si se cambiase a *(0, 0, 0)*, se rotara a la misma orientacin que su padre.
-     * En caso de no tener padre, se considerar rotacin global.
+     * Cambia la rotación del objeto, que depende de la rotación de sus ancestros. Por ejemplo, si se cambiase a *(0, 0, 0)*, se rotaría a la misma orientación que su padre.
+     * En caso de no tener padre, se considerará rotación global.
      *
-     * @param x Nueva rotacin en el eje x, local al padre, expresada en grados.
-     * @param y Nueva rotacin en el eje y, local al padre, expresada en grados.
-     * @param z Nueva rotacin en el eje z, local al padre, expresada en grados.
+     * @param x Nueva rotación en el eje x, local al padre, expresada en grados.
+     * @param y Nueva rotación en el eje y, local al padre, expresada en grados.
+     * @param z Nueva rotación en el eje z, local al padre, expresada en grados.
      */
     void SetAngle(GLfloat x = 0, GLfloat y = 0, GLfloat z = 0);
     /**
@@ -292,8 +539,8 @@ class CComponent_Transform: public CComponent
     /**
      * @brief Cambiar escala  global, con respecto al padre.
      *
-     * Cambia la escala del objeto, que depende de la transformacin de sus ancestros. Por ejemplo, si se cambiase a *(1, 1, 1)*, se escalara a igual escala que su padre.
-     * En caso de no tener padre, se considerar escala global.
+     * Cambia la escala del objeto, que depende de la transformación de sus ancestros. Por ejemplo, si se cambiase a *(1, 1, 1)*, se escalaría a igual escala que su padre.
+     * En caso de no tener padre, se considerará escala global.
      *
      * @param v Vector que representa la nueva escala local al padre.
      */
@@ -301,8 +548,8 @@ class CComponent_Transform: public CComponent
     /**
      * @brief Cambiar escala  global, con respecto al padre.
      *
-     * Cambia la escala del objeto, que depende de la transformacin de sus ancestros. Por ejemplo, si se cambiase a *(1, 1, 1)*, se escalara a igual escala que su padre.
-     * En caso de no tener padre, se considerar escala global.
+     * Cambia la escala del objeto, que depende de la transformación de sus ancestros. Por ejemplo, si se cambiase a *(1, 1, 1)*, se escalaría a igual escala que su padre.
+     * En caso de no tener padre, se considerará escala global.
      *
      * @param x Nueva escala en el eje x, local al padre.
      * @param y Nueva escala en el eje y, local al padre.
@@ -311,11 +558,11 @@ class CComponent_Transform: public CComponent
     void SetScale(GLfloat x = 1.f, GLfloat y = 1.f, GLfloat z = 1.f);
 
     /**
-     * @brief Apuntar a una posicin
+     * @brief Apuntar a una posición
      *
-     * Dado un punto en el espacio (global), se ajustar el objeto para que sus componentes apunten al punto determinado.
+     * Dado un punto en el espacio (global), se ajustará el objeto para que sus componentes apunten al punto determinado.
      *
-     * @warning Se modificarn todos los ejes del objeto para apuntar. En caso de no querer usar uno, se debe deshacer de forma
+     * @warning Se modificarán todos los ejes del objeto para apuntar. En caso de no querer usar uno, se debe deshacer de forma
      * manual con SetAngle(), quitando la/s componente/s deseada/s, y dejando las que resten.
      *
      * @param target Punto en el espacio, representado como un vector *(x, y, z)*.
@@ -324,11 +571,11 @@ class CComponent_Transform: public CComponent
      */
     void LookAt(vector3f target, vector3f up_vector = gMath.Y_AXIS, vector3f forward_vector = gMath.Z_AXIS);
     /**
-     * @brief Apuntar a una posicin
+     * @brief Apuntar a una posición
      *
-     * Dado un punto en el espacio (global), se ajustar el objeto para que sus componentes apunten al punto determinado.
+     * Dado un punto en el espacio (global), se ajustará el objeto para que sus componentes apunten al punto determinado.
      *
-     * @warning Se modificarn todos los ejes del objeto para apuntar. En caso de no querer usar uno, se debe deshacer de forma
+     * @warning Se modificarán todos los ejes del objeto para apuntar. En caso de no querer usar uno, se debe deshacer de forma
      * manual con SetAngle(), quitando la/s componente/s deseada/s, y dejando las que resten.
      *
      * @param x Coordenada x del punto a mirar.
@@ -340,24 +587,109 @@ class CComponent_Transform: public CComponent
     void LookAt(GLfloat x, GLfloat y, GLfloat z, vector3f up_vector = gMath.Y_AXIS, vector3f forward_vector = gMath.Z_AXIS);
 
     /**
-     * @brief Aplicar transformacin a una matriz de transformacin.
+     * @brief Matriz de mundo.
+     *
+     * Devuelve la transformación del objeto (posición, rotación y escala, en ese orden) aplicada sobre la de sus ancestros.
+     *
+     * La matriz local y la de mundo se guardan en caché: la local sólo se recalcula si han cambiado position, angle o scale, y la de mundo
+     * sólo si ha cambiado la local o la de mundo del padre. Comprobar la caché cuesta unas pocas comparaciones por ancestro.
+     *
+     * El sistema "transforms" de CSystem_Scheduler actualiza todas las matrices una vez por iteración, después de "behaviours", así que
+     * el resto de sistemas (render, con todas sus cámaras, partículas, sonido...) sólo leen la caché.
+     *
+     * @warning Si la caché no es válida, esta función la escribe (también la de los ancestros). Desde objetos paralelos
+     * (CGameObject::SetParallel()) no se debe consultar la transformación de otros objetos que se modifiquen en la misma iteración.
+     *
+     * @return Matriz de mundo. La referencia es válida mientras exista el componente.
+     */
+    const glm::mat4& WorldMatrix();
+
+    /**
+     * @brief Matriz normal.
+     *
+     * Inversa traspuesta de WorldMatrix(), para transformar normales. Se guarda en caché junto a la matriz de mundo.
+     * Para obtener la matriz normal vista desde una cámara, basta con multiplicarla por CComponent_Camera::NormalMatrix().
+     *
+     * @return Matriz normal. La referencia es válida mientras exista el componente.
+     */
+    const glm::mat4& NormalMatrix();
+
+    /**
+     * @brief Matriz de mundo guardada en caché, sin comprobar si sigue siendo válida.
+     *
+     * No escribe nada, así que se puede llamar desde varios hilos a la vez. Es válida después de UpdateWorldMatrices() hasta que se mueva algún
+     * objeto: CSystem_Render la actualiza antes de lanzar las tareas de grabación, que sólo usan estas funciones.
+     */
+    inline const glm::mat4& CachedWorldMatrix()
+    {
+      return world_matrix;
+    }
+
+    /**
+     * @brief Matriz normal guardada en caché, sin comprobar si sigue siendo válida (véase CachedWorldMatrix()).
+     */
+    inline const glm::mat4& CachedNormalMatrix()
+    {
+      return normal_matrix;
+    }
+
+    /**
+     * @brief Versión de la matriz de mundo.
      *
-     * Aplica los datos del componente (posicin, rotacin y escala, en ese orden) y la de sus ancentros, empezando por el primero, y
-     * acabando en el objeto actual, para generar una matriz modelview, usada internamente por openGL.
+     * Aumenta cada vez que cambia WorldMatrix(). Sirve para guardar en caché datos que dependan de ella (p.ej. volúmenes envolventes en espacio de mundo).
+     */
+    inline uint WorldVersion()
+    {
+      WorldMatrix();
+      return world_version;
+    }
+
+    /**
+     * @brief Avisar de que el volumen envolvente del objeto ha cambiado sin que cambie su matriz de mundo.
+     *
+     * CSystem_Spatial lo actualizará en la siguiente iteración. Se llama automáticamente al añadir o quitar componentes;
+     * hay que llamarlo a mano tras cambiar CComponent_Mesh_Render::mesh_name de un objeto que no se mueve.
+     */
+    inline void BoundsChanged()
+    {
+      Data().Moved(data_index);
+    }
+
+    /**
+     * @brief Actualizar todas las matrices de mundo.
+     *
+     * Recorre la jerarquía plana de CComponent_Transform_Data de forma lineal (los padres antes que los hijos) y actualiza la caché de cada transformación.
+     * Las matrices locales, los productos por la matriz del padre y las matrices normales se calculan en lotes con los kernels de SIMD.
+     * Lo llama el sistema "transforms" de CSystem_Scheduler.
+     */
+    static void UpdateWorldMatrices();
+
+  protected:
+    CComponent_Transform* ParentTransform();
+
+    bool LocalChanged();
+    void SaveLocal();
+    bool UpdateLocal();
+    void UpdateWorld(CComponent_Transform* parent_transform);
+
+  public:
+
+    /**
+     * @brief Aplicar transformación a una matriz de transformación.
      *
-     * No es necesario usarla, pero puede ser til en algunos casos muy particulares.
+     * Multiplica la matriz dada por la matriz de mundo del componente (véase WorldMatrix()), para generar una matriz modelview, usada internamente por openGL.
      *
-     * @param modelviewMatrix Matriz actual (por ejemplo, generada por la cmara).
+     * @param modelviewMatrix Matriz actual (por ejemplo, generada por la cámara).
      * @return Devuelve la matriz "modelviewMatrix" transformada por las componentes descritas anteriormente.
      */
     glm::mat4 ApplyTransform(const glm::mat4& modelviewMatrix);
 
     /**
-     * @brief Normalizar ngulos.
+     * @brief Normalizar ángulos.
      *
-     * Normaliza los ngulos.
+     * Normaliza los ángulos.
      *
-     * @deprecated Al usar cuaterniones, esta funcin deja de tener sentido. No es conveniente usarla en ningn momento.
+     * @deprecated Al usar cuaterniones, esta función deja de tener sentido. No es conveniente usarla en ningún momento.
      */
     inline void NormalizeAngles()
     {
@@ -373,104 +705,104 @@ class CComponent_Transform: public CComponent
     /**
      * @brief Vector hacia "arriba" del componente.
      *
-     * Dada una rotacin por angle, se generar un vector que simule la direccin "arriba" para ese objeto rotado (eje y local).
+     * Dada una rotación por angle, se generará un vector que simule la dirección "arriba" para ese objeto rotado (eje y local).
      *
-     * @bug No se tiene en cuenta a los padres para este clculo.
+     * @bug No se tiene en cuenta a los padres para este cálculo.
      *
-     * @return Vector *(0.f, 1.f, 0.f)* rotado por la rotacin scale.
+     * @return Vector *(0.f, 1.f, 0.f)* rotado por la rotación scale.
      */
     vector3f up();
     /**
      * @brief Vector hacia la "izquierda" del componente.
      *
-     * Dada una rotacin por angle, se generar un vector que simule la direccin "izquierda" para ese objeto rotado (eje x local).
+     * Dada una rotación por angle, se generará un vector que simule la dirección "izquierda" para ese objeto rotado (eje x local).
      *
-     * @bug No se tiene en cuenta a los padres para este clculo.
+     * @bug No se tiene en cuenta a los padres para este cálculo.
      *
-     * @return Vector *(1.f, 0.f, 0.f)* rotado por la rotacin scale.
+     * @return Vector *(1.f, 0.f, 0.f)* rotado por la rotación scale.
      */
     vector3f left();
     /**
      * @brief Vector hacia "adelante" del componente.
      *
-     * Dada una rotacin por angle, se generar un vector que simule la direccin "adelante" para ese objeto rotado (eje z local).
+     * Dada una rotación por angle, se generará un vector que simule la dirección "adelante" para ese objeto rotado (eje z local).
      *
-     * @bug No se tiene en cuenta a los padres para este clculo.
+     * @bug No se tiene en cuenta a los padres para este cálculo.
      *
-     * @return Vector *(0.f, 0.f, 1.f)* rotado por la rotacin scale.
+     * @return Vector *(0.f, 0.f, 1.f)* rotado por la rotación scale.
      */
     vector3f forward();
 
     /**
      * @brief Alabeo.
      *
-     * Retorna la rotacin local en el eje Z.
+     * Retorna la rotación local en el eje Z.
      *
      * @image html components/transform/pyr1.jpg
      *
      * @image html components/transform/pyr2.jpg
      *
-     * @return ngulo, expresado en grados, de la rotacin del eje Z del componente.
+     * @return Ángulo, expresado en grados, de la rotación del eje Z del componente.
      */
     GLfloat pitch();
     /**
-     * @brief Guiada.
+     * @brief Guiñada.
      *
-     * Retorna la rotacin local en el eje Y.
+     * Retorna la rotación local en el eje Y.
      *
      * @image html components/transform/pyr1.jpg
      *
      * @image html components/transform/pyr2.jpg
      *
-     * @return ngulo, expresado en grados, de la rotacin del eje Y del componente.
+     * @return Ángulo, expresado en grados, de la rotación del eje Y del componente.
      */
     GLfloat yaw();
     /**
      * @brief Cabeceo.
      *
-     * Retorna la rotacin local en el eje X.
+     * Retorna la rotación local en el eje X.
      *
      * @image html components/transform/pyr1.jpg
      *
      * @image html components/transform/pyr2.jpg
      *
-     * @return ngulo, expresado en grados, de la rotacin del eje X del componente.
+     * @return Ángulo, expresado en grados, de la rotación del eje X del componente.
      */
     GLfloat roll();
 
     /**
-     * @brief Rotacin global.
+     * @brief Rotación global.
      *
-     * Devuelve la rotacin global del objeto, aplicando las rotaciones de los padres (si los hubiese).
+     * Devuelve la rotación global del objeto, aplicando las rotaciones de los padres (si los hubiese).
      *
-     * @return Vector de 3 componentes, expresadas en grados, de la rotacin global del objeto.
+     * @return Vector de 3 componentes, expresadas en grados, de la rotación global del objeto.
      */
     vector3f Rotation();
     /**
-     * @brief Rotacin local.
+     * @brief Rotación local.
      *
-     * Devuelve la rotacin local del objeto a su padre. Si no hay padre, la rotacin se considerar global.
-     * Este mtodo es idntico a obtener pitch(), yaw() y roll().
+     * Devuelve la rotación local del objeto a su padre. Si no hay padre, la rotación se considerará global.
+     * Este método es idéntico a obtener pitch(), yaw() y roll().
      *
-     * @return Vector de 3 componentes, expresadas en grados, de la rotacin local del objeto.
+     * @return Vector de 3 componentes, expresadas en grados, de la rotación local del objeto.
      */
     vector3f LRotation();  // Pitch, yaw, roll
 
     /**
-     * @brief Posicin global.
+     * @brief Posición global.
      *
-     * Devuelve la posicin global del objeto, aplicando las transformaciones de los padres (si los hubiese).
+     * Devuelve la posición global del objeto, aplicando las transformaciones de los padres (si los hubiese).
      *
-     * @return Vector de 3 componentes de la posicin global del objeto.
+     * @return Vector de 3 componentes de la posición global del objeto.
      */
     vector3f_t Position();
     /**
-     * @brief Posicin local.
+     * @brief Posición local.
      *
-     * Devuelve la posicin local del objeto a su padre. Si no hay padre, la posicin se considerar global.
-     * Es idntico a acceder al atributo position.
+     * Devuelve la posición local del objeto a su padre. Si no hay padre, la posición se considerará global.
+     * Es idéntico a acceder al atributo position.
      *
-     * @return Vector de 3 componentes de la posicin local del objeto.
+     * @return Vector de 3 componentes de la posición local del objeto.
      */
     vector3f_t LPosition()
     {
@@ -15,22 +15,22 @@
 /*@{*/
 
 /**
- * @brief Motor grfico.
+ * @brief Motor gráfico.
  *
  * Representa el conjunto de estancias del juego (los sistemas van aparte).
- * En este caso, el motor grfico se encargar de gestionar la ejecucin y flujo principal del
- * juego. En caso de un cambio de nivel o de estancia (CInstance), ser esta clase la encargada de
+ * En este caso, el motor gráfico se encargará de gestionar la ejecución y flujo principal del
+ * juego. En caso de un cambio de nivel o de estancia (CInstance), será esta clase la encargada de
  * gestionar dicho cambio.
  *
- * El objeto de esta clase (gEngine), ser el encargado de gestionar las estancias (CInstance) o niveles.
+ * El objeto de esta clase (gEngine), será el encargado de gestionar las estancias (CInstance) o niveles.
  * Para ello, dispone de un mapa de estancias, cada una caracterizada por un nombre (string). Desde cualquier
- * estancia, sabiendo el nombre de alguna otra, se podr pedir un cambio de estancia, simulando un
- * cambio de nivel, por lo que se cargarn nuevos recursos, nuevos objetos, se reiniciarn sistemas, etc.
+ * estancia, sabiendo el nombre de alguna otra, se podrá pedir un cambio de estancia, simulando un
+ * cambio de nivel, por lo que se cargarán nuevos recursos, nuevos objetos, se reiniciarán sistemas, etc.
  *
- * @note **Nota**: en caso de querer aadir soporte multihilo, solo bastara con modificar parte e esta clase, y parte de CInstance,
- * @note por lo que no debera de haber grandes cambios.
+ * @note **Nota**: en caso de querer añadir soporte multihilo, solo bastaría con modificar parte e esta clase, y parte de CInstance,
+ * @note por lo que no debería de haber grandes cambios.
  *
- * @warning sese el objeto gEngine para utilizar los mtodos de este clase, para que repercutan en tiempo de ejecucin.
+ * @warning Úsese el objeto gEngine para utilizar los métodos de este clase, para que repercutan en tiempo de ejecución.
  *
  * @see gEngine
  * @see CInstance
@@ -55,25 +55,25 @@ class CEngine
     /**
      * @brief Constructor.
      *
-     * Construye el motor grfico, y pone de ttulo a la ventana "GO-Engine".
+     * Construye el motor gráfico, y pone de título a la ventana "GO-Engine".
      */
     CEngine();
     /**
      * @brief Destructor.
      *
-     * Destruye el motor grfico.
+     * Destruye el motor gráfico.
      */
     virtual ~CEngine(){};
 
     /**
      * @brief Iniciar el motor.
      *
-     * Inicia el motor grfico, por lo que iniciar *SDL2*, los sistemas definidos e iniciar las funciones
-     * User_Engine_Loader() (icono, ttulo, etc.) y User_Instance_Loader() (cargar estancias). Adems, esta clase
-     * conservar los argumentos pasados al programa. Ser llamado al iniciar OnExecute().
+     * Inicia el motor gráfico, por lo que iniciará *SDL2*, los sistemas definidos e iniciará las funciones
+     * User_Engine_Loader() (icono, título, etc.) y User_Instance_Loader() (cargar estancias). Además, esta clase
+     * conservará los argumentos pasados al programa. Será llamado al iniciar OnExecute().
      *
-     * @param argc Cantidad de argumentos del programa. Se corresponde por el argumento definido por la funcin main().
-     * @param argv Array de argumentos del programa. Se corresponde por el argumento definido por la funcin main().
+     * @param argc Cantidad de argumentos del programa. Se corresponde por el argumento definido por la función main().
+     * @param argv Array de argumentos del programa. Se corresponde por el argumento definido por la función main().
      * @return Retorna true si se inicia correctamente, false en caso contrario.
      *
      * @see CSystem
@@ -84,21 +84,21 @@ class CEngine
     /**
      * @brief Cerrar el motor.
      *
-     * Cierra el motor grfico, cerrando la librera *SDL2*, cerrando los sitemas, y eliminando todas las estancias.
-     * Ser llamado al acabar OnExecute().
+     * Cierra el motor gráfico, cerrando la librería *SDL2*, cerrando los sitemas, y eliminando todas las estancias.
+     * Será llamado al acabar OnExecute().
      */
     virtual void Close();
 
     /**
-     * @brief Comenzar ejecucin
+     * @brief Comenzar ejecución
      *
-     * Comienza la ejecucin del motor grfico. Primero el motor con Init(), y luego ejecuta la primer estancia aadida con la funcin
-     * AddInstance(), usada desde User_Instance_Loader(). Finalmente, despus de haber ejecutado las estancias necesarias, se cerrar el motor, llamando
-     * a la funcin close. Ser llamado desde la funcin main().
+     * Comienza la ejecución del motor gráfico. Primero el motor con Init(), y luego ejecuta la primer estancia añadida con la función
+     * AddInstance(), usada desde User_Instance_Loader(). Finalmente, después de haber ejecutado las estancias necesarias, se cerrará el motor, llamando
+     * a la función close. Será llamado desde la función main().
      *
-     * @param argc Cantidad de argumentos. Procedente de la funcin main().
-     * @param argv Argumentos. Procedente de la funcin main().
-     * @return Estado de ejecucin. Retorna siempre 0.
+     * @param argc Cantidad de argumentos. Procedente de la función main().
+     * @param argv Argumentos. Procedente de la función main().
+     * @return Estado de ejecución. Retorna siempre 0.
      */
     virtual int OnExecute(int argc, char* argv[]);
 
@@ -106,18 +106,18 @@ class CEngine
     /**
      * @brief Cambiar icono del motor.
      *
-     * Cambia el icono del motor grfico por uno personalizado. Debe ser una imagen de tamao 32x32, con formato RGBA, preferiblemente en formato tga.
+     * Cambia el icono del motor gráfico por uno personalizado. Debe ser una imagen de tamaño 32x32, con formato RGBA, preferiblemente en formato tga.
      * Se debe especificar la ruta completa al icono, por lo general, debe estar en data/engine
      * @param icon_name
      */
     void SetIcon(std::string icon_name);
 
     /**
-     * @brief Obtener ttulo.
+     * @brief Obtener título.
      *
-     * Devuelve el ttulo del motor grfico (ttulo de la ventana).
+     * Devuelve el título del motor gráfico (título de la ventana).
      *
-     * @return String que contiene el ttulo de la ventana.
+     * @return String que contiene el título de la ventana.
      */
     std::string GetTitle()
     {
@@ -125,10 +125,10 @@ class CEngine
     }
 
     /**
-     * @brief Cambiar ttulo.
+     * @brief Cambiar título.
      *
-     * Cambia el ttulo de la ventana de la aplicacin.
-     * @param text Nuevo ttulo.
+     * Cambia el título de la ventana de la aplicación.
+     * @param text Nuevo título.
      */
     void SetTitle(const char* text)
     {
@@ -139,24 +139,24 @@ class CEngine
     }
 
     /**
-     * @brief Aadir una nueva estancia.
+     * @brief Añadir una nueva estancia.
      *
-     * Esta funcin aade una nueva estancia al motor grfico, dada una funcin **callback** del formato
+     * Esta función añade una nueva estancia al motor gráfico, dada una función **callback** del formato
      @code
      bool callback(void);
      @endcode
      *
-     * dado un nombre de estancia (identificador nico) y la ruta a un fichero de recursos, con extensin .rc, que
-     * contendr los recursos necesarios para la estancia (sonidos, modelos, texturas...), generalmente en
-     * la ruta <i>/data/resources</i>. El identificador de estancia ser usado para hacer referencia a otras
-     * estancias (cargar el "nivel2" desde el *"nivel1"*), y el callback se usar para **cargar los objetos de dicha estancia**.
-     * Vanse los ejemplos de prueba de la carpeta "user".
+     * dado un nombre de estancia (identificador único) y la ruta a un fichero de recursos, con extensión .rc, que
+     * contendrá los recursos necesarios para la estancia (sonidos, modelos, texturas...), generalmente en
+     * la ruta <i>/data/resources</i>. El identificador de estancia será usado para hacer referencia a otras
+     * estancias (cargar el "nivel2" desde el *"nivel1"*), y el callback se usará para **cargar los objetos de dicha estancia**.
+     * Véanse los ejemplos de prueba de la carpeta "user".
      *
-     * @warning La primera estancia aadida ser la primera estancia cargada del programa.
+     * @warning La primera estancia añadida será la primera estancia cargada del programa.
      *
-     * @param load_gameObject_function Callback de la funcin para cargar los objetos de juego. Debe ser del tipo *bool callback(void)*
+     * @param load_gameObject_function Callback de la función para cargar los objetos de juego. Debe ser del tipo *bool callback(void)*
      * @param resource_file Ruta al fichero de recursos a cargar para dicha estancia. Si es "" o el fichero no existe, se asume que la estancia no usa recursos (absurdo).
-     * @param instance_name Nombre de la estancia. Debe ser un identificador nico.
+     * @param instance_name Nombre de la estancia. Debe ser un identificador único.
      *
      * @see user/include/gameObjects.h
      * @see user/src/gameObjects.cpp
@@ -169,8 +169,8 @@ class CEngine
     /**
      * @brief Fotogramas por segundo.
      *
-     * Retorna la cantidad de fotogramas por segundo. Ser calculado cada 10 milisegundos.
-     * @return Fotogramas por segundo de los ltimos 10 milisegundos.
+     * Retorna la cantidad de fotogramas por segundo. Será calculado cada 10 milisegundos.
+     * @return Fotogramas por segundo de los últimos 10 milisegundos.
      */
     GLdouble fps()
     {
@@ -180,8 +180,8 @@ class CEngine
     /**
      * @brief Instancia ejecutada actualmente.
      *
-     * Devuelve un puntero del tipo CInstance que apunta a la estancia que est siendo ejecutada actualmente.
-     * Es mejor usar GetCurrentInstance() si slo se desea saber el nombre.
+     * Devuelve un puntero del tipo CInstance que apunta a la estancia que está siendo ejecutada actualmente.
+     * Es mejor usar GetCurrentInstance() si sólo se desea saber el nombre.
      *
      * @see CInstance
      * @return Puntero a la estancia ejecutada actualmente.
@@ -195,8 +195,8 @@ class CEngine
      * @brief Argumentos del programa.
      *
      * Obtener una referencia a un vector de argumentos (string) pasados al programa como argumentos.
-     * Puede ser de utilidad para ciertos casos (depuracin, etc). Si un argumento empieza por un "-",
-     * ser ejecutado como un comando de consola despus de haber cargado los sistemas, y antes de
+     * Puede ser de utilidad para ciertos casos (depuración, etc). Si un argumento empieza por un "-",
+     * será ejecutado como un comando de consola después de haber cargado los sistemas, y antes de
      * haber cargado la primera estancia.
      *
      * @return Referencia a un vector de argumentos.
@@ -209,13 +209,13 @@ class CEngine
     // Exits without saving.
     // Should never be used
     /**
-     * @brief Abortar la ejecucin.
+     * @brief Abortar la ejecución.
      *
-     * Aborta la ejecucin del programa, terminando bruscamente en cuanto es llamada. Esto hace que los sistemas,
-     * objetos, recursos... no sean liberados correctamente. Si se quiere terminar la ejecucin correctamente,
+     * Aborta la ejecución del programa, terminando bruscamente en cuanto es llamada. Esto hace que los sistemas,
+     * objetos, recursos... no sean liberados correctamente. Si se quiere terminar la ejecución correctamente,
      * use Exit().
      *
-     * @warning No debe de usar esta funcin salvo que sea estrictamente necesario (fallos drsticos).
+     * @warning No debe de usar esta función salvo que sea estrictamente necesario (fallos drásticos).
      */
     void Abort()
     {
@@ -223,9 +223,9 @@ class CEngine
     }
 
     /**
-     * @brief Termina la ejecucin.
+     * @brief Termina la ejecución.
      *
-     * Termina la ejecucin del programa, terminando primero la ejecucin de la estancia actual, para posteriormente
+     * Termina la ejecución del programa, terminando primero la ejecución de la estancia actual, para posteriormente
      * liberar recursos, cerrar sistemas, etc.
      */
     void Exit()
@@ -238,7 +238,7 @@ class CEngine
     /**
      * @brief Nombre de estancia ejecutada actualmente.
      *
-     * Devuelve el identificador de la estancia que se est ejecutando actualmente.
+     * Devuelve el identificador de la estancia que se está ejecutando actualmente.
      * @return Nombre de la estancia ejecutada actualmente. En caso de que no haya ninguna cargada, devuelve "".
      */
     std::string GetCurrentInstance()
@@ -247,11 +247,11 @@ class CEngine
     }
 
     /**
-     * @brief Nombre de la estancia que ser ejecutada despus de la actual.
+     * @brief Nombre de la estancia que será ejecutada después de la actual.
      *
-     * Devuelve el identificador de la estancia que ser ejecutada despus de la actual.
+     * Devuelve el identificador de la estancia que será ejecutada después de la actual.
      *
-     * @return Nombre de la estancia que ser ejecutada despus que la actual. Si no se ha planeado ninguna con SetNextInstance, devolver "".
+     * @return Nombre de la estancia que será ejecutada después que la actual. Si no se ha planeado ninguna con SetNextInstance, devolverá "".
      */
     std::string GetNextInstance()
     {
@@ -264,7 +264,7 @@ class CEngine
     /**
      * @brief Cambiar de estancia.
      *
-     * Cambia la prxima estancia a ejecutar, y finaliza la estancia actual. Bsicamente, es un "cambio de nivel".
+     * Cambia la próxima estancia a ejecutar, y finaliza la estancia actual. Básicamente, es un "cambio de nivel".
      *
      * @param instance Nombre de la nueva estancia a ejecutar. Debe existir dicha estancia.
      */
@@ -279,9 +279,9 @@ class CEngine
     /**
      * @brief Cambiar de estancia.
      *
-     * Cambia la prxima estancia a ejecutar, pero **no** finaliza la estancia actual.
+     * Cambia la próxima estancia a ejecutar, pero **no** finaliza la estancia actual.
      *
-     * @param instance Nombre de la prxima estancia a ejecutar. Debe existir dicha estancia.
+     * @param instance Nombre de la próxima estancia a ejecutar. Debe existir dicha estancia.
      */
     void SetNextInstance(std::string instance)
     {
@@ -292,8 +292,8 @@ class CEngine
     /**
      * @brief Terminar la estancia actual.
      *
-     * Finaliza la ejecucin de la estancia actual. Si se ha definido una prxima estancia con
-     * SetNextInstance(), se ejecutar dicha estancia. En caso contrario, finalizar la ejecucin del motor grfico.
+     * Finaliza la ejecución de la estancia actual. Si se ha definido una próxima estancia con
+     * SetNextInstance(), se ejecutará dicha estancia. En caso contrario, finalizará la ejecución del motor gráfico.
      */
     void EndInstance()
     {
@@ -302,9 +302,9 @@ class CEngine
 };
 
 /**
- * @brief Objeto global del motor grfico.
+ * @brief Objeto global del motor gráfico.
  *
- * Para referirse al motor, basta con usar este objeto. Debe ser el nico objeto de su tipo.
+ * Para referirse al motor, basta con usar este objeto. Debe ser el único objeto de su tipo.
  *
  * @see CEngine
  */
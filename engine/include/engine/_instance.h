@@ -14,18 +14,18 @@
 /**
  * @brief Clase que representa a una estancia o nivel.
  *
- * Una estancia o nivel representa un escenario concreto de nuestra aplicacin o nivel.
- * Por ejemplo, supngase el caso en el que nuestro juego esta compuesto de varios subjuegos (3 en raya,
- * ajedrez, pker...). Cada juego podra corresponderse con una estancia, y el men de seleccin de juego
- * tambin podra considerarse una estancia o nivel.
+ * Una estancia o nivel representa un escenario concreto de nuestra aplicación o nivel.
+ * Por ejemplo, supóngase el caso en el que nuestro juego esta compuesto de varios subjuegos (3 en raya,
+ * ajedrez, póker...). Cada juego podría corresponderse con una estancia, y el menú de selección de juego
+ * también podría considerarse una estancia o nivel.
  *
- * As pues, una estancia de componene de:
- * - Una serie de objetos de juego, cargados desde el callback de carga de objetos (vase CInstance() ).
+ * Así pues, una estancia de componene de:
+ * - Una serie de objetos de juego, cargados desde el callback de carga de objetos (véase CInstance() ).
  * - Una serie de recursos, sean texturas, modelos, sonidos... cargados directamente desde un fichero de recursos *.rc*.
- * - Una prxima estancia a ejecutar (si no hay prxima, finaliza el juego).
+ * - Una próxima estancia a ejecutar (si no hay próxima, finaliza el juego).
  *
- * Sin ms, el motor grfica u objeto gEngine se encargar de gestionar las estancias, de manera que el usuario slo
- * tiene que definirlas, definir la prxima estancia de cada una (se puede hacer de manera dinmica) y estblecer un
+ * Sin más, el motor gráfica u objeto gEngine se encargará de gestionar las estancias, de manera que el usuario sólo
+ * tiene que definirlas, definir la próxima estancia de cada una (se puede hacer de manera dinámica) y estblecer un
  * fichero de recursos a cargar.
  *
  * @see CEngine
@@ -54,7 +54,7 @@ class CInstance
       bool LoadResources();
 
     void Close();
-      void UnLoadResources(); // se descargarn los archivos cuando, al cargar los archivos de la proxima estancia, se demuestre que solo se descartaran los que no necesitan seguir en el motor
+      void UnLoadResources(); // se descargarán los archivos cuando, al cargar los archivos de la proxima estancia, se demuestre que solo se descartaran los que no necesitan seguir en el motor
 
       std::string OnExecute();
     void OnLoop();
@@ -72,11 +72,11 @@ class CInstance
     /**
      * @brief Constructor principal.
      *
-     * Crea una estancia. No debe llamarse a este constructor de manera dinmica, sino que
-     * debe ser creada por el mtodo CEngine::AddInstance(). Se caracteriza porque se le proporciona
+     * Crea una estancia. No debe llamarse a este constructor de manera dinámica, sino que
+     * debe ser creada por el método CEngine::AddInstance(). Se caracteriza porque se le proporciona
      * un callback de los objetos a crear, y un fichero de recursos.
      *
-     * @param load_gameObject_function Callback de la funcin para cargar los objetos de juego. Debe ser del tipo *bool callback(void)*
+     * @param load_gameObject_function Callback de la función para cargar los objetos de juego. Debe ser del tipo *bool callback(void)*
      * @param resource_file Ruta al fichero de recursos a cargar para dicha estancia. Si es "" o el fichero no existe, se asume que la estancia no usa recursos (absurdo).
      *
      * @see CEngine
@@ -88,7 +88,7 @@ class CInstance
     /**
      * @brief Cambiar de estancia.
      *
-     * Cambia la prxima estancia a ejecutar, y finaliza la estancia actual. Bsicamente, es un "cambio de nivel".
+     * Cambia la próxima estancia a ejecutar, y finaliza la estancia actual. Básicamente, es un "cambio de nivel".
      * Se recomienda usar CEngine::NextInstance() con gEngine.
      *
      * @param next_instance_name Nombre de la nueva estancia a ejecutar. Debe existir dicha estancia.
@@ -100,10 +100,10 @@ class CInstance
       /**
        * @brief Cambiar de estancia.
        *
-       * Cambia la prxima estancia a ejecutar, pero **no** finaliza la estancia actual.
+       * Cambia la próxima estancia a ejecutar, pero **no** finaliza la estancia actual.
        * Se recomienda usar CEngine::SetNextInstance() con gEngine.
        *
-       * @param next_instance_name Nombre de la prxima estancia a ejecutar. Debe existir dicha estancia.
+       * @param next_instance_name Nombre de la próxima estancia a ejecutar. Debe existir dicha estancia.
        *
        * @see CEngine
        * @see gEngine
@@ -112,8 +112,8 @@ class CInstance
       /**
        * @brief Terminar la estancia actual.
        *
-       * Finaliza la ejecucin de la estancia actual. Si se ha definido una prxima estancia con
-       * SetNextInstance(), se ejecutar dicha estancia. En caso contrario, finalizar la ejecucin del motor grfico.
+       * Finaliza la ejecución de la estancia actual. Si se ha definido una próxima estancia con
+       * SetNextInstance(), se ejecutará dicha estancia. En caso contrario, finalizará la ejecución del motor gráfico.
        * Se recomienda usar CEngine::EndInstance() con gEngine.
        *
        * @see CEngine
@@ -0,0 +1,176 @@
+/**
+ * @file
+ * @brief Fichero que incluye el buffer de cambios estructurales de game objects.
+ */
+
+#ifndef __COMMAND_BUFFER_H_
+#define __COMMAND_BUFFER_H_
+
+#include "_globals.h"
+#include "_object.h"
+
+#include <map>
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Buffer de cambios estructurales.
+ *
+ * Guarda los cambios que modifican la estructura de los game objects (crear, borrar, emparentar, añadir o quitar componentes)
+ * para aplicarlos más tarde, todos juntos, en un punto conocido: al final de cada iteración de CSystem_Scheduler.
+ * Así, los callbacks de los objetos pueden pedir esos cambios mientras CSystem_GameObject_Manager recorre la lista de objetos,
+ * incluso desde los hilos de CSystem_Jobs, sin invalidar la iteración.
+ *
+ * Cada hilo tiene su propio buffer, que se obtiene con CSystem_GameObject_Manager::Commands(). Los cambios se aplican en el orden en el que se pidieron,
+ * buffer a buffer.
+ *
+ * Los objetos creados con Spawn() existen desde el primer momento, por lo que se pueden configurar (componentes, posición...), pero no se añaden
+ * al gestor hasta que se aplica el buffer: hasta entonces no aparecen en CSystem_GameObject_Manager::Get() ni se actualizan.
+ *
+ * Los cambios guardan el handle de los objetos (véase gameObject_handle_t), no su puntero: si un objeto se borra antes de aplicar el buffer, los
+ * cambios que quedan sobre él se descartan, aunque otro objeto ocupe su slot. Sólo se aceptan objetos del gestor o creados con Spawn() en el
+ * mismo buffer.
+ *
+ * Ejemplo:
+ *
+ @code
+  CCommand_Buffer& cmd = gGameObjects.Commands();
+
+  CGameObject* firework = cmd.Spawn("firework");
+  CGameObject* trail = cmd.Spawn("firework_trail");
+  cmd.Reparent(trail, firework);
+  cmd.AddComponent<CComponent_Particle_Emitter>(trail);
+
+  cmd.Destroy(old_firework);
+ @endcode
+ *
+ * @see CSystem_GameObject_Manager::ApplyCommands()
+ */
+class CCommand_Buffer
+{
+  friend class CSystem_GameObject_Manager;
+
+  protected:
+    enum command_type_t { spawn, destroy, reparent, add_component, remove_component };
+
+    typedef CComponent* (*component_creator_t)(CGameObject* go);
+
+    // Objeto al que se refiere un cambio: un objeto del gestor, o uno creado con Spawn() en este buffer. Vacío es NULL
+    struct target_t
+    {
+      gameObject_handle_t handle;
+      int spawn;                   // Posición en "commands" del Spawn() que lo crea, o -1
+    };
+
+    struct command_t
+    {
+      command_type_t type;
+      CGameObject* go;             // Objeto creado (spawn). Es del buffer hasta que se aplica
+      target_t target;
+      target_t other;              // Nuevo padre (reparent)
+      int component;               // Componente (add_component, remove_component)
+      component_creator_t creator; // add_component
+      bool flag;                   // init (spawn), delete_children (destroy)
+    };
+
+    std::vector<command_t> commands;
+    std::map<CGameObject*, int> spawned;  // Objetos creados con Spawn() pendientes, y su posición en "commands"
+    uint num_spawns;
+    uint num_ignored;                     // Cambios descartados al pedirlos. Se avisa al aplicar el buffer, en el hilo principal
+
+    template <class Type>
+    static CComponent* CreateComponent(CGameObject* go)
+    {
+      return new Type(go);
+    }
+
+    // Devuelve false si "go" no es NULL ni un objeto del gestor o de este buffer
+    bool Target(CGameObject* go, target_t& target);
+    // Objeto actual de un target, o NULL si ya no existe. Sólo al aplicar el buffer, después de añadir los objetos creados
+    CGameObject* Resolve(const target_t& target);
+
+    void Push(command_type_t type, CGameObject* go, CGameObject* other = NULL, int component = -1, component_creator_t creator = NULL, bool flag = false);
+
+  public:
+    CCommand_Buffer(): num_spawns(0), num_ignored(0) {};
+    ~CCommand_Buffer();
+
+    /**
+     * @brief Crear un game object.
+     *
+     * @param name Nombre del objeto. Si al aplicar el buffer ya existe otro objeto con ese nombre, el nuevo se descarta.
+     * @param init Si es true, se inicia el objeto en el momento (véase CGameObject::Init()).
+     * @return Puntero al nuevo objeto, que se puede configurar antes de que se añada al gestor.
+     */
+    CGameObject* Spawn(const std::string& name, bool init = true);
+
+    /**
+     * @brief Crear varios game objects de una vez.
+     *
+     * Los objetos se llamarán "prefix0", "prefix1"... y se reservan en bloque.
+     *
+     * @param prefix Prefijo de los nombres.
+     * @param count Número de objetos.
+     * @param init Si es true, se inician los objetos en el momento.
+     * @return Punteros a los nuevos objetos.
+     */
+    std::vector<CGameObject*> SpawnBatch(const std::string& prefix, uint count, bool init = true);
+
+    /**
+     * @brief Borrar un game object.
+     *
+     * @param go Objeto a borrar.
+     * @param delete_children Si es true, se borran también sus hijos. En caso contrario, se quedan huérfanos.
+     */
+    void Destroy(CGameObject* go, bool delete_children = true);
+
+    /**
+     * @brief Cambiar el padre de un game object.
+     *
+     * @param go Objeto a mover.
+     * @param parent Nuevo padre. Si es NULL, el objeto se queda huérfano.
+     */
+    void Reparent(CGameObject* go, CGameObject* parent);
+
+    /**
+     * @brief Añadir un componente.
+     *
+     * @param go Objeto al que se añade el componente. No se hace nada si ya lo tiene.
+     */
+    template <class Type>
+    void AddComponent(CGameObject* go)
+    {
+      Push(add_component, go, NULL, Type::GetID(), &CCommand_Buffer::CreateComponent<Type>);
+    }
+
+    /**
+     * @brief Quitar un componente.
+     *
+     * @param go Objeto del que se quita el componente. El componente CComponent_Transform no se puede quitar.
+     */
+    template <class Type>
+    void RemoveComponent(CGameObject* go)
+    {
+      Push(remove_component, go, NULL, Type::GetID());
+    }
+
+    /**
+     * @brief Número de cambios pendientes.
+     */
+    inline uint Size()
+    {
+      return commands.size();
+    }
+
+    /**
+     * @brief Descartar los cambios pendientes.
+     *
+     * Los objetos creados con Spawn() que aún no se han añadido al gestor se borran.
+     */
+    void Clear();
+};
+
+/*@}*/
+
+#endif /* __COMMAND_BUFFER_H_ */
@@ -0,0 +1,232 @@
+/**
+ * @file
+ * @brief Fichero que incluye los volúmenes envolventes y el frustum de cámara, usados para descartar objetos no visibles.
+ */
+
+#ifndef __CULLING_H_
+#define __CULLING_H_
+
+#include "_globals.h"
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Culling.
+ *
+ * Espacio de nombres para los volúmenes envolventes (cajas y esferas) y el frustum de las cámaras. CSystem_Render los usa para no dibujar
+ * los objetos que quedan fuera de la vista de cada cámara.
+ */
+namespace Culling
+{
+  /**
+   * @brief Caja alineada con los ejes (AABB).
+   *
+   * Una caja recién creada está vacía (min > max), y crece con Extend().
+   */
+  struct aabb_t
+  {
+    glm::vec3 min;
+    glm::vec3 max;
+
+    aabb_t(): min(FLT_MAX), max(-FLT_MAX) {}
+    aabb_t(const glm::vec3& mn, const glm::vec3& mx): min(mn), max(mx) {}
+
+    /** @brief La caja no contiene ningún punto. */
+    inline bool Empty() const
+    {
+      return min.x > max.x or min.y > max.y or min.z > max.z;
+    }
+
+    /** @brief Vaciar la caja. */
+    inline void Clear()
+    {
+      min = glm::vec3(FLT_MAX);
+      max = glm::vec3(-FLT_MAX);
+    }
+
+    /** @brief Ampliar la caja para que contenga un punto. */
+    inline void Extend(const glm::vec3& p)
+    {
+      min = glm::min(min, p);
+      max = glm::max(max, p);
+    }
+
+    /** @brief Ampliar la caja para que contenga otra caja. */
+    inline void Extend(const aabb_t& b)
+    {
+      if(b.Empty())
+        return;
+
+      min = glm::min(min, b.min);
+      max = glm::max(max, b.max);
+    }
+
+    /** @brief Ampliar la caja una distancia en todas las direcciones. */
+    inline void Inflate(float r)
+    {
+      if(Empty())
+        return;
+
+      min -= glm::vec3(r);
+      max += glm::vec3(r);
+    }
+
+    inline glm::vec3 Center() const
+    {
+      return (min + max) * 0.5f;
+    }
+
+    /** @brief Mitad del tamaño de la caja en cada eje. */
+    inline glm::vec3 Extents() const
+    {
+      return (max - min) * 0.5f;
+    }
+
+    /** @brief Área de la superficie de la caja. Es el coste que minimiza CSystem_Spatial al insertar. */
+    inline float Surface() const
+    {
+      if(Empty())
+        return 0.f;
+
+      glm::vec3 d = max - min;
+      return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    /** @brief La caja contiene completamente a otra. */
+    inline bool Contains(const aabb_t& b) const
+    {
+      return min.x <= b.min.x and min.y <= b.min.y and min.z <= b.min.z and
+             b.max.x <= max.x and b.max.y <= max.y and b.max.z <= max.z;
+    }
+
+    inline bool Intersects(const aabb_t& b) const
+    {
+      return min.x <= b.max.x and b.min.x <= max.x and
+             min.y <= b.max.y and b.min.y <= max.y and
+             min.z <= b.max.z and b.min.z <= max.z;
+    }
+
+    /** @brief Distancia al cuadrado de un punto a la caja (0 si está dentro). */
+    inline float Distance2(const glm::vec3& p) const
+    {
+      glm::vec3 d = glm::max(min - p, glm::max(glm::vec3(0.f), p - max));
+      return glm::dot(d, d);
+    }
+
+    /**
+     * @brief Intersección con un rayo.
+     *
+     * @param origin Origen del rayo.
+     * @param inv_direction Inverso de la dirección en cada eje (1 / dirección).
+     * @param max_distance Distancia máxima, en unidades de la dirección.
+     * @param distance Distancia a la que el rayo entra en la caja (0 si el origen está dentro).
+     * @return Devuelve true si el rayo corta la caja antes de "max_distance".
+     */
+    bool Raycast(const glm::vec3& origin, const glm::vec3& inv_direction, float max_distance, float& distance) const;
+
+    /**
+     * @brief Transformar la caja.
+     *
+     * Devuelve la caja alineada con los ejes que contiene a esta caja transformada por "m" (una matriz afín, como las de mundo).
+     */
+    aabb_t Transform(const glm::mat4& m) const;
+  };
+
+  /**
+   * @brief Esfera.
+   *
+   * Una esfera con radio negativo está vacía.
+   */
+  struct sphere_t
+  {
+    glm::vec3 center;
+    float radius;
+
+    sphere_t(): center(0.f), radius(-1.f) {}
+    sphere_t(const glm::vec3& c, float r): center(c), radius(r) {}
+
+    inline bool Empty() const
+    {
+      return radius < 0.f;
+    }
+
+    /**
+     * @brief Transformar la esfera.
+     *
+     * El radio se multiplica por la mayor escala de "m", de forma que la esfera resultante siempre contiene a la original transformada.
+     */
+    sphere_t Transform(const glm::mat4& m) const;
+  };
+
+  /**
+   * @brief Volumen envolvente: una caja y una esfera que contienen al mismo objeto.
+   *
+   * La esfera se comprueba antes, por ser más barata, y la caja sólo si la esfera corta algún plano.
+   */
+  struct bounds_t
+  {
+    aabb_t box;
+    sphere_t sphere;
+
+    bounds_t() {}
+
+    /** @brief Volumen a partir de una caja. La esfera es la que circunscribe la caja. */
+    explicit bounds_t(const aabb_t& b);
+
+    inline bool Empty() const
+    {
+      return box.Empty();
+    }
+
+    bounds_t Transform(const glm::mat4& m) const;
+  };
+
+  /**
+   * @brief Frustum (volumen de visión) de una cámara.
+   *
+   * Se compone de 6 planos extraídos de la matriz proyección * vista, por lo que funciona igual con cámaras en perspectiva y ortogonales
+   * (véase Viewmode::viewmodes_t). Los planos apuntan hacia dentro del frustum.
+   */
+  class frustum_t
+  {
+    protected:
+      glm::vec4 planes[6];  // Izquierda, derecha, abajo, arriba, cerca, lejos
+
+    public:
+      frustum_t() {}
+
+      /** @brief Frustum de una matriz proyección * vista. */
+      explicit frustum_t(const glm::mat4& view_proj)
+      {
+        Set(view_proj);
+      }
+
+      /** @brief Resultado de Classify(). */
+      enum classify_t { outside, intersecting, inside };
+
+      void Set(const glm::mat4& view_proj);
+
+      /**
+       * @brief Posición de una caja respecto al frustum.
+       *
+       * Al recorrer una jerarquía de cajas, si un nodo queda dentro no hace falta comprobar sus hijos.
+       */
+      classify_t Classify(const aabb_t& b) const;
+
+      bool Intersects(const sphere_t& s) const;
+      bool Intersects(const aabb_t& b) const;
+
+      /**
+       * @brief Comprobar si un volumen puede ser visible.
+       *
+       * Es conservador: puede devolver true para volúmenes que quedan fuera por poco (cerca de las esquinas del frustum), pero nunca false
+       * para uno visible.
+       */
+      bool Intersects(const bounds_t& b) const;
+  };
+}
+
+/*@}*/
+
+#endif /* __CULLING_H_ */
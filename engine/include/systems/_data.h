@@ -9,9 +9,9 @@
 #include "_globals.h"
 #include "_system.h"
 
-/** Ficheros donde se guardarn las variables. */
+/** Ficheros donde se guardarán las variables. */
 #define __CSYSTEM_DATA_STORAGE_SAVEFILE "data/cfg/vars.dat"
-/** Ficheros donde se guardarn las variables de usuario. @no_use */
+/** Ficheros donde se guardarán las variables de usuario. @no_use */
 #define __CSYSTEM_DATA_STORAGE_CONFIG_SAVEFILE "data/cfg/user.cfg"
 
 
@@ -23,7 +23,7 @@
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_RESOLUTION_WINDOW_MODE "windowed"
 /** Valor por defecto de la variable "__RENDER_RESOLUTION_MULTISAMPLING", para activar o desactivar el multimuestreo (antialising). */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_RESOLUTION_MULTISAMPLING 1
-/** Valor por defecto de la variable "__RENDER_RESOLUTION_MULTISAMPLING_VALUE", para determinar el nmero de buffers a usar con el multimuestreo. */
+/** Valor por defecto de la variable "__RENDER_RESOLUTION_MULTISAMPLING_VALUE", para determinar el número de buffers a usar con el multimuestreo. */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_RESOLUTION_MULTISAMPLING_VALUE 1
 
 /** Valor por defecto de la variable "__RENDER_SOUND_RADIUS", para activar o desactivar el dibujado del sonido. */
@@ -33,28 +33,54 @@
 /** Valor por defecto de la variable "__RENDER_SOUND_RADIUS_X", para  saber las "X" secciones que tienen las esferas de sonido. */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_SOUND_RADIUS_X 10.f
 
-/** Valor por defecto de la variable "__RENDER_TRANSFORM", para activar o desactivar el dibujado de los componentes de transformacin. */
+/** Valor por defecto de la variable "__RENDER_TRANSFORM", para activar o desactivar el dibujado de los componentes de transformación. */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_TRANSFORM 1
 /** Valor por defecto de la variable "__RENDER_TRANSFORM_GRID", para activar o desactivar el dibujado de la rejilla. */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_TRANSFORM_GRID 1
-/** Valor por defecto de la variable "__RENDER_TRANSFORM_GRID_ROWS", para definir el nmero de filas en la rejilla. */
+/** Valor por defecto de la variable "__RENDER_TRANSFORM_GRID_ROWS", para definir el número de filas en la rejilla. */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_TRANSFORM_GRID_ROWS 20
 /** Valor por defecto de la variable "__RENDER_TRANSFORM_GRID_ROWS_SCALE", para definir la escala de las filas en la rejilla. */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_TRANSFORM_GRID_ROWS_SCALE 1.f
-/** Valor por defecto de la variable "__RENDER_TRANSFORM_GRID_COLS", para definir el nmero de columnas en la rejilla. */
+/** Valor por defecto de la variable "__RENDER_TRANSFORM_GRID_COLS", para definir el número de columnas en la rejilla. */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_TRANSFORM_GRID_COLS 20
 /** Valor por defecto de la variable "__RENDER_TRANSFORM_GRID_COLS_SCALE", para definir la escala de las columnas en la rejilla. */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_TRANSFORM_GRID_COLS_SCALE 1.f
 
+/** Valor por defecto de la variable "__RENDER_FRUSTUM_CULLING", para activar o desactivar el descarte de objetos fuera de la vista de cada cámara. */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_FRUSTUM_CULLING 1
+/** Valor por defecto de la variable "__RENDER_QUEUE", para ordenar los objetos por estado de OpenGL antes de dibujarlos (véase CRender_Queue). */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_QUEUE 1
+/** Valor por defecto de la variable "__RENDER_INSTANCING", para dibujar con una sola llamada las copias seguidas de un mismo modelo (véase CRender_Queue). */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_INSTANCING 1
+/** Valor por defecto de la variable "__RENDER_STREAM_BUFFER_SIZE", siendo el tamaño en bytes del buffer para los vértices dinámicos (véase CSystem_Stream_Buffer). */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_STREAM_BUFFER_SIZE 8388608
+/** Valor por defecto de la variable "__RENDER_PARALLEL_RECORDING", para grabar la cola de dibujo de cada cámara en los hilos de CSystem_Jobs (véase CSystem_Render). */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_PARALLEL_RECORDING 1
+/** Valor por defecto de la variable "__RENDER_PIPELINED", para dibujar cada iteración en un hilo propio mientras se simula la siguiente (véase CSystem_Render::Pipelined()). */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_PIPELINED 0
+/** Valor por defecto de la variable "__RENDER_LOD", para dibujar los modelos lejanos con menos triángulos (véase CResource_Mesh::SelectLOD()). */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_LOD 1
+/** Valor por defecto de la variable "__RENDER_LOD_PIXEL_ERROR", el error máximo en píxeles de un nivel de detalle simplificado. */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_LOD_PIXEL_ERROR 1.f
+/** Valor por defecto de la variable "__RENDER_SHARED_MESH_BUFFERS", para juntar los modelos de cada fichero de recursos en buffers compartidos (véase CMesh_Buffer). Necesita GL_ARB_draw_elements_base_vertex. */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_SHARED_MESH_BUFFERS 0
+/** Valor por defecto de la variable "__RENDER_STATIC_BATCHING", para juntar los modelos de los objetos estáticos al cargar cada estancia (véase CSystem_Static_Batching). */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_STATIC_BATCHING 1
+/** Valor por defecto de la variable "__RENDER_STATIC_BATCHING_CELL_SIZE", el lado de las celdas en las que se reparten los objetos estáticos. */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_STATIC_BATCHING_CELL_SIZE 16.f
+
 /** Valor por defecto de la variable "__SOUND_VOLUME", para definir el volumen del juego. */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_SOUND_VOLUME 1.0
-/** Valor por defecto de la variable "__SOUND_MUSIC_VOLUME", para definir el volumen de la msica del juego. */
+/** Valor por defecto de la variable "__SOUND_MUSIC_VOLUME", para definir el volumen de la música del juego. */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_SOUND_MUSIC_VOLUME 1.0
 /** Valor por defecto de la variable "__SOUND_VOLUME_NUMBER_SOURCES", recursos usados para los componentes CComponent_Audio_Source con Bind(). */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_SOUND_NUMBER_SOURCES 225
 /** Valor por defecto de la variable "__SOUND_VOLUME_NUMBER_SOURCES_ONESHIT", recursos usados para los componentes CComponent_Audio_Source con oneshots ( CComponent_Audio_Source::PlayOneShot() ). */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_SOUND_NUMBER_SOURCES_ONESHOT 30
 
+/** Valor por defecto de la variable "__JOBS_NUMBER_THREADS", número de hilos de CSystem_Jobs (incluido el principal). Con 0 se usa un hilo por núcleo. */
+#define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_JOBS_NUMBER_THREADS 0
+
 /** Valor por defecto de la variable "__INPUT_AXIS1_UP_KEY", para definir la tecla por defecto "arriba" del eje 1 (wads). */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_INPUT_AXIS1_UP_KEY "W"
 /** Valor por defecto de la variable "__INPUT_AXIS1_DOWN_KEY", para definir la tecla por defecto "abajo" del eje 1 (wads). */
@@ -71,13 +97,13 @@
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_INPUT_AXIS2_LEFT_KEY "Left"
 /** Valor por defecto de la variable "__INPUT_AXIS2_RIGHT_KEY", para definir la tecla por defecto "derecha" del eje 2 (flechas). */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_INPUT_AXIS2_RIGHT_KEY "Right"
-/** Valor por defecto de la variable "__INPUT_ACTION1_KEY", para definir la tecla por defecto de "accin1". */
+/** Valor por defecto de la variable "__INPUT_ACTION1_KEY", para definir la tecla por defecto de "acción1". */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_INPUT_ACTION1_KEY "N"
-/** Valor por defecto de la variable "__INPUT_ACTION2_KEY", para definir la tecla por defecto de "accin2". */
+/** Valor por defecto de la variable "__INPUT_ACTION2_KEY", para definir la tecla por defecto de "acción2". */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_INPUT_ACTION2_KEY "M"
-/** Valor por defecto de la variable "__INPUT_ACTION3_KEY", para definir la tecla por defecto de "accin3". */
+/** Valor por defecto de la variable "__INPUT_ACTION3_KEY", para definir la tecla por defecto de "acción3". */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_INPUT_ACTION3_KEY "J"
-/** Valor por defecto de la variable "__INPUT_ACTION4_KEY", para definir la tecla por defecto de "accin4". */
+/** Valor por defecto de la variable "__INPUT_ACTION4_KEY", para definir la tecla por defecto de "acción4". */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_INPUT_ACTION4_KEY "K"
 /** Valor por defecto de la variable "__INPUT_RUN_KEY", para definir la tecla por defecto de "correr". */
 #define __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_INPUT_RUN_KEY "Left Shift"
@@ -106,11 +132,11 @@ const int __NO_INT = __CSYSTEM_DATA_STORAGE_NOINT;
 const float __NO_FLOAT = __CSYSTEM_DATA_STORAGE_NOFLOAT;
 
 /**
- * @brief Sistema de gestin de datos (variables).
+ * @brief Sistema de gestión de datos (variables).
  *
- * El sistema de preservacin de datos o Data Storage se usa para guardar valores en variables para que sean
+ * El sistema de preservación de datos o Data Storage se usa para guardar valores en variables para que sean
  * persistentes entre sesiones, dando al usuario total libertad para guardar los valores que desee entre sesiones
- * de ejecucin.
+ * de ejecución.
  *
  * El sistema de almacenamiento de variables funciona como un *hash* o mapa, con un std::map, siendo la clave el nombre de la
  * variable, y el valor, el valor de dicha variable. Por tanto, tendremos 3 tablas, una para cada tipo, de la siguiente manera:
@@ -121,7 +147,7 @@ const float __NO_FLOAT = __CSYSTEM_DATA_STORAGE_NOFLOAT;
  * var_nombre2      | 50
  * ...              | ...
  *
- * Por ejemplo, un usuario puede hacer lo siguiente para cargar la posicin de un objeto (sea cmara, personaje principal...):
+ * Por ejemplo, un usuario puede hacer lo siguiente para cargar la posición de un objeto (sea cámara, personaje principal...):
  @code
  // ... Suponemos que hay un CGameObject llamado "pj1"
  if(!gData.ExistsInt("pj1_pos_x"))
@@ -132,12 +158,12 @@ const float __NO_FLOAT = __CSYSTEM_DATA_STORAGE_NOFLOAT;
  // ...
  @endcode
  *
- * Y se podr usar para todo tipo de ejemplos, siempre y cuando las variables sean de tipo entero, flotante o string.
+ * Y se podrá usar para todo tipo de ejemplos, siempre y cuando las variables sean de tipo entero, flotante o string.
  *
  * La lista de variables de sistema (importantes, las que empiezan por '__'), puede encontrarse en el fichero include/systems/_data.h
  * con el prefijo "__CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS".
  *
- * Finalmente, las variables slo se guardarn al cambiar de estancia, o cuando el usuario lo espeficique con Save() o SaveConfig().
+ * Finalmente, las variables sólo se guardarán al cambiar de estancia, o cuando el usuario lo espeficique con Save() o SaveConfig().
  *
  * @warning Dos variables de distinto tipo pueden tener un mismo identificador. Esto significa, hay un mapa para cada tipo de variable.
  */
@@ -171,10 +197,10 @@ class CSystem_Data_Storage: public CSystem
     /**
      * @brief Guardar variables almacenadas actualmente en el sistema.
      *
-     * El sistema tratar de guardar todas las variables del sistema en un fichero externo especificado
-     * por el usuario. Adems, sern guardadas en formato binario, no en formato de texto.
+     * El sistema tratará de guardar todas las variables del sistema en un fichero externo especificado
+     * por el usuario. Además, serán guardadas en formato binario, no en formato de texto.
      *
-     * @warning Se guardarn todas las variables, tanto las de usuario como las de sistema.
+     * @warning Se guardarán todas las variables, tanto las de usuario como las de sistema.
      *
      * @param file Fichero objetivo de guardado.
      * @return ture si han guardado los datos de manera correcta, false en caso contrario.
@@ -183,9 +209,9 @@ class CSystem_Data_Storage: public CSystem
     /**
      * @brief Cargar variables almacenadas en un fichero.
      *
-     * El sistema tratar de cargar todas las variables almacenadas en un fichero externo. Toda variable
-     * cargada se aadir al sistema de variables actual. En caso de existir, se sobreescribir dicho valor.
-     * Esto significa que no se borrarn las variables existentes en el sistema.
+     * El sistema tratará de cargar todas las variables almacenadas en un fichero externo. Toda variable
+     * cargada se añadirá al sistema de variables actual. En caso de existir, se sobreescribirá dicho valor.
+     * Esto significa que no se borrarán las variables existentes en el sistema.
      *
      * @param file Fichero objetivo de carga.
      * @return ture si han cargado los datos de manera correcta, false en caso contrario.
@@ -194,16 +220,16 @@ class CSystem_Data_Storage: public CSystem
 
     // Modificar, instanciar gSystem_Config o algo
     /**
-     * @brief Cargar configuracin inicial.
+     * @brief Cargar configuración inicial.
      *
-     * Carga la configuracin inicial. Similar a usar Load() sin parmetros. Si no se consigue cargar el fichero de variables,
-     * se crearn una serie de variables con los valores por defecto descritos en el fichero engine/include/_data.h.
+     * Carga la configuración inicial. Similar a usar Load() sin parámetros. Si no se consigue cargar el fichero de variables,
+     * se crearán una serie de variables con los valores por defecto descritos en el fichero engine/include/_data.h.
      */
     void LoadConfig();
     /**
-     * @brief Guardar configuracin.
+     * @brief Guardar configuración.
      *
-     * Idntico a usar Save() sin argumentos.
+     * Idéntico a usar Save() sin argumentos.
      */
     void SaveConfig();
 
@@ -211,7 +237,7 @@ class CSystem_Data_Storage: public CSystem
      * @brief Asociar valor a un string.
      *
      * Asocia a la variable de tipo string con nombre "name_id" el valor descrito en "value". Si ya existe, se sobrescribe su valor.
-     * El identificador debe ser un identificador vlido (caracteres alfanumricos o '_').
+     * El identificador debe ser un identificador válido (caracteres alfanuméricos o '_').
      *
      * @param name_id Nombre de la variable a modificar.
      * @param value Nuevo valor de la variable.
@@ -223,7 +249,7 @@ class CSystem_Data_Storage: public CSystem
      * @brief Asociar valor a un entero.
      *
      * Asocia a la variable de tipo entero o int con nombre "name_id" el valor descrito en "value". Si ya existe, se sobrescribe su valor.
-     * El identificador debe ser un identificador vlido (caracteres alfanumricos o '_').
+     * El identificador debe ser un identificador válido (caracteres alfanuméricos o '_').
      *
      * @param name_id Nombre de la variable a modificar.
      * @param value Nuevo valor de la variable.
@@ -235,7 +261,7 @@ class CSystem_Data_Storage: public CSystem
      * @brief Asociar valor a un flotante.
      *
      * Asocia a la variable de tipo flotante o float con nombre "name_id" el valor descrito en "value". Si ya existe, se sobrescribe su valor.
-     * El identificador debe ser un identificador vlido (caracteres alfanumricos o '_').
+     * El identificador debe ser un identificador válido (caracteres alfanuméricos o '_').
      *
      * @param name_id Nombre de la variable a modificar.
      * @param value Nuevo valor de la variable.
@@ -250,7 +276,7 @@ class CSystem_Data_Storage: public CSystem
      * Retorna el valor de la variable de nombre "name_id" del tipo string.
      *
      * @param name_id Nombre de la variable.
-     * @return Valor de la variable. Retornar __NO_STRING en caso de que la variable no exista.
+     * @return Valor de la variable. Retornará __NO_STRING en caso de que la variable no exista.
      */
     std::string GetString(std::string name_id);
     /**
@@ -259,7 +285,7 @@ class CSystem_Data_Storage: public CSystem
      * Retorna el valor de la variable de nombre "name_id" del tipo entero o int.
      *
      * @param name_id Nombre de la variable.
-     * @return Valor de la variable. Retornar __NO_INT en caso de que la variable no exista.
+     * @return Valor de la variable. Retornará __NO_INT en caso de que la variable no exista.
      */
     int GetInt(std::string name_id);
     /**
@@ -268,7 +294,7 @@ class CSystem_Data_Storage: public CSystem
      * Retorna el valor de la variable de nombre "name_id" del tipo flotante o float.
      *
      * @param name_id Nombre de la variable.
-     * @return Valor de la variable. Retornar __NO_FLOAT en caso de que la variable no exista.
+     * @return Valor de la variable. Retornará __NO_FLOAT en caso de que la variable no exista.
      */
     float GetFloat(std::string name_id);
 
@@ -303,7 +329,7 @@ class CSystem_Data_Storage: public CSystem
     /**
      * @brief Comprobar si existe una variable del tipo string.
      *
-     * Comprobar si hay constancia de la variable dada.
+     * Comprobará si hay constancia de la variable dada.
      *
      * @param name_id Nombre de la variable a comprobar.
      * @return Retorna true si la variable existe, false en caso contrario.
@@ -312,7 +338,7 @@ class CSystem_Data_Storage: public CSystem
     /**
      * @brief Comprobar si existe una variable del tipo entero.
      *
-     * Comprobar si hay constancia de la variable dada.
+     * Comprobará si hay constancia de la variable dada.
      *
      * @param name_id Nombre de la variable a comprobar.
      * @return Retorna true si la variable existe, false en caso contrario.
@@ -321,7 +347,7 @@ class CSystem_Data_Storage: public CSystem
     /**
      * @brief Comprobar si existe una variable del tipo flotante.
      *
-     * Comprobar si hay constancia de la variable dada.
+     * Comprobará si hay constancia de la variable dada.
      *
      * @param name_id Nombre de la variable a comprobar.
      * @return Retorna true si la variable existe, false en caso contrario.
@@ -332,33 +358,33 @@ class CSystem_Data_Storage: public CSystem
      * @brief Elimina todas las variables.
      *
      * Elimina todas las variables del sistema, de todos los tipos.
-     * Adems, eliminar las variables de *sistema*, aquellas que empiezan por "__".
+     * Además, eliminará las variables de *sistema*, aquellas que empiezan por "__".
      *
-     * @warning Use este funcin si est seguro de lo que hace, ya que varios elementos del motor dependen en gran medida de variables de sistema.
+     * @warning Use este función si está seguro de lo que hace, ya que varios elementos del motor dependen en gran medida de variables de sistema.
      */
     void RemoveAll();
     /**
      * @brief Elimina todas las variables menos las de sistema.
      *
      * Elimina todas las variables del usuario, de todos los tipos.
-     * En este caso, no se eliminarn las variables de *sistema*, aquellas que empiezan por "__".
+     * En este caso, no se eliminarán las variables de *sistema*, aquellas que empiezan por "__".
      *
      */
     void RemoveUserVars();
 };
 
-// ->NOTA Para el gestor de datos, se deberan crear 2 objetos: 1 para la configuracin de la aplicacin, y otra para guardar variables de usuario.
+// ->NOTA Para el gestor de datos, se deberían crear 2 objetos: 1 para la configuración de la aplicación, y otra para guardar variables de usuario.
 /**
  * @brief Objeto global del sistema "Data Storage".
  *
- * Se debe usar como nica estancia de dicho sistema. Para mayor comodidad, use el objeto gData,
+ * Se debe usar como única estancia de dicho sistema. Para mayor comodidad, use el objeto gData,
  * que es una referencia a este objeto.
  */
 extern CSystem_Data_Storage gSystem_Data_Storage;
 /**
  * @brief Objeto global del sistema "Data Storage".
  *
- * Se debe usar como nica estancia de dicho sistema.
+ * Se debe usar como única estancia de dicho sistema.
  */
 extern CSystem_Data_Storage& gData;
 
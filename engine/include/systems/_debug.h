@@ -40,13 +40,13 @@ namespace Debug
   /**
    * @brief Enum para los distintos tipos de mensajes de alerta.
    *
-   * Un dilogo o message box es un *pop-up* que permite alertar al usuario de errores, advertencias o informacin.
+   * Un diálogo o message box es un *pop-up* que permite alertar al usuario de errores, advertencias o información.
    */
   enum flags_t {error = SDL_MESSAGEBOX_ERROR, warning = SDL_MESSAGEBOX_WARNING, information = SDL_MESSAGEBOX_INFORMATION};
   /**
-   * @brief Estructura que represente una lnea de texto dentro de la consola.
+   * @brief Estructura que represente una línea de texto dentro de la consola.
    *
-   * Cada lnea tiene asociada un texto (string) y un color (colorf_t). Se usa de manera interna en
+   * Cada línea tiene asociada un texto (string) y un color (colorf_t). Se usa de manera interna en
    * el sistema CSystem_Debug.
    */
   typedef struct string_console_t
@@ -73,19 +73,19 @@ namespace Debug
 /**
  * @brief Sistema que representa el depurador del motor.
  *
- * Este sistema, uno de los ms importante para el desarrollo, es el encargado de servir de utililidad
- * para depurar algunos aspectos del programa, tales como mostrar errores, advertencias, guardar informacin en
+ * Este sistema, uno de los más importante para el desarrollo, es el encargado de servir de utililidad
+ * para depurar algunos aspectos del programa, tales como mostrar errores, advertencias, guardar información en
  * un log, etc.
  *
  * Actualmente, el depurador realiza las siguientes acciones:
  *
- * - Escribir informacin o errores en un *log* (fichero de texto, por defecto en __CSYSTEM_DEBUG_STORAGE_SAVEFILE).
+ * - Escribir información o errores en un *log* (fichero de texto, por defecto en __CSYSTEM_DEBUG_STORAGE_SAVEFILE).
  * - Abrir advertencias o pop-ups para informar o advertir al usuario sobre los aspectos deseados (errores, notificaciones...).
  * - Una consola o terminal de comandos completamente funcional.
- *   - Dicha consola se activar mediante la tecla F10 por defecto, o con la tecla almacenada en la variable del sistema CSystem_Data_Storage "__INPUT_CONSOLE_KEY".
+ *   - Dicha consola se activará mediante la tecla F10 por defecto, o con la tecla almacenada en la variable del sistema CSystem_Data_Storage "__INPUT_CONSOLE_KEY".
  *
- * @warning En caso de que la consola est abierta, se ignorar la entrada del usuario hasta que se cierre. Esto significa que, slo se
- * @warning procesar entrada para este sistema, y no para el resto de objetos.
+ * @warning En caso de que la consola esté abierta, se ignorará la entrada del usuario hasta que se cierre. Esto significa que, sólo se
+ * @warning procesará entrada para este sistema, y no para el resto de objetos.
  */
 class CSystem_Debug: public CSystem
 {
@@ -144,19 +144,19 @@ class CSystem_Debug: public CSystem
      */
     CSystem_Debug(): CSystem(), opened(false), file(NULL){}
     /**
-     * @brief Comprobar si el fichero de log est abierto.
+     * @brief Comprobar si el fichero de log está abierto.
      *
      * @deprecated
      * @no_use
      *
-     * @return true si el fichero de log est abierto, false en caso contrario.
+     * @return true si el fichero de log está abierto, false en caso contrario.
      */
     bool IsOpened(){return opened;}
 
     /**
-     * @brief Comprobar si la consola est desplegada.
+     * @brief Comprobar si la consola está desplegada.
      *
-     * @return En caso de que la consoa est abierta, devuelve true. En caso contrario, devuelve false.
+     * @return En caso de que la consoa esté abierta, devuelve true. En caso contrario, devuelve false.
      */
     bool IsConsole()
     {
@@ -173,7 +173,7 @@ class CSystem_Debug: public CSystem
      gDebug.command("go_show_tree");
      @endcode
      *
-     * Es idntico a abrir una terminal y escribir
+     * Es idéntico a abrir una terminal y escribir
      *
      @code
      > go_show_tree
@@ -181,10 +181,10 @@ class CSystem_Debug: public CSystem
      *
      * La lista completa de comandos es la siguiente:
      *
-     * ->PorHacer Escribir lista de comandos en la documentacin.
+     * ->PorHacer Escribir lista de comandos en la documentación.
      *
      * @warning Puede que la lista de comandos anterior no este actualizada. Ejecute el comando "help" para
-     * @warning ver la lista de comandos, en sus respectivas categoras.
+     * @warning ver la lista de comandos, en sus respectivas categorías.
      *
      * @param command Comando a ejecutar, con el la instruccion y los argumentos.
      * @param log Flag para saber si se debe escribir los comandos ejecutados en la terminal.
@@ -193,29 +193,29 @@ class CSystem_Debug: public CSystem
 
     // log.txt File
     /**
-     * @brief Escribir un mensaje en una lnea del fichero de logs.
+     * @brief Escribir un mensaje en una línea del fichero de logs.
      *
-     * Escribe una lnea con formato al fichero de logs, que puede resultar til para depurar algunos aspectos.
+     * Escribe una línea con formato al fichero de logs, que puede resultar útil para depurar algunos aspectos.
      *
      * Por ejemplo, usando:
      @code
      gDebug.log("Texto de prueba: %s -> %d", "nombre", 50);
      @endcode
      *
-     * Genera la lnea en el fichero de logs siguiente:
+     * Genera la línea en el fichero de logs siguiente:
      @code
      [12/04/2014 09:59] Texto de prueba: nombre -> 50
      @endcode
      *
      * Si no quiere una marca de tiempo, use raw().
      *
-     * @param fmt Formato de salida. Idntico a usar "printf" de *C*.
+     * @param fmt Formato de salida. Idéntico a usar "printf" de *C*.
      */
     void log(const char* fmt, ...);
     /**
-     * @brief Escribir un mensaje de error en una lnea del fichero de logs.
+     * @brief Escribir un mensaje de error en una línea del fichero de logs.
      *
-     * Escribe una lnea con formato al fichero de logs, que puede resultar til para depurar algunos aspectos con respecto
+     * Escribe una línea con formato al fichero de logs, que puede resultar útil para depurar algunos aspectos con respecto
      * a errores.
      *
      * Por ejemplo, usando:
@@ -223,21 +223,21 @@ class CSystem_Debug: public CSystem
      gDebug.error("No quedan huevos!!");
      @endcode
      *
-     * Genera la lnea en el fichero de logs siguiente:
+     * Genera la línea en el fichero de logs siguiente:
      @code
      [12/04/2014 09:59] **ERROR** No quedan huevos!!
      @endcode
      *
      * Si no quiere una marca de tiempo, use raw().
      *
-     * @param fmt Formato de salida. Idntico a usar "printf" de *C*.
+     * @param fmt Formato de salida. Idéntico a usar "printf" de *C*.
      */
     void error(const char* fmt, ...);
     /**
-     * @brief Escribir un mensaje sin marca de tiempo y sin saltos de lnea en el fichero de logs.
+     * @brief Escribir un mensaje sin marca de tiempo y sin saltos de línea en el fichero de logs.
      *
-     * Escribe una lnea con formato al fichero de logs, que puede resultar til para depurar algunos aspectos. No introduce
-     * un retorno de carro al final de la lnea, ni tampoco aade marca de tiempo.
+     * Escribe una línea con formato al fichero de logs, que puede resultar útil para depurar algunos aspectos. No introduce
+     * un retorno de carro al final de la línea, ni tampoco añade marca de tiempo.
      *
      * Por ejemplo, usando:
      @code
@@ -246,13 +246,13 @@ class CSystem_Debug: public CSystem
      gDebug.raw("Esto es otra linea\n");
      @endcode
      *
-     * Genera la lnea en el fichero de logs siguiente:
+     * Genera la línea en el fichero de logs siguiente:
      @code
      Esto es una linea
      Esto es otra linea
      @endcode
      *
-     * @param fmt Formato de salida. Idntico a usar "printf" de *C*.
+     * @param fmt Formato de salida. Idéntico a usar "printf" de *C*.
      */
     void raw_log(const char* fmt, ...);
 
@@ -261,79 +261,79 @@ class CSystem_Debug: public CSystem
     /**
      * @brief Mensaje estilo pop-up
      *
-     * Genera una nueva ventana o digolo con el mensaje a mostrar al usuario.
+     * Genera una nueva ventana o diágolo con el mensaje a mostrar al usuario.
      *
-     * @param flags Tipo de mensaje (error, informacin, warning). @see Debug::flags_t
-     * @param title Ttulo del dilogo.
-     * @param fmt Cuerpo, texto o mensaje del dilogo. Como si se usase "printf" de *C*.
+     * @param flags Tipo de mensaje (error, información, warning). @see Debug::flags_t
+     * @param title Título del diálogo.
+     * @param fmt Cuerpo, texto o mensaje del diálogo. Como si se usase "printf" de *C*.
      */
     void msg_box(Uint32 flags, const char* title, const char* fmt, ...);
 
     // Console
     /**
-     * @brief Escribir una lnea en consola.
+     * @brief Escribir una línea en consola.
      *
-     * Escribe una lnea en consola con un formato determinado. Por ejemplo, usar
+     * Escribe una línea en consola con un formato determinado. Por ejemplo, usar
      @code
      gDebug.cosole_msg("Texto de prueba numero %d", 40);
      @endcode
      *
-     * Generar por consola el mensaje:
+     * Generará por consola el mensaje:
      *
      * <span style="font-weight: bold; background-color: black; color: white; display: block; padding: 5px;">Texto de consola</span>
      *
-     * @param fmt Cuerpo, texto o mensaje del dilogo. Como si se usase "printf" de *C*.
+     * @param fmt Cuerpo, texto o mensaje del diálogo. Como si se usase "printf" de *C*.
      */
     void console_msg(const char* fmt, ...);
     /**
-     * @brief Escribir una lnea de error (roja) en consola.
+     * @brief Escribir una línea de error (roja) en consola.
      *
-     * Escribe una lnea de error en consola con un formato determinado. Por ejemplo, usar
+     * Escribe una línea de error en consola con un formato determinado. Por ejemplo, usar
      @code
      gDebug.cosole_msg("Error! No quedan huevos!!");
      @endcode
      *
-     * Generar por consola el mensaje:
+     * Generará por consola el mensaje:
      *
      * <span style="font-weight: bold; background-color: black; color: red; display: block; padding: 5px;">Error! No quedan huevos!!</span>
      *
-     * @param fmt Cuerpo, texto o mensaje del dilogo. Como si se usase "printf" de *C*.
+     * @param fmt Cuerpo, texto o mensaje del diálogo. Como si se usase "printf" de *C*.
      */
     void console_error_msg(const char* fmt, ...);
     /**
-     * @brief Escribir una lnea de advertencia (naranja) en consola.
+     * @brief Escribir una línea de advertencia (naranja) en consola.
      *
-     * Escribe una lnea de advertencia en consola con un formato determinado. Por ejemplo, usar
+     * Escribe una línea de advertencia en consola con un formato determinado. Por ejemplo, usar
      @code
      gDebug.cosole_msg("Advertencia! te quedan 2 huevos.");
      @endcode
      *
-     * Generar por consola el mensaje:
+     * Generará por consola el mensaje:
      *
      * <span style="font-weight: bold; background-color: black; color: #ffbf00; display: block; padding: 5px;">Advertencia! te quedan 2 huevos.</span>
      *
-     * @param fmt Cuerpo, texto o mensaje del dilogo. Como si se usase "printf" de *C*.
+     * @param fmt Cuerpo, texto o mensaje del diálogo. Como si se usase "printf" de *C*.
      */
     void console_warning_msg(const char* fmt, ...);
     /**
-     * @brief Escribir una lnea de informacin (azul) en consola.
+     * @brief Escribir una línea de información (azul) en consola.
      *
-     * Escribe una lnea de informacin en consola con un formato determinado. Por ejemplo, usar
+     * Escribe una línea de información en consola con un formato determinado. Por ejemplo, usar
      @code
      gDebug.cosole_msg("FYI: Esto es un mensaje de informacion.");
      @endcode
      *
-     * Generar por consola el mensaje:
+     * Generará por consola el mensaje:
      *
      * <span style="font-weight: bold; background-color: black; color: #57b8d9; display: block; padding: 5px;">FYI: Esto es un mensaje de informacion.</span>
      *
-     * @param fmt Cuerpo, texto o mensaje del dilogo. Como si se usase "printf" de *C*.
+     * @param fmt Cuerpo, texto o mensaje del diálogo. Como si se usase "printf" de *C*.
      */
     void console_info_msg(const char* fmt, ...);
     /**
-     * @brief Escribir una lnea con un color personalizado en consola.
+     * @brief Escribir una línea con un color personalizado en consola.
      *
-     * Escribe una lnea con un color personalizado en consola con un formato determinado. Por ejemplo, usar
+     * Escribe una línea con un color personalizado en consola con un formato determinado. Por ejemplo, usar
      *
      @code
      gDebug.console_custom_msg(0.6f, 0.f, 0.6f, 1.f, "Violeta");
@@ -345,7 +345,7 @@ class CSystem_Debug: public CSystem
      gDebug.console_custom_msg(1.f, 0.f, 0.f, 1.f, "Rojo");
      @endcode
      *
-     * Generar por consola los mensajes:
+     * Generará por consola los mensajes:
      *
      * <span style="font-weight: bold; background-color: black; color: #990099; display: block; padding: 5px;">Violeta</span>
      * <span style="font-weight: bold; background-color: black; color: #000099; display: block; padding: 5px;">Azul oscuro</span>
@@ -359,14 +359,14 @@ class CSystem_Debug: public CSystem
      * @param g Componente verde del color.
      * @param b Componente azul del color.
      * @param a Componente alfa (trasparencia) del color.
-     * @param fmt Cuerpo, texto o mensaje del dilogo. Como si se usase "printf" de *C*.
+     * @param fmt Cuerpo, texto o mensaje del diálogo. Como si se usase "printf" de *C*.
      */
     void console_custom_msg(GLfloat r, GLfloat g, GLfloat b, GLfloat a, const char* fmt, ...);
 
     /**
-     * @brief Escribir una lnea con un color personalizado en consola.
+     * @brief Escribir una línea con un color personalizado en consola.
      *
-     * Escribe una lnea con un color personalizado en consola con un formato determinado. Por ejemplo, usar
+     * Escribe una línea con un color personalizado en consola con un formato determinado. Por ejemplo, usar
      *
      @code
      gDebug.console_custom_msg(0.6f, 0.f, 0.6f, 1.f, "Violeta");
@@ -378,7 +378,7 @@ class CSystem_Debug: public CSystem
      gDebug.console_custom_msg(1.f, 0.f, 0.f, 1.f, "Rojo");
      @endcode
      *
-     * Generar por consola los mensajes:
+     * Generará por consola los mensajes:
      *
      * <span style="font-weight: bold; background-color: black; color: #990099; display: block; padding: 5px;">Violeta</span>
      * <span style="font-weight: bold; background-color: black; color: #000099; display: block; padding: 5px;">Azul oscuro</span>
@@ -389,7 +389,7 @@ class CSystem_Debug: public CSystem
      * <span style="font-weight: bold; background-color: black; color: #FF0000; display: block; padding: 5px;">Rojo</span>
      *
      * @param color Color del mensaje.
-     * @param fmt Cuerpo, texto o mensaje del dilogo. Como si se usase "printf" de *C*.
+     * @param fmt Cuerpo, texto o mensaje del diálogo. Como si se usase "printf" de *C*.
      */
     void console_custom_msg(colorf_t color, const char* fmt, ...);
 
@@ -429,6 +429,10 @@ class CSystem_Debug: public CSystem
     // Systems
     void Console_command__SYSTEM_TIME_SETSCALE(std::string arguments);
     void Console_command__SYSTEM_USERINPUT_SHOW_JOYSTICKS(std::string arguments);
+    void Console_command__SYSTEM_SCHEDULER_SHOW(std::string arguments);
+    void Console_command__SYSTEM_TRANSFORM_BENCHMARK(std::string arguments);
+    void Console_command__SYSTEM_MEMORY_SHOW(std::string arguments);
+    void Console_command__SYSTEM_SPATIAL_SHOW(std::string arguments);
 
     // Game Objects
     void Console_command__GO_SHOW_TREE(std::string arguments);
@@ -450,6 +454,15 @@ class CSystem_Debug: public CSystem
     void Console_command__R_RESIZE_WINDOW(std::string arguments);
     void Console_command__R_DRAW_TRANSFORM(std::string arguments);
     void Console_command__R_DRAW_GRID(std::string arguments);
+    void Console_command__R_CULLING(std::string arguments);
+    void Console_command__R_QUEUE(std::string arguments);
+    void Console_command__R_INSTANCING(std::string arguments);
+    void Console_command__R_GLSTATE(std::string arguments);
+    void Console_command__R_STREAM(std::string arguments);
+    void Console_command__R_PARALLEL(std::string arguments);
+    void Console_command__R_PIPELINED(std::string arguments);
+    void Console_command__R_OCCLUSION(std::string arguments);
+    void Console_command__R_LOD(std::string arguments);
     void Console_command__R_FPS(std::string arguments);
     void Console_command__R_DRAW_SOUND(std::string arguments);
     void Console_command__R_GLINFO(std::string arguments);
@@ -458,14 +471,14 @@ class CSystem_Debug: public CSystem
 /**
  * @brief Objeto global del sistema "Debug".
  *
- * Se debe usar como nica estancia de dicho sistema. Para mayor comodidad, use el objeto gDebug,
+ * Se debe usar como única estancia de dicho sistema. Para mayor comodidad, use el objeto gDebug,
  * que es una referencia a este objeto.
  */
 extern CSystem_Debug gSystem_Debug;
 /**
  * @brief Objeto global del sistema "Debug".
  *
- * Se debe usar como nica estancia de dicho sistema.
+ * Se debe usar como única estancia de dicho sistema.
  */
 extern CSystem_Debug& gDebug;
 
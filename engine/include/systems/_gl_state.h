@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @brief Fichero que incluye la caché del estado de OpenGL.
+ */
+
+#ifndef __CSYSTEM_GL_STATE_H_
+#define __CSYSTEM_GL_STATE_H_
+
+#include "_globals.h"
+#include "_system.h"
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Número de unidades de textura cuyo enlace se recuerda. Las demás se cambian siempre.
+ */
+#define __GL_STATE_TEXTURE_UNITS 8
+
+/**
+ * @brief Estado de OpenGL.
+ *
+ * Espacio de nombres para los tipos de cambio de estado que cuenta CSystem_GL_State.
+ */
+namespace GL_State
+{
+  /**
+   * @brief Tipos de cambio de estado.
+   */
+  enum change_t { capability = 0, blend_func, depth_mask, active_texture, texture, program, vertex_array, __change_not_defined };
+
+  /** @brief Nombre de un tipo de cambio, para la consola. */
+  const char* change_to_string(change_t c);
+}
+
+/**
+ * @brief Caché del estado de OpenGL.
+ *
+ * Guarda una copia del estado que el motor cambia con más frecuencia (glEnable/glDisable, glBlendFunc, glDepthMask, glActiveTexture, glBindTexture,
+ * glUseProgram y glBindVertexArray), y sólo llama a OpenGL cuando el valor cambia. Todas las funciones devuelven true si han llegado a llamar a OpenGL.
+ *
+ * Para que la copia sea correcta, todo el motor cambia este estado a través de gGLState. El código que lo cambie directamente (callbacks de render,
+ * before_render y after_render, shaders de usuario...) debe llamar después a Invalidate(), que marca todo el estado como desconocido. CSystem_Render
+ * y CRender_Queue ya lo hacen después de llamar a los callbacks.
+ *
+ * Cuenta los cambios hechos y los evitados en cada iteración. La consola los muestra con el comando "r_glstate".
+ *
+ @code
+  gGLState.Enable(GL_BLEND);
+  gGLState.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  gGLState.ActiveTexture(GL_TEXTURE0);
+  gGLState.BindTexture(GL_TEXTURE_2D, texture->GetID());  // No llama a OpenGL si la textura ya estaba enlazada en la unidad 0
+ @endcode
+ */
+class CSystem_GL_State: public CSystem
+{
+  public:
+    /** @brief Contadores de una iteración. */
+    struct stats_t
+    {
+      uint changes[GL_State::__change_not_defined];  // Llamadas hechas a OpenGL
+      uint skipped[GL_State::__change_not_defined];  // Llamadas evitadas porque el valor no cambiaba
+    };
+
+  protected:
+    // -1 si no se conoce
+    int capabilities[8];
+    GLint blend_src, blend_dst;
+    int depth;
+    GLint active_unit;
+    GLint textures[__GL_STATE_TEXTURE_UNITS];
+    GLint current_program;
+    GLint current_vertex_array;
+
+    stats_t stats;
+    stats_t last_stats;
+
+    int CapabilityIndex(GLenum cap);
+
+    inline bool Changed(GL_State::change_t c)
+    {
+      stats.changes[c]++;
+      return true;
+    }
+
+    inline bool Skipped(GL_State::change_t c)
+    {
+      stats.skipped[c]++;
+      return false;
+    }
+
+  public:
+    CSystem_GL_State(): CSystem() { Invalidate(); ClearStats(); };
+
+    /** @brief Iniciar la caché. Lo llama CSystem_Render::Init(), una vez creado el contexto de OpenGL. */
+    bool Init();
+    void Close();
+    bool Reset();
+
+    /**
+     * @brief Empezar una iteración: guarda los contadores de la anterior y los pone a 0.
+     *
+     * Lo llama CSystem_Render::OnRender().
+     */
+    void OnFrame();
+
+    /** @brief Marcar todo el estado como desconocido, después de que se haya cambiado sin pasar por la caché. */
+    void Invalidate();
+
+    bool SetCapability(GLenum cap, bool state);
+
+    inline bool Enable(GLenum cap)
+    {
+      return SetCapability(cap, true);
+    }
+
+    inline bool Disable(GLenum cap)
+    {
+      return SetCapability(cap, false);
+    }
+
+    bool BlendFunc(GLenum src, GLenum dst);
+    bool DepthMask(bool state);
+    bool ActiveTexture(GLenum unit);
+
+    /** @brief Sólo se guarda GL_TEXTURE_2D. Con otros objetivos, se llama siempre a OpenGL. */
+    bool BindTexture(GLenum target, GLuint texture);
+    bool UseProgram(GLuint program);
+    bool BindVertexArray(GLuint vertex_array);
+
+    /** @brief VAO activo, o -1 si no se conoce. */
+    inline GLint VertexArray()
+    {
+      return current_vertex_array;
+    }
+
+    /** @brief Programa activo, o -1 si no se conoce. */
+    inline GLint Program()
+    {
+      return current_program;
+    }
+
+    /**
+     * @brief Avisar de que se ha borrado un objeto de OpenGL.
+     *
+     * OpenGL desenlaza los objetos al borrarlos, y su nombre se puede reutilizar después, así que hay que olvidarlo.
+     */
+    void TextureDeleted(GLuint texture);
+    void VertexArrayDeleted(GLuint vertex_array);
+    void ProgramDeleted(GLuint program);
+
+    /** @brief Contadores de la última iteración completa. */
+    inline const stats_t& Stats()
+    {
+      return last_stats;
+    }
+
+    void ClearStats();
+
+    /** @brief Mostrar los contadores de la última iteración por la consola. */
+    void PrintStats();
+};
+
+extern CSystem_GL_State gSystem_GL_State;
+extern CSystem_GL_State& gGLState;
+
+/*@}*/
+
+#endif /* __CSYSTEM_GL_STATE_H_ */
@@ -27,9 +27,9 @@ namespace Input
   /**
    * @brief Enum para conservar los estados de teclas.
    *
-   * Los estados que puede tener un botn se accin son los siguientes:
+   * Los estados que puede tener un botón se acción son los siguientes:
    *
-   * Identificador        | Valor | Descripcin
+   * Identificador        | Valor | Descripción
    * -------------------- | ----- | -----------
    * <i>key_keyup</i>     | -2    | Instante en el que se deja de presionar la tecla.
    * <i>key_unpressed</i> | -1    | Tecla sin presionar.
@@ -61,7 +61,7 @@ namespace Input
    * <i>pov_left</i>     | <i>pov_center</i> | <i>pov_right</i>
    * <i>pov_leftdown</i> | <i>pov_down</i>   | <i>pov_rightdown</i>
    *
-   * @warning En el caso de la librera SDL2, pocos povs son considerados como tales en un joystick.
+   * @warning En el caso de la librería SDL2, pocos povs son considerados como tales en un joystick.
    *
    * @see CSystem_UserInput::CJoystick
    */
@@ -74,7 +74,7 @@ namespace Input
   /**
    * @brief Enum para representar los estados de los diversos botones de un joystick.
    *
-   * Similar a keystate_t, los valores de esta enum sirven para recalcar los estados de un botn de un joystick.
+   * Similar a keystate_t, los valores de esta enum sirven para recalcar los estados de un botón de un joystick.
    * Sencillamente, hay 4 estados:
    *
    * - Siendo pulsado.
@@ -86,10 +86,10 @@ namespace Input
    * @see CSystem_UserInput::CJoyButton
    * @see CSystem_UserInput::CButton
    */
-  enum button_t { button_buttonup = -2 /**< Botn dejando de ser pulsado. */,
-                  button_unpressed = -1 /**< Botn sin pulsar. */,
-                  button_buttondown = 1,   /**< Botn siendo pulsado.*/
-                  button_pressed = 2, /**< Botn pulsado. */ };
+  enum button_t { button_buttonup = -2 /**< Botón dejando de ser pulsado. */,
+                  button_unpressed = -1 /**< Botón sin pulsar. */,
+                  button_buttondown = 1,   /**< Botón siendo pulsado.*/
+                  button_pressed = 2, /**< Botón pulsado. */ };
 }
 
 /**
@@ -244,7 +244,7 @@ class CSystem_UserInput: public CSystem
 
         //void OnEvent();
         void OnInput();
-        //void OnLoop(); // Debera usarse para comprobar si un joystick ha sido desconectado :L <- medianamente necesario
+        //void OnLoop(); // Debería usarse para comprobar si un joystick ha sido desconectado :L <- medianamente necesario
 
       public:
         /*vector<CAxis> GetAxes(){return axes;}
@@ -286,7 +286,7 @@ class CSystem_UserInput: public CSystem
 
 
   public:
-      // Axis - para el futuro, se sopotarn joysticks
+      // Axis - para el futuro, se sopotarán joysticks
     CKeyAxis axis1; // wasd
     CKeyAxis axis2; // arrows
 
@@ -342,7 +342,7 @@ class CSystem_UserInput: public CSystem
 
 typedef CSystem_UserInput InputClasses;
 
-// Crear 2 objetos: 1 para la configuracin de la aplicacin, y otra para guardar variables de usuario.
+// Crear 2 objetos: 1 para la configuración de la aplicación, y otra para guardar variables de usuario.
 extern CSystem_UserInput gSystem_UserInput;
 extern CSystem_UserInput& gUserInput;
 
@@ -0,0 +1,165 @@
+/**
+ * @file
+ * @brief Fichero que incluye el sistema de tareas (jobs) en paralelo.
+ */
+
+#ifndef __CSYSTEM_JOBS_H_
+#define __CSYSTEM_JOBS_H_
+
+#include "_globals.h"
+#include "_system.h"
+
+#include <deque>
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Función de una tarea.
+ *
+ * Recibe el puntero de datos con el que se lanzó la tarea y el rango [begin, end) que debe procesar.
+ */
+typedef void (*job_function_t)(void* data, uint begin, uint end);
+
+/**
+ * @brief Contador de tareas pendientes.
+ *
+ * Cada tarea lanzada con un contador lo incrementa, y lo decrementa al terminar. CSystem_Jobs::Wait() espera a que llegue a 0.
+ * Varias tareas pueden compartir contador, de forma que se puede esperar a un grupo de tareas, o encadenar grupos (un grupo
+ * no se lanza hasta que el anterior ha terminado).
+ */
+typedef SDL_atomic_t job_counter_t;
+
+/**
+ * @brief Sistema de tareas en paralelo.
+ *
+ * Mantiene un conjunto de hilos trabajadores, cada uno con su propia cola de tareas. Un hilo saca tareas del final de su cola,
+ * y cuando se queda sin ellas "roba" tareas del principio de la cola de otro hilo (work stealing), de forma que la carga se reparte sola.
+ *
+ * El hilo principal también participa: mientras espera a un contador (CSystem_Jobs::Wait()) ejecuta tareas pendientes en vez de bloquearse.
+ *
+ * El número de hilos se lee de la variable "__JOBS_NUMBER_THREADS" de CSystem_Data_Storage (contando el hilo principal).
+ * Con valor 0 se usa un hilo por núcleo. Con valor 1 no se crea ningún hilo y todas las tareas se ejecutan en el hilo que las lanza.
+ *
+ * Ejemplo:
+ *
+ @code
+  void Mover(void* data, uint begin, uint end)
+  {
+    vector3f* positions = (vector3f*)data;
+    for(uint i = begin; i < end; i++)
+      positions[i].y += 1.f;
+  }
+
+  gJobs.ParallelFor(&Mover, &positions[0], 0, positions.size());
+ @endcode
+ *
+ * Las tareas no deben usar OpenGL (el contexto pertenece al hilo principal) ni modificar estructuras compartidas sin sincronizar.
+ *
+ * @see __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_JOBS_NUMBER_THREADS
+ */
+class CSystem_Jobs: public CSystem
+{
+  protected:
+    struct job_t
+    {
+      job_function_t function;
+      void* data;
+      uint begin;
+      uint end;
+      job_counter_t* counter;
+    };
+
+    struct worker_t
+    {
+      std::deque<job_t> jobs;
+      SDL_mutex* mutex;
+      SDL_Thread* thread;
+      uint index;
+    };
+
+    std::vector<worker_t*> workers;  // workers[0] es el hilo principal
+    SDL_sem* semaphore;              // Una señal por tarea lanzada, para despertar a los hilos dormidos
+    SDL_atomic_t quit;
+    SDL_TLSID tls_worker;
+
+    static int WorkerThread(void* data);
+
+    worker_t* CurrentWorker();
+    void Push(worker_t* worker, const job_t& job);
+    bool Pop(worker_t* worker, job_t& job);
+    bool Steal(worker_t* thief, job_t& job);
+    bool RunPending(worker_t* worker);
+    void Execute(const job_t& job);
+
+  public:
+    CSystem_Jobs(): CSystem(), semaphore(NULL), tls_worker(0) {};
+
+    bool Init();
+    void Close();
+
+    /**
+     * @brief Número de hilos que ejecutan tareas, incluido el hilo principal.
+     */
+    inline uint NumThreads()
+    {
+      return workers.size() ? workers.size() : 1;
+    }
+
+    /**
+     * @brief Índice del hilo actual.
+     *
+     * @return Valor entre 0 y NumThreads(). El hilo principal, y cualquier hilo que no pertenezca al sistema, es el 0.
+     */
+    uint CurrentThread();
+
+    /**
+     * @brief Lanzar una tarea.
+     *
+     * La tarea se añade a la cola del hilo actual y se ejecutará en cualquier hilo. La función vuelve inmediatamente.
+     *
+     * @param function Función a ejecutar.
+     * @param data Datos que recibe la función.
+     * @param begin Inicio del rango que recibe la función.
+     * @param end Fin (no incluido) del rango que recibe la función.
+     * @param counter Contador que se incrementa ahora y se decrementa al terminar la tarea. Puede ser NULL.
+     */
+    void Run(job_function_t function, void* data, uint begin, uint end, job_counter_t* counter);
+
+    /**
+     * @brief Esperar a que un contador llegue a 0.
+     *
+     * Mientras espera, el hilo ejecuta tareas pendientes (suyas o robadas).
+     */
+    void Wait(job_counter_t* counter);
+
+    /**
+     * @brief Ejecutar una tarea pendiente, si la hay.
+     *
+     * Permite al hilo principal colaborar con los trabajadores mientras espera a algo distinto de un contador.
+     *
+     * @return Devuelve true si se ha ejecutado alguna tarea, false en caso contrario.
+     */
+    bool Help();
+
+    /**
+     * @brief Ejecutar una función sobre un rango en paralelo.
+     *
+     * Divide el rango [begin, end) en bloques de "grain" elementos, los lanza como tareas y espera a que terminen todos.
+     * Puede llamarse desde dentro de otra tarea.
+     *
+     * @param function Función a ejecutar sobre cada bloque.
+     * @param data Datos que recibe la función.
+     * @param begin Inicio del rango.
+     * @param end Fin (no incluido) del rango.
+     * @param grain Elementos por bloque. Con 0 se elige según el número de hilos.
+     */
+    void ParallelFor(job_function_t function, void* data, uint begin, uint end, uint grain = 0);
+};
+
+extern CSystem_Jobs gSystem_Jobs;
+extern CSystem_Jobs& gJobs;
+
+/*@}*/
+
+#endif /* __CSYSTEM_JOBS_H_ */
@@ -5,20 +5,51 @@
 
 #include "_object.h"
 #include "_system.h"
+#include "systems/_command_buffer.h"
 
-// ->xPORHACER Cambiar los nombres de los mtodos de CSystem_GameObject_Manager por algo ms sencillo (AddGameObject -> Add).
+// ->xPORHACER Cambiar los nombres de los métodos de CSystem_GameObject_Manager por algo más sencillo (AddGameObject -> Add).
 class CSystem_GameObject_Manager: public CSystem
 {
   protected:
     friend class CSystem_Render;
     friend class CSystem_Debug;
-
-    std::map<std::string, CGameObject*> gameObjects;
+    friend class CSystem_Scheduler;
+    friend class CSystem_Static_Batching;
+
+    /**
+     * @brief Slot de la tabla de objetos.
+     *
+     * Relaciona el índice de un handle con la posición del objeto en el array denso "gameObjects".
+     */
+    struct gameObject_slot_t
+    {
+      CGameObject* go;
+      int dense_index;  // Posición en gameObjects, -1 si está libre
+      uint generation;  // Aumenta cada vez que se libera el slot
+    };
+
+    std::vector<CGameObject*> gameObjects;                 // Array denso, usado para iterar
+    std::vector<gameObject_slot_t> slots;                  // Tabla de slots, indexada por handle
+    std::vector<int> free_slots;                           // Slots libres para reutilizar
+    std::map<std::string, CGameObject*> gameObjects_names; // Índice secundario por nombre (Get, operator[], Search...)
+    std::vector<CGameObject*> parallel_objects;            // Objetos marcados como paralelos en la iteración actual
+    std::vector<gameObject_handle_t> iteration;            // Copia de los handles de gameObjects durante OnEvent(), OnInput() y OnLoop()
+    Components::signature_t scheduled_components;         // Componentes cuyo OnLoop ejecuta CSystem_Scheduler, no OnLoop()
+    std::vector<CCommand_Buffer*> command_buffers;         // Un buffer de cambios por hilo de CSystem_Jobs
     //map<string, function_t> gameObjects_functions;
-    int last_ID;
+
+    gameObject_handle_t AllocSlot(CGameObject* go);
+    void FreeSlot(CGameObject* go);
+    void ClearSlots();
+
+    // Copiar los handles a "iteration". Borrar un objeto mueve el último del array denso a su hueco, así que no se puede iterar sobre
+    // gameObjects mientras los callbacks borran objetos
+    void SnapshotHandles();
+
+    static void ParallelLoop(void* data, uint begin, uint end);
 
   public:
-    CSystem_GameObject_Manager(): CSystem() {};
+    CSystem_GameObject_Manager(): CSystem(), scheduled_components(0) {};
 
     bool Init();
     void Close();
@@ -38,8 +69,7 @@ class CSystem_GameObject_Manager: public CSystem
     bool Delete(std::string name, bool delete_children = true);
     void DeleteAll();
     void DeleteAll_NonPreserved();
-    bool Remove(std::string name, bool remove_children = true); // ->PORHACER Hay que probar la funcin CSystem_GameObject_Manager::Remove().
-      bool RebuildIndex(); // <- Mecanismo insano, pero puesto por si acaso (quien coo llega a 4 mil millones de objetos?)
+    bool Remove(std::string name, bool remove_children = true); // ->PORHACER Hay que probar la función CSystem_GameObject_Manager::Remove().
 
     std::vector<CGameObject*> Search(std::string prefix);
 
@@ -49,6 +79,44 @@ class CSystem_GameObject_Manager: public CSystem
     CGameObject* Get(std::string name);
     CGameObject* operator[](std::string name);
 
+    CGameObject* Get(gameObject_handle_t handle);
+    bool IsValid(gameObject_handle_t handle);
+
+    inline uint Size()
+    {
+      return gameObjects.size();
+    }
+
+    /**
+     * @brief Excluir componentes de OnLoop().
+     *
+     * Los componentes indicados no se actualizan desde OnLoop(), porque tienen su propio sistema en CSystem_Scheduler.
+     *
+     * @param mask Máscara de componentes (véase Components::bit()).
+     */
+    inline void SetScheduledComponents(Components::signature_t mask)
+    {
+      scheduled_components = mask;
+    }
+
+    /**
+     * @brief Buffer de cambios estructurales del hilo actual.
+     *
+     * Los callbacks de los objetos deben usar este buffer, en vez de Add(), Delete() o CGameObject::AddChild(), para cambiar la estructura de los objetos
+     * durante la iteración.
+     *
+     * @see CCommand_Buffer
+     */
+    CCommand_Buffer& Commands();
+
+    /**
+     * @brief Aplicar los cambios de todos los buffers.
+     *
+     * Se llama automáticamente al final de cada iteración de CSystem_Scheduler. Se aplican primero las creaciones (reservando espacio para todas a la vez),
+     * después los cambios de jerarquía y de componentes, y por último los borrados. Los cambios sobre objetos que no pertenezcan al gestor se ignoran.
+     */
+    void ApplyCommands();
+
     void DisableGameObject(std::string name, bool recursive = true);
     void EnableGameObject(std::string name, bool recursive = true);
     void SetGameObjectState(std::string name, bool state = true, bool recursive = true);
@@ -0,0 +1,268 @@
+/**
+ * @file
+ * @brief Fichero que incluye el sistema de memoria (arena por clases de tamaño).
+ */
+
+#ifndef __CSYSTEM_MEMORY_H_
+#define __CSYSTEM_MEMORY_H_
+
+#include "_globals.h"
+#include "_system.h"
+
+#include <new>
+#include <utility>
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Tamaño mínimo de una página de CMemory_Arena.
+ */
+#define __MEMORY_ARENA_PAGE_SIZE 65536
+
+/**
+ * @brief Arena de memoria por clases de tamaño.
+ *
+ * Reparte bloques de memoria agrupados por clases de tamaño (16, 32, 48, 64, y 4 clases por cada potencia de 2 hasta 1 MB). Cada clase
+ * pide páginas grandes (al menos __MEMORY_ARENA_PAGE_SIZE bytes), las trocea, y guarda los bloques liberados en una lista para reutilizarlos,
+ * así que reservar y liberar no llaman a **new** ni a **delete** salvo al añadir una página nueva. Los bloques mayores que la última clase
+ * tienen su propia página, que se libera al liberar el bloque.
+ *
+ * Como los objetos del mismo tamaño se colocan juntos, crear y borrar muchos objetos de vida corta no fragmenta el heap.
+ *
+ * Release() devuelve de una vez toda la memoria de la arena. Si aún quedan bloques vivos (p.ej. de objetos preservados), sólo libera las páginas vacías.
+ *
+ * Reservar y liberar está protegido por un spinlock, así que se puede usar desde las tareas de CSystem_Jobs.
+ */
+class CMemory_Arena
+{
+  protected:
+    struct page_t
+    {
+      char* memory;
+      size_t size;
+      int size_class;  // -1 si es un bloque grande
+      uint used;       // Bloques vivos
+    };
+
+    struct size_class_t
+    {
+      size_t block_size;
+      void* free_list;  // Lista enlazada dentro de los propios bloques libres
+      page_t* current;  // Página de la que se siguen sacando bloques nuevos
+      size_t offset;    // Siguiente bloque sin usar de "current"
+    };
+
+    std::vector<size_class_t> classes;
+    std::map<char*, page_t*> pages;  // Por dirección de inicio
+    SDL_SpinLock lock;
+
+    size_t used_bytes;
+    size_t reserved_bytes;
+    uint num_allocations;
+
+    int SizeClass(size_t size);
+    page_t* FindPage(void* p);
+    page_t* AddPage(size_t size, int size_class);
+    void DeletePage(page_t* page);
+
+  public:
+    CMemory_Arena();
+    ~CMemory_Arena();
+
+    /**
+     * @brief Reservar memoria.
+     *
+     * @param size Tamaño en bytes.
+     * @return Puntero a memoria sin construir, alineado a 16 bytes.
+     */
+    void* Allocate(size_t size);
+
+    /**
+     * @brief Liberar memoria.
+     *
+     * @param p Puntero devuelto por Allocate().
+     * @param size Tamaño con el que se reservó.
+     * @return Devuelve true si la memoria pertenecía a la arena, false en caso contrario.
+     */
+    bool Free(void* p, size_t size);
+
+    /**
+     * @brief Liberar todas las páginas sin bloques vivos.
+     *
+     * Si no queda ningún bloque vivo, se liberan todas las páginas de una vez y se olvidan las listas de bloques libres.
+     *
+     * @return Bytes devueltos al sistema.
+     */
+    size_t Release();
+
+    /** @brief Bytes en uso (incluyendo el redondeo a la clase de tamaño). */
+    inline size_t Used()
+    {
+      return used_bytes;
+    }
+
+    /** @brief Bytes reservados en páginas. */
+    inline size_t Reserved()
+    {
+      return reserved_bytes;
+    }
+
+    /** @brief Número de bloques vivos. */
+    inline uint NumAllocations()
+    {
+      return num_allocations;
+    }
+
+    /** @brief Número de páginas. */
+    inline uint NumPages()
+    {
+      return pages.size();
+    }
+};
+
+/**
+ * @brief Sistema de memoria.
+ *
+ * Contiene la arena de la estancia actual (véase CMemory_Arena). Sólo sirve la memoria de tamaño variable de los objetos: los componentes de
+ * clases hijas (las que no caben en el pool de su tipo, véase __COMPONENT_POOL_IMPLEMENT) y los buffers de los emisores de partículas. También
+ * se puede usar en contenedores con Memory::allocator.
+ *
+ * Al cambiar de estancia, Systems_Reset() llama a Reset() después de borrar los objetos no preservados. Si no queda ningún bloque vivo, la
+ * memoria vuelve al sistema de una sola vez en lugar de objeto a objeto. Si quedan bloques de objetos preservados, sólo se liberan las páginas
+ * que se han quedado vacías: una página con un solo bloque vivo se mantiene entera.
+ *
+ * Los game objects y los componentes no salen de la arena, sino de un pool por tipo (véase CComponent_Pool). Los pools son de tamaño fijo y
+ * conservan sus bloques entre estancias, para reutilizarlos en la siguiente sin pedir memoria: no se liberan al cambiar de estancia.
+ *
+ * @see CComponent_Pool
+ */
+class CSystem_Memory: public CSystem
+{
+  protected:
+    CMemory_Arena instance_arena;
+
+  public:
+    CSystem_Memory(): CSystem() {};
+
+    bool Init();
+    void Close();
+    bool Reset();
+
+    /**
+     * @brief Reservar memoria de la arena de la estancia.
+     */
+    inline void* Allocate(size_t size)
+    {
+      return instance_arena.Allocate(size);
+    }
+
+    /**
+     * @brief Liberar memoria de la arena de la estancia.
+     *
+     * @return Devuelve true si la memoria pertenecía a la arena, false en caso contrario.
+     */
+    inline bool Free(void* p, size_t size)
+    {
+      return instance_arena.Free(p, size);
+    }
+
+    /**
+     * @brief Arena de la estancia actual.
+     */
+    inline CMemory_Arena& Arena()
+    {
+      return instance_arena;
+    }
+
+    /**
+     * @brief Mostrar el uso de memoria por la consola.
+     */
+    void PrintStats();
+};
+
+extern CSystem_Memory gSystem_Memory;
+extern CSystem_Memory& gMemory;
+
+/**
+ * @brief Memoria.
+ *
+ * Espacio de nombres para las utilidades de CSystem_Memory.
+ */
+namespace Memory
+{
+  /**
+   * @brief Allocator de la STL que usa la arena de la estancia.
+   *
+   * Ejemplo:
+   *
+   @code
+    std::vector<GLfloat, Memory::allocator<GLfloat> > data;
+   @endcode
+   */
+  template <class T>
+  class allocator
+  {
+    public:
+      typedef T value_type;
+      typedef T* pointer;
+      typedef const T* const_pointer;
+      typedef T& reference;
+      typedef const T& const_reference;
+      typedef size_t size_type;
+      typedef ptrdiff_t difference_type;
+
+      template <class U>
+      struct rebind
+      {
+        typedef allocator<U> other;
+      };
+
+      allocator() {}
+      template <class U> allocator(const allocator<U>&) {}
+
+      inline pointer allocate(size_type n, const void* hint = 0)
+      {
+        return (pointer)gSystem_Memory.Allocate(n * sizeof(T));
+      }
+
+      inline void deallocate(pointer p, size_type n)
+      {
+        if(p)
+          gSystem_Memory.Free(p, n * sizeof(T));
+      }
+
+      inline size_type max_size() const
+      {
+        return size_type(-1) / sizeof(T);
+      }
+
+      template <class U, class... Args>
+      inline void construct(U* p, Args&&... args)
+      {
+        ::new((void*)p) U(std::forward<Args>(args)...);
+      }
+
+      template <class U>
+      inline void destroy(U* p)
+      {
+        p->~U();
+      }
+  };
+
+  template <class T, class U>
+  inline bool operator==(const allocator<T>&, const allocator<U>&)
+  {
+    return true;
+  }
+
+  template <class T, class U>
+  inline bool operator!=(const allocator<T>&, const allocator<U>&)
+  {
+    return false;
+  }
+}
+
+/*@}*/
+
+#endif /* __CSYSTEM_MEMORY_H_ */
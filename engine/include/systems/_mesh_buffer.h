@@ -0,0 +1,113 @@
+/**
+ * @file
+ * @brief Fichero que incluye los buffers compartidos por varios modelos de CResource_Mesh.
+ */
+
+#ifndef __MESH_BUFFER_H_
+#define __MESH_BUFFER_H_
+
+#include "_globals.h"
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief VBO e IBO compartidos por varios modelos, con un único VAO.
+ *
+ * Con la opción "__RENDER_SHARED_MESH_BUFFERS", CSystem_Resources::LoadResourceFile() no sube cada modelo del fichero a sus propios buffers, sino
+ * que los junta al final en uno de estos por formato de vértice (véase CResource_Mesh::Format()) y tipo de índice. Cada modelo ocupa un rango
+ * de vértices y otro de índices, y se dibuja con glDrawElementsBaseVertex(): sus índices siguen empezando en 0.
+ *
+ * Así, los modelos de un buffer comparten el VAO: CRender_Queue no lo cambia al pasar de uno a otro, y puede juntar sus copias en una sola
+ * llamada a glMultiDrawElementsIndirect().
+ *
+ * El tamaño se fija al crearlo, y el espacio de un modelo no se reutiliza al borrarlo. El buffer se borra con su último modelo (véase Release()).
+ */
+class CMesh_Buffer
+{
+  protected:
+    GLuint m_VBO;
+    GLuint m_IBO;
+    GLuint m_VAO;
+
+    flags_t format;         // Resources::mesh_format_t
+    GLenum index_type;
+    GLsizei vertex_size;
+    GLsizei index_size;
+
+    uint max_vertices, max_indices;
+    uint num_vertices, num_indices;   // Ya ocupados
+
+    uint users;             // Modelos que lo usan
+
+  public:
+    CMesh_Buffer(flags_t f, GLenum type, GLsizei size);
+    ~CMesh_Buffer();
+
+    /**
+     * @brief Crear los buffers y el VAO.
+     *
+     * @param vertices Número total de vértices de los modelos.
+     * @param indices Número total de índices de los modelos.
+     */
+    bool Create(uint vertices, uint indices);
+
+    /**
+     * @brief Copiar los vértices y los índices de un modelo.
+     *
+     * @param vertex_data Vértices, con el formato del buffer.
+     * @param vertices Número de vértices.
+     * @param index_data Índices, del tipo del buffer, empezando en 0.
+     * @param indices Número de índices.
+     * @param base_vertex Posición del primer vértice del modelo en el buffer.
+     * @param first_index Posición del primer índice del modelo en el buffer.
+     * @return false si no cabe.
+     */
+    bool Add(const void* vertex_data, uint vertices, const void* index_data, uint indices, GLint& base_vertex, GLuint& first_index);
+
+    inline void AddUser()
+    {
+      users++;
+    }
+
+    /** @brief Un modelo deja de usarlo. Devuelve true si era el último, y el buffer se puede borrar. */
+    inline bool Release()
+    {
+      return (users == 0 or --users == 0);
+    }
+
+    inline GLuint GetVAO()
+    {
+      return m_VAO;
+    }
+
+    inline GLuint GetVBO()
+    {
+      return m_VBO;
+    }
+
+    inline GLuint GetIBO()
+    {
+      return m_IBO;
+    }
+
+    inline flags_t Format()
+    {
+      return format;
+    }
+
+    inline GLenum IndexType()
+    {
+      return index_type;
+    }
+
+    /** @brief Bytes ocupados en la GPU. */
+    inline uint Bytes()
+    {
+      return max_vertices * vertex_size + max_indices * index_size;
+    }
+};
+
+/*@}*/
+
+#endif /* __MESH_BUFFER_H_ */
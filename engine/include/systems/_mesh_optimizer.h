@@ -0,0 +1,75 @@
+/**
+ * @file
+ * @brief Fichero que incluye las funciones que reordenan los índices y los vértices de los modelos de CResource_Mesh.
+ */
+
+#ifndef __MESH_OPTIMIZER_H_
+#define __MESH_OPTIMIZER_H_
+
+#include "_globals.h"
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Tamaño de la caché de vértices (LRU) que supone OptimizeVertexCache().
+ */
+#define __MESH_OPTIMIZER_CACHE_SIZE 32
+
+/**
+ * @brief Tamaño de la caché de vértices (FIFO) con la que OptimizeOverdraw() mide cuánto empeora la caché al reordenar.
+ */
+#define __MESH_OPTIMIZER_FIFO_SIZE 16
+
+/**
+ * @brief Reordenación de modelos indexados.
+ *
+ * Funciones que CResource_Mesh aplica al cargar cada nivel de detalle, en este orden:
+ *
+ * <ol>
+ * <li>OptimizeVertexCache(): ordena los triángulos para reutilizar los vértices ya procesados por la GPU (algoritmo de Tom Forsyth).
+ * <li>OptimizeOverdraw(): parte ese orden en grupos de triángulos seguidos, y dibuja antes los grupos más hacia fuera del modelo, para que tapen
+ *     a los de dentro y se descarten más fragmentos por profundidad. Sólo corta donde la caché de vértices apenas empeora.
+ * <li>OptimizeVertexFetch(): numera los vértices en el orden en que los usan los índices, para leerlos de memoria de forma secuencial.
+ * </ol>
+ *
+ * No usan OpenGL: sólo cambian los vectores que reciben.
+ */
+namespace MeshOptimizer
+{
+  /**
+   * @brief Ordenar los triángulos para la caché de vértices.
+   *
+   * @param indices Índices de los triángulos (3 por triángulo). Se reordenan los triángulos, no los vértices de cada uno.
+   * @param num_vertices Número de vértices del modelo.
+   */
+  void OptimizeVertexCache(std::vector<uint>& indices, uint num_vertices);
+
+  /**
+   * @brief Ordenar grupos de triángulos de fuera hacia dentro, para reducir el *overdraw*.
+   *
+   * @param indices Índices, ya ordenados con OptimizeVertexCache().
+   * @param positions Posición de cada vértice.
+   * @param threshold Cuánto puede empeorar la caché de vértices, como factor sobre el número medio de vértices procesados por triángulo (1.05 = un 5%).
+   */
+  void OptimizeOverdraw(std::vector<uint>& indices, const std::vector<glm::vec3>& positions, float threshold);
+
+  /**
+   * @brief Numerar los vértices en el orden en que se usan.
+   *
+   * @param indices Índices de todos los triángulos que se van a dibujar. Se cambian por los nuevos números.
+   * @param num_vertices Número de vértices del modelo.
+   * @param remap Para cada vértice original, su nuevo número, o -1 si ningún triángulo lo usa.
+   * @return Número de vértices usados.
+   */
+  uint OptimizeVertexFetch(std::vector<uint>& indices, uint num_vertices, std::vector<uint>& remap);
+
+  /**
+   * @brief Vértices procesados por triángulo (ACMR) con una caché FIFO de __MESH_OPTIMIZER_FIFO_SIZE. Entre 0.5 y 3; cuanto más bajo, mejor.
+   */
+  float ACMR(const std::vector<uint>& indices, uint num_vertices);
+}
+
+/*@}*/
+
+#endif /* __MESH_OPTIMIZER_H_ */
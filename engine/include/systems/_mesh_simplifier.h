@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @brief Fichero que incluye la simplificación de modelos para los niveles de detalle de CResource_Mesh.
+ */
+
+#ifndef __MESH_SIMPLIFIER_H_
+#define __MESH_SIMPLIFIER_H_
+
+#include "_globals.h"
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Peso de los planos que se añaden en los bordes abiertos del modelo, para que la simplificación no los encoja.
+ */
+#define __MESH_SIMPLIFIER_BORDER_WEIGHT 10.f
+
+/**
+ * @brief Coseno mínimo entre la normal de un triángulo antes y después de un colapso. Por debajo, el triángulo se da la vuelta o se deforma demasiado.
+ */
+#define __MESH_SIMPLIFIER_MIN_NORMAL_DOT 0.2f
+
+/**
+ * @brief Simplificación de modelos con métricas de error cuádricas (Garland y Heckbert).
+ *
+ * Cada vértice guarda la suma de las cuádricas de los planos de sus triángulos (ponderadas por su área), y el coste de llevar un vértice
+ * a otro es la distancia cuadrática media de su nueva posición a esos planos. Se colapsan primero las aristas más baratas, por pasadas:
+ * en cada una se ordenan todas, y se colapsan en orden las que no tocan la vecindad de otro colapso de la misma pasada.
+ *
+ * Los colapsos son de un vértice sobre otro ya existente, sin crear vértices nuevos: todos los niveles de detalle comparten los vértices
+ * del modelo original y sólo cambian los índices.
+ *
+ * La topología se mira por posición, así que las costuras de normales o coordenadas UV (vértices distintos en la misma posición) se
+ * simplifican como el resto. Al colapsar, cada vértice de la costura pasa al vértice del destino con el que comparte un triángulo, para
+ * conservar sus atributos. No se colapsan los vértices de aristas con más de dos triángulos, y los de los bordes abiertos sólo se mueven a lo
+ * largo del borde.
+ *
+ * Cada llamada a Simplify() parte del resultado de la anterior, así que una cadena de niveles se genera de más a menos detalle:
+ *
+ @code
+  CMesh_Simplifier simplifier(positions, indices);
+
+  std::vector<uint> lod;
+  float error = simplifier.Simplify(indices.size() / 6, lod);   // Mitad de triángulos
+  error = simplifier.Simplify(indices.size() / 12, lod);        // Una cuarta parte
+ @endcode
+ */
+class CMesh_Simplifier
+{
+  protected:
+    // Matriz simétrica 4x4: a00 a01 a02 a03 a11 a12 a13 a22 a23 a33, y la suma de los pesos
+    struct quadric_t
+    {
+      double a[10];
+      double w;
+    };
+
+    struct collapse_t
+    {
+      uint from, to;
+      float cost;
+
+      inline bool operator<(const collapse_t& other) const
+      {
+        return cost < other.cost;
+      }
+    };
+
+    std::vector<glm::vec3> positions;
+    std::vector<uint> weld;           // Primer vértice con la misma posición (el que representa a todos en la topología)
+    std::vector<uint> indices;        // Triángulos actuales, con los vértices originales
+    std::vector<quadric_t> quadrics;  // Por vértice representante
+    std::vector<bool> locked;
+    float error;                      // Coste máximo de los colapsos hechos hasta ahora
+
+    // Vecindad de cada vértice representante en la pasada actual: triángulos en adjacency[offsets[v]] a adjacency[offsets[v + 1]]
+    std::vector<uint> offsets;
+    std::vector<uint> adjacency;
+
+    void Weld();
+    void InitQuadrics();
+
+    bool Pass(uint target_triangles);
+    bool CanCollapse(uint from, uint to, const std::vector<uint>& collapse);
+
+  public:
+    /**
+     * @brief Preparar la simplificación de un modelo.
+     *
+     * @param p Posición de cada vértice.
+     * @param i Índices de los triángulos (3 por triángulo).
+     */
+    CMesh_Simplifier(const std::vector<glm::vec3>& p, const std::vector<uint>& i);
+
+    /**
+     * @brief Simplificar hasta un número de triángulos.
+     *
+     * Puede quedarse por encima si ya no quedan aristas que se puedan colapsar.
+     *
+     * @param target_triangles Triángulos que se quieren conseguir.
+     * @param out Índices del modelo simplificado.
+     * @return Error del resultado: raíz del mayor coste de los colapsos hechos (desde el modelo original), en las unidades del modelo.
+     */
+    float Simplify(uint target_triangles, std::vector<uint>& out);
+};
+
+/*@}*/
+
+#endif /* __MESH_SIMPLIFIER_H_ */
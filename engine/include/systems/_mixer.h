@@ -5,7 +5,7 @@
 #include "_system.h"
 #include "_object.h"
 
-// Ms sencillo:
+// Más sencillo:
 // Audio Source y Audio Listener como componentes, no como audio.
 class CSystem_Mixer: public CSystem
 {
@@ -30,7 +30,7 @@ class CSystem_Mixer: public CSystem
     ALuint GetFreeOneShot();
 
   public:
-    CGameObject* listener; // Si es invlido o no reconocido, se usar la cmara principal del Render como listener.
+    CGameObject* listener; // Si es inválido o no reconocido, se usará la cámara principal del Render como listener.
 
   public:
     CSystem_Mixer(): CSystem() {};
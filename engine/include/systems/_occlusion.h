@@ -0,0 +1,171 @@
+/**
+ * @file
+ * @brief Fichero que incluye el descarte por oclusión de CSystem_Render, con consultas de oclusión de OpenGL.
+ */
+
+#ifndef __OCCLUSION_H_
+#define __OCCLUSION_H_
+
+#include "_globals.h"
+#include "_object.h"
+#include "systems/_culling.h"
+
+#include <map>
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Iteraciones que se guarda el estado de un objeto que ya no se dibuja con la cámara. Después se borra su consulta.
+ */
+#define __OCCLUSION_MAX_UNSEEN 60
+
+/**
+ * @brief Fracción de su tamaño que se agranda la caja de cada objeto al consultarla, para que el propio objeto no la tape.
+ */
+#define __OCCLUSION_BOX_MARGIN 0.01f
+
+/**
+ * @brief Descarte por oclusión de una cámara.
+ *
+ * Cada modelo de CRender_Queue tiene una consulta de oclusión de OpenGL (GL_ANY_SAMPLES_PASSED). Al terminar de dibujar la cámara, con el
+ * depth buffer completo, se dibuja la caja envolvente de cada modelo sin escribir color ni profundidad, y la consulta dice si algún fragmento
+ * la ha pasado. El resultado se lee en la iteración siguiente, sin esperar a la GPU (si aún no está, se mantiene el anterior), y los modelos
+ * ocultos no se dibujan.
+ *
+ * Por usar el resultado de la iteración anterior, un objeto que aparece de detrás de otro tarda una iteración en dibujarse. A cambio, nunca se
+ * detiene la CPU esperando a la GPU. Para no perder objetos de más, se consideran visibles:
+ *
+ * <ul>
+ * <li>Los objetos nuevos, o que no se dibujaron con la cámara en la iteración anterior (su resultado es viejo).
+ * <li>Los objetos cuya caja corta el plano cercano de la cámara: sus caras delanteras se recortarían, y la consulta podría fallar estando a la vista.
+ * </ul>
+ *
+ * Las cajas se dibujan con "__flatShader" y un único cubo unidad, escalado en la matriz de modelo-vista. Los objetos se guardan por su
+ * gameObject_handle_t, y no por la dirección del componente: los pools reutilizan las direcciones, y un modelo nuevo heredaría el resultado
+ * del borrado.
+ *
+ * Necesita GL_ARB_occlusion_query2 (GL_ANY_SAMPLES_PASSED). Si no está, CSystem_Render no lo usa con ninguna cámara.
+ *
+ * CSystem_Render crea uno por cámara con la opción CComponent_Camera::occlusion_culling activada, y lo pasa a CRender_Queue::Submit().
+ * Todas sus funciones usan OpenGL, así que sólo se pueden llamar desde el hilo que tiene el contexto.
+ */
+class COcclusion_Culling
+{
+  public:
+    /** @brief Contadores de una iteración. */
+    struct stats_t
+    {
+      uint tested;        // Modelos comprobados
+      uint occluded;      // Modelos no dibujados por estar ocultos
+      uint queries;       // Consultas lanzadas
+      uint near_plane;    // Modelos que cortan el plano cercano, dibujados sin consulta
+    };
+
+  protected:
+    struct entry_t
+    {
+      GLuint query;
+      bool visible;
+      bool pending;       // Consulta lanzada y sin leer
+      uint last_frame;    // Última iteración en la que se dibujó con la cámara
+    };
+
+    // Por objeto (el que tiene el CComponent_Mesh_Render)
+    std::map<gameObject_handle_t, entry_t> entries;
+
+    const void* owner;
+    uint frame;
+
+    stats_t stats;
+    stats_t last_stats;
+
+    // Estado de OpenGL de las consultas
+    GLint box_modelview;
+    bool cull_face;
+
+    static GLuint m_BoxVBOVertices;
+    static GLuint m_BoxVAO;
+
+  public:
+    COcclusion_Culling(): owner(NULL), frame(0), box_modelview(-1), cull_face(false) { ClearStats(); }
+    ~COcclusion_Culling() { Clear(); }
+
+    /** @brief Crear el cubo de las consultas. Lo llama CSystem_Render::Init(). */
+    static bool InitRenderVBO();
+
+    /** @brief Saber si OpenGL permite las consultas (GL_ARB_occlusion_query2). */
+    static inline bool Supported()
+    {
+      return GLEW_ARB_occlusion_query2 != GL_FALSE;
+    }
+    static void CloseRenderVBO();
+
+    /** @brief Borrar todas las consultas y el estado de los objetos. */
+    void Clear();
+
+    /**
+     * @brief Cambiar la cámara a la que pertenece. Si cambia, se borra el estado de la anterior.
+     *
+     * @param o Cámara (puede ser cualquier puntero que la identifique).
+     */
+    void SetOwner(const void* o);
+
+    inline const void* Owner()
+    {
+      return owner;
+    }
+
+    /**
+     * @brief Empezar una iteración.
+     *
+     * Lee los resultados de las consultas lanzadas en las anteriores que ya estén disponibles, y borra los objetos que llevan más de
+     * __OCCLUSION_MAX_UNSEEN iteraciones sin dibujarse.
+     */
+    void BeginFrame();
+
+    /**
+     * @brief Saber si un objeto se debe dibujar en esta iteración.
+     *
+     * @param key Objeto con el CComponent_Mesh_Render.
+     * @return false si la última consulta del objeto, de la iteración anterior, dice que estaba oculto.
+     */
+    bool Visible(const gameObject_handle_t& key);
+
+    /**
+     * @brief Preparar el estado de OpenGL para lanzar consultas: sin escribir color ni profundidad, y sin descartar caras.
+     *
+     * @param projMatrix Matriz de proyección de la cámara.
+     */
+    void BeginQueries(const glm::mat4& projMatrix);
+
+    /**
+     * @brief Lanzar la consulta de un objeto para la iteración siguiente. Debe llamarse entre BeginQueries() y EndQueries().
+     *
+     * @param key Objeto con el CComponent_Mesh_Render.
+     * @param modelViewMatrix Matriz de modelo-vista del objeto.
+     * @param box Caja envolvente del modelo, en su espacio local.
+     * @param projMatrix Matriz de proyección de la cámara.
+     */
+    void Query(const gameObject_handle_t& key, const glm::mat4& modelViewMatrix, const Culling::aabb_t& box, const glm::mat4& projMatrix);
+
+    /** @brief Volver al estado de dibujo: escritura de color y profundidad activadas, y ningún VAO activo. */
+    void EndQueries();
+
+    inline uint Size()
+    {
+      return entries.size();
+    }
+
+    /** @brief Contadores de la última iteración terminada. */
+    inline const stats_t& Stats()
+    {
+      return last_stats;
+    }
+
+    void ClearStats();
+};
+
+/*@}*/
+
+#endif /* __OCCLUSION_H_ */
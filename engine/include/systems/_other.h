@@ -85,7 +85,7 @@ class CSystem_Math: public CSystem
 
     void Close() {}
 
-    // Geometra
+    // Geometría
     typedef struct cone_t
     {
       vector3f direction;
@@ -107,7 +107,7 @@ class CSystem_Math: public CSystem
       else if(color.a > 1.f) color.a = 1.f;
     }
 
-    // Aritmtica
+    // Aritmética
     float abs(float val)
     {
       return std::abs(val);
@@ -123,7 +123,7 @@ class CSystem_Math: public CSystem
        return ((x != 0) && !(x & (x - 1)));
     }
 
-    // trigonometra
+    // trigonometría
     inline void NormalizeAngles(GLfloat &deg_x, GLfloat &deg_y, GLfloat &deg_z)
     {
       if(deg_x < 0 ) deg_x = 360 + deg_x;
@@ -3,23 +3,17 @@
 
 #include "_object.h"
 #include "systems/_system.h"
+#include "systems/_render_queue.h"
+#include "systems/_occlusion.h"
 
 #define __RENDER_OPENGL_MIN_CORE "3.3.0"
 
-// Problema grave: alphablending
+// Objetos por bloque al grabar una cámara en paralelo. Cada bloque se graba en su propia CRender_Queue
+#define __RENDER_RECORD_CHUNK 256
+
+// Alphablending: los objetos transparentes se ordenan de atrás hacia delante en CRender_Queue, después de los opacos
 // http://blogs.msdn.com/b/shawnhar/archive/2009/02/18/depth-sorting-alpha-blended-objects.aspx
 // http://stackoverflow.com/questions/5793354/how-to-write-prevent-writing-to-opengl-depth-buffer-in-glsl
-/*
- * Parece que el "algoritmo" ser:
- *
- * Para cada objeto a dibujar:
- *   Si el objeto es transparente, aadir en el vector "lista_transparente", ordenando por la distancia hacia la cmara
- *   Si no es transparente, dibujar el objeto
- *
- * Desactivar la escritura al depth buffer
- * Para cada objeto en lista_transparente
- *     dibujar objetos de atrs hacia delante
- */
 
 namespace Render
 {
@@ -47,6 +41,104 @@ class CSystem_Render: public CSystem
     CGameObject* GUI_Camera;
 
     int current_camera;
+    CRender_Queue render_queue;                 // Lo que se dibuja con la cámara actual, ordenado por estado de OpenGL
+
+    // Grabación de una cámara: lo que ve, repartido en bloques de __RENDER_RECORD_CHUNK objetos que se pueden grabar en hilos distintos.
+    // Todo se copia de la cámara antes de lanzar las tareas, que no usan OpenGL ni tocan la cámara
+    struct camera_record_t
+    {
+      CComponent_Camera* camera;
+      bool draw;                              // Cámara activa en esta iteración
+      glm::mat4 projMatrix;
+      glm::mat4 modelViewMatrix;
+      glm::mat4 normalMatrix;
+      Culling::frustum_t frustum;
+      bool culling;
+      bool parallel;                          // Repartir los bloques entre los hilos de CSystem_Jobs
+      bool recorded;                          // Grabada antes de empezar a dibujar
+      bool occlusion;                         // Descarte por oclusión (CComponent_Camera::occlusion_culling)
+      uint index;                             // Posición de la cámara en camera_list
+      float lod_height;                       // Alto en píxeles de la ventana de la cámara, para los niveles de detalle
+      float lod_error;                        // "__RENDER_LOD_PIXEL_ERROR", o 0 sin niveles de detalle
+
+      // Estado de la cámara con el que se dibuja
+      viewportf_t viewport;
+      bool clear;
+      colorf_t background_color;
+      GLuint skybox_texture;                  // 0 si no tiene skybox
+      glm::vec3 position;
+
+      std::vector<CGameObject*> visible;      // Objetos de CSystem_Spatial dentro del frustum
+      std::vector<CGameObject*>* objects;     // "visible", o todos los objetos sin culling
+      std::vector<CRender_Queue*> chunks;     // Una cola por bloque. Sólo crecen
+      uint num_chunks;
+
+      camera_record_t(): camera(NULL), draw(false), culling(false), parallel(false), recorded(false), occlusion(false), index(0), lod_height(0.f), lod_error(0.f), clear(false), skybox_texture(0), objects(NULL), num_chunks(0) {}
+    };
+
+    // Todo lo que se dibuja en una iteración. Hay dos: con "__RENDER_PIPELINED", el hilo de render dibuja una mientras la simulación prepara la otra
+    struct frame_t
+    {
+      std::vector<camera_record_t*> cameras;  // Una por cámara de camera_list
+
+      // Opciones de CSystem_Data_Storage, para no leerlas desde el hilo de render
+      bool queue;
+      bool instancing;
+      int width, height;
+      bool grid;
+      GLint grid_cols, grid_rows;
+      GLfloat grid_cols_scale, grid_rows_scale;
+
+      // Cámara de la GUI y texturas a dibujar con ella
+      viewportf_t gui_viewport;
+      glm::mat4 gui_projMatrix;
+      glm::mat4 gui_modelViewMatrix;
+      glm::mat4 gui_normalMatrix;
+      std::vector<CComponent_GUI_Texture*> gui_textures;    // En el orden de dibujo
+      std::vector<CComponent_GUI_Texture::draw_t> gui;
+
+      frame_t(): queue(false), instancing(false), width(0), height(0), grid(false), grid_cols(0), grid_rows(0), grid_cols_scale(1.f), grid_rows_scale(1.f) {}
+    };
+
+    frame_t frames[2];
+    uint current_frame;
+
+    // Descarte por oclusión de cada posición de camera_list. Guarda consultas de OpenGL, así que sólo lo usa el hilo que dibuja
+    std::vector<COcclusion_Culling*> occlusion_culling;
+    COcclusion_Culling* GetOcclusion(camera_record_t* record);
+
+    void SetUpFrame(frame_t* frame);
+    void SetUpRecord(camera_record_t* record, CComponent_Camera* cam, bool culling, bool parallel);
+    void SetUpGUI(frame_t* frame);
+
+    // Actualizar en el hilo principal las matrices de mundo y los volúmenes envolventes, antes de grabar. Los objetos creados o emparentados
+    // al aplicar los cambios de CSystem_GameObject_Manager, y los que mueven los callbacks de las cámaras, llegan con la caché sin actualizar;
+    // las tareas de grabación sólo la leen
+    void PrepareRecord();
+
+    // Tareas de CSystem_Jobs. "data" es un camera_record_t (o un frame_t, en CollectGUI())
+    static void RecordCamera(void* data, uint begin, uint end);
+    static void RecordChunk(void* data, uint begin, uint end);
+    static void CollectGUI(void* data, uint begin, uint end);
+
+    // Dibujo de una iteración ya grabada. Sólo usan lo guardado en frame_t, así que sirven en los dos hilos
+    void DrawFrame(frame_t* frame);
+    void DrawCamera(frame_t* frame, camera_record_t* record);
+    void DrawGUI(frame_t* frame);
+
+    // Modo en tubería: el hilo de render es el dueño del contexto de OpenGL mientras está en marcha
+    SDL_Thread* render_thread;
+    SDL_sem* frame_ready;         // La simulación ha dejado una iteración en pending_frame
+    SDL_sem* frame_done;          // El hilo de render ha terminado la última iteración (y está libre)
+    frame_t* pending_frame;
+    SDL_atomic_t thread_quit;
+    SDL_atomic_t thread_ok;       // El hilo de render ha podido tomar el contexto
+
+    // Frames que se pueden dibujar en el hilo de render: ningún elemento llama a código del usuario
+    bool CanPipeline(frame_t* frame);
+    bool StartPipeline();
+    void Publish(frame_t* frame);
+    static int RenderThread(void* data);
 
     // Skybox VBO
     GLuint m_SkyboxVBOVertices;                     // Vertex VBO Name
@@ -58,6 +150,7 @@ class CSystem_Render: public CSystem
     GLuint m_GridVBOColors;                       // Vertex VBO Name
     GLuint m_GridVBO_numcols;
     GLuint m_GridVBO_numrows;
+    GLsizeiptr m_GridVBO_size;                    // Bytes reservados en cada VBO. Sólo se vuelven a reservar si la rejilla crece
     GLuint m_GridVAO;
 
     //bool multitexture_supported;
@@ -69,14 +162,14 @@ class CSystem_Render: public CSystem
       CGameObject* go;
       uint count;
     }
-    map<string, gameObject_Render_count_t> r_gameObjects; // <- ESTO!!
+    map<string, gameObject_Render_count_t> r_gameObjects; // <- ¡¡ESTO!!
 
     bool AddToRender(CGameObject* go)
     {
       if(!go) return false;
 
       map<string, gameObject_Render_count_t>::iterator it = r_gameObjects.find(go->GetName());
-      if(it != r_gameObjects.end()) // Ya existe, no se aade
+      if(it != r_gameObjects.end()) // Ya existe, no se añade
         return false;
       else
       {
@@ -134,7 +227,7 @@ class CSystem_Render: public CSystem
     }
 
   public:
-    CSystem_Render(): CSystem(), window(NULL){ };
+    CSystem_Render(): CSystem(), window(NULL), current_frame(0), render_thread(NULL), frame_ready(NULL), frame_done(NULL), pending_frame(NULL) { };
 
     virtual bool Init();
       bool InitSkyboxVBO();
@@ -209,13 +302,32 @@ class CSystem_Render: public CSystem
 
     void RemoveCamera(const std::string& camera);
 
+    /**
+     * @brief Saber si el hilo de render está en marcha (véase "__RENDER_PIPELINED").
+     *
+     * Mientras lo está, el contexto de OpenGL pertenece al hilo de render: el hilo principal no puede usar OpenGL.
+     */
+    inline bool Pipelined()
+    {
+      return render_thread != NULL;
+    }
+
+    /**
+     * @brief Parar el hilo de render.
+     *
+     * Espera a que termine la iteración que está dibujando y devuelve el contexto de OpenGL al hilo principal. Hay que llamarla antes de usar
+     * OpenGL fuera del render (p.ej. para cargar recursos). Si el modo sigue activo, el hilo vuelve a arrancar en la siguiente iteración
+     * que se pueda dibujar en él. Si no está en marcha, no hace nada.
+     */
+    void StopPipeline();
+
     //inline void RenderGameObject(CGameObject* go);
   protected:
     void OnLoop();
     void OnRender();
-      void RenderGrid(CComponent_Camera* cam);
-      bool RenderSkybox(CComponent_Camera* cam);
-      inline void Clear();
+      void RenderGrid(frame_t* frame, camera_record_t* record);
+      bool RenderSkybox(camera_record_t* record);
+      void Clear(frame_t* frame);
       inline void RenderToScreen()
       {
         SDL_GL_SwapWindow(window);
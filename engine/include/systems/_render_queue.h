@@ -0,0 +1,302 @@
+/**
+ * @file
+ * @brief Fichero que incluye la cola de dibujo de CSystem_Render, ordenada por estado de OpenGL.
+ */
+
+#ifndef __RENDER_QUEUE_H_
+#define __RENDER_QUEUE_H_
+
+#include "_globals.h"
+#include "_object.h"
+
+class CShader;
+class CResource_Mesh;
+class CComponent_Mesh_Render;
+class CComponent_Particle_Emitter;
+class COcclusion_Culling;
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Número mínimo de copias seguidas de un modelo para dibujarlas con una sola llamada instanciada.
+ *
+ * Por debajo, sale más barato dibujarlas una a una que subir el buffer de instancias.
+ */
+#define __RENDER_QUEUE_MIN_INSTANCES 4
+
+/**
+ * @brief Número máximo de instancias por llamada. Los grupos más grandes se parten en varias llamadas.
+ */
+#define __RENDER_QUEUE_MAX_INSTANCES 1024
+
+/**
+ * @brief Cola de dibujo.
+ *
+ * Espacio de nombres para las claves de ordenación de CRender_Queue.
+ */
+namespace RenderQueue
+{
+  /**
+   * @brief Clave de ordenación de un elemento.
+   *
+   * 64 bits, de más a menos significativo:
+   *
+   * <ul>
+   * <li><b>Opacos:</b> pase (2 bits), transparencia (1 bit, a 0), shader (8), textura (12), modelo (12), profundidad (24), sin usar (5).
+   * <li><b>Transparentes:</b> pase (2 bits), transparencia (1 bit, a 1), profundidad invertida (24), shader (8), textura (12), modelo (12), sin usar (5).
+   * </ul>
+   *
+   * Así, los opacos se dibujan antes que los transparentes, agrupados por shader, textura y modelo, y de delante hacia atrás dentro de cada grupo
+   * (aprovechando el descarte por profundidad). Los transparentes se dibujan de atrás hacia delante, que es lo que necesita la mezcla.
+   * Los identificadores de shader, textura y modelo se truncan: si dos coinciden, sólo se pierde algo de agrupación.
+   */
+  typedef Uint64 key_t;
+
+  /**
+   * @brief Pases de dibujo. Un pase se dibuja completo antes que el siguiente.
+   */
+  enum pass_t { scene = 0, overlay, __pass_not_defined = 4 };
+
+  /**
+   * @brief Construir una clave.
+   *
+   * @param pass Pase (véase pass_t).
+   * @param translucent El elemento es transparente.
+   * @param shader Programa de OpenGL.
+   * @param texture Textura de OpenGL.
+   * @param mesh Identificador del modelo (véase CResource_Mesh::ID()). CRender_Queue añade en los 2 bits más bajos el nivel de detalle.
+   * @param depth Distancia a la cámara, en espacio de vista. Las negativas cuentan como 0.
+   */
+  key_t Key(pass_t pass, bool translucent, uint shader, uint texture, uint mesh, float depth);
+}
+
+/**
+ * @brief Cola de dibujo.
+ *
+ * CSystem_Render recoge en ella lo que ve cada cámara, en lugar de dibujarlo objeto a objeto: los modelos de CComponent_Mesh_Render, los emisores de
+ * partículas (transparentes), y los dummys y callbacks de render, que se dibujan con su propio estado de OpenGL y van después de los modelos opacos,
+ * en el orden en que se añadieron.
+ *
+ * Sort() ordena los elementos por su clave (véase RenderQueue::key_t) con una ordenación radix de 8 pasadas de 8 bits (se saltan las pasadas en
+ * las que todas las claves tienen el mismo byte), en tiempo lineal. Submit() los dibuja cambiando el estado a través de CSystem_GL_State, así
+ * que el programa, la textura y el VAO sólo se cambian cuando cambian de un elemento al siguiente.
+ *
+ * Además, si está activa la opción "__RENDER_INSTANCING", los modelos seguidos con el mismo modelo, textura y transparencia que usan el shader
+ * "__textureShader" (y no tienen callbacks before_render ni after_render) se dibujan con una sola llamada a glDrawArraysInstanced(), con el shader
+ * "__textureInstancedShader". La matriz de modelo-vista, el color y textureFlag de cada copia se escriben en CSystem_Stream_Buffer
+ * (véase __RENDER_QUEUE_MIN_INSTANCES).
+ *
+ * Si los modelos están en un buffer compartido (véase CMesh_Buffer) y hay GL_ARB_multi_draw_indirect y GL_ARB_base_instance, el grupo puede
+ * incluir modelos distintos del mismo buffer: cada modelo y nivel de detalle es un comando de glMultiDrawElementsIndirect(), con sus instancias
+ * a partir de baseInstance. Las instancias y los comandos se escriben juntos en CSystem_Stream_Buffer.
+ *
+ * Sólo Submit() usa OpenGL. El resto de funciones se pueden llamar desde cualquier hilo, siempre que cada cola la use un solo hilo a la vez.
+ *
+ * Los modelos y los emisores guardan al añadirse todo lo que necesitan para dibujarse (matrices, color, textura y una copia de las partículas), así que
+ * Submit() no vuelve a leer sus componentes, y la cola se puede dibujar mientras la escena sigue avanzando. Las excepciones son los callbacks:
+ * los dummys, el callback de render del objeto y los before_render y after_render de los modelos (véase HasCallbacks()).
+ *
+ * Ejemplo (lo que hace CSystem_Render con cada cámara, con la grabación repartida en varias colas):
+ *
+ @code
+  // En los hilos de CSystem_Jobs, un bloque de objetos por cola
+  chunk.Clear();
+  for(...)
+    go->OnRender(projMatrix, modelViewMatrix, &frustum, &chunk);
+
+  // En el hilo de OpenGL
+  queue.Clear();
+  for(...)
+    queue.Append(chunk);
+  queue.Sort();
+  queue.Submit(projMatrix, normalMatrix, instancing);
+ @endcode
+ */
+class CRender_Queue
+{
+  public:
+    /** @brief Contadores de la última llamada a Submit(). */
+    struct stats_t
+    {
+      uint items;
+      uint draws;     // Llamadas de dibujo de modelos (una por grupo instanciado)
+      uint instanced; // Grupos instanciados
+      uint programs;  // Cambios de programa
+      uint textures;  // Cambios de textura
+      uint meshes;    // Cambios de VAO
+      uint multidraws; // Grupos de varios modelos de un buffer compartido, con glMultiDrawElementsIndirect()
+      uint triangles; // Triángulos de modelos dibujados
+      uint reduced;   // Modelos dibujados con un nivel de detalle simplificado
+    };
+
+  protected:
+    enum item_type_t { mesh_item = 0, particles_item, custom_item };
+
+    struct item_t
+    {
+      RenderQueue::key_t key;
+      item_type_t type;
+      bool translucent;
+
+      CGameObject* gameObject;        // Sólo se usa al dibujar en los callbacks; puede estar ya borrado en modo en tubería
+      gameObject_handle_t handle;     // Para el descarte por oclusión
+      CComponent_Mesh_Render* mesh_render;
+      CComponent_Particle_Emitter* particle_emitter;
+
+      CShader* shader;
+      CResource_Mesh* mesh;
+      GLuint texture;
+      bool error_mesh;  // El modelo no existe: se dibuja el modelo de error en color rosa
+      bool instanceable;
+      bool callbacks;   // Modelo con before_render o after_render
+      uint lod;         // Nivel de detalle del modelo
+
+      glm::mat4 modelViewMatrix;
+      glm::mat4 normalMatrix;   // Parte del objeto: se multiplica por la de la cámara al dibujar
+      glm::vec4 color;
+      GLfloat texture_flag;
+
+      uint particle_data;       // Posición de las partículas en "particle_data": posiciones, ángulo y escala, y colores, seguidos
+      uint particle_count;
+    };
+
+    // Atributos de cada instancia en "__textureInstancedShader" (posiciones 3 a 8), seguidos en este orden
+    struct instance_t
+    {
+      glm::mat4 modelViewMatrix;
+      glm::vec4 color;
+      GLfloat texture_flag;
+    };
+
+    // Comando de glMultiDrawElementsIndirect()
+    struct indirect_t
+    {
+      GLuint count;
+      GLuint instance_count;
+      GLuint first_index;
+      GLint base_vertex;
+      GLuint base_instance;
+    };
+
+    struct sort_t
+    {
+      RenderQueue::key_t key;
+      uint index;
+    };
+
+    std::vector<item_t> items;
+    std::vector<sort_t> order;
+    std::vector<sort_t> scratch;
+    uint num_custom;
+    uint num_callbacks;
+    stats_t stats;
+
+    std::vector<GLfloat> particle_data;   // Copia de las partículas de los emisores añadidos
+
+    // Cámara con la que se eligen los niveles de detalle (véase SetView())
+    uint lod_camera;
+    glm::mat4 lod_projMatrix;
+    float lod_height;
+    float lod_error;
+
+    std::vector<instance_t> instances;  // Se copian a CSystem_Stream_Buffer antes de cada llamada instanciada
+    std::vector<indirect_t> commands;
+    std::vector<Uint8> indirect_data;   // Instancias y comandos seguidos, para escribirlos con una sola llamada a CSystem_Stream_Buffer::Write()
+    bool multidraw;             // Agrupar modelos distintos de un mismo CMesh_Buffer
+    CShader* texture_shader;    // Los modelos con este shader se pueden instanciar
+
+    // Último shader cuyos uniforms de cámara se han puesto en Submit()
+    CShader* current_shader;
+
+    void SetShader(CShader* shader, const glm::mat4& projMatrix);
+    void SetState(const item_t& item);
+
+    uint Batch(uint first);
+    bool DrawInstanced(uint first, uint count, const glm::mat4& projMatrix);
+    void SetInstanceAttributes(GLintptr offset);
+
+  public:
+    CRender_Queue(): num_custom(0), num_callbacks(0), lod_camera(0), lod_height(0.f), lod_error(0.f), multidraw(false), texture_shader(NULL), current_shader(NULL) { stats.items = stats.draws = stats.instanced = stats.programs = stats.textures = stats.meshes = stats.multidraws = stats.triangles = stats.reduced = 0; }
+
+    /** @brief Vaciar la cola. */
+    void Clear();
+
+    /** @brief Liberar la memoria de las instancias y de las partículas. Lo llama CSystem_Render::Close(). */
+    void Close();
+
+    /**
+     * @brief Cámara con la que se eligen los niveles de detalle de los modelos que se añadan (véase CComponent_Mesh_Render::SelectLOD()).
+     *
+     * @param camera Posición de la cámara en la lista de CSystem_Render.
+     * @param projMatrix Matriz de proyección de la cámara.
+     * @param viewport_height Alto en píxeles de la ventana de la cámara.
+     * @param max_error Error máximo en píxeles (opción "__RENDER_LOD_PIXEL_ERROR"), o 0 para dibujar siempre los modelos originales.
+     */
+    void SetView(uint camera, const glm::mat4& projMatrix, float viewport_height, float max_error);
+
+    /**
+     * @brief Añadir un modelo.
+     *
+     * Resuelve el shader, el modelo, la textura y el nivel de detalle del componente, que no se vuelven a buscar al dibujar.
+     */
+    void Add(CComponent_Mesh_Render* mesh_render, const glm::mat4& modelViewMatrix);
+
+    /** @brief Añadir un emisor de partículas. Siempre es transparente. */
+    void Add(CComponent_Particle_Emitter* particle_emitter, const glm::mat4& modelViewMatrix);
+
+    /**
+     * @brief Añadir los dummys y el callback de render de un objeto.
+     *
+     * Se dibujan con CGameObject::OnRenderCallbacks(), después de los modelos opacos y en el orden en que se añadieron.
+     */
+    void AddCustom(CGameObject* go, const glm::mat4& modelViewMatrix);
+
+    /**
+     * @brief Añadir los elementos de otra cola, detrás de los que ya hay.
+     *
+     * CSystem_Render graba cada bloque de objetos en su propia cola, en los hilos de CSystem_Jobs, y las junta después con esta función.
+     */
+    void Append(const CRender_Queue& other);
+
+    /** @brief Ordenar los elementos por su clave. */
+    void Sort();
+
+    /**
+     * @brief Dibujar los elementos en el orden de Sort() (o en el orden en que se añadieron, si no se ha llamado).
+     *
+     * Al terminar, deja la escritura en el depth buffer activada y ningún VAO activo.
+     *
+     * @param projMatrix Matriz de proyección de la cámara.
+     * @param normalMatrix Inversa traspuesta de la matriz de vista de la cámara (véase CComponent_Camera::NormalMatrix()).
+     * @param instancing Agrupar las copias de un modelo en llamadas instanciadas (opción "__RENDER_INSTANCING").
+     * @param occlusion Descarte por oclusión de la cámara, o NULL para dibujarlo todo. No se dibujan los modelos que su última consulta dio por
+     * ocultos, y al terminar se lanzan las consultas de todos los modelos para la iteración siguiente (véase COcclusion_Culling). Se debe haber
+     * llamado antes a COcclusion_Culling::BeginFrame().
+     */
+    void Submit(const glm::mat4& projMatrix, const glm::mat4& normalMatrix, bool instancing, COcclusion_Culling* occlusion = NULL);
+
+    inline uint Size()
+    {
+      return items.size();
+    }
+
+    /**
+     * @brief Saber si algún elemento llama a código del usuario al dibujarse.
+     *
+     * Los callbacks leen la escena en el momento de dibujar, así que una cola que los tenga no se puede dibujar en otro hilo.
+     */
+    inline bool HasCallbacks()
+    {
+      return num_callbacks > 0;
+    }
+
+    inline const stats_t& Stats()
+    {
+      return stats;
+    }
+};
+
+/*@}*/
+
+#endif /* __RENDER_QUEUE_H_ */
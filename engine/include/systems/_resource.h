@@ -3,11 +3,15 @@
 
 #include "_globals.h"
 #include "systems/_system.h"
+#include "systems/_culling.h"
+
+class CMesh_Buffer;
 
 namespace Resources
 {
   enum types_t {base, mesh, texture, sound, font};
   enum enum_loadgltexture {texture_none = 0x00, texture_mipmap = 0x01, texture_linear = 0x02, texture_nearest = 0x04 }; // metodos para cargar la textura
+  enum mesh_format_t {mesh_float = 0x00, mesh_position_16 = 0x01, mesh_uv_16 = 0x02}; // formato de los vértices de cada modelo (véase CResource_Mesh::Format())
 }
 
 class CResource
@@ -30,8 +34,28 @@ class CResource
     std::string File(){ return rc_file; }
 };
 
+// Niveles de detalle de los modelos, contando el original. Cada uno tiene la mitad de triángulos que el anterior
+#define __MESH_LOD_LEVELS 4
+// Los modelos con menos triángulos no se simplifican
+#define __MESH_LOD_MIN_TRIANGLES 256
+// Un nivel sólo se guarda si tiene como mucho esta fracción de los triángulos del anterior
+#define __MESH_LOD_MIN_REDUCTION 0.85f
+// Margen, como fracción del error máximo, para cambiar de nivel (véase CResource_Mesh::SelectLOD())
+#define __MESH_LOD_HYSTERESIS 0.25f
+// Cuánto puede empeorar la caché de vértices al reordenar los triángulos para el overdraw (véase MeshOptimizer::OptimizeOverdraw())
+#define __MESH_OVERDRAW_THRESHOLD 1.05f
+
 class CResource_Mesh: public CResource
 {
+  public:
+    /** @brief Nivel de detalle: rango de índices en el IBO y su error respecto al modelo original. */
+    struct lod_t
+    {
+      GLuint first;   // Primer índice
+      GLsizei count;  // Número de índices
+      float error;    // En unidades del modelo
+    };
+
   private:
     friend class CSystem_Resources;
     /*vector<GLfloat> vertexArray;
@@ -39,19 +63,237 @@ class CResource_Mesh: public CResource
     vector<GLfloat> uvArray;*/
 
     int numTriangles, numUvCoords;
-    GLuint m_ModelVBOVertices;
-    GLuint m_ModelVBONormals;
-    GLuint m_ModelVBOTexCoords;
+    std::vector<lod_t> lods;     // El 0 es el modelo original
+    GLuint m_ModelVBOVertices;   // Posición, UV y normal de cada vértice, intercalados (véase Format())
+    GLuint m_ModelIBO;           // Índices de todos los niveles de detalle, seguidos
     GLuint m_ModelVAO;
+    GLenum index_type;           // GL_UNSIGNED_SHORT si hay pocos vértices, o GL_UNSIGNED_INT
+    GLsizei index_size;
+
+    flags_t format;              // Resources::mesh_format_t
+    GLsizei vertex_size;
+    glm::mat4 dequantize;        // Del espacio de las posiciones de 16 bits al del modelo
+
+    // Vértices e índices (de index_type, empezando en 0) hasta que se suben a la GPU (véase Upload())
+    std::vector<Uint8> vertex_data;
+    std::vector<Uint8> index_data;
+    uint data_vertices, data_indices;
+    bool defer_upload;           // Lo pone CSystem_Resources para subirlo después a un CMesh_Buffer
+
+    CMesh_Buffer* shared;        // Buffer compartido con otros modelos, o NULL si tiene los suyos
+    GLint base_vertex;           // Posición del primer vértice y del primer índice en el buffer compartido
+    GLuint index_offset;
+
+    uint id;                     // Identificador para la clave de CRender_Queue (el VAO se puede compartir)
+    static uint next_id;
+
+    // Subir los datos de LoadFile() a un VBO, un IBO y un VAO propios
+    bool Upload();
+    // Usar un buffer compartido, en el que ya están sus datos
+    void SetShared(CMesh_Buffer* buffer, GLint base, GLuint first);
+    void FreeData();
+
+    Culling::bounds_t bounds;  // En espacio local, calculado al cargar
 
   public:
-    CResource_Mesh(): CResource(){ numTriangles = numUvCoords = 0; m_ModelVBOVertices = m_ModelVBONormals = m_ModelVBOTexCoords = 0; type = Resources::mesh; };
+    CResource_Mesh(): CResource(){ numTriangles = numUvCoords = 0; m_ModelVBOVertices = m_ModelIBO = m_ModelVAO = 0; index_type = GL_UNSIGNED_INT; index_size = sizeof(GLuint); format = Resources::mesh_float; vertex_size = 0; dequantize = glm::mat4(1.f); data_vertices = data_indices = 0; defer_upload = false; shared = NULL; base_vertex = 0; index_offset = 0; id = next_id++; type = Resources::mesh; };
     ~CResource_Mesh(){ Clear(); }
 
+    /**
+     * @brief Cargar un modelo con Assimp.
+     *
+     * Genera hasta __MESH_LOD_LEVELS niveles de detalle con CMesh_Simplifier, salvo para los modelos pequeños (véase __MESH_LOD_MIN_TRIANGLES).
+     *
+     * Se guarda indexado: un único VBO con los vértices de Assimp (véase Format()) y un IBO con los índices de todos los niveles, seguidos. Los
+     * triángulos de cada nivel se reordenan con MeshOptimizer para la caché de vértices y el *overdraw*, y los vértices en el orden en que se usan.
+     * Con la opción "__RENDER_SHARED_MESH_BUFFERS", CSystem_Resources::LoadResourceFile() los junta después en un CMesh_Buffer con los demás modelos
+     * del fichero.
+     *
+     * @param file Fichero del modelo.
+     * @param arguments "[índice del modelo en el fichero] [nolod] [quantize]", con las opciones en cualquier orden. Con "nolod" sólo se guarda el
+     * modelo original, y con "quantize" las posiciones se guardan en 16 bits (Resources::mesh_position_16).
+     */
     bool LoadFile(std::string file, std::string arguments = "");
+
+    /**
+     * @brief Crear un modelo a partir de sus vértices y triángulos, igual que LoadFile() (niveles de detalle, orden de los triángulos, formato...).
+     *
+     * @param positions Posición de cada vértice.
+     * @param uvs Coordenada UV de cada vértice, o vacío.
+     * @param normals Normal de cada vértice, o vacío.
+     * @param indices Tres índices por triángulo.
+     * @param lod Generar niveles de detalle.
+     * @param quantize Guardar las posiciones en 16 bits (Resources::mesh_position_16).
+     */
+    bool LoadFromMemory(const std::vector<glm::vec3>& positions, const std::vector<glm::vec2>& uvs, const std::vector<glm::vec3>& normals,
+                        const std::vector<uint>& indices, bool lod = true, bool quantize = false);
     void Clear();
 
-    void Render();
+    /**
+     * @brief Leer de la GPU los vértices y los triángulos de un nivel de detalle, en el espacio del modelo.
+     *
+     * Los vértices son todos los del modelo (también los que sólo usa el original). Las UV y las normales que no tenía el modelo valen 0 y (0, 0, 1).
+     * Lo usa CSystem_Static_Batching para juntar modelos.
+     */
+    bool GetGeometry(std::vector<glm::vec3>& positions, std::vector<glm::vec2>& uvs, std::vector<glm::vec3>& normals, std::vector<uint>& indices, uint lod = 0);
+
+    void Render(uint lod = 0);
+
+    /**
+     * @brief Activar el VAO del modelo, para dibujarlo con Draw().
+     *
+     * CRender_Queue lo llama sólo cuando cambia de modelo, y dibuja seguidas todas las copias del mismo.
+     */
+    void Bind();
+
+    /**
+     * @brief Dibujar el modelo con un nivel de detalle. Su VAO debe estar activo (véase Bind()).
+     *
+     * Sólo los modelos de un CMesh_Buffer usan las variantes BaseVertex (GL_ARB_draw_elements_base_vertex); los demás empiezan en el vértice 0.
+     */
+    inline void Draw(uint lod = 0)
+    {
+      const lod_t& level = lods[std::min(lod, (uint)lods.size() - 1)];
+      if(!shared)
+        glDrawElements(GL_TRIANGLES, level.count, index_type, (GLvoid*)((size_t)(index_offset + level.first) * index_size));
+      else
+        glDrawElementsBaseVertex(GL_TRIANGLES, level.count, index_type, (GLvoid*)((size_t)(index_offset + level.first) * index_size), base_vertex);
+    }
+
+    /** @brief Dibujar varias copias del modelo con una sola llamada. Su VAO debe estar activo, junto con los atributos de cada instancia. */
+    inline void DrawInstanced(uint count, uint lod = 0)
+    {
+      const lod_t& level = lods[std::min(lod, (uint)lods.size() - 1)];
+      if(!shared)
+        glDrawElementsInstanced(GL_TRIANGLES, level.count, index_type, (GLvoid*)((size_t)(index_offset + level.first) * index_size), count);
+      else
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, level.count, index_type, (GLvoid*)((size_t)(index_offset + level.first) * index_size), count, base_vertex);
+    }
+
+    /**
+     * @brief Activar los atributos de los vértices en el VAO y el VBO activos, para un formato (véase Format()).
+     *
+     * La usan los modelos con sus propios buffers y CMesh_Buffer.
+     */
+    static void SetVertexAttributes(flags_t format, GLsizei vertex_size);
+
+    inline uint NumLODs()
+    {
+      return lods.size();
+    }
+
+    /** @brief Vértices del modelo (los de todos los niveles de detalle). */
+    inline uint Vertices()
+    {
+      return data_vertices;
+    }
+
+    /** @brief Triángulos de un nivel de detalle. */
+    inline uint Triangles(uint lod = 0)
+    {
+      return lods.empty() ? 0 : lods[std::min(lod, (uint)lods.size() - 1)].count / 3;
+    }
+
+    /**
+     * @brief Elegir el nivel de detalle con el que dibujar el modelo.
+     *
+     * Se usa el más simple cuyo error, en píxeles, no pase de max_error, con un margen (__MESH_LOD_HYSTERESIS) para no cambiar de nivel
+     * en cada iteración cuando el objeto está cerca del límite.
+     *
+     * @param pixels_per_unit Píxeles que ocupa en pantalla una unidad del modelo (véase CComponent_Mesh_Render::SelectLOD()).
+     * @param max_error Error máximo en píxeles (opción "__RENDER_LOD_PIXEL_ERROR").
+     * @param current Nivel con el que se dibujó la última vez.
+     */
+    uint SelectLOD(float pixels_per_unit, float max_error, uint current);
+
+    /** @brief VAO del modelo, o el de su buffer compartido. */
+    GLuint GetVAO();
+
+    /** @brief Identificador único del modelo. CRender_Queue lo usa en sus claves en lugar del VAO, que pueden compartir varios modelos. */
+    inline uint ID()
+    {
+      return id;
+    }
+
+    /** @brief Buffer compartido en el que está el modelo, o NULL si tiene los suyos. */
+    inline CMesh_Buffer* Shared()
+    {
+      return shared;
+    }
+
+    /** @brief Posición del primer vértice del modelo en su VBO (0 si no está en un buffer compartido). */
+    inline GLint BaseVertex()
+    {
+      return base_vertex;
+    }
+
+    /** @brief Posición del primer índice de un nivel de detalle en su IBO. */
+    inline GLuint FirstIndex(uint lod = 0)
+    {
+      return index_offset + lods[std::min(lod, (uint)lods.size() - 1)].first;
+    }
+
+    /** @brief Número de índices de un nivel de detalle. */
+    inline GLsizei IndexCount(uint lod = 0)
+    {
+      return lods[std::min(lod, (uint)lods.size() - 1)].count;
+    }
+
+    /** @brief Tipo de los índices: GL_UNSIGNED_SHORT o GL_UNSIGNED_INT. */
+    inline GLenum IndexType()
+    {
+      return index_type;
+    }
+
+    /**
+     * @brief Formato de los vértices (Resources::mesh_format_t), elegido al cargar el modelo.
+     *
+     * <ul>
+     * <li>Atributo 0, posición: 3 floats, o 3 x 16 bits (*snorm*) dentro de la caja envolvente con Resources::mesh_position_16. Los shaders no
+     *     lo notan: la vuelta al espacio del modelo va en la matriz de modelo-vista (véase DequantizeMatrix()).
+     * <li>Atributo 1, UV: 2 floats, o 2 x 16 bits (*unorm*) con Resources::mesh_uv_16, que se usa si todas están entre 0 y 1.
+     * <li>Atributo 2, normal: siempre 2 x 16 bits (*snorm*), con la codificación octaédrica. Los shaders que la usan deben decodificarla:
+     @code
+      vec3 DecodeNormal(vec2 e)
+      {
+        vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+        if(n.z < 0.0)
+          n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+        return normalize(n);
+      }
+     @endcode
+     * </ul>
+     */
+    inline flags_t Format()
+    {
+      return format;
+    }
+
+    /** @brief Bytes de cada vértice en el VBO. */
+    inline GLsizei VertexSize()
+    {
+      return vertex_size;
+    }
+
+    /**
+     * @brief Matriz que lleva las posiciones del VBO al espacio del modelo. Identidad salvo con Resources::mesh_position_16.
+     *
+     * Se multiplica por la derecha a la matriz de modelo-vista al dibujar. La matriz normal no cambia: las normales no se escalan.
+     */
+    inline const glm::mat4& DequantizeMatrix()
+    {
+      return dequantize;
+    }
+
+    /**
+     * @brief Volumen envolvente del modelo, en espacio local.
+     *
+     * Se calcula al cargar el modelo. La esfera está centrada en la caja, con el radio justo para contener todos los vértices.
+     */
+    inline const Culling::bounds_t& Bounds()
+    {
+      return bounds;
+    }
 };
 
 class CResource_Texture: public CResource
@@ -137,6 +379,11 @@ class CSystem_Resources: public CSystem
     std::map<std::string, CResource*> resource_list;
     bool InitEngineResources();
 
+    // Modelos del fichero que se está cargando, para juntarlos en buffers compartidos (opción "__RENDER_SHARED_MESH_BUFFERS")
+    bool share_meshes;
+    std::vector<CResource_Mesh*> shared_meshes;
+    void BuildSharedBuffers();
+
     std::map<std::string, CResource*> GetList()
     {
       return resource_list;
@@ -152,6 +399,8 @@ class CSystem_Resources: public CSystem
 
     bool LoadResourceFile(std::string rc_file);
       bool LoadResource(std::string name, std::string rc_file, Resources::types_t type, std::string arguments = "");
+    /** @brief Añadir un recurso ya creado (p.ej. con CResource_Mesh::LoadFromMemory()). El sistema se encarga de borrarlo. */
+    bool AddResource(std::string name, CResource* resource);
     void AddEmpty(std::string name);
 
     void ClearNonEngineResources();
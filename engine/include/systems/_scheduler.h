@@ -0,0 +1,220 @@
+/**
+ * @file
+ * @brief Fichero que incluye el planificador de sistemas de actualización.
+ */
+
+#ifndef __CSYSTEM_SCHEDULER_H_
+#define __CSYSTEM_SCHEDULER_H_
+
+#include "_globals.h"
+#include "_system.h"
+#include "_object.h"
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Planificador.
+ *
+ * Espacio de nombres para los recursos y opciones de los sistemas de CSystem_Scheduler.
+ */
+namespace Scheduler
+{
+  /**
+   * @brief Recursos que no son componentes.
+   *
+   * Estado global que pueden leer o escribir los sistemas, además de los componentes. Sus bits van a continuación de los de Components::components_t,
+   * de forma que un mismo access_t puede contener ambos.
+   */
+  enum resources_t { input = Components::__component_not_defined, time, audio, gameobjects, render, behaviours, spatial, __resource_not_defined };
+
+  /**
+   * @brief Opciones de un sistema.
+   *
+   * <ul>
+   * <li><b>main_thread:</b> El sistema sólo puede ejecutarse en el hilo principal (OpenGL, eventos de SDL...).
+   * <li><b>parallel:</b> En sistemas de consulta, los objetos se reparten en bloques entre los hilos de CSystem_Jobs.
+   * </ul>
+   */
+  enum system_flags_t { none = 0x00, main_thread = 0x01, parallel = 0x02 };
+
+  /**
+   * @brief Máscara de acceso de un sistema.
+   *
+   * Bits de Components::components_t y de resources_t que un sistema lee o escribe.
+   */
+  typedef flags_t access_t;
+
+  /**
+   * @brief Bit de un componente.
+   */
+  inline access_t bit(Components::components_t c)
+  {
+    return (access_t)1 << c;
+  }
+
+  /**
+   * @brief Bit de un recurso.
+   */
+  inline access_t bit(resources_t r)
+  {
+    return (access_t)1 << r;
+  }
+}
+
+/**
+ * @brief Función de un sistema.
+ *
+ * Recibe los datos con los que se registró el sistema.
+ */
+typedef void (*scheduler_function_t)(void* data);
+
+/**
+ * @brief Función de un sistema de consulta.
+ *
+ * Se llama una vez por cada game object que tenga los componentes de la consulta.
+ */
+typedef void (*scheduler_query_function_t)(CGameObject* go, void* data);
+
+/**
+ * @brief Sistema planificador de actualizaciones.
+ *
+ * Sustituye a la secuencia fija de CInstance::OnLoop(). Cada sistema de actualización declara qué componentes y recursos lee y cuáles escribe.
+ * En cada iteración, el planificador construye un grafo de dependencias: si dos sistemas acceden a lo mismo y al menos uno de ellos lo escribe,
+ * el registrado antes se ejecuta antes. El resto de sistemas se ejecutan a la vez en los hilos de CSystem_Jobs, sin necesidad de bloqueos.
+ *
+ * Hay dos tipos de sistema:
+ * - Sistemas normales: una función que se llama una vez por iteración.
+ * - Sistemas de consulta: una función que se llama por cada game object activo con todos los componentes de la consulta (p.ej. Transform y Particle Emitter).
+ *   Leen implícitamente el recurso Scheduler::gameobjects.
+ *
+ * Por defecto se registran los sistemas del motor, en este orden: "input", "time", "behaviours", "transforms", "particles", "audio_sources", "spatial", "mixer" y "render".
+ * "behaviours" ejecuta los callbacks de los objetos. Como pueden hacer cualquier cosa, por defecto escribe los objetos, los componentes sin sistema propio
+ * y el recurso Scheduler::behaviours. Si los callbacks de un juego acceden a menos cosas, se puede restringir con SetAccess().
+ *
+ * Ejemplo:
+ *
+ @code
+  void Gravity(CGameObject* go, void* data)
+  {
+    go->Transform()->position.y -= 9.8f * gTime.deltaTime_s();
+  }
+
+  gScheduler.AddQuery("gravity", Components::bit(Components::transform), &Gravity, NULL,
+                      Scheduler::bit(Scheduler::time),
+                      Scheduler::bit(Components::transform), Scheduler::parallel);
+ @endcode
+ *
+ * @see CSystem_Jobs
+ */
+class CSystem_Scheduler: public CSystem
+{
+  protected:
+    struct system_t
+    {
+      std::string name;
+      scheduler_function_t function;
+      scheduler_query_function_t query_function;
+      Components::signature_t query;
+      void* data;
+      Scheduler::access_t reads;
+      Scheduler::access_t writes;
+      flags_t flags;
+
+      std::vector<system_t*> dependents;  // Sistemas que esperan a éste
+      uint num_dependencies;
+      SDL_atomic_t pending;               // Dependencias sin terminar en la iteración actual
+      std::vector<CGameObject*> objects;  // Objetos de la consulta en la iteración actual
+    };
+
+    std::vector<system_t*> systems;       // En orden de registro
+    bool dirty;                           // Hay que reconstruir el grafo
+
+    SDL_atomic_t remaining;               // Sistemas sin terminar en la iteración actual
+    SDL_mutex* main_mutex;
+    std::vector<system_t*> main_queue;    // Sistemas listos que deben ejecutarse en el hilo principal
+
+    system_t* Find(const std::string& name);
+    bool Add(system_t* system);
+
+    void BuildGraph();
+    void Launch(system_t* system);
+    void Execute(system_t* system);
+    void ExecuteQuery(system_t* system);
+
+    static void SystemJob(void* data, uint begin, uint end);
+    static void QueryJob(void* data, uint begin, uint end);
+
+    void AddDefaultSystems();
+
+  public:
+    CSystem_Scheduler(): CSystem(), dirty(true), main_mutex(NULL) {};
+
+    bool Init();
+    void Close();
+
+    /**
+     * @brief Ejecutar una iteración.
+     *
+     * Ejecuta todos los sistemas respetando sus dependencias, y vuelve cuando han terminado todos. Al final, aplica los buffers de cambios
+     * estructurales (véase CSystem_GameObject_Manager::ApplyCommands()).
+     */
+    void OnLoop();
+
+    /**
+     * @brief Registrar un sistema.
+     *
+     * @param name Nombre único del sistema.
+     * @param function Función del sistema.
+     * @param data Datos que recibe la función.
+     * @param reads Componentes y recursos que lee (véase Scheduler::bit()).
+     * @param writes Componentes y recursos que escribe.
+     * @param flags Opciones del sistema (véase Scheduler::system_flags_t).
+     * @return Devuelve true si se ha registrado, false si ya existe un sistema con ese nombre.
+     */
+    bool Add(const std::string& name, scheduler_function_t function, void* data, Scheduler::access_t reads, Scheduler::access_t writes, flags_t flags = Scheduler::none);
+
+    /**
+     * @brief Registrar un sistema de consulta.
+     *
+     * @param name Nombre único del sistema.
+     * @param query Componentes que debe tener un objeto para pasar a la función (véase Components::bit()).
+     * @param function Función a llamar por cada objeto.
+     * @param data Datos que recibe la función.
+     * @param reads Componentes y recursos que lee.
+     * @param writes Componentes y recursos que escribe.
+     * @param flags Opciones del sistema (véase Scheduler::system_flags_t).
+     * @return Devuelve true si se ha registrado, false si ya existe un sistema con ese nombre.
+     */
+    bool AddQuery(const std::string& name, Components::signature_t query, scheduler_query_function_t function, void* data, Scheduler::access_t reads, Scheduler::access_t writes, flags_t flags = Scheduler::none);
+
+    /**
+     * @brief Quitar un sistema.
+     *
+     * @param name Nombre del sistema.
+     * @return Devuelve true si existía, false en caso contrario.
+     */
+    bool Remove(const std::string& name);
+
+    /**
+     * @brief Cambiar los accesos de un sistema ya registrado.
+     *
+     * @param name Nombre del sistema.
+     * @param reads Componentes y recursos que lee.
+     * @param writes Componentes y recursos que escribe.
+     * @return Devuelve true si existía, false en caso contrario.
+     */
+    bool SetAccess(const std::string& name, Scheduler::access_t reads, Scheduler::access_t writes);
+
+    /**
+     * @brief Mostrar los sistemas y sus dependencias por la consola.
+     */
+    void PrintGraph();
+};
+
+extern CSystem_Scheduler gSystem_Scheduler;
+extern CSystem_Scheduler& gScheduler;
+
+/*@}*/
+
+#endif /* __CSYSTEM_SCHEDULER_H_ */
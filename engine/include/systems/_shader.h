@@ -9,14 +9,51 @@
  *   - https://github.com/luugiathuy/GLSLShaderManager
  */
 
-// Deberamos poner los shaders como Resources?
-// O dejarlos como sistema independiente? <-
+// ¿Deberíamos poner los shaders como Resources?
+// ¿O dejarlos como sistema independiente? <-
+
+namespace Shader
+{
+  /**
+   * @brief Uniforms que usa el motor, con su posición resuelta al enlazar cada shader (véase CShader::GetUniform()).
+   */
+  enum uniform_t { proj_matrix = 0, modelview_matrix, normal_matrix, color, texture, texture_flag, __uniform_not_defined };
+
+  /** @brief Nombre del uniform en el código GLSL. */
+  const char* uniform_to_string(uniform_t u);
+}
+
+/**
+ * @brief Punto de enlace del bloque de uniforms "CameraData".
+ *
+ * Los shaders que lo declaran (véase __SHADER_CAMERA_BLOCK) leen la proyección de la cámara de un único buffer, que CSystem_Render sube una vez por cámara
+ * con CSystem_Shader_Manager::SetCamera(), en lugar de recibirla en cada llamada de dibujo.
+ */
+#define __SHADER_CAMERA_BLOCK_BINDING 0
+
+/**
+ * @brief Declaración GLSL del bloque "CameraData", para el principio del código de un vertex shader.
+ *
+ * Sustituye a "uniform mat4 ProjMatrix;". Time contiene los segundos desde el inicio (x) y la duración de la última iteración (y).
+ */
+#define __SHADER_CAMERA_BLOCK \
+  "#version 120\n" \
+  "#extension GL_ARB_uniform_buffer_object : require\n" \
+  "layout(std140) uniform CameraData" \
+  "{" \
+    "mat4 ProjMatrix;" \
+    "mat4 ViewMatrix;" \
+    "mat4 ViewNormalMatrix;" \
+    "vec4 Time;" \
+  "};"
 
 class CShader
 {
   friend class CSystem_Shader_Manager;
   protected:
     std::map<std::string, int> shader_variables;
+    GLint uniforms[Shader::__uniform_not_defined];  // Posiciones de los uniforms del motor, -1 si el shader no los usa
+    bool camera_block;
 
     uint VertexShader;
     uint GeometricShader;
@@ -44,8 +81,19 @@ class CShader
     int GetAttributeIndex(const std::string& varname);
     int GetUniformIndex(const std::string& varname);
 
+    /**
+     * @brief Posición de un uniform del motor, resuelta al enlazar el shader.
+     *
+     * A diferencia de GetUniformIndex(), no busca por nombre. Devuelve -1 si el shader no usa el uniform (glUniform*() lo ignora).
+     */
+    inline GLint GetUniform(Shader::uniform_t u) { return uniforms[u]; }
+
+    /** @brief El shader lee la proyección del bloque "CameraData" (véase __SHADER_CAMERA_BLOCK). */
+    inline bool HasCameraBlock() { return camera_block; }
+
   protected:
     int GetVariableIndex(const std::string& varname, bool isUniform);
+    void ResolveUniforms();
 };
 
 class CSystem_Shader_Manager: public CSystem
@@ -56,8 +104,19 @@ class CSystem_Shader_Manager: public CSystem
 
     std::string last_shader_used;
 
+    // Datos de "CameraData", con la disposición std140
+    struct camera_block_t
+    {
+      glm::mat4 projMatrix;
+      glm::mat4 viewMatrix;
+      glm::mat4 viewNormalMatrix;
+      glm::vec4 time;
+    };
+
+    GLuint camera_ubo;
+
   public:
-    CSystem_Shader_Manager(): CSystem() {};
+    CSystem_Shader_Manager(): CSystem(), camera_ubo(0) {};
     ~CSystem_Shader_Manager() {};
 
     bool Init();
@@ -73,6 +132,17 @@ class CSystem_Shader_Manager: public CSystem
 
     CShader* UseShader(const std::string& name = "");
 
+    /**
+     * @brief Subir los datos de la cámara actual al bloque "CameraData".
+     *
+     * Lo llama CSystem_Render una vez por cámara, después de CComponent_Camera::SetUp(). Vale para todos los shaders que declaran el bloque.
+     *
+     * @param projMatrix Matriz de proyección.
+     * @param viewMatrix Matriz de vista.
+     * @param viewNormalMatrix Inversa traspuesta de la matriz de vista (véase CComponent_Camera::NormalMatrix()).
+     */
+    void SetCamera(const glm::mat4& projMatrix, const glm::mat4& viewMatrix, const glm::mat4& viewNormalMatrix);
+
   private:
     CShader* Load(const std::string& name, const std::string& vertexFile, const std::string& fragmentFile, const std::string& geometryFile = "");
     void Clear(CShader* inShader);
@@ -82,7 +152,7 @@ class CSystem_Shader_Manager: public CSystem
 
     CShader* LoadShaderStr(const std::string& name, const char** inVertCode, const char** inFragCode, const char** inGeomCode = NULL);
     bool LoadStr(const std::string& name, uint inShaderType, const char** inShaderCode, uint& inOutShader);
-    // ?
+    // ¿?
 };
 
 extern CSystem_Shader_Manager gSystem_Shader_Manager;
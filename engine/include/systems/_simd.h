@@ -0,0 +1,115 @@
+/**
+ * @file
+ * @brief Fichero que incluye los kernels vectorizados (SIMD) de transformaciones.
+ */
+
+#ifndef __SIMD_H_
+#define __SIMD_H_
+
+#include "_globals.h"
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Kernels vectorizados.
+ *
+ * Funciones que procesan muchas transformaciones a la vez con instrucciones SIMD (SSE2 o AVX2, según la CPU), usadas por
+ * CComponent_Transform::UpdateWorldMatrices(). Todas tienen una versión escalar equivalente, que se usa si la CPU o el compilador
+ * no soportan ninguna otra, y para los objetos que sobran al final de cada lote.
+ *
+ * El conjunto de instrucciones se elige automáticamente la primera vez (véase Best()), aunque se puede forzar otro con SetCurrent().
+ *
+ * @see CSystem_Debug::Console_command__SYSTEM_TRANSFORM_BENCHMARK()
+ */
+namespace SIMD
+{
+  /**
+   * @brief Conjuntos de instrucciones.
+   *
+   * <ul>
+   * <li><b>scalar:</b> Código C++ normal, un objeto cada vez.
+   * <li><b>sse:</b> Lotes de 4 objetos con registros de 128 bits (SSE2).
+   * <li><b>avx2:</b> Lotes de 8 objetos con registros de 256 bits.
+   * </ul>
+   */
+  enum instruction_set_t { scalar = 0, sse, avx2, __instruction_set_not_defined };
+
+  /**
+   * @brief Nombre de un conjunto de instrucciones.
+   */
+  const char* instruction_set_to_string(instruction_set_t set);
+
+  /**
+   * @brief Mejor conjunto de instrucciones soportado por la CPU y por el compilador.
+   */
+  instruction_set_t Best();
+
+  /**
+   * @brief Conjunto de instrucciones en uso.
+   */
+  instruction_set_t Current();
+
+  /**
+   * @brief Cambiar el conjunto de instrucciones en uso.
+   *
+   * @param set Nuevo conjunto. Si no está soportado, se usa Best().
+   * @return Conjunto de instrucciones que se usará a partir de ahora.
+   */
+  instruction_set_t SetCurrent(instruction_set_t set);
+
+  /**
+   * @brief Componer matrices locales.
+   *
+   * Para cada índice "i" de "indices", calcula output[i] = traslación(position[i]) * rotación(angle[i]) * escala(scale[i]),
+   * igual que glm::translate(), glm::toMat4() y glm::scale().
+   *
+   * @param position Array de posiciones (p.ej. un bloque de CComponent_Transform_Data).
+   * @param angle Array de orientaciones.
+   * @param scale Array de escalas.
+   * @param output Array de matrices de salida.
+   * @param indices Índices a procesar dentro de los arrays.
+   * @param count Número de índices.
+   */
+  void ComposeTRS(const vector3f* position, const glm::quat* angle, const vector3f* scale, glm::mat4* output, const uint* indices, uint count);
+
+  /**
+   * @brief Multiplicar matrices.
+   *
+   * Calcula *output[i] = *left[i] * *right[i]. Las matrices pueden estar en cualquier sitio, pero output[i] no debe coincidir con left[i] ni con right[i].
+   *
+   * @param left Matrices de la izquierda (p.ej. matrices de mundo de los padres).
+   * @param right Matrices de la derecha (p.ej. matrices locales).
+   * @param output Matrices de salida.
+   * @param count Número de productos.
+   */
+  void MultiplyMatrices(const glm::mat4* const* left, const glm::mat4* const* right, glm::mat4* const* output, uint count);
+
+  /**
+   * @brief Matrices normales.
+   *
+   * Calcula *output[i] = glm::transpose(glm::inverse(*input[i])) suponiendo que *input[i] es afín (la última fila es 0, 0, 0, 1), como las
+   * matrices de mundo. Así, se evita la inversa general: basta con 3 productos vectoriales y un determinante.
+   *
+   * @param input Matrices afines.
+   * @param output Matrices de salida. Si una matriz no tiene inversa, su parte 3x3 queda a 0.
+   * @param count Número de matrices.
+   */
+  void NormalMatrices(const glm::mat4* const* input, glm::mat4* const* output, uint count);
+
+  /**
+   * @brief Comparar los kernels con el cálculo objeto a objeto con glm.
+   *
+   * Genera "count" transformaciones aleatorias con padre, calcula sus matrices locales, de mundo y normales, primero con glm (glm::translate(),
+   * glm::toMat4(), glm::scale(), producto y glm::inverse()) y después con cada conjunto de instrucciones soportado, y muestra por la consola
+   * el tiempo por objeto, la mejora y el error máximo con respecto a glm.
+   *
+   * @param count Número de transformaciones.
+   * @param iterations Repeticiones de cada prueba. Se muestra la más rápida.
+   */
+  void Benchmark(uint count, uint iterations = 10);
+}
+
+/*@}*/
+
+#endif /* __SIMD_H_ */
@@ -0,0 +1,190 @@
+/**
+ * @file
+ * @brief Fichero que incluye el sistema de índice espacial (árbol dinámico de cajas).
+ */
+
+#ifndef __CSYSTEM_SPATIAL_H_
+#define __CSYSTEM_SPATIAL_H_
+
+#include "_globals.h"
+#include "_system.h"
+#include "components/_component.h"
+#include "systems/_culling.h"
+
+class CGameObject;
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Margen relativo de las cajas del índice espacial.
+ *
+ * Cada objeto se guarda con una caja algo mayor que su volumen envolvente (un porcentaje de su tamaño más __SPATIAL_MIN_MARGIN), de forma que
+ * si se mueve poco no hace falta reinsertarlo en el árbol.
+ */
+#define __SPATIAL_MARGIN 0.1f
+
+/**
+ * @brief Margen mínimo de las cajas del índice espacial, en unidades de mundo.
+ */
+#define __SPATIAL_MIN_MARGIN 0.1f
+
+/**
+ * @brief Sistema de índice espacial.
+ *
+ * Guarda los game objects en un árbol dinámico de cajas (una BVH que se actualiza de forma incremental), según su volumen envolvente en espacio de mundo:
+ * la unión de los de CComponent_Mesh_Render y CComponent_Particle_Emitter, o su posición si no tiene ninguno.
+ *
+ * Cada objeto se guarda con una caja ampliada (véase __SPATIAL_MARGIN), y sólo se reinserta cuando su volumen se sale de ella. Al insertar, se elige
+ * el hermano que menos aumenta la superficie total, y se rota el árbol para mantenerlo equilibrado.
+ *
+ * No se recorren todos los objetos en cada iteración: CComponent_Transform anota qué transformaciones han cambiado su matriz de mundo (véase
+ * CComponent_Transform_Data::Moved()), y OnLoop() sólo actualiza ésas y los emisores de partículas, cuyo volumen cambia en cada iteración.
+ * Lo llama el sistema "spatial" de CSystem_Scheduler, después de "transforms" y "particles".
+ *
+ * Lo usan CSystem_Render, para descartar por frustum sin recorrer todos los objetos, y CGameObject::NearBy(). También se puede consultar desde el código de usuario,
+ * p.ej. para buscar las fuentes de sonido cercanas a un punto:
+ *
+ @code
+  std::vector<CGameObject*> sources;
+  gSpatial.QuerySphere(glm::vec3(0.f, 0.f, 0.f), 50.f, sources, Components::bit(Components::audio_source));
+ @endcode
+ *
+ * Las consultas sólo devuelven objetos registrados en CSystem_GameObject_Manager, y deben hacerse desde el hilo principal o desde sistemas que lean el
+ * recurso Scheduler::spatial. Cada hilo de CSystem_Jobs usa su propia pila de recorrido, así que se pueden hacer varias consultas a la vez mientras
+ * nadie modifique el índice (p.ej. CSystem_Render consulta en paralelo lo que ve cada cámara).
+ */
+class CSystem_Spatial: public CSystem
+{
+  protected:
+    struct node_t
+    {
+      Culling::aabb_t box;      // Caja ampliada en las hojas, unión de los hijos en el resto
+      int parent;               // En los nodos libres, siguiente nodo libre
+      int left, right;          // -1 en las hojas
+      int height;               // 0 en las hojas, -1 en los nodos libres
+
+      // Sólo en las hojas
+      CGameObject* object;
+      Culling::bounds_t bounds; // Volumen exacto
+      uint data_index;          // Índice de datos de la transformación del objeto
+      int unbounded;            // Posición en "unbounded", o -1
+
+      inline bool Leaf() const
+      {
+        return left < 0;
+      }
+    };
+
+    std::vector<node_t> nodes;
+    int root;
+    int free_node;
+
+    std::vector<int> leaf_of;       // Hoja de cada transformación, por índice de datos (-1 si no tiene)
+    std::vector<uint> last_update;  // Iteración en la que se actualizó cada transformación, por índice de datos
+    std::vector<int> unbounded;     // Hojas con dummys o callback de render: nunca se descartan al dibujar
+
+    std::vector<uint> moved;
+    std::vector<std::vector<int> > stacks;  // Pila de recorrido de las consultas, una por hilo de CSystem_Jobs
+    uint frame;
+    uint num_leaves;
+    uint num_updates;
+    uint num_reinserts;
+
+    int AllocateNode();
+    void FreeNode(int index);
+
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int index);
+    void Refit(int index);
+
+    void Update(uint data_index);
+    void SetUnbounded(int leaf, bool state);
+
+    bool Accept(int leaf, Components::signature_t components);
+
+    std::vector<int>& Stack();
+
+  public:
+    CSystem_Spatial(): CSystem(), root(-1), free_node(-1), frame(0), num_leaves(0), num_updates(0), num_reinserts(0) {};
+
+    bool Init();
+    void Close();
+    bool Reset();
+
+    /**
+     * @brief Actualizar el índice.
+     *
+     * Actualiza los objetos que se han movido (o han cambiado sus componentes) desde la última llamada, y los que tienen un emisor de partículas.
+     */
+    void OnLoop();
+
+    /**
+     * @brief Quitar una transformación del índice.
+     *
+     * Lo llama el destructor de CComponent_Transform.
+     *
+     * @param data_index Índice de datos de la transformación (véase CComponent_Transform::GetDataIndex()).
+     */
+    void Remove(uint data_index);
+
+    /**
+     * @brief Objetos que pueden verse desde un frustum.
+     *
+     * Objetos cuyo volumen corta el frustum. Si un nodo del árbol queda dentro del frustum, se añaden todos sus objetos sin comprobarlos.
+     *
+     * @param frustum Frustum en espacio de mundo.
+     * @param output Vector al que se añaden los objetos.
+     * @param components Si no es 0, sólo se devuelven los objetos que tengan todos estos componentes (véase Components::bit()).
+     * @return Número de objetos añadidos.
+     */
+    uint QueryFrustum(const Culling::frustum_t& frustum, std::vector<CGameObject*>& output, Components::signature_t components = 0);
+
+    /**
+     * @brief Objetos que hay que dibujar desde un frustum.
+     *
+     * Igual que QueryFrustum(), pero añade además todos los objetos con dummys o callback de render, que no tienen volumen envolvente.
+     */
+    uint QueryVisible(const Culling::frustum_t& frustum, std::vector<CGameObject*>& output);
+
+    /**
+     * @brief Objetos cuyo volumen corta una esfera.
+     *
+     * @return Número de objetos añadidos a "output".
+     */
+    uint QuerySphere(const glm::vec3& center, float radius, std::vector<CGameObject*>& output, Components::signature_t components = 0);
+
+    /**
+     * @brief Objetos cuyo volumen corta una caja.
+     *
+     * @return Número de objetos añadidos a "output".
+     */
+    uint QueryAABB(const Culling::aabb_t& box, std::vector<CGameObject*>& output, Components::signature_t components = 0);
+
+    /**
+     * @brief Lanzar un rayo.
+     *
+     * Se comprueba la caja envolvente de cada objeto, no su malla.
+     *
+     * @param origin Origen del rayo.
+     * @param direction Dirección del rayo (no hace falta normalizarla).
+     * @param max_distance Distancia máxima, en unidades de "direction".
+     * @param distance Si no es NULL, guarda la distancia a la que el rayo entra en la caja del objeto.
+     * @param components Si no es 0, sólo se tienen en cuenta los objetos que tengan todos estos componentes.
+     * @return Objeto más cercano que corta el rayo, o NULL si no hay ninguno.
+     */
+    CGameObject* Raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance, float* distance = NULL, Components::signature_t components = 0);
+
+    /**
+     * @brief Mostrar el estado del índice por la consola.
+     */
+    void PrintStats();
+};
+
+extern CSystem_Spatial gSystem_Spatial;
+extern CSystem_Spatial& gSpatial;
+
+/*@}*/
+
+#endif /* __CSYSTEM_SPATIAL_H_ */
@@ -0,0 +1,117 @@
+/**
+ * @file
+ * @brief Fichero que incluye el sistema que junta los modelos de los objetos estáticos.
+ */
+
+#ifndef __CSYSTEM_STATIC_BATCHING_H_
+#define __CSYSTEM_STATIC_BATCHING_H_
+
+#include "_globals.h"
+#include "_system.h"
+#include "_object.h"
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Número mínimo de objetos de un grupo para juntarlos. Un objeto solo se sigue dibujando por su cuenta.
+ */
+#define __STATIC_BATCHING_MIN_OBJECTS 2
+
+/**
+ * @brief Número máximo de vértices de cada modelo combinado, para que sus índices quepan en 16 bits. Los grupos más grandes se parten.
+ */
+#define __STATIC_BATCHING_MAX_VERTICES 0xFFFF
+
+/**
+ * @brief Sistema de agrupación de objetos estáticos.
+ *
+ * Al terminar el callback de carga de cada estancia (véase CInstance), Bake() junta los modelos de los objetos marcados como estáticos
+ * (véase CGameObject::SetStatic()) que se dibujan igual: mismo shader, textura, color y fuerza del color. Los vértices se pasan a espacio de mundo
+ * con la transformación de cada objeto, y cada grupo se guarda como un modelo nuevo (CResource_Mesh::LoadFromMemory()) que dibuja un objeto nuevo
+ * sin transformación, "static_batch_N". El CComponent_Mesh_Render de los objetos originales se desactiva.
+ *
+ * Los objetos se reparten antes en celdas de una rejilla (opción "__RENDER_STATIC_BATCHING_CELL_SIZE"), según el centro de su volumen envolvente,
+ * para que cada modelo combinado siga siendo pequeño: el descarte por frustum (CSystem_Spatial) y por oclusión trata cada celda por separado.
+ * Así, cientos de llamadas de dibujo se quedan en unas pocas por celda.
+ *
+ * No se juntan los objetos desactivados, transparentes, con callbacks before_render o after_render, o sin modelo. Los modelos combinados no tienen
+ * niveles de detalle, y guardan las posiciones en float aunque los originales usen 16 bits (Resources::mesh_position_16): ya están en espacio
+ * de mundo, y cuantizarlas sobre la caja de todo el grupo perdería precisión.
+ *
+ * Si se borra uno de los objetos de un grupo (o su CComponent_Mesh_Render), el grupo se deshace (Unbake()): los demás objetos vuelven a dibujarse
+ * uno a uno, y el objeto combinado se desactiva hasta el cambio de estancia. Los cambios de transformación o de material de los objetos estáticos
+ * no se ven mientras estén agrupados.
+ *
+ * Se puede desactivar con la opción "__RENDER_STATIC_BATCHING".
+ */
+class CSystem_Static_Batching: public CSystem
+{
+  protected:
+    struct batch_t
+    {
+      gameObject_handle_t gameObject;            // Objeto que dibuja el modelo combinado
+      std::vector<gameObject_handle_t> sources;  // Objetos estáticos que contiene
+      bool baked;                                // false si se ha deshecho
+    };
+
+    std::vector<batch_t> batches;
+    uint num_baked;         // Grupos sin deshacer
+    uint num_sources;       // Objetos en grupos sin deshacer
+    uint next_name;         // Para los nombres de los objetos y modelos combinados
+
+    // Juntar un grupo de objetos en un modelo. Devuelve false si no se ha podido crear
+    bool BakeGroup(const std::vector<CGameObject*>& objects);
+
+  public:
+    CSystem_Static_Batching(): CSystem(), num_baked(0), num_sources(0), next_name(0) {};
+
+    bool Init();
+    void Close();
+
+    /**
+     * @brief Deshacer todos los grupos: los objetos preservados entre estancias vuelven a dibujarse uno a uno.
+     *
+     * Se llama después de que CSystem_GameObject_Manager borre los objetos no preservados.
+     */
+    bool Reset();
+
+    /**
+     * @brief Juntar los modelos de los objetos estáticos.
+     *
+     * Lo llama CInstance al terminar su callback de carga. Los objetos marcados como estáticos después no se juntan hasta que se vuelva a
+     * llamar, por ejemplo tras crear una parte de la escena que ya no se va a mover. Los objetos que ya están en un grupo no se vuelven a juntar.
+     *
+     * @return Número de grupos creados.
+     */
+    uint Bake();
+
+    /**
+     * @brief Deshacer un grupo.
+     *
+     * Los objetos del grupo que sigan existiendo vuelven a dibujarse uno a uno, y el objeto combinado deja de dibujarse. Lo llama el destructor de
+     * CComponent_Mesh_Render.
+     *
+     * @param batch Índice del grupo.
+     */
+    void Unbake(int batch);
+
+    /** @brief Número de grupos sin deshacer. */
+    inline uint Size()
+    {
+      return num_baked;
+    }
+
+    /** @brief Número de objetos en grupos sin deshacer. */
+    inline uint Sources()
+    {
+      return num_sources;
+    }
+};
+
+extern CSystem_Static_Batching gSystem_Static_Batching;
+extern CSystem_Static_Batching& gStaticBatching;
+
+/*@}*/
+
+#endif /* __CSYSTEM_STATIC_BATCHING_H_ */
@@ -0,0 +1,134 @@
+/**
+ * @file
+ * @brief Fichero que incluye el buffer circular para los datos de vértices que cambian en cada iteración.
+ */
+
+#ifndef __CSYSTEM_STREAM_BUFFER_H_
+#define __CSYSTEM_STREAM_BUFFER_H_
+
+#include "_globals.h"
+#include "_system.h"
+
+#include <deque>
+
+/** @addtogroup Sistemas */
+/*@{*/
+
+/**
+ * @brief Alineamiento de cada bloque dentro del buffer, en bytes.
+ */
+#define __STREAM_BUFFER_ALIGNMENT 16
+
+/**
+ * @brief Buffer circular para datos de vértices dinámicos.
+ *
+ * Un único buffer de OpenGL (de "__RENDER_STREAM_BUFFER_SIZE" bytes) del que se reparten bloques de forma consecutiva. Los emisores de partículas,
+ * las texturas de la GUI y las instancias de CRender_Queue escriben aquí sus datos de cada iteración, en lugar de volver a reservar la memoria de
+ * sus propios buffers con glBufferData().
+ *
+ * <ul>
+ * <li><b>Con ARB_buffer_storage:</b> el buffer se mapea una sola vez, de forma persistente, y Write() copia directamente en él. Al terminar cada
+ *     iteración se pone una barrera (glFenceSync()) sobre la zona escrita, y antes de volver a escribir en ella se espera a que la GPU la haya usado.
+ * <li><b>Sin la extensión:</b> Write() usa glBufferSubData(), y cuando el buffer se llena se deja huérfano (glBufferData() con NULL) y se
+ *     empieza de nuevo, así que nunca se escribe en una zona que la GPU pueda estar leyendo.
+ * </ul>
+ *
+ * Write() deja el buffer enlazado en GL_ARRAY_BUFFER, así que basta con apuntar los atributos al desplazamiento devuelto:
+ *
+ @code
+  GLintptr offset = gStreamBuffer.Write(&positions[0], positions.size() * sizeof(GLfloat));
+  if(offset < 0) return;
+
+  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (GLvoid*)offset);
+ @endcode
+ */
+class CSystem_Stream_Buffer: public CSystem
+{
+  public:
+    /** @brief Contadores de una iteración. */
+    struct stats_t
+    {
+      uint writes;
+      uint bytes;
+      uint wraps;   // Veces que se ha vuelto al principio del buffer
+      uint waits;   // Barreras por las que se ha tenido que esperar a la GPU
+    };
+
+  protected:
+    struct fence_t
+    {
+      GLsync sync;
+      GLintptr start, end;
+    };
+
+    GLuint buffer;
+    GLsizeiptr size;
+    GLubyte* mapped;              // NULL si no se usa el mapeo persistente
+
+    GLintptr head;                // Siguiente posición libre
+    GLintptr pending;             // Principio de la zona escrita que aún no tiene barrera
+    std::deque<fence_t> fences;   // Zonas que la GPU puede estar leyendo, de la más antigua a la más nueva
+
+    stats_t stats;
+    stats_t last_stats;
+
+    bool Create(bool persistent);
+    void Destroy();
+
+    // Barrera sobre la zona escrita desde la última, y espera a las que se solapen con [start, end)
+    void Fence();
+    void Wait(GLintptr start, GLintptr end);
+    // Esperar a la barrera más antigua y quitarla
+    void WaitFront();
+
+  public:
+    CSystem_Stream_Buffer(): CSystem(), buffer(0), size(0), mapped(NULL), head(0), pending(0) { ClearStats(); };
+
+    /** @brief Crear el buffer. Lo llama CSystem_Render::Init(), una vez creado el contexto de OpenGL. */
+    bool Init();
+    void Close();
+    bool Reset();
+
+    /**
+     * @brief Terminar una iteración: pone la barrera sobre lo escrito en ella y guarda los contadores.
+     *
+     * Lo llama CSystem_Render::OnRender(), después de dibujar todas las cámaras.
+     */
+    void OnFrame();
+
+    /**
+     * @brief Copiar datos al buffer.
+     *
+     * @param data Datos a copiar.
+     * @param bytes Tamaño de los datos.
+     * @return Desplazamiento de los datos dentro de Buffer(), o -1 si no caben en el buffer. El buffer queda enlazado en GL_ARRAY_BUFFER.
+     */
+    GLintptr Write(const void* data, GLsizeiptr bytes);
+
+    /** @brief Buffer de OpenGL. */
+    inline GLuint Buffer()
+    {
+      return buffer;
+    }
+
+    /** @brief El buffer está mapeado de forma persistente (ARB_buffer_storage). */
+    inline bool Persistent()
+    {
+      return mapped != NULL;
+    }
+
+    /** @brief Contadores de la última iteración completa. */
+    inline const stats_t& Stats()
+    {
+      return last_stats;
+    }
+
+    void ClearStats();
+};
+
+extern CSystem_Stream_Buffer gSystem_Stream_Buffer;
+extern CSystem_Stream_Buffer& gStreamBuffer;
+
+/*@}*/
+
+#endif /* __CSYSTEM_STREAM_BUFFER_H_ */
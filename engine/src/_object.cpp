@@ -1,17 +1,29 @@
 #include "_object.h"
 #include "_components.h"
 #include "systems/_manager.h"
+#include "systems/_spatial.h"
+#include "systems/_render_queue.h"
+#include "systems/_gl_state.h"
 
 using namespace std;
 
+__COMPONENT_POOL_IMPLEMENT(CGameObject)
+
 CGameObject::CGameObject(std::string name)
 {
   inited = false;
   enabled = false;
   this->name = name;
   id = -1;
+  generation = 0;
+
+  for(int i = 0; i < Components::__component_not_defined; i++)
+    components[i] = NULL;
+  signature = 0;
 
   preserve = false;
+  parallel = false;
+  is_static = false;
 
   Parent = NULL;
   start = behaviour = event_behaviour = input_behaviour = render = NULL;
@@ -47,58 +59,39 @@ void CGameObject::Close()
   //id = -1;
   name = "";
 
-  for(map<int, CComponent*>::const_iterator it = components.begin(); it != components.end(); ++it)
-    delete it->second;
-  components.clear();
+  for(int i = 0; i < Components::__component_not_defined; i++)
+  {
+    if(components[i])
+      delete components[i];
+    components[i] = NULL;
+  }
+  signature = 0;
 
   //functions.clear();
 
-   for(map<string, CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
-     it->second->Close();
+   for(vector<CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
+     (*it)->Close();
    children.clear();
 }
 
-bool dfs_search_children_loops(CGameObject* father, CGameObject* new_go)
+bool CGameObject::AddChild(CGameObject* ch)
 {
-  bool repetido = false;
-
-  if(father == new_go)   // Si son el mismo, es que se ha intentado emparentar a un objeto consigo mismo
-  {
-    repetido = true;
-    return repetido;
-  }
+  if(ch == NULL)
+    return false;
 
-  if(father->GetNumChildren() == 0) // sin hijos
-    return repetido;
+  // Hay un ciclo si el nuevo hijo es el propio objeto o uno de sus ancestros
+  for(CGameObject* p = this; p != NULL; p = p->Parent)
+    if(p == ch)
+      return false;
 
-  for(uint i = 0; i < father->GetNumChildren(); i++)
-    if((repetido = dfs_search_children_loops(father->GetChild(i), new_go)) == true)
-      return repetido;
+  if(ch->Parent == this)
+    return true;
 
-  return repetido;
-}
+  ch->RemoveParent();
 
-bool CGameObject::AddChild(CGameObject* ch)
-{
-  if(ch != NULL)
-  {
-    // Hacer esta comprobacin de forma recursiva por todos los hijos, as se evitan bucles infinitos y esas mierdas a la hora de llamar funciones
-    // un dfs debe de estar bien, supongo (comprobar para todos los hijos)
-
-    // Buscar hijos de forma recursiva
-    // O mejor an, usar un puntero a un "parent" para que un objeto solo tenga un padre. Se actualiza para que se emparenta
-    // Para poner a punto lo de arriba, hay que evitar ciclos
-    // Buscar un algoritmo para ello
-    if(!dfs_search_children_loops(this, ch) && !dfs_search_children_loops(ch, this)) // Buscar repetidos hacia adelante y hacia atrs (importante en ambos sentidos)
-    {
-      children.insert(pair<string, CGameObject*>(ch->GetName(), ch));
-      children[ch->GetName()]->SetParent(this);
-      return true;
-    }
-    //cout << "BUCLE DE HIJOS!!!: " << name << " - " << children->GetName() << endl;
-    return false;
-  }
-  return false;
+  children.push_back(ch);
+  ch->SetParent(this);
+  return true;
 }
 
 short int CGameObject::AddChildren(const vector<CGameObject*>& children)
@@ -115,48 +108,56 @@ short int CGameObject::AddChildren(const vector<CGameObject*>& children)
 
 bool CGameObject::RemoveChild(string str)
 {
-  map<string, CGameObject*>::iterator it = children.find(str);
-  if(it != children.end())
+  for(vector<CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
   {
-    it->second->UnParent();
-    children.erase(it);
-    return true;
+    if((*it)->GetName() == str)
+    {
+      (*it)->UnParent();
+      children.erase(it);
+      return true;
+    }
   }
   return false;
 }
 
 void CGameObject::RemoveChildren()
 {
-  for(map<string, CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
-    it->second->UnParent();
+  for(vector<CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
+    (*it)->UnParent();
 
   children.clear();
 }
 
 CGameObject* CGameObject::GetChild(std::string name)
 {
-  if(children.find(name) != children.end())
-    return children[name];
+  for(vector<CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
+    if((*it)->GetName() == name)
+      return (*it);
 
   return NULL;
 }
 
 CGameObject* CGameObject::GetChild(uint index)
 {
-  if(index < 0 or index >= children.size())
+  if(index >= children.size())
     return NULL;
 
-  map<string, CGameObject*>::iterator it = children.begin();
-  advance(it, index);
-  return it->second;
-//  map<string, CGameObject*>::iterator it = children.begin();
-//  for(uint i = 0; i < index; i++)
-//    ++it;
-//
-//  if(it == children.end())
-//    return NULL;
-//
-//  return it->second;
+  return children[index];
+}
+
+void CGameObject::SetParent(CGameObject* parent)
+{
+  if(parent != NULL)
+  {
+    Parent = parent;
+    CComponent_Transform::Data().SetHierarchyDirty();
+  }
+}
+
+void CGameObject::UnParent()
+{
+  Parent = NULL;
+  CComponent_Transform::Data().SetHierarchyDirty();
 }
 
 /*void CGameObject::SendMessage(CGameObject* dest, string func, input_t data, output_t o_data)
@@ -214,8 +215,8 @@ bool CGameObject::RemoveFromSystem()
   return false;
 }
 
-// En vez de iterar por todos los componentes, se debera iterar por los principales que se sabe que van a funcionar (o algo)
-// Por ejemplo, CComponent_Mesh_Render NO debera tener keyevent, ni event, ni behaviour
+// En vez de iterar por todos los componentes, se debería iterar por los principales que se sabe que van a funcionar (o algo)
+// Por ejemplo, CComponent_Mesh_Render NO debería tener keyevent, ni event, ni behaviour
 
 void CGameObject::OnEvent()
 {
@@ -224,8 +225,9 @@ void CGameObject::OnEvent()
 
   CallEventFunction();
 
-  for(map<int, CComponent*>::iterator it = components.begin(); it != components.end(); ++it)
-    it->second->OnEvent();
+  for(int i = 0; i < Components::__component_not_defined; i++)
+    if(signature & Components::bit((Components::components_t)i))
+      components[i]->OnEvent();
 }
 
 void CGameObject::OnInput()
@@ -235,22 +237,24 @@ void CGameObject::OnInput()
 
   CallInputFunction();
 
-  for(map<int, CComponent*>::iterator it = components.begin(); it != components.end(); ++it)
-    it->second->OnInput();
+  for(int i = 0; i < Components::__component_not_defined; i++)
+    if(signature & Components::bit((Components::components_t)i))
+      components[i]->OnInput();
 }
 
-void CGameObject::OnLoop()
+void CGameObject::OnLoop(Components::signature_t components)
 {
   if(!enabled or !inited)
     return;
 
   CallBehaviourFunction();
 
-  for(map<int, CComponent*>::iterator it = components.begin(); it != components.end(); ++it)
-    it->second->OnLoop();
+  for(int i = 0; i < Components::__component_not_defined; i++)
+    if(signature & components & Components::bit((Components::components_t)i))
+      components[i]->OnLoop();
 }
 
-void CGameObject::OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix)
+void CGameObject::OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix, const Culling::frustum_t* frustum, CRender_Queue* queue)
 {
   if(!enabled or !inited)
     return;
@@ -258,28 +262,101 @@ void CGameObject::OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix)
   //if(flags & gof_render)
   //for(map<int, CComponent*>::iterator it = components.begin(); it != components.end(); ++it)
     //it->second->OnRender();
-  if(GetComponent<CComponent_Mesh_Render>())
-    GetComponent<CComponent_Mesh_Render>()->OnRender(projMatrix, modelViewMatrix);
+  // Los dummys y el callback de render no tienen volumen envolvente, así que nunca se descartan
+  if(signature & Components::bit(Components::mesh_render))
+  {
+    CComponent_Mesh_Render* mesh_render = (CComponent_Mesh_Render*)components[Components::mesh_render];
+    if(!frustum or mesh_render->IsVisible(*frustum))
+    {
+      if(queue)
+        queue->Add(mesh_render, modelViewMatrix);
+      else
+        mesh_render->OnRender(projMatrix, modelViewMatrix);
+    }
+  }
 
-  if(GetComponent<CComponent_Particle_Emitter>())
-    GetComponent<CComponent_Particle_Emitter>()->OnRender(projMatrix, modelViewMatrix);
+  if(signature & Components::bit(Components::particle_emitter))
+  {
+    CComponent_Particle_Emitter* particle_emitter = (CComponent_Particle_Emitter*)components[Components::particle_emitter];
+    if(!frustum or particle_emitter->IsVisible(*frustum))
+    {
+      if(queue)
+        queue->Add(particle_emitter, modelViewMatrix);
+      else
+        particle_emitter->OnRender(projMatrix, modelViewMatrix);
+    }
+  }
 
+  if(queue)
+  {
+    if((signature & Components::bit(Components::dummy)) or render)
+      queue->AddCustom(this, modelViewMatrix);
+  }
+  else
+    OnRenderCallbacks(projMatrix, modelViewMatrix);
+}
+
+void CGameObject::OnRenderCallbacks(glm::mat4 projMatrix, glm::mat4 modelViewMatrix)
+{
   // Dummys
-  if(GetComponent<CComponent_Dummy>())
-    GetComponent<CComponent_Dummy>()->OnRender(projMatrix, modelViewMatrix);
+  if(signature & Components::bit(Components::dummy))
+    components[Components::dummy]->OnRender(projMatrix, modelViewMatrix);
 
-  CallRenderFunction();
+  if(render)
+  {
+    CallRenderFunction();
+
+    // El callback puede cambiar el estado de OpenGL sin pasar por la caché
+    gSystem_GL_State.Invalidate();
+  }
 }
 
 
 
+void CGameObject::SetRecursive(bool CGameObject::* attribute, bool state)
+{
+  CComponent_Transform_Data& data = CComponent_Transform::Data();
+  uint begin, end;
+
+  if(Transform() and data.Subtree(Transform()->GetDataIndex(), begin, end))
+  {
+    SetRecursive_Untransformed(attribute, state);
+    for(uint i = begin; i < end; i++)
+    {
+      CGameObject* go = data.HierarchyOwner(i)->GetGameObject();
+      go->*attribute = state;
+      go->SetRecursive_Untransformed(attribute, state);
+    }
+  }
+  else // Jerarquía sin reconstruir, u objetos sin iniciar (aún no tienen transformación)
+  {
+    for(vector<CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
+    {
+      (*it)->*attribute = state;
+      (*it)->SetRecursive(attribute, state);
+    }
+  }
+}
+
+void CGameObject::SetRecursive_Untransformed(bool CGameObject::* attribute, bool state)
+{
+  // Los hijos sin transformación no están en la jerarquía plana, ni sus descendientes bajo ellos
+  for(vector<CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
+  {
+    if(!(*it)->Transform())
+    {
+      (*it)->*attribute = state;
+      (*it)->SetRecursive(attribute, state);
+    }
+  }
+}
+
 void CGameObject::Enable(bool recursive)
 {
   enabled = true;
 
   if(recursive)
-    for(map<string, CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
-      it->second->Enable(true);
+    SetRecursive(&CGameObject::enabled, true);
 }
 
 void CGameObject::Disable(bool recursive)
@@ -287,8 +364,7 @@ void CGameObject::Disable(bool recursive)
   enabled = false;
 
   if(recursive)
-    for(map<string, CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
-      it->second->Disable(true);
+    SetRecursive(&CGameObject::enabled, false);
 }
 
 void CGameObject::SetState(bool state, bool recursive)
@@ -296,8 +372,7 @@ void CGameObject::SetState(bool state, bool recursive)
   enabled = state;
 
   if(recursive)
-    for(map<string, CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
-      it->second->SetState(state, true);
+    SetRecursive(&CGameObject::enabled, state);
 }
 
 void CGameObject::Preserve(bool recursive)
@@ -307,8 +382,7 @@ void CGameObject::Preserve(bool recursive)
   preserve = true;
 
   if(recursive)
-    for(map<string, CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
-      it->second->Preserve(true);
+    SetRecursive(&CGameObject::preserve, true);
 }
 
 void CGameObject::UnPreserve(bool recursive)
@@ -316,8 +390,7 @@ void CGameObject::UnPreserve(bool recursive)
   preserve = false;
 
   if(recursive)
-    for(map<string, CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
-      it->second->UnPreserve(true);
+    SetRecursive(&CGameObject::preserve, false);
 }
 
 void CGameObject::SetPreserve(bool state, bool recursive)
@@ -325,8 +398,23 @@ void CGameObject::SetPreserve(bool state, bool recursive)
   preserve = state;
 
   if(recursive)
-    for(map<string, CGameObject*>::iterator it = children.begin(); it != children.end(); ++it)
-      it->second->SetPreserve(state, true);
+    SetRecursive(&CGameObject::preserve, state);
+}
+
+void CGameObject::SetParallel(bool state, bool recursive)
+{
+  parallel = state;
+
+  if(recursive)
+    SetRecursive(&CGameObject::parallel, state);
+}
+
+void CGameObject::SetStatic(bool state, bool recursive)
+{
+  is_static = state;
+
+  if(recursive)
+    SetRecursive(&CGameObject::is_static, state);
 }
 
 bool CGameObject::NearBy(CGameObject* go, double distance)
@@ -337,7 +425,26 @@ bool CGameObject::NearBy(CGameObject* go, double distance)
   return false;
 }
 
-// ??
+uint CGameObject::NearBy(double distance, vector<CGameObject*>& output, Components::signature_t components)
+{
+  uint begin = output.size();
+
+  gSystem_Spatial.QuerySphere(Transform()->Position().to_glm(), (float)distance, output, components);
+
+  // Quitar el propio objeto
+  for(uint i = begin; i < output.size(); i++)
+  {
+    if(output[i] == this)
+    {
+      output.erase(output.begin() + i);
+      break;
+    }
+  }
+
+  return output.size() - begin;
+}
+
+// ¿?¿?
 /*void CGameObject::OnRenderDebug()
 {
   if(GetComponent<CComponent_Transform>())
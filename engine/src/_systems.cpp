@@ -14,6 +14,23 @@ bool Systems_Init()
     gSystem_Debug.msg_box(Debug::error, ERROR_INIT, "Could not load Storage system");
   }
 
+  if(!gSystem_Jobs.Init())
+  {
+    gSystem_Debug.msg_box(Debug::error, ERROR_INIT, "Could not load Jobs system");
+  }
+
+  if(!gSystem_Memory.Init())
+  {
+    gSystem_Debug.msg_box(Debug::error, ERROR_FATAL_INIT, "Could not load Memory system");
+    return false;
+  }
+
+  if(!gSystem_Spatial.Init())
+  {
+    gSystem_Debug.msg_box(Debug::error, ERROR_FATAL_INIT, "Could not load Spatial system");
+    return false;
+  }
+
   if(!gSystem_GameObject_Manager.Init())
   {
     gSystem_Debug.msg_box(Debug::error, ERROR_FATAL_INIT, "Could not load GameObject Manager system");
@@ -44,6 +61,12 @@ bool Systems_Init()
     return false;
   }
 
+  if(!gSystem_Static_Batching.Init())
+  {
+    gSystem_Debug.msg_box(Debug::error, ERROR_FATAL_INIT, "Could not load Static Batching system");
+    return false;
+  }
+
   if(!gSystem_Time.Init())
   {
     gSystem_Debug.msg_box(Debug::error, ERROR_FATAL_INIT, "Could not load Time system");
@@ -68,6 +91,12 @@ bool Systems_Init()
     return false;
   }
 
+  if(!gSystem_Scheduler.Init())
+  {
+    gSystem_Debug.msg_box(Debug::error, ERROR_FATAL_INIT, "Could not load Scheduler system");
+    return false;
+  }
+
   gSystem_Debug.ParseAppArguments();
 
   return true;
@@ -76,6 +105,7 @@ bool Systems_Init()
 void Systems_Close()
 {
   gSystem_Data_Storage.Close();
+  gSystem_Static_Batching.Close();
   gSystem_GameObject_Manager.Close();
   gSystem_Render.Close();
   gSystem_Debug.Close();
@@ -86,6 +116,10 @@ void Systems_Close()
   gSystem_Mixer.Close();
   gSystem_UserInput.Close();
   gSystem_Shader_Manager.Close();
+  gSystem_Scheduler.Close();
+  gSystem_Jobs.Close();
+  gSystem_Spatial.Close();
+  gSystem_Memory.Close();
 }
 
 bool Systems_Reset()
@@ -106,6 +140,12 @@ bool Systems_Reset()
     return false;
   }
 
+  if(!gSystem_Static_Batching.Reset())
+  {
+    gSystem_Debug.msg_box(Debug::error, ERROR_FATAL, "Could not reset Static Batching system");
+    return false;
+  }
+
   if(!gSystem_Render.Reset())
   {
     gSystem_Debug.msg_box(Debug::error, ERROR_FATAL, "Could not reset Render system");
@@ -148,6 +188,19 @@ bool Systems_Reset()
     return false;
   }
 
+  if(!gSystem_Spatial.Reset())
+  {
+    gSystem_Debug.msg_box(Debug::error, ERROR_FATAL, "Could not reset Spatial system");
+    return false;
+  }
+
+  // Después de borrar los objetos no preservados: su memoria se devuelve de una vez
+  if(!gSystem_Memory.Reset())
+  {
+    gSystem_Debug.msg_box(Debug::error, ERROR_FATAL, "Could not reset Memory system");
+    return false;
+  }
+
   return true;
 }
 
@@ -11,6 +11,8 @@
 
 using namespace std;
 
+__COMPONENT_POOL_IMPLEMENT(CComponent_Audio_Source)
+
 CComponent_Audio_Source::CComponent_Audio_Source(CGameObject* gameObject): CComponent(gameObject)
 {
   playing = paused = false;
@@ -177,7 +179,7 @@ void CComponent_Audio_Source::PlayOneShotAt(vector3f pos)
   ALuint buffer = sound->BufferID();
   alSourceQueueBuffers(source_oneshot, 1, &buffer);
 
-  // Vectores vacos, de momento
+  // Vectores vacíos, de momento
   vector3f vel, euler;
 
   alSourcefv(source_oneshot, AL_POSITION, pos.to_a());
@@ -201,7 +203,7 @@ void CComponent_Audio_Source::PlayOneShotAt(vector3f pos)
   //alSourcei(source_oneshot, AL_LOOPING, loop);
   alSourcePlay(source_oneshot);
 
-  // usar PlayOneShot() para esto, evitando que OnLoop() cambie los valores de volumne, pitch o posicin
+  // usar PlayOneShot() para esto, evitando que OnLoop() cambie los valores de volumne, pitch o posición
 }
 
 void CComponent_Audio_Source::PlayOneShotAt(ALfloat x, ALfloat y, ALfloat z)
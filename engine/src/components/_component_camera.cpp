@@ -10,6 +10,7 @@
 using namespace Viewmode;
 using namespace std;
 
+__COMPONENT_POOL_IMPLEMENT(CComponent_Camera)
 
 const char* Viewmode::viewmode_s[] = {"perspective", "ortho", "ortho_screen", "not_defined"};
 
@@ -31,9 +32,9 @@ viewmodes_t Viewmode::string_to_viewmode(const std::string& c)
 }
 
 CComponent_Camera::CComponent_Camera(CGameObject* gameObject): CComponent(gameObject),
- viewmode(perspective), field_of_view(45.f), near_clip(0.1f), far_clip(200.f), clear(true), target("")
+ viewmode(perspective), field_of_view(45.f), near_clip(0.1f), far_clip(200.f), clear(true), occlusion_culling(false), target("")
 {
-  disable_gui = false; // ?
+  disable_gui = false; // ¿?
 
   viewport.x = viewport.y = 0;
   //gSystem_Render.GetWindowSize(&viewport.width, &viewport.height);
@@ -131,7 +132,7 @@ void CComponent_Camera::SetViewport()
 
 void CComponent_Camera::Clear()
 {
-  // Canal alpha?
+  // ¿Canal alpha?
   if(clear)
   {
     glClearColor(background_color.r, background_color.g, background_color.b, background_color.a);
@@ -141,35 +142,39 @@ void CComponent_Camera::Clear()
 
 void CComponent_Camera::SetUp()
 {
-  //if(!enabled) return; // ?
+  //if(!enabled) return; // ¿?
 
   vector3f p =  gameObject->Transform()->Position();       // Camera position
   vector3f up = gameObject->Transform()->up();             // Up vector (for "screen rotation")
   vector3f tp(0, 0, 1);                                    // Target point
 
-  if(viewmode == Viewmode::ortho or viewmode == Viewmode::ortho_screen) // Aadir rotaciones o algo
+  if(viewmode == Viewmode::ortho or viewmode == Viewmode::ortho_screen) // Añadir rotaciones o algo
+  {
+    normalMatrix = glm::transpose(glm::inverse(modelViewMatrix));
     return;
+  }
 
-  // Solucin temporal: usar un pivote anclado al objeto que manipule la cmara como un hijo.
-  // Mientras la cmara rote, se aplicarn las rotaciones al pivote, lo que permitir a la cmara mirar libremente.
-  //  -> La solucin es un poco burda, pero sencilla. Al menos, no complicamos las cosas con procesos matemticos innecesarios.
+  // Solución temporal: usar un pivote anclado al objeto que manipule la cámara como un hijo.
+  // Mientras la cámara rote, se aplicarán las rotaciones al pivote, lo que permitirá a la cámara mirar libremente.
+  //  -> La solución es un poco burda, pero sencilla. Al menos, no complicamos las cosas con procesos matemáticos innecesarios.
   //
-  // Nota: Recalcular la posicin global del pivote o del objetivo en cada iteracin, para cada cmara,
-  //   puede resultar pesado si la cmara est anidada a otros objetos. Sera conveniente declarar un
+  // Nota: Recalcular la posición global del pivote o del objetivo en cada iteración, para cada cámara,
+  //   puede resultar pesado si la cámara está anidada a otros objetos. Sería conveniente declarar un
   //   previous_pos y un pos para evitar recalcular si son iguales (ganamos GPU y CPU a cambio de 48 bytes).
 
   CGameObject* target_p = gSystem_GameObject_Manager[target];
 
-  if(!target_p) // Aadir pivote y calcular su posicin global:
+  if(!target_p) // Añadir pivote y calcular su posición global:
     tp = pivot->Transform()->Position(); // Inservible...
-  else        // O coger la posicin global del objeto.
+  else        // O coger la posición global del objeto.
     tp = target_p->Transform()->Position();
 
-  // ->xBUG En CComponent_Camera::Setup() Caso fatal; hay que tomar un valor vlido del vector "up"
+  // ->xBUG En CComponent_Camera::Setup() Caso fatal; hay que tomar un valor válido del vector "up"
   //if((p - tp).normalize() == up or (p - tp).normalize() == vector3f())
     //up.x += 0.05f;
 
   modelViewMatrix = glm::lookAt(p.to_glm(), tp.to_glm(), up.to_glm());
+  normalMatrix = glm::transpose(glm::inverse(modelViewMatrix));
 }
 
 void CComponent_Camera::parseDebug(string command)
@@ -185,7 +190,7 @@ void CComponent_Camera::parseDebug(string command)
     return;
   }
 
-  if(attrib == "disable_gui" or attrib == "clear")
+  if(attrib == "disable_gui" or attrib == "clear" or attrib == "occlusion_culling")
   {
     bool data;
     ss >> data;
@@ -197,9 +202,11 @@ void CComponent_Camera::parseDebug(string command)
     }
 
     if(attrib == "disable_gui")
-      disable_gui = data; // ?
+      disable_gui = data; // ¿?
     else if(attrib == "clear")
       clear = data;
+    else if(attrib == "occlusion_culling")
+      occlusion_culling = data;
 
     gSystem_Debug.console_msg("From component %s - %s: Set variable \"%s\" to value \"%d\".", gameObject->GetName().c_str(), Components::component_to_string( (Components::components_t)GetID()), attrib.c_str(), (int)data );
   }
@@ -315,6 +322,7 @@ void CComponent_Camera::printDebug()
   gSystem_Debug.console_warning_msg("-----------------------------------------");
   gSystem_Debug.console_warning_msg("disable_gui           bool          %d", (int)disable_gui);
   gSystem_Debug.console_warning_msg("clear                 bool          %d", (int)clear);
+  gSystem_Debug.console_warning_msg("occlusion_culling     bool          %d", (int)occlusion_culling);
   gSystem_Debug.console_warning_msg("viewport              viewportf_t   %s", viewport.str().c_str());
   gSystem_Debug.console_warning_msg("viewmode              viewmode_t    %s", viewmode_to_string(viewmode));
   gSystem_Debug.console_warning_msg("field_of_view         float         %f", field_of_view);
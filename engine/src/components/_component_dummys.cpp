@@ -4,13 +4,15 @@
 
 using namespace std;
 
+__COMPONENT_POOL_IMPLEMENT(CComponent_Dummy)
+
 vector3f direction;
 float angle;
 
 void CComponent_Dummy::OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix)
 {
-  glBindTexture(GL_TEXTURE_2D, /*gResources.GetTexture("crate1")->GetID()*/ 0);
-  glUseProgram(0);
+  gSystem_GL_State.BindTexture(GL_TEXTURE_2D, /*gResources.GetTexture("crate1")->GetID()*/ 0);
+  gSystem_GL_State.UseProgram(0);
 
   glColor3f(1.f, 1.f, 1.f);
   glMatrixMode(GL_PROJECTION);
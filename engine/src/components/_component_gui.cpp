@@ -3,11 +3,16 @@
 #include "systems/_resource.h"
 #include "systems/_render.h"
 #include "systems/_shader.h"
+#include "systems/_gl_state.h"
+#include "systems/_stream_buffer.h"
 #include "systems/_other.h"
 
+#include <cstring>
+
 using namespace std;
 
-GLuint CComponent_GUI_Texture::m_GUITextureVBOVertices = 0;
+__COMPONENT_POOL_IMPLEMENT(CComponent_GUI_Texture)
+
 GLuint CComponent_GUI_Texture::m_GUITextureVBOTexCoords = 0;
 GLuint CComponent_GUI_Texture::m_GUITextureVAO = 0;
 
@@ -28,8 +33,8 @@ CComponent_GUI_Texture::~CComponent_GUI_Texture()
 
 }
 
-// Problemtico: deben reconstruirse estos VBOs cada vez que se cambie el tamao de la pantalla :L
-//   Solucin temporal -> Actualizar el VBO de vrtices en cada iteracin.
+// Problemático: deben reconstruirse estos VBOs cada vez que se cambie el tamaño de la pantalla :L
+//   Solución temporal -> Escribir los vértices en el buffer circular en cada iteración.
 
 bool CComponent_GUI_Texture::InitRenderVBO()
 {
@@ -45,31 +50,27 @@ bool CComponent_GUI_Texture::InitRenderVBO()
     return false;
   }
 
-  glGenBuffers( 1, &m_GUITextureVBOVertices );
   glGenBuffers( 1, &m_GUITextureVBOTexCoords );
 
-  if(!m_GUITextureVBOVertices or !m_GUITextureVBOTexCoords)
+  if(!m_GUITextureVBOTexCoords)
   {
     gSystem_Debug.error("From CComponent_Transform: Could not generate Transform VBO.");
 
     glDeleteVertexArrays(1, &m_GUITextureVAO);
-    glDeleteBuffers( 1, &m_GUITextureVBOVertices );
     glDeleteBuffers( 1, &m_GUITextureVBOTexCoords );
 
     return false;
   }
 
-  glBindVertexArray(m_GUITextureVAO);
+  gSystem_GL_State.BindVertexArray(m_GUITextureVAO);
 
   glBindBuffer( GL_ARRAY_BUFFER, m_GUITextureVBOTexCoords );
   glBufferData( GL_ARRAY_BUFFER, 6*3*sizeof(GLfloat), GUITexture_TexCoords, GL_DYNAMIC_DRAW );
   glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, 0);
 
-  glBindBuffer( GL_ARRAY_BUFFER, m_GUITextureVBOVertices );
-  glBufferData( GL_ARRAY_BUFFER, 6*3*sizeof(GLfloat), NULL, GL_DYNAMIC_DRAW );
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+  // El atributo 0 apunta al buffer circular, y se fija en UpdateVBO()
 
-  glBindVertexArray(0);
+  gSystem_GL_State.BindVertexArray(0);
 
   return true;
 }
@@ -77,33 +78,18 @@ bool CComponent_GUI_Texture::InitRenderVBO()
 void CComponent_GUI_Texture::CloseRenderVBO()
 {
   glDeleteVertexArrays(1, &m_GUITextureVAO);
-  glDeleteBuffers( 1, &m_GUITextureVBOVertices );
   glDeleteBuffers( 1, &m_GUITextureVBOTexCoords );
 }
 
-void CComponent_GUI_Texture::UpdateVBO()
+bool CComponent_GUI_Texture::UpdateVBO(const draw_t& draw)
 {
-  int w, h;
-  gSystem_Render.GetWindowSize(&w, &h);
-
-  if(w != 0 and h != 0)
-  {
-    const GLfloat GUITexture_Vertices[][3]
-    {
-      {-width/2 + (float)pixel_offset_x/w,  height/2 + (float)pixel_offset_y/h, 0.f},
-      { width/2 + (float)pixel_offset_x/w,  height/2 + (float)pixel_offset_y/h, 0.f},
-      { width/2 + (float)pixel_offset_x/w, -height/2 + (float)pixel_offset_y/h, 0.f},
-      {-width/2 + (float)pixel_offset_x/w, -height/2 + (float)pixel_offset_y/h, 0.f}
-    };
-
-    glBindVertexArray(m_GUITextureVAO);
+  GLintptr offset = gSystem_Stream_Buffer.Write(draw.vertices, sizeof(draw.vertices));
+  if(offset < 0)
+    return false;
 
-    glBindBuffer( GL_ARRAY_BUFFER, m_GUITextureVBOVertices );
-    glBufferData( GL_ARRAY_BUFFER, 6*3*sizeof(GLfloat), GUITexture_Vertices, GL_DYNAMIC_DRAW );
-    //glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (GLvoid*)offset);
 
-    glBindVertexArray(0);
-  }
+  return true;
 }
 
 bool CComponent_GUI_Texture::HitTest(GLfloat x, GLfloat y)
@@ -120,40 +106,71 @@ bool CComponent_GUI_Texture::HitTest(GLfloat x, GLfloat y)
   return false;
 }
 
-void CComponent_GUI_Texture::OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix)
+bool CComponent_GUI_Texture::GetDraw(const glm::mat4& modelViewMatrix, draw_t& draw)
 {
-  if(!enabled) return;
+  if(!enabled) return false;
+
+  int w, h;
+  gSystem_Render.GetWindowSize(&w, &h);
+
+  if(w == 0 or h == 0)
+    return false;
 
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, gSystem_Resources.GetTexture(texture_name)->GetID());
+  draw.texture = gSystem_Resources.GetTexture(texture_name)->GetID();
 
-  gSystem_Math.Clamp(color_apply_force, 0.f, 1.f);
+  draw.modelViewMatrix = glm::translate(modelViewMatrix, gameObject->Transform()->position.to_glm());
+  //draw.modelViewMatrix = draw.modelViewMatrix * gameObject->Transform()->angle; // ¿?
+  draw.modelViewMatrix = draw.modelViewMatrix * glm::mat4_cast(gameObject->Transform()->angle);
+  draw.modelViewMatrix = glm::scale(draw.modelViewMatrix,  gameObject->Transform()->scale.to_glm());
 
-  modelViewMatrix = glm::translate(modelViewMatrix, gameObject->Transform()->position.to_glm());
-  //modelViewMatrix = modelViewMatrix * gameObject->Transform()->angle; // ?
-  modelViewMatrix = modelViewMatrix * glm::mat4_cast(gameObject->Transform()->angle);
-  modelViewMatrix = glm::scale(modelViewMatrix,  gameObject->Transform()->scale.to_glm());
+  draw.color = glm::vec4(color.r, color.g, color.b, color.a);
+  draw.texture_flag = 1.0f - gSystem_Math.Clamp(color_apply_force, 0.f, 1.f);
+
+  const GLfloat GUITexture_Vertices[][3]
+  {
+    {-width/2 + (float)pixel_offset_x/w,  height/2 + (float)pixel_offset_y/h, 0.f},
+    { width/2 + (float)pixel_offset_x/w,  height/2 + (float)pixel_offset_y/h, 0.f},
+    { width/2 + (float)pixel_offset_x/w, -height/2 + (float)pixel_offset_y/h, 0.f},
+    {-width/2 + (float)pixel_offset_x/w, -height/2 + (float)pixel_offset_y/h, 0.f}
+  };
+  memcpy(draw.vertices, GUITexture_Vertices, sizeof(draw.vertices));
+
+  return true;
+}
+
+void CComponent_GUI_Texture::Draw(const draw_t& draw, const glm::mat4& projMatrix)
+{
+  gSystem_GL_State.ActiveTexture(GL_TEXTURE0);
+  gSystem_GL_State.BindTexture(GL_TEXTURE_2D, draw.texture);
 
   CShader* simpleShader = gSystem_Shader_Manager.UseShader("__textureShader");
-  glUniformMatrix4fv(simpleShader->GetUniformIndex("ProjMatrix") , 1, GL_FALSE, glm::value_ptr(projMatrix));
-  glUniformMatrix4fv(simpleShader->GetUniformIndex("ModelViewMatrix") , 1, GL_FALSE, glm::value_ptr(modelViewMatrix));
-  glUniform1f(simpleShader->GetUniformIndex("textureFlag"), 1.0f - color_apply_force);
-  glUniform4f(simpleShader->GetUniformIndex("in_Color"), color.r, color.g, color.b, color.a);
+  glUniformMatrix4fv(simpleShader->GetUniform(Shader::proj_matrix) , 1, GL_FALSE, glm::value_ptr(projMatrix));
+  glUniformMatrix4fv(simpleShader->GetUniform(Shader::modelview_matrix) , 1, GL_FALSE, glm::value_ptr(draw.modelViewMatrix));
+  glUniform1f(simpleShader->GetUniform(Shader::texture_flag), draw.texture_flag);
+  glUniform4f(simpleShader->GetUniform(Shader::color), draw.color.r, draw.color.g, draw.color.b, draw.color.a);
 
-  UpdateVBO();
+  gSystem_GL_State.BindVertexArray(m_GUITextureVAO);
+  if(!UpdateVBO(draw))
+  {
+    gSystem_GL_State.BindVertexArray(0);
+    return;
+  }
 
-  glBindVertexArray(m_GUITextureVAO);
   glEnableVertexAttribArray(0);
   glEnableVertexAttribArray(1);
 
-  glBindBuffer( GL_ARRAY_BUFFER, m_GUITextureVBOVertices );
-  glBindBuffer( GL_ARRAY_BUFFER, m_GUITextureVBOTexCoords );
-
   glDrawArrays( GL_QUADS, 0, 4);
 
   glDisableVertexAttribArray(0);
   glDisableVertexAttribArray(1);
-  glBindVertexArray(0);
+  gSystem_GL_State.BindVertexArray(0);
+}
+
+void CComponent_GUI_Texture::OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix)
+{
+  draw_t draw;
+  if(GetDraw(modelViewMatrix, draw))
+    Draw(draw, projMatrix);
 
   /*glTranslatef(position.x, position.y, position.z);
   //glRotatef(rotation_z, 0.f, 0.f, 1.f);
@@ -1,11 +1,19 @@
 #include "components/_component_mesh_render.h"
 #include "systems/_resource.h"
 #include "systems/_shader.h"
+#include "systems/_gl_state.h"
 #include "systems/_debug.h"
 #include "systems/_other.h"
+#include "systems/_render.h"
+#include "systems/_data.h"
+#include "systems/_static_batching.h"
+
+#include <cstring>
 
 using namespace std;
 
+__COMPONENT_POOL_IMPLEMENT(CComponent_Mesh_Render)
+
 
 //BOOST_CLASS_EXPORT_IMPLEMENT(CComponent_Mesh_Render);
 
@@ -19,11 +27,26 @@ CComponent_Mesh_Render::CComponent_Mesh_Render(CGameObject* gameObject) :
   //materials.resize(0);
   color(1.f, 1.f, 1.f, 1.f);
   color_apply_force = 0.f;
+
+  bounds_mesh = NULL;
+  bounds_version = 0;
+
+  memset(lod, 0, sizeof(lod));
+
+  static_batch = -1;
 }
 
 CComponent_Mesh_Render::~CComponent_Mesh_Render()
 {
   //materials.resize(0);
+
+  // Los demás objetos del grupo vuelven a dibujarse uno a uno
+  if(static_batch >= 0)
+  {
+    int batch = static_batch;
+    static_batch = -1;
+    gSystem_Static_Batching.Unbake(batch);
+  }
 }
 
 void CComponent_Mesh_Render::OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix)
@@ -34,57 +57,159 @@ void CComponent_Mesh_Render::OnRender(glm::mat4 projMatrix, glm::mat4 modelViewM
   // Guardar el shader dentro del mesh render!
   //CShader* simpleShader = gSystem_Shader_Manager.GetShader(shader_name);
   //glUseProgram(simpleShader->GetProgram());
-  glm::mat4 NormalMatrix = glm::transpose(glm::inverse((modelViewMatrix)));
-
   CShader* simpleShader = gSystem_Shader_Manager.UseShader(shader_name);
 
-  glUniformMatrix4fv(simpleShader->GetUniformIndex("ProjMatrix"), 1, GL_FALSE,
+  glUniformMatrix4fv(simpleShader->GetUniform(Shader::proj_matrix), 1, GL_FALSE,
       glm::value_ptr(projMatrix));
-  glUniformMatrix4fv(simpleShader->GetUniformIndex("ModelViewMatrix"), 1, GL_FALSE,
-      glm::value_ptr(modelViewMatrix));
-  glUniformMatrix4fv(simpleShader->GetUniformIndex("NormalMatrix"), 1, GL_FALSE,
-      glm::value_ptr(NormalMatrix));
-  glUniform1i(simpleShader->GetUniformIndex("texture"), 0);
+  glUniform1i(simpleShader->GetUniform(Shader::texture), 0);
 
-  gSystem_Math.Clamp(color_apply_force, 0.f, 1.f);
+  CResource_Mesh* mesh = gSystem_Resources.GetMesh(mesh_name);
+  bool error_mesh = (mesh == gSystem_Resources.GetMesh("__MDL_ERROR"));
 
+  SetUniforms(simpleShader, modelViewMatrix, mesh, error_mesh);
 
   if(before_render)
+  {
     before_render(gameObject);
+    gSystem_GL_State.Invalidate();
+  }
 
   if(color.a != 1.0)
   {
-    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-    glDepthMask(GL_FALSE);
+    gSystem_GL_State.BlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    gSystem_GL_State.DepthMask(GL_FALSE);
     //glEnable(GL_BLEND);
   }
 
-  CResource_Mesh* mesh = gSystem_Resources.GetMesh(mesh_name);
-  glActiveTexture(GL_TEXTURE0);
-  if(mesh != gSystem_Resources.GetMesh("__MDL_ERROR")) // Cambiar el color a rojo
-  {
-    glBindTexture(GL_TEXTURE_2D, gSystem_Resources.GetTexture(material_name)->GetID());
-    glUniform4f(simpleShader->GetUniformIndex("in_Color"), color.r, color.g, color.b, color.a);
-    glUniform1f(simpleShader->GetUniformIndex("textureFlag"), 1.0f - color_apply_force);
-  }
+  gSystem_GL_State.ActiveTexture(GL_TEXTURE0);
+  if(!error_mesh)
+    gSystem_GL_State.BindTexture(GL_TEXTURE_2D, gSystem_Resources.GetTexture(material_name)->GetID());
   else
-  {
-    glBindTexture(GL_TEXTURE_2D, gSystem_Resources.GetTexture("__TEXTURE_WHITE")->GetID());
-    glUniform4f(simpleShader->GetUniformIndex("in_Color"), 1.f, 0.f, 0.56f, 1.f);
-    glUniform1f(simpleShader->GetUniformIndex("textureFlag"), 1.0f);
-  }
+    gSystem_GL_State.BindTexture(GL_TEXTURE_2D, gSystem_Resources.GetTexture("__TEXTURE_WHITE")->GetID());
+
+  // Sin la cola, se dibuja con la cámara actual
+  uint level = 0;
+  CGameObject* camera = gSystem_Render.GetCurrentCamera();
+  if(camera and gSystem_Data_Storage.GetInt("__RENDER_LOD"))
+    level = SelectLOD(mesh, gSystem_Render.GetCurrentCameraIndex(), projMatrix, modelViewMatrix, camera->Camera()->viewport.height * gSystem_Data_Storage.GetInt("__RENDER_RESOLUTION_HEIGHT"),
+                      gSystem_Data_Storage.GetFloat("__RENDER_LOD_PIXEL_ERROR"));
 
-  mesh->Render();
+  mesh->Render(level);
 
-  glDepthMask(GL_TRUE);
+  gSystem_GL_State.DepthMask(GL_TRUE);
   //glDisable(GL_BLEND);
 
   if(after_render)
+  {
     after_render(gameObject);
+    gSystem_GL_State.Invalidate();
+  }
 
   //glUseProgram(0);
 }
 
+void CComponent_Mesh_Render::SetUniforms(CShader* shader, const glm::mat4& modelViewMatrix, CResource_Mesh* mesh, bool error_mesh)
+{
+  // inversa_traspuesta(vista * mundo) = inversa_traspuesta(vista) * inversa_traspuesta(mundo). La primera se calcula una vez por cámara,
+  // y la segunda una vez por iteración en el sistema "transforms"
+  CGameObject* camera = gSystem_Render.GetCurrentCamera();
+  glm::mat4 NormalMatrix = camera ? camera->Camera()->NormalMatrix() * gameObject->Transform()->NormalMatrix()
+                                  : glm::transpose(glm::inverse(modelViewMatrix));
+
+  glm::vec4 out_color;
+  float texture_flag;
+  GetColor(error_mesh, out_color, texture_flag);
+
+  SetUniforms(shader, modelViewMatrix * mesh->DequantizeMatrix(), NormalMatrix, out_color, texture_flag);
+}
+
+void CComponent_Mesh_Render::SetUniforms(CShader* shader, const glm::mat4& modelViewMatrix, const glm::mat4& normalMatrix, const glm::vec4& color, float texture_flag)
+{
+  glUniformMatrix4fv(shader->GetUniform(Shader::modelview_matrix), 1, GL_FALSE,
+      glm::value_ptr(modelViewMatrix));
+
+  // Sólo si el shader la usa (__textureShader no)
+  if(shader->GetUniform(Shader::normal_matrix) >= 0)
+    glUniformMatrix4fv(shader->GetUniform(Shader::normal_matrix), 1, GL_FALSE,
+        glm::value_ptr(normalMatrix));
+
+  glUniform4f(shader->GetUniform(Shader::color), color.r, color.g, color.b, color.a);
+  glUniform1f(shader->GetUniform(Shader::texture_flag), texture_flag);
+}
+
+uint CComponent_Mesh_Render::SelectLOD(CResource_Mesh* mesh, uint camera, const glm::mat4& projMatrix, const glm::mat4& modelViewMatrix, float viewport_height, float max_error)
+{
+  if(max_error <= 0.f or viewport_height <= 0.f or mesh->NumLODs() < 2)
+    return 0;
+
+  // Escala del objeto en la vista: el eje más largo
+  float scale = sqrt(max(glm::length2(glm::vec3(modelViewMatrix[0])), max(glm::length2(glm::vec3(modelViewMatrix[1])), glm::length2(glm::vec3(modelViewMatrix[2])))));
+
+  // projMatrix[1][1] es 1 / tan(fov / 2) en perspectiva, y 2 / alto en ortográfica
+  float pixels_per_unit = projMatrix[1][1] * viewport_height * 0.5f * scale;
+
+  // En perspectiva, se divide por la distancia al punto más cercano de la esfera. Con la cámara dentro, el modelo original
+  if(projMatrix[2][3] != 0.f)
+  {
+    const Culling::sphere_t& sphere = mesh->Bounds().sphere;
+    float distance = -(modelViewMatrix * glm::vec4(sphere.center, 1.f)).z - sphere.radius * scale;
+
+    if(distance <= 0.f)
+    {
+      if(camera < __MESH_RENDER_LOD_CAMERAS)
+        lod[camera] = 0;
+
+      return 0;
+    }
+
+    pixels_per_unit /= distance;
+  }
+
+  // Cada cámara con su nivel: si lo compartieran, dos cámaras a distinta distancia se lo cambiarían una a otra en cada iteración
+  uint current = (camera < __MESH_RENDER_LOD_CAMERAS) ? lod[camera] : 0;
+  uint selected = mesh->SelectLOD(pixels_per_unit, max_error, current);
+  if(camera < __MESH_RENDER_LOD_CAMERAS)
+    lod[camera] = selected;
+
+  return selected;
+}
+
+void CComponent_Mesh_Render::GetColor(bool error_mesh, glm::vec4& out_color, float& texture_flag)
+{
+  float force = gSystem_Math.Clamp(color_apply_force, 0.f, 1.f);
+
+  if(!error_mesh)
+  {
+    out_color = glm::vec4(color.r, color.g, color.b, color.a);
+    texture_flag = 1.0f - force;
+  }
+  else // Cambiar el color a rosa
+  {
+    out_color = glm::vec4(1.f, 0.f, 0.56f, 1.f);
+    texture_flag = 1.0f;
+  }
+}
+
+const Culling::bounds_t& CComponent_Mesh_Render::WorldBounds()
+{
+  CResource_Mesh* mesh = gSystem_Resources.GetMesh(mesh_name);
+  uint version = gameObject->Transform()->WorldVersion();
+
+  if(mesh != bounds_mesh or version != bounds_version)
+  {
+    world_bounds = mesh ? mesh->Bounds().Transform(gameObject->Transform()->WorldMatrix()) : Culling::bounds_t();
+    bounds_mesh = mesh;
+    bounds_version = version;
+  }
+
+  return world_bounds;
+}
+
+bool CComponent_Mesh_Render::IsVisible(const Culling::frustum_t& frustum)
+{
+  return frustum.Intersects(world_bounds);
+}
+
 void CComponent_Mesh_Render::parseDebug(string command)
 {
   stringstream ss(command);
@@ -115,7 +240,10 @@ void CComponent_Mesh_Render::parseDebug(string command)
     }
 
     if(attrib == "mesh_name")
+    {
       mesh_name = data;
+      gameObject->Transform()->BoundsChanged();
+    }
     else if(attrib == "material_name")
       material_name = data;
     else if(attrib == "shader_name")
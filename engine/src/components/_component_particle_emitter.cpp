@@ -2,17 +2,20 @@
 #include "systems/_other.h"
 #include "systems/_resource.h"
 #include "systems/_shader.h"
+#include "systems/_gl_state.h"
+#include "systems/_stream_buffer.h"
 #include "components/_component_particle_emitter.h"
 
+#include <algorithm>
+
 using namespace std;
 
+__COMPONENT_POOL_IMPLEMENT(CComponent_Particle_Emitter)
+
 //BOOST_CLASS_EXPORT_IMPLEMENT(CComponent_Particle_Emitter);
 GLuint CComponent_Particle_Emitter::m_ParticlesVAO = 0;
 GLuint CComponent_Particle_Emitter::m_ParticlesVBOVertices = 0;
-
-GLuint CComponent_Particle_Emitter::m_ParticlesVBOPosition = 0;
-GLuint CComponent_Particle_Emitter::m_ParticlesVBOAngleScale = 0;
-GLuint CComponent_Particle_Emitter::m_ParticlesVBOColor = 0;
+vector<GLfloat> CComponent_Particle_Emitter::stream_data;
 
 bool CComponent_Particle_Emitter::InitRenderVBO()
 {
@@ -23,24 +26,16 @@ bool CComponent_Particle_Emitter::InitRenderVBO()
         "From CComponent_Particle_Emitter: Could not generate Particle Emitter VAO.");
   }
 
-  glBindVertexArray(m_ParticlesVAO);
+  gSystem_GL_State.BindVertexArray(m_ParticlesVAO);
 
   glGenBuffers(1, &m_ParticlesVBOVertices);
 
-  glGenBuffers(1, &m_ParticlesVBOPosition);
-  glGenBuffers(1, &m_ParticlesVBOAngleScale);
-  glGenBuffers(1, &m_ParticlesVBOColor);
-
-  if(!m_ParticlesVBOVertices or !m_ParticlesVBOPosition or !m_ParticlesVBOAngleScale or !m_ParticlesVBOColor)
+  if(!m_ParticlesVBOVertices)
   {
     gSystem_Debug.error("From CComponent_Particle_Emitter: Could not generate Particle Emitter VBO.");
 
     glDeleteBuffers(1, &m_ParticlesVBOVertices);
 
-    glDeleteBuffers(1, &m_ParticlesVBOPosition);
-    glDeleteBuffers(1, &m_ParticlesVBOAngleScale);
-    glDeleteBuffers(1, &m_ParticlesVBOColor);
-
     glDeleteVertexArrays(1, &m_ParticlesVAO);
 
     return false;
@@ -59,25 +54,14 @@ bool CComponent_Particle_Emitter::InitRenderVBO()
 
   // los 2 VBOs de arriban se pueden poner como constantes dentro del shader, ya que permanecen intactos
 
-  // Other, not inited yet
-  glBindBuffer(GL_ARRAY_BUFFER, m_ParticlesVBOPosition);
-  //glBufferData(GL_ARRAY_BUFFER, particles.size() * 3 * sizeof(GLfloat), NULL, GL_STREAM_DRAW);
-  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
-
-  glBindBuffer(GL_ARRAY_BUFFER, m_ParticlesVBOAngleScale);
-  //glBufferData(GL_ARRAY_BUFFER, particles.size() * 2 * sizeof(GLfloat), NULL, GL_STREAM_DRAW);
-  glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, 0);
-
-  glBindBuffer(GL_ARRAY_BUFFER, m_ParticlesVBOColor);
-  //glBufferData(GL_ARRAY_BUFFER, particles.size() * 4 * sizeof(GLfloat), NULL, GL_STREAM_DRAW);
-  glVertexAttribPointer(3, 4, GL_FLOAT, GL_TRUE, 0, 0);
+  // Los atributos 1 a 3 apuntan al buffer circular, y se fijan en UpdateVBO() en cada iteración
 
   glVertexAttribDivisor(0, 0);
   glVertexAttribDivisor(1, 1);
   glVertexAttribDivisor(2, 1);
   glVertexAttribDivisor(3, 1);
 
-  glBindVertexArray(0);
+  gSystem_GL_State.BindVertexArray(0);
 
   return true;
 }
@@ -86,10 +70,6 @@ void CComponent_Particle_Emitter::CloseRenderVBO()
 {
   glDeleteBuffers(1, &m_ParticlesVBOVertices);
 
-  glDeleteBuffers(1, &m_ParticlesVBOPosition);
-  glDeleteBuffers(1, &m_ParticlesVBOAngleScale);
-  glDeleteBuffers(1, &m_ParticlesVBOColor);
-
   glDeleteVertexArrays(1, &m_ParticlesVAO);
 }
 
@@ -163,7 +143,7 @@ CComponent_Particle_Emitter::~CComponent_Particle_Emitter()
   /*for(vector<CParticle>::iterator it = particles.begin(); it != particles.end(); ++it)
   {
     delete (*it);
-    // ->xBUG Tiempos demasiado largos a la hora de borrar partculas. Normal, son demasiadas, y parece que "delete" es lento.
+    // ->xBUG Tiempos demasiado largos a la hora de borrar partículas. Normal, son demasiadas, y parece que "delete" es lento.
     // Parece arreglado, ya que no da problemas. Ahora no se usan punteros, sino que se utilizan objetos. Tal vez, en un futuro, se usen punteros por simplicidad.
   }*/
 
@@ -212,7 +192,7 @@ void CComponent_Particle_Emitter::Start()
       new_particles = particles_per_second * gSystem_Time.GetTicks_s();
   }
 
-  for(vector<CParticle>::iterator it = particles.begin(); it != particles.end(); ++it)
+  for(particle_list_t::iterator it = particles.begin(); it != particles.end(); ++it)
   {
     //(*it) = new CParticle;
     //(*it) = CParticle();
@@ -230,24 +210,40 @@ void CComponent_Particle_Emitter::Start()
   v_ParticlesColor_data.resize(max_particles*4);
 }
 
-void CComponent_Particle_Emitter::UpdateVBO()
+bool CComponent_Particle_Emitter::UpdateVBO(const GLfloat* positions, const GLfloat* angle_scale, const GLfloat* colors, uint count)
+{
+  if(!count)
+    return false;
+
+  // Una sola escritura: si el buffer da la vuelta entre dos, sin ARB_buffer_storage se deja huérfano y la primera se podría perder.
+  // Las copias de CRender_Queue ya están seguidas; las del propio componente se juntan antes
+  const GLfloat* data = positions;
+  if(angle_scale != positions + count * 3 or colors != positions + count * 5)
+  {
+    stream_data.resize(count * 9);
+    copy(positions, positions + count * 3, stream_data.begin());
+    copy(angle_scale, angle_scale + count * 2, stream_data.begin() + count * 3);
+    copy(colors, colors + count * 4, stream_data.begin() + count * 5);
+    data = &stream_data[0];
+  }
+
+  GLintptr offset = gSystem_Stream_Buffer.Write(data, count * 9 * sizeof(GLfloat));
+  if(offset < 0) return false;
+
+  // Write() deja el buffer circular enlazado, así que cada atributo queda apuntando a su parte del bloque
+  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (GLvoid*)offset);
+  glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, (GLvoid*)(offset + count * 3 * sizeof(GLfloat)));
+  glVertexAttribPointer(3, 4, GL_FLOAT, GL_TRUE, 0, (GLvoid*)(offset + count * 5 * sizeof(GLfloat)));
+
+  return true;
+}
+
+GLuint CComponent_Particle_Emitter::GetTexture()
 {
-  glBindBuffer(GL_ARRAY_BUFFER, m_ParticlesVBOPosition);
-  glBufferData(GL_ARRAY_BUFFER, particles.size() * 3 * sizeof(GLfloat), NULL, GL_STREAM_DRAW);
-  glBufferSubData(GL_ARRAY_BUFFER, 0, particles.size() * 3 * sizeof(GLfloat), &v_ParticlePosition_data[0]);
-  //glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
-
-  glBindBuffer(GL_ARRAY_BUFFER, m_ParticlesVBOAngleScale);
-  glBufferData(GL_ARRAY_BUFFER, particles.size() * 2 * sizeof(GLfloat), NULL, GL_STREAM_DRAW);
-  glBufferSubData(GL_ARRAY_BUFFER, 0, particles.size() * 2 * sizeof(GLfloat), &v_ParticlesAngleScale_data[0]);
-  //glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, 0);
-
-  glBindBuffer(GL_ARRAY_BUFFER, m_ParticlesVBOColor);
-  glBufferData(GL_ARRAY_BUFFER, particles.size() * 4 * sizeof(GLfloat), NULL, GL_STREAM_DRAW);
-  glBufferSubData(GL_ARRAY_BUFFER, 0, particles.size() * 4 * sizeof(GLfloat), &v_ParticlesColor_data[0]);
-  //glVertexAttribPointer(3, 4, GL_FLOAT, GL_TRUE, 0, 0);
-
-  //glBindVertexArray(0);
+  if(material_name == "")
+    return 0; // ¿?
+
+  return gSystem_Resources.GetTexture(material_name)->GetID();
 }
 
 void CComponent_Particle_Emitter::NewParticle(CParticle& p, vector3f pos_difference)
@@ -260,9 +256,9 @@ void CComponent_Particle_Emitter::NewParticle(CParticle& p, vector3f pos_differe
   p.color.b = gMath.random(start_min_color.b, start_max_color.b);
   p.color.a = gMath.random(start_min_color.a, start_max_color.a);
 
-  vector3f random_vector = gMath.random_vector(direction.normalize(), angle_spread/2);                // Direccin
-  vector3f random_vector_XZ = vector3f(random_vector.x, 0, random_vector.z).normalize();  // Separacin del origen
-  // ->POR-HACER Hay que hacer que el rea de generacin aleatoria de partculas sea perpendicular al vector de direccin.
+  vector3f random_vector = gMath.random_vector(direction.normalize(), angle_spread/2);                // Dirección
+  vector3f random_vector_XZ = vector3f(random_vector.x, 0, random_vector.z).normalize();  // Separación del origen
+  // ->POR-HACER Hay que hacer que el área de generación aleatoria de partículas sea perpendicular al vector de dirección.
 
   p.position = random_vector * gMath.random(start_min_distance, start_max_distance) + pos_difference;
   p.position += random_vector_XZ * gMath.random(start_max_base_radius, start_min_base_radius);
@@ -334,50 +330,63 @@ void makebillboardGLM(glm::mat4& matrix)
   matrix = output;
 }
 
-// ->NOTA En CComponent_Particle_Emitter::OnRender(), se producen algunos bajones de fps cuando el nmero de particulas supera una cierta cantidad (50.000). No debera ser muy problemtico para casos sencillos.
+Culling::bounds_t CComponent_Particle_Emitter::WorldBounds()
+{
+  return Culling::bounds_t(local_bounds).Transform(gameObject->Transform()->WorldMatrix());
+}
+
+bool CComponent_Particle_Emitter::IsVisible(const Culling::frustum_t& frustum)
+{
+  return frustum.Intersects(Culling::bounds_t(local_bounds).Transform(gameObject->Transform()->CachedWorldMatrix()));
+}
+
+// ->NOTA En CComponent_Particle_Emitter::OnRender(), se producen algunos bajones de fps cuando el número de particulas supera una cierta cantidad (50.000). No debería ser muy problemático para casos sencillos.
 void CComponent_Particle_Emitter::OnRender(glm::mat4 projMatrix, glm::mat4 modelViewMatrix)
 {
-  if(!enabled) return;
+  if(!enabled or particles.empty()) return;
 
-  glDepthMask(GL_FALSE);
-  glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
+  Draw(projMatrix, modelViewMatrix, GetTexture(), &v_ParticlePosition_data[0], &v_ParticlesAngleScale_data[0], &v_ParticlesColor_data[0], particles.size());
+}
 
-  glBindVertexArray(m_ParticlesVAO);
-  UpdateVBO();
+void CComponent_Particle_Emitter::Draw(const glm::mat4& projMatrix, const glm::mat4& modelViewMatrix, GLuint texture, const GLfloat* positions, const GLfloat* angle_scale, const GLfloat* colors, uint count)
+{
+  gSystem_GL_State.BindVertexArray(m_ParticlesVAO);
+  if(!UpdateVBO(positions, angle_scale, colors, count))
+  {
+    gSystem_GL_State.BindVertexArray(0);
+    return;
+  }
 
-  glActiveTexture(GL_TEXTURE0);
-  if(material_name != "") glBindTexture(GL_TEXTURE_2D, gSystem_Resources.GetTexture(material_name)->GetID());
-  else                    glBindTexture(GL_TEXTURE_2D, 0); // ?
+  gSystem_GL_State.DepthMask(GL_FALSE);
+  gSystem_GL_State.BlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
+
+  gSystem_GL_State.ActiveTexture(GL_TEXTURE0);
+  gSystem_GL_State.BindTexture(GL_TEXTURE_2D, texture);
 
   CShader* shader = gSystem_Shader_Manager.UseShader("__particlesShader");
-  glUniformMatrix4fv(shader->GetUniformIndex("ProjMatrix") , 1, GL_FALSE, glm::value_ptr(projMatrix));
-  glUniformMatrix4fv(shader->GetUniformIndex("ModelViewMatrix") , 1, GL_FALSE, glm::value_ptr(modelViewMatrix));
-  glUniform1i(shader->GetUniformIndex("texture"), 0);
-  glUniform1f(shader->GetUniformIndex("textureFlag"), 1.f);
+  glUniformMatrix4fv(shader->GetUniform(Shader::proj_matrix) , 1, GL_FALSE, glm::value_ptr(projMatrix));
+  glUniformMatrix4fv(shader->GetUniform(Shader::modelview_matrix) , 1, GL_FALSE, glm::value_ptr(modelViewMatrix));
+  glUniform1i(shader->GetUniform(Shader::texture), 0);
+  glUniform1f(shader->GetUniform(Shader::texture_flag), 1.f);
 
   glEnableVertexAttribArray(0);
   glEnableVertexAttribArray(1);
   glEnableVertexAttribArray(2);
   glEnableVertexAttribArray(3);
 
-  glBindBuffer(GL_ARRAY_BUFFER, m_ParticlesVBOVertices);
-  glBindBuffer(GL_ARRAY_BUFFER, m_ParticlesVBOPosition);
-  glBindBuffer(GL_ARRAY_BUFFER, m_ParticlesVBOAngleScale);
-  glBindBuffer(GL_ARRAY_BUFFER, m_ParticlesVBOColor);
-
-  glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, particles.size());
+  glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
 
   glDisableVertexAttribArray(0);
   glDisableVertexAttribArray(1);
   glDisableVertexAttribArray(2);
   glDisableVertexAttribArray(3);
 
-  glBindVertexArray(0);
+  gSystem_GL_State.BindVertexArray(0);
 
-  glDepthMask(GL_TRUE);
+  gSystem_GL_State.DepthMask(GL_TRUE);
 };
 
-// ->PORHACER En CComponent_Particle_Emitter::OnLoop(), falta activar los valores "maximos" durante la emisin de la partcula. Se puede usar CSystem_Mat.Clamp()
+// ->PORHACER En CComponent_Particle_Emitter::OnLoop(), falta activar los valores "maximos" durante la emisión de la partícula. Se puede usar CSystem_Mat.Clamp()
 void CComponent_Particle_Emitter::OnLoop()
 {
   if(freeze || !enabled) return;
@@ -401,7 +410,10 @@ void CComponent_Particle_Emitter::OnLoop()
   }
 
   int added_particles = 0;
-  for(vector<CParticle>::iterator it = particles.begin(); it != particles.end(); ++it)
+  float max_particle_scale = 0.f;
+  local_bounds.Clear();
+
+  for(particle_list_t::iterator it = particles.begin(); it != particles.end(); ++it)
   {
     if((*it).life >= 0 and (*it).active)
     {
@@ -449,6 +461,9 @@ void CComponent_Particle_Emitter::OnLoop()
       v_ParticlePosition_data[3*index + 1] = (*it).position.y;
       v_ParticlePosition_data[3*index + 2] = (*it).position.z;
 
+      local_bounds.Extend(glm::vec3((*it).position.x, (*it).position.y, (*it).position.z));
+      max_particle_scale = std::max(max_particle_scale, std::abs((*it).scale));
+
       // Angle and scale
       v_ParticlesAngleScale_data[2*index + 0] = (*it).angle;
       v_ParticlesAngleScale_data[2*index + 1] = (*it).scale;
@@ -473,6 +488,9 @@ void CComponent_Particle_Emitter::OnLoop()
   if(((int)new_particles) > 0)  // If enough time has elapsed, lets reset this var.
     new_particles = 0;
 
+  // Cada partícula es un billboard de lado "scale" centrado en su posición
+  local_bounds.Inflate(max_particle_scale);
+
   /*v_ParticlesColor_data[0] = 1.f;
   v_ParticlesColor_data[1] = 0.f;
   v_ParticlesColor_data[2] = 0.f;
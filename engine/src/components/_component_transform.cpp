@@ -1,6 +1,9 @@
 #include "components/_component_transform.h"
 #include "systems/_other.h"
 #include "systems/_shader.h"
+#include "systems/_gl_state.h"
+#include "systems/_simd.h"
+#include "systems/_spatial.h"
 
 #include "_object.h"
 
@@ -92,7 +95,7 @@ bool CComponent_Transform::InitRenderVBO()
     return false;
   }
 
-  glBindVertexArray(m_TransformVAO);
+  gSystem_GL_State.BindVertexArray(m_TransformVAO);
 
   glBindBuffer( GL_ARRAY_BUFFER, m_TransformVBOVertices );
   glBufferData( GL_ARRAY_BUFFER, 6*3*sizeof(GLfloat), transform_vertices, GL_STATIC_DRAW );
@@ -102,7 +105,7 @@ bool CComponent_Transform::InitRenderVBO()
   glBufferData( GL_ARRAY_BUFFER, 6*3*sizeof(GLfloat), transform_colors, GL_STATIC_DRAW );
   glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
 
-  glBindVertexArray(0);
+  gSystem_GL_State.BindVertexArray(0);
 
   return true;
 }
@@ -116,7 +119,182 @@ void CComponent_Transform::CloseRenderVBO()
 }
 
 
-CComponent_Transform::CComponent_Transform(CGameObject* gameObject): CComponent(gameObject)
+__COMPONENT_POOL_IMPLEMENT(CComponent_Transform)
+
+CComponent_Transform_Data::~CComponent_Transform_Data()
+{
+  for(uint i = 0; i < num_chunks; i++)
+    delete chunks[i];
+
+  delete[] chunks;
+  for(vector<chunk_t**>::iterator it = old_chunks.begin(); it != old_chunks.end(); ++it)
+    delete[] (*it);
+}
+
+uint CComponent_Transform_Data::Allocate(CComponent_Transform* owner)
+{
+  SDL_AtomicLock(&lock);
+
+  if(free_list.empty())
+  {
+    // Las tablas llenas no se borran: otros hilos pueden estar leyéndolas
+    if(num_chunks == chunks_capacity)
+    {
+      uint capacity = chunks_capacity ? chunks_capacity * 2 : 16;
+      chunk_t** table = new chunk_t*[capacity];
+      for(uint c = 0; c < num_chunks; c++)
+        table[c] = chunks[c];
+
+      if(chunks)
+        old_chunks.push_back(chunks);
+      chunks = table;
+      chunks_capacity = capacity;
+    }
+
+    chunk_t* chunk = new chunk_t;
+    uint base = num_chunks * __COMPONENT_POOL_CHUNK_SIZE;
+    chunks[num_chunks] = chunk;
+    num_chunks++;
+
+    for(int i = __COMPONENT_POOL_CHUNK_SIZE - 1; i >= 0; i--)
+    {
+      chunk->owner[i] = NULL;
+      free_list.push_back(base + i);
+    }
+  }
+
+  uint index = free_list.back();
+  free_list.pop_back();
+
+  chunk_t* chunk = chunks[index / __COMPONENT_POOL_CHUNK_SIZE];
+  uint i = index % __COMPONENT_POOL_CHUNK_SIZE;
+
+  chunk->owner[i] = owner;
+  chunk->position[i] = vector3f(0.f, 0.f, 0.f);
+  chunk->angle[i] = glm::quat();
+  chunk->scale[i] = vector3f(1.f, 1.f, 1.f);
+  hierarchy_dirty = true;
+
+  SDL_AtomicUnlock(&lock);
+
+  return index;
+}
+
+void CComponent_Transform_Data::Free(uint index)
+{
+  SDL_AtomicLock(&lock);
+
+  if(index < num_chunks * __COMPONENT_POOL_CHUNK_SIZE)
+  {
+    chunks[index / __COMPONENT_POOL_CHUNK_SIZE]->owner[index % __COMPONENT_POOL_CHUNK_SIZE] = NULL;
+    free_list.push_back(index);
+    hierarchy_dirty = true;
+  }
+
+  SDL_AtomicUnlock(&lock);
+}
+
+void CComponent_Transform_Data::BuildHierarchy()
+{
+  if(!hierarchy_dirty)
+    return;
+
+  SDL_AtomicLock(&lock);
+
+  uint capacity = num_chunks * __COMPONENT_POOL_CHUNK_SIZE;
+  first_child.assign(capacity, -1);
+  next_sibling.assign(capacity, -1);
+
+  // Padre de cada transformación (listas de hijos enlazadas, sin reservar memoria por objeto)
+  for(int index = capacity - 1; index >= 0; index--)
+  {
+    CComponent_Transform* t = chunks[index / __COMPONENT_POOL_CHUNK_SIZE]->owner[index % __COMPONENT_POOL_CHUNK_SIZE];
+    CComponent_Transform* parent = t ? t->ParentTransform() : NULL;
+    if(parent)
+    {
+      next_sibling[index] = first_child[parent->data_index];
+      first_child[parent->data_index] = index;
+    }
+  }
+
+  order.clear();
+  order_owner.clear();
+  order_parent.clear();
+  order_size.clear();
+
+  // Preorden desde cada raíz
+  for(uint root = 0; root < capacity; root++)
+  {
+    CComponent_Transform* t = chunks[root / __COMPONENT_POOL_CHUNK_SIZE]->owner[root % __COMPONENT_POOL_CHUNK_SIZE];
+    if(!t or t->ParentTransform())
+      continue;
+
+    stack.clear();
+    stack.push_back(root);
+    while(!stack.empty())
+    {
+      uint index = stack.back();
+      stack.pop_back();
+
+      chunk_t* chunk = chunks[index / __COMPONENT_POOL_CHUNK_SIZE];
+      CComponent_Transform* owner = chunk->owner[index % __COMPONENT_POOL_CHUNK_SIZE];
+      CComponent_Transform* parent = owner->ParentTransform();
+
+      chunk->order_index[index % __COMPONENT_POOL_CHUNK_SIZE] = order.size();
+      order.push_back(index);
+      order_owner.push_back(owner);
+      order_parent.push_back(parent ? (int)chunks[parent->data_index / __COMPONENT_POOL_CHUNK_SIZE]->order_index[parent->data_index % __COMPONENT_POOL_CHUNK_SIZE] : -1);
+      order_size.push_back(1);
+
+      for(int child = first_child[index]; child >= 0; child = next_sibling[child])
+        stack.push_back(child);
+    }
+  }
+
+  // Los hijos van después que sus padres, así que basta una pasada hacia atrás
+  for(int i = order.size() - 1; i > 0; i--)
+    if(order_parent[i] >= 0)
+      order_size[order_parent[i]] += order_size[i];
+
+  hierarchy_dirty = false;
+
+  SDL_AtomicUnlock(&lock);
+}
+
+bool CComponent_Transform_Data::Subtree(uint index, uint& begin, uint& end)
+{
+  if(hierarchy_dirty or index >= num_chunks * __COMPONENT_POOL_CHUNK_SIZE)
+    return false;
+
+  uint position = chunks[index / __COMPONENT_POOL_CHUNK_SIZE]->order_index[index % __COMPONENT_POOL_CHUNK_SIZE];
+  if(position >= order.size() or order[position] != index)
+    return false;
+
+  begin = position + 1;
+  end = position + order_size[position];
+
+  return true;
+}
+
+CComponent_Transform_Data& CComponent_Transform::Data()
+{
+  static CComponent_Transform_Data data;
+  return data;
+}
+
+CComponent_Transform::CComponent_Transform(CGameObject* gameObject): CComponent(gameObject),
+  data_index(Data().Allocate(this)),
+  position(Data().position(data_index)),
+  scale(Data().scale(data_index)),
+  angle(Data().angle(data_index)),
+  local_matrix(Data().local(data_index)),
+  world_matrix(Data().world(data_index)),
+  normal_matrix(Data().normal(data_index)),
+  dirty(true),
+  world_version(0),
+  parent_version(0),
+  last_parent(NULL),
+  normal_version(0)
 {
   position.x = position.y = position.z = 0;
   scale.x = scale.y = scale.z = 1.f;
@@ -124,12 +302,18 @@ CComponent_Transform::CComponent_Transform(CGameObject* gameObject): CComponent(
 
 CComponent_Transform::~CComponent_Transform()
 {
-
+  gSystem_Spatial.Remove(data_index);
+  Data().Free(data_index);
 }
 
 void CComponent_Transform::Set(input_t d)
 {
-  (*this) = *(CComponent_Transform*)d;
+  CComponent_Transform* t = (CComponent_Transform*)d;
+
+  enabled = t->enabled;
+  position = t->position;
+  angle = t->angle;
+  scale = t->scale;
 }
 
 output_t CComponent_Transform::Get()
@@ -167,7 +351,7 @@ void CComponent_Transform::OnRender(glm::mat4 modelViewMatrix, glm::mat4 projMat
 
 }
 
-// ->xPORHACER Habra que echarle un vistazo a la funcin CComponent_Transform::EulerAngles(), ya que no devuelve los valores de rotacin "deseados", o mejor dicho, esperados
+// ->xPORHACER Habría que echarle un vistazo a la función CComponent_Transform::EulerAngles(), ya que no devuelve los valores de rotación "deseados", o mejor dicho, esperados
 vector3f CComponent_Transform::EulerAngles()
 {
   //return vector3f(pitch(), yaw(), roll());
@@ -196,13 +380,13 @@ void CComponent_Transform::LTranslate(GLfloat x, GLfloat y, GLfloat z)
 {
   if(!enabled or (x == 0 and y == 0 and z == 0)) return;
 
-  // Mover basandose en la rotacin (cosa extraa)
+  // Mover basandose en la rotación (cosa extraña)
   // Translate X
   /*glMatrixMode(GL_MODELVIEW);
   glPushMatrix();
   glLoadIdentity();
 
-  // Orientacin
+  // Orientación
   glMultMatrixf((const float*)glm::value_ptr(glm::toMat4(angle)));
   glTranslatef(x, y, z);
 
@@ -218,17 +402,19 @@ void CComponent_Transform::LTranslate(GLfloat x, GLfloat y, GLfloat z)
   position.x += transformMatrix[3][0];
   position.y += transformMatrix[3][1];
   position.z += transformMatrix[3][2];
+  dirty = true;
 }
 
 void CComponent_Transform::LRotate(GLfloat x, GLfloat y, GLfloat z)
 {
   if(!enabled or (x == 0 and y == 0 and z == 0)) return;
 
-  // Como Rotate(), slo que primero se aplica la rotacin, y luego la orientacin (mientras que en Rotate se aplica primero la orientacin y luego la rotacin).
+  // Como Rotate(), sólo que primero se aplica la rotación, y luego la orientación (mientras que en Rotate se aplica primero la orientación y luego la rotación).
   gMath.NormalizeAngles(x, y, z);
 
   glm::vec3 EulerAngles(_DEG_TO_RAD(x), _DEG_TO_RAD(y), _DEG_TO_RAD(z));
   angle = angle * glm::quat(EulerAngles);
+  dirty = true;
 }
 
 void CComponent_Transform::Translate(vector3f v)
@@ -243,6 +429,7 @@ void CComponent_Transform::Translate(GLfloat x, GLfloat y, GLfloat z)
   position.x += x;
   position.y += y;
   position.z += z;
+  dirty = true;
 
 }
 
@@ -258,6 +445,7 @@ void CComponent_Transform::SetPosition(GLfloat x, GLfloat y, GLfloat z)
    position.x = x;
    position.y = y;
    position.z = z;
+   dirty = true;
 }
 
 void CComponent_Transform::Rotate(vector3f v)
@@ -273,6 +461,7 @@ void CComponent_Transform::Rotate(GLfloat x, GLfloat y, GLfloat z)
 
   glm::vec3 EulerAngles(_DEG_TO_RAD(x), _DEG_TO_RAD(y), _DEG_TO_RAD(z));
   angle = glm::quat(EulerAngles) * angle;
+  dirty = true;
 }
 
 void CComponent_Transform::SetAngle(vector3f v)
@@ -283,6 +472,7 @@ void CComponent_Transform::SetAngle(vector3f v)
   v = gSystem_Math.NormalizeAngles(v);
   v = gSystem_Math.deg_to_rad(v);
   angle = glm::quat(v.to_glm());
+  dirty = true;
 }
 
 void CComponent_Transform::SetAngle(GLfloat x, GLfloat y, GLfloat z)
@@ -311,6 +501,7 @@ void CComponent_Transform::Scale(GLfloat x, GLfloat y, GLfloat z)
   scale.x *= x;
   scale.y *= y;
   scale.z *= z;
+  dirty = true;
 }
 
 void CComponent_Transform::SetScale(vector3f v)
@@ -325,102 +516,210 @@ void CComponent_Transform::SetScale(GLfloat x, GLfloat y, GLfloat z)
   scale.x = x;
   scale.y = y;
   scale.z = z;
+  dirty = true;
 }
 
-glm::mat4 CComponent_Transform::ApplyTransform(const glm::mat4& modelviewMatrix)
+// Comparación exacta: vector3f_t::operator!= usa una precisión, y la caché no debe ignorar movimientos pequeños
+static inline bool changed_vector(const vector3f& a, const vector3f& b)
 {
-  //transformMatrix = modelviewMatrix;
-  glm::mat4 transformMatrix = modelviewMatrix;
-
-  if(gameObject->GetParent())
-    ApplyParentTransform(gameObject->GetParent(), transformMatrix);
+  return a.x != b.x or a.y != b.y or a.z != b.z;
+}
 
-  // Posicin
-  // -> glTranslatef(position.x, position.y, position.z);
-  // Orientacin
-  // -> glMultMatrixf((const float*)glm::value_ptr(glm::toMat4(angle)));                  // <- GLOBAL
-  //glMultMatrixf((const float*)glm::value_ptr(glm::inverse(glm::toMat4(angle))));  // <- LOCAL
-  // Escala
-  // -> glScalef(scale.x, scale.y, scale.z);
-  transformMatrix = glm::translate(transformMatrix, position.to_glm());
-  transformMatrix = transformMatrix * (glm::toMat4(angle));
-  transformMatrix = glm::scale(transformMatrix, scale.to_glm());
+CComponent_Transform* CComponent_Transform::ParentTransform()
+{
+  CGameObject* parent = gameObject ? gameObject->GetParent() : NULL;
+  return parent ? parent->Transform() : NULL;
+}
 
-  //glLoadMatrixf((const float*)glm::value_ptr(transformMatrix));
-  return transformMatrix;
+bool CComponent_Transform::LocalChanged()
+{
+  return dirty or changed_vector(position, last_position) or angle != last_angle or changed_vector(scale, last_scale);
 }
 
-void CComponent_Transform::ApplyParentTransform(CGameObject* parent, glm::mat4& transformMatrix)
+void CComponent_Transform::SaveLocal()
 {
-  //   if(!parent->transform()->enabled) return;
-  // Se puede usar en una pila sin problemas y sin llamadas recursivas
-  // se evita el parmetro "parent"
-  if(parent == NULL)
-    return ;
+  last_position = position;
+  last_angle = angle;
+  last_scale = scale;
+  dirty = false;
+}
 
-  ApplyParentTransform(parent->GetParent(), transformMatrix);
+bool CComponent_Transform::UpdateLocal()
+{
+  if(!LocalChanged())
+    return false;
 
-  // Posicin
-  //glTranslatef(parent->Transform()->position.x, parent->Transform()->position.y, parent->Transform()->position.z);
-  // Orientacin
-  //glMultMatrixf((const float*)glm::value_ptr(glm::toMat4(parent->Transform()->angle)));                  // <- GLOBAL
-  // Escala
-  //glScalef(parent->Transform()->scale.x, parent->Transform()->scale.y, parent->Transform()->scale.z);
+  uint index = 0;
+  SIMD::ComposeTRS(&position, &angle, &scale, &local_matrix, &index, 1);
+  SaveLocal();
 
-  transformMatrix = glm::translate(transformMatrix, parent->Transform()->position.to_glm());
-  transformMatrix = transformMatrix * (glm::toMat4(parent->Transform()->angle));
-  transformMatrix = glm::scale(transformMatrix, parent->Transform()->scale.to_glm());
+  return true;
+}
 
-  //glLoadMatrixf((const float*)glm::value_ptr(transformMatrix));
+void CComponent_Transform::UpdateWorld(CComponent_Transform* parent_transform)
+{
+  bool changed = UpdateLocal();
 
-  /*std::stack<CGameObject*> parent_stack;
-  CGameObject* p = gameObject->GetParent();
-  while(p)
+  if(parent_transform)
+  {
+    if(changed or parent_transform != last_parent or parent_transform->world_version != parent_version)
+    {
+      world_matrix = parent_transform->world_matrix * local_matrix;
+      last_parent = parent_transform;
+      parent_version = parent_transform->world_version;
+      world_version++;
+      Data().Moved(data_index);
+    }
+  }
+  else if(changed or last_parent)
   {
-    parent_stack.push(p);
-    p = p->GetParent();
+    world_matrix = local_matrix;
+    last_parent = NULL;
+    world_version++;
+    Data().Moved(data_index);
   }
+}
+
+const glm::mat4& CComponent_Transform::WorldMatrix()
+{
+  CComponent_Transform* parent_transform = ParentTransform();
+
+  // Valida antes la caché de los ancestros
+  if(parent_transform)
+    parent_transform->WorldMatrix();
 
-  while(!parent_stack.empty())
+  UpdateWorld(parent_transform);
+
+  return world_matrix;
+}
+
+const glm::mat4& CComponent_Transform::NormalMatrix()
+{
+  WorldMatrix();
+
+  if(normal_version != world_version)
   {
-    p = parent_stack.top();
-    parent_stack.pop();
+    const glm::mat4* input = &world_matrix;
+    glm::mat4* output = &normal_matrix;
+    SIMD::NormalMatrices(&input, &output, 1);
+
+    normal_version = world_version;
+  }
 
-    glTranslatef(p->transform()->position.x, p->transform()->position.y, p->transform()->position.z);
+  return normal_matrix;
+}
 
-    glRotatef(p->transform()->angle.x, 1.f, 0.f, 0.f);
-    glRotatef(p->transform()->angle.y, 0.f, 1.f, 0.f);
-    glRotatef(p->transform()->angle.z, 0.f, 0.f, 1.f);
+void CComponent_Transform_Data::FlushBatch()
+{
+  if(!batch_output.empty())
+    SIMD::MultiplyMatrices(&batch_left[0], &batch_right[0], &batch_output[0], batch_output.size());
 
-    glScalef(p->transform()->scale.x, p->transform()->scale.y, p->transform()->scale.z);
-  }*/
+  batch_left.clear();
+  batch_right.clear();
+  batch_output.clear();
 }
 
-vector3f_t CComponent_Transform::Position()
+void CComponent_Transform::UpdateWorldMatrices()
 {
-  if(!gameObject->GetParent())
-    return position;
+  CComponent_Transform_Data& data = Data();
+  data.BuildHierarchy();
 
-  /*glMatrixMode(GL_MODELVIEW);
-  glPushMatrix();
-  glLoadIdentity();
+  uint size = data.order_owner.size();
+  data.changed.assign(size, 0);
 
-  ApplyParentTransform(gameObject->GetParent());
+  // Matrices locales: se buscan las que han cambiado en cada bloque SoA, y se calculan todas juntas
+  for(uint c = 0; c < data.num_chunks; c++)
+  {
+    CComponent_Transform_Data::chunk_t* chunk = data.chunks[c];
+
+    data.indices.clear();
+    for(uint i = 0; i < __COMPONENT_POOL_CHUNK_SIZE; i++)
+    {
+      CComponent_Transform* t = chunk->owner[i];
+      if(t and t->LocalChanged())
+      {
+        t->SaveLocal();
+        data.indices.push_back(i);
+        data.changed[chunk->order_index[i]] = 1;
+      }
+    }
+
+    if(!data.indices.empty())
+      SIMD::ComposeTRS(chunk->position, chunk->angle, chunk->scale, chunk->local, &data.indices[0], data.indices.size());
+  }
 
-  // Posicin
-  glTranslatef(position.x, position.y, position.z);
-  // Orientacin
-  glMultMatrixf((const float*)glm::value_ptr(glm::toMat4(angle)));
-  // Escala
-  glScalef(scale.x, scale.y, scale.z); // ?
+  // Matrices de mundo: los padres van antes que los hijos. Los productos se acumulan en un lote, que se calcula
+  // antes de que un hijo necesite la matriz de un padre que aún está en él
+  data.normal_input.clear();
+  data.normal_output.clear();
+  int batch_begin = -1;
 
-  GLdouble matrix[16];
-  glGetDoublev(GL_MODELVIEW_MATRIX, matrix);
+  for(uint k = 0; k < size; k++)
+  {
+    CComponent_Transform* t = data.order_owner[k];
+    int p = data.order_parent[k];
+    CComponent_Transform* parent = (p >= 0) ? data.order_owner[p] : NULL;
+
+    if(!data.changed[k] and parent == t->last_parent and (!parent or parent->world_version == t->parent_version))
+    {
+      // WorldMatrix() puede haberla actualizado fuera de esta pasada, sin calcular la normal
+      if(t->normal_version != t->world_version)
+      {
+        data.normal_input.push_back(&t->world_matrix);
+        data.normal_output.push_back(&t->normal_matrix);
+        t->normal_version = t->world_version;
+      }
+
+      continue;
+    }
+
+    data.changed[k] = 1;
+
+    if(parent)
+    {
+      if(batch_begin >= 0 and p >= batch_begin and data.changed[p])
+      {
+        data.FlushBatch();
+        batch_begin = -1;
+      }
+
+      if(batch_begin < 0)
+        batch_begin = k;
+
+      data.batch_left.push_back(&parent->world_matrix);
+      data.batch_right.push_back(&t->local_matrix);
+      data.batch_output.push_back(&t->world_matrix);
+      t->parent_version = parent->world_version;
+    }
+    else
+      t->world_matrix = t->local_matrix;
+
+    t->last_parent = parent;
+    t->world_version++;
+    data.Moved(t->data_index);
+
+    data.normal_input.push_back(&t->world_matrix);
+    data.normal_output.push_back(&t->normal_matrix);
+    t->normal_version = t->world_version;
+  }
+
+  data.FlushBatch();
+
+  if(!data.normal_output.empty())
+    SIMD::NormalMatrices(&data.normal_input[0], &data.normal_output[0], data.normal_output.size());
+}
+
+glm::mat4 CComponent_Transform::ApplyTransform(const glm::mat4& modelviewMatrix)
+{
+  return modelviewMatrix * WorldMatrix();
+}
+
+vector3f_t CComponent_Transform::Position()
+{
+  if(!gameObject or !gameObject->GetParent())
+    return position;
 
-  glPopMatrix();
-  return vector3f(matrix[12], matrix[13], matrix[14]);*/
-  //glm::mat4 matrix = ApplyParentTransform(gameObject->GetParent());
-  glm::mat4 matrix = ApplyTransform(glm::mat4(1.0));
+  const glm::mat4& matrix = WorldMatrix();
   return vector3f(matrix[3][0], matrix[3][1], matrix[3][2]);
 }
 
@@ -429,7 +728,7 @@ void CComponent_Transform::LookAt(GLfloat x, GLfloat y, GLfloat z, vector3f up_v
   LookAt(vector3f(x, y, z), up_vector, forward_vector);
 }
 
-// ->NOTA La funcin CComponent_Transform::LookAt() no funciona como debera, ya que se carga completamente la orientacin del vector. Esto es, jode ejes de la cmara.
+// ->NOTA La función CComponent_Transform::LookAt() no funciona como debería, ya que se carga completamente la orientación del vector. Esto es, jode ejes de la cámara.
 void CComponent_Transform::LookAt(vector3f target, vector3f up, vector3f forward)
 {
   //http://stackoverflow.com/questions/12435671/quaternion-lookat-function
@@ -594,7 +893,7 @@ vector3f CComponent_Transform::Rotation()
 //    roll *= -1;
 //  gMath.NormalizeAngle(roll);
 
-  // ??
+  // ¿?¿?
 
   return gSystem_Math.quat_to_angles(langle);
 }
@@ -607,7 +906,7 @@ vector3f CComponent_Transform::LRotation()
 {
   CGameObject* parent = gameObject->GetParent();
 
-  // de abajo a arriba o de arriba a abajo?
+  // ¿de abajo a arriba o de arriba a abajo?
   while(parent != NULL)
   {
     glTranslatef(parent->transform()->position.x, parent->transform()->position.y, parent->transform()->
@@ -28,7 +28,7 @@ bool CEngine::Init(int argc, char* argv[])
     return false;
   }
 
-  /** Mas mdulos y libreras de SDL aqu **/
+  /** Mas módulos y librerías de SDL aquí **/
 
   if(!Systems_Init())
   {
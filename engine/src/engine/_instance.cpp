@@ -27,6 +27,9 @@ bool CInstance::Init()
 
   gameObjects_loader();
 
+  // Juntar los modelos de los objetos estáticos que ha creado la estancia
+  gSystem_Static_Batching.Bake();
+
   FPS = frames = 0;
   current_time = previous_time = 0;
 
@@ -46,11 +49,14 @@ bool CInstance::LoadResources()
 
 void CInstance::Close()
 {
+  // La siguiente estancia carga sus recursos desde este hilo
+  gSystem_Render.StopPipeline();
+
   UnLoadResources();
 
   i_running = false;
 
-  // Aqu habra que borrar objetos y tal
+  // Aquí habría que borrar objetos y tal
 
 }
 void CInstance::UnLoadResources()
@@ -82,11 +88,8 @@ string CInstance::OnExecute()
 
 void CInstance::OnLoop()
 {
-  gSystem_UserInput.OnLoop();
-  gSystem_Time.OnLoop();
-  gSystem_Mixer.OnLoop();
-  gSystem_GameObject_Manager.OnLoop();
-  gSystem_Render.OnLoop();
+  // Input, Time, Mixer, GameObject_Manager, Render... según sus dependencias (véase CSystem_Scheduler)
+  gSystem_Scheduler.OnLoop();
 }
 
 void CInstance::OnEvent()
@@ -114,7 +117,11 @@ void CInstance::OnRender()
 {
   gSystem_Render.OnRender();
 
-  // Esto debera ir en gSystem_Render
+  // El hilo de render dibuja y presenta la iteración por su cuenta (véase "__RENDER_PIPELINED")
+  if(gSystem_Render.Pipelined())
+    return;
+
+  // Esto debería ir en gSystem_Render
   if(gSystem_Debug.IsConsole()) gSystem_Debug.OnRender();
   gSystem_Render.RenderToScreen();
 }
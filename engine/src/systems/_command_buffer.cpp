@@ -0,0 +1,123 @@
+#include "systems/_command_buffer.h"
+#include "systems/_manager.h"
+
+using namespace std;
+
+CCommand_Buffer::~CCommand_Buffer()
+{
+  Clear();
+}
+
+bool CCommand_Buffer::Target(CGameObject* go, target_t& target)
+{
+  target.handle = gameObject_handle_t();
+  target.spawn = -1;
+
+  if(!go)
+    return true;
+
+  map<CGameObject*, int>::iterator it = spawned.find(go);
+  if(it != spawned.end())
+  {
+    target.spawn = it->second;
+    return true;
+  }
+
+  // Mientras se recorren los objetos no cambia la tabla de slots, así que se puede consultar desde cualquier hilo
+  if(gSystem_GameObject_Manager.IsValid(go->GetHandle()))
+  {
+    target.handle = go->GetHandle();
+    return true;
+  }
+
+  num_ignored++;
+  return false;
+}
+
+CGameObject* CCommand_Buffer::Resolve(const target_t& target)
+{
+  if(target.spawn >= 0)
+  {
+    // Los creados que se han descartado (nombre repetido) no están en el gestor
+    CGameObject* go = commands[target.spawn].go;
+    return (go and gSystem_GameObject_Manager.IsValid(go->GetHandle())) ? go : NULL;
+  }
+
+  return gSystem_GameObject_Manager.Get(target.handle);
+}
+
+void CCommand_Buffer::Push(command_type_t type, CGameObject* go, CGameObject* other, int component, component_creator_t creator, bool flag)
+{
+  command_t command;
+  command.type = type;
+  command.go = NULL;
+  command.component = component;
+  command.creator = creator;
+  command.flag = flag;
+
+  if(type == spawn)
+  {
+    command.go = go;
+    Target(NULL, command.target);
+    Target(NULL, command.other);
+    spawned[go] = commands.size();
+  }
+  else if(!Target(go, command.target) or !Target(other, command.other))
+    return;
+
+  commands.push_back(command);
+}
+
+CGameObject* CCommand_Buffer::Spawn(const string& name, bool init)
+{
+  CGameObject* go = new CGameObject(name);
+  if(init) go->Init();
+
+  Push(spawn, go, NULL, -1, NULL, init);
+  num_spawns++;
+
+  return go;
+}
+
+vector<CGameObject*> CCommand_Buffer::SpawnBatch(const string& prefix, uint count, bool init)
+{
+  vector<CGameObject*> output;
+  output.reserve(count);
+
+  CGameObject::Pool().Reserve(count);
+  commands.reserve(commands.size() + count);
+
+  for(uint i = 0; i < count; i++)
+  {
+    ostringstream oss;
+    oss << prefix << i;
+
+    output.push_back(Spawn(oss.str(), init));
+  }
+
+  return output;
+}
+
+void CCommand_Buffer::Destroy(CGameObject* go, bool delete_children)
+{
+  if(go)
+    Push(destroy, go, NULL, -1, NULL, delete_children);
+}
+
+void CCommand_Buffer::Reparent(CGameObject* go, CGameObject* parent)
+{
+  if(go)
+    Push(reparent, go, parent);
+}
+
+void CCommand_Buffer::Clear()
+{
+  // Los objetos creados que no se llegaron a añadir al gestor son del buffer
+  for(vector<command_t>::iterator it = commands.begin(); it != commands.end(); ++it)
+    if(it->type == spawn)
+      delete it->go;
+
+  commands.clear();
+  spawned.clear();
+  num_spawns = num_ignored = 0;
+}
@@ -0,0 +1,182 @@
+#include "systems/_culling.h"
+
+using namespace std;
+
+namespace Culling
+{
+  aabb_t aabb_t::Transform(const glm::mat4& m) const
+  {
+    if(Empty())
+      return aabb_t();
+
+    // Arvo: cada eje de la caja resultante es la traslación más la suma de las contribuciones mínimas y máximas de cada columna
+    glm::vec3 out_min(m[3]);
+    glm::vec3 out_max(m[3]);
+
+    for(int c = 0; c < 3; c++)
+    {
+      for(int r = 0; r < 3; r++)
+      {
+        float a = m[c][r] * min[c];
+        float b = m[c][r] * max[c];
+
+        if(a < b)
+        {
+          out_min[r] += a;
+          out_max[r] += b;
+        }
+        else
+        {
+          out_min[r] += b;
+          out_max[r] += a;
+        }
+      }
+    }
+
+    return aabb_t(out_min, out_max);
+  }
+
+  bool aabb_t::Raycast(const glm::vec3& origin, const glm::vec3& inv_direction, float max_distance, float& distance) const
+  {
+    if(Empty())
+      return false;
+
+    // Método de las franjas ("slabs"): intervalo del rayo dentro de cada par de planos
+    float t_min = 0.f;
+    float t_max = max_distance;
+
+    for(int i = 0; i < 3; i++)
+    {
+      float t1 = (min[i] - origin[i]) * inv_direction[i];
+      float t2 = (max[i] - origin[i]) * inv_direction[i];
+
+      // Rayo paralelo y dentro de la franja: 0 * inf da NaN, que no debe descartar la caja
+      if(t1 != t1 or t2 != t2)
+        continue;
+
+      t_min = std::max(t_min, std::min(t1, t2));
+      t_max = std::min(t_max, std::max(t1, t2));
+
+      if(t_min > t_max)
+        return false;
+    }
+
+    distance = t_min;
+    return true;
+  }
+
+  sphere_t sphere_t::Transform(const glm::mat4& m) const
+  {
+    if(Empty())
+      return sphere_t();
+
+    float sx = glm::length2(glm::vec3(m[0]));
+    float sy = glm::length2(glm::vec3(m[1]));
+    float sz = glm::length2(glm::vec3(m[2]));
+    float scale = sqrt(std::max(sx, std::max(sy, sz)));
+
+    return sphere_t(glm::vec3(m * glm::vec4(center, 1.f)), radius * scale);
+  }
+
+  bounds_t::bounds_t(const aabb_t& b): box(b)
+  {
+    if(!b.Empty())
+      sphere = sphere_t(b.Center(), glm::length(b.Extents()));
+  }
+
+  bounds_t bounds_t::Transform(const glm::mat4& m) const
+  {
+    bounds_t output;
+    output.box = box.Transform(m);
+    output.sphere = sphere.Transform(m);
+
+    return output;
+  }
+
+  void frustum_t::Set(const glm::mat4& m)
+  {
+    // Gribb-Hartmann: cada plano es la cuarta fila de la matriz más o menos una de las otras tres
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    planes[0] = row3 + row0;
+    planes[1] = row3 - row0;
+    planes[2] = row3 + row1;
+    planes[3] = row3 - row1;
+    planes[4] = row3 + row2;
+    planes[5] = row3 - row2;
+
+    for(int i = 0; i < 6; i++)
+    {
+      float length = glm::length(glm::vec3(planes[i]));
+      if(length > 0.f)
+        planes[i] /= length;
+    }
+  }
+
+  bool frustum_t::Intersects(const sphere_t& s) const
+  {
+    if(s.Empty())
+      return false;
+
+    for(int i = 0; i < 6; i++)
+      if(glm::dot(glm::vec3(planes[i]), s.center) + planes[i].w < -s.radius)
+        return false;
+
+    return true;
+  }
+
+  bool frustum_t::Intersects(const aabb_t& b) const
+  {
+    if(b.Empty())
+      return false;
+
+    glm::vec3 center = b.Center();
+    glm::vec3 extents = b.Extents();
+
+    for(int i = 0; i < 6; i++)
+    {
+      glm::vec3 normal(planes[i]);
+      float r = extents.x * std::abs(normal.x) + extents.y * std::abs(normal.y) + extents.z * std::abs(normal.z);
+
+      if(glm::dot(normal, center) + planes[i].w < -r)
+        return false;
+    }
+
+    return true;
+  }
+
+  frustum_t::classify_t frustum_t::Classify(const aabb_t& b) const
+  {
+    if(b.Empty())
+      return outside;
+
+    glm::vec3 center = b.Center();
+    glm::vec3 extents = b.Extents();
+    classify_t output = inside;
+
+    for(int i = 0; i < 6; i++)
+    {
+      glm::vec3 normal(planes[i]);
+      float r = extents.x * std::abs(normal.x) + extents.y * std::abs(normal.y) + extents.z * std::abs(normal.z);
+      float d = glm::dot(normal, center) + planes[i].w;
+
+      if(d < -r)
+        return outside;
+      if(d < r)
+        output = intersecting;
+    }
+
+    return output;
+  }
+
+  bool frustum_t::Intersects(const bounds_t& b) const
+  {
+    if(!b.sphere.Empty() and !Intersects(b.sphere))
+      return false;
+
+    return Intersects(b.box);
+  }
+}
@@ -195,12 +195,26 @@ void CSystem_Data_Storage::LoadConfig()
     SetFloat("__RENDER_TRANSFORM_GRID_ROWS_SCALE", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_TRANSFORM_GRID_ROWS_SCALE);
     SetFloat("__RENDER_TRANSFORM_GRID_COLS_SCALE", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_TRANSFORM_GRID_COLS_SCALE);
 
+    SetInt("__RENDER_FRUSTUM_CULLING", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_FRUSTUM_CULLING);
+    SetInt("__RENDER_QUEUE", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_QUEUE);
+    SetInt("__RENDER_INSTANCING", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_INSTANCING);
+    SetInt("__RENDER_STREAM_BUFFER_SIZE", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_STREAM_BUFFER_SIZE);
+    SetInt("__RENDER_PARALLEL_RECORDING", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_PARALLEL_RECORDING);
+    SetInt("__RENDER_PIPELINED", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_PIPELINED);
+    SetInt("__RENDER_LOD", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_LOD);
+    SetFloat("__RENDER_LOD_PIXEL_ERROR", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_LOD_PIXEL_ERROR);
+    SetInt("__RENDER_SHARED_MESH_BUFFERS", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_SHARED_MESH_BUFFERS);
+    SetInt("__RENDER_STATIC_BATCHING", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_STATIC_BATCHING);
+    SetFloat("__RENDER_STATIC_BATCHING_CELL_SIZE", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_STATIC_BATCHING_CELL_SIZE);
+
     SetFloat("__SOUND_VOLUME", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_SOUND_VOLUME);
     SetFloat("__SOUND_MUSIC_VOLUME", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_SOUND_MUSIC_VOLUME);
 
     SetInt("__SOUND_NUMBER_SOURCES", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_SOUND_NUMBER_SOURCES);
     SetInt("__SOUND_NUMBER_SOURCES_ONESHOT", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_SOUND_NUMBER_SOURCES_ONESHOT);
 
+    SetInt("__JOBS_NUMBER_THREADS", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_JOBS_NUMBER_THREADS);
+
     SetString("__INPUT_AXIS1_UP_KEY", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_INPUT_AXIS1_UP_KEY);
     SetString("__INPUT_AXIS1_DOWN_KEY", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_INPUT_AXIS1_DOWN_KEY);
     SetString("__INPUT_AXIS1_LEFT_KEY", __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_INPUT_AXIS1_LEFT_KEY);
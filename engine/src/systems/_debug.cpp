@@ -6,7 +6,13 @@
 #include "systems/_other.h"
 #include "systems/_mixer.h"
 #include "systems/_shader.h"
+#include "systems/_gl_state.h"
+#include "systems/_stream_buffer.h"
 #include "systems/_input.h"
+#include "systems/_scheduler.h"
+#include "systems/_simd.h"
+#include "systems/_memory.h"
+#include "systems/_spatial.h"
 
 #include "engine/_engine.h"
 
@@ -112,7 +118,7 @@ bool CSystem_Debug::InitConsoleFont()
   }
 
   base = glGenLists(256);
-  glBindTexture(GL_TEXTURE_2D, gSystem_Resources.GetTexture(__CSYSTEM_DEBUG_CONSOLE_FONT)->GetID());
+  gSystem_GL_State.BindTexture(GL_TEXTURE_2D, gSystem_Resources.GetTexture(__CSYSTEM_DEBUG_CONSOLE_FONT)->GetID());
 
   for (int loop1=0; loop1<256; loop1++)                        // Loop Through All 256 Lists
   {
@@ -130,7 +136,7 @@ bool CSystem_Debug::InitConsoleFont()
     glEndList();
   }
 
-  glBindTexture(GL_TEXTURE_2D, 0);
+  gSystem_GL_State.BindTexture(GL_TEXTURE_2D, 0);
 
   return true;
 
@@ -143,7 +149,7 @@ bool CSystem_Debug::InitConsoleFont()
 
   const GLfloat consoleFont_texCoords[][2]
   {
-    // problema, tal vez estn mal puestos
+    // problema, tal vez estén mal puestos
     {    0.f,  0.999f}, {0.0625f,  0.999f},
     {0.0625f, 0.9375f}, {   0.0f, 0.9375f}
   };
@@ -157,7 +163,7 @@ bool CSystem_Debug::InitConsoleFont()
 
   glGenBuffers( 1, &m_ConsoleFontVBOVertices );
   glGenBuffers( 1, &m_ConsoleFontVBOTexCoords );
-  glGenBuffers( 1, &m_ConsoleFontVBOTypeInfo ); // Este se actualiza automticamente cada vez que se llama a print().
+  glGenBuffers( 1, &m_ConsoleFontVBOTypeInfo ); // Este se actualiza automáticamente cada vez que se llama a print().
 
   if(!m_ConsoleFontVBOVertices or !m_ConsoleFontVBOTexCoords or !m_ConsoleFontVBOTypeInfo)
   {
@@ -214,6 +220,10 @@ bool CSystem_Debug::InitCommandMap()
     // Systems
   console_commands.insert(pair<string, command_p>("system_time_setscale", &CSystem_Debug::Console_command__SYSTEM_TIME_SETSCALE));
   console_commands.insert(pair<string, command_p>("system_userinput_show_joysticks", &CSystem_Debug::Console_command__SYSTEM_USERINPUT_SHOW_JOYSTICKS));
+  console_commands.insert(pair<string, command_p>("system_scheduler_show", &CSystem_Debug::Console_command__SYSTEM_SCHEDULER_SHOW));
+  console_commands.insert(pair<string, command_p>("system_transform_benchmark", &CSystem_Debug::Console_command__SYSTEM_TRANSFORM_BENCHMARK));
+  console_commands.insert(pair<string, command_p>("system_memory_show", &CSystem_Debug::Console_command__SYSTEM_MEMORY_SHOW));
+  console_commands.insert(pair<string, command_p>("system_spatial_show", &CSystem_Debug::Console_command__SYSTEM_SPATIAL_SHOW));
 
     // Game objects
   console_commands.insert(pair<string, command_p>("go_show_tree", &CSystem_Debug::Console_command__GO_SHOW_TREE));
@@ -233,6 +243,15 @@ bool CSystem_Debug::InitCommandMap()
   console_commands.insert(pair<string, command_p>("r_resize_window", &CSystem_Debug::Console_command__R_RESIZE_WINDOW));
   console_commands.insert(pair<string, command_p>("r_draw_transform", &CSystem_Debug::Console_command__R_DRAW_TRANSFORM));
   console_commands.insert(pair<string, command_p>("r_draw_grid", &CSystem_Debug::Console_command__R_DRAW_GRID));
+  console_commands.insert(pair<string, command_p>("r_culling", &CSystem_Debug::Console_command__R_CULLING));
+  console_commands.insert(pair<string, command_p>("r_queue", &CSystem_Debug::Console_command__R_QUEUE));
+  console_commands.insert(pair<string, command_p>("r_instancing", &CSystem_Debug::Console_command__R_INSTANCING));
+  console_commands.insert(pair<string, command_p>("r_glstate", &CSystem_Debug::Console_command__R_GLSTATE));
+  console_commands.insert(pair<string, command_p>("r_stream", &CSystem_Debug::Console_command__R_STREAM));
+  console_commands.insert(pair<string, command_p>("r_parallel", &CSystem_Debug::Console_command__R_PARALLEL));
+  console_commands.insert(pair<string, command_p>("r_pipelined", &CSystem_Debug::Console_command__R_PIPELINED));
+  console_commands.insert(pair<string, command_p>("r_occlusion", &CSystem_Debug::Console_command__R_OCCLUSION));
+  console_commands.insert(pair<string, command_p>("r_lod", &CSystem_Debug::Console_command__R_LOD));
   console_commands.insert(pair<string, command_p>("r_fps", &CSystem_Debug::Console_command__R_FPS));
   console_commands.insert(pair<string, command_p>("r_draw_sound", &CSystem_Debug::Console_command__R_DRAW_SOUND));
   console_commands.insert(pair<string, command_p>("r_glinfo", &CSystem_Debug::Console_command__R_GLINFO));
@@ -513,8 +532,8 @@ void CSystem_Debug::OnRender()
 
   glPushAttrib(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-  glBlendFunc(GL_SRC_ALPHA,GL_ONE);
-  glEnable(GL_BLEND);
+  gSystem_GL_State.BlendFunc(GL_SRC_ALPHA,GL_ONE);
+  gSystem_GL_State.Enable(GL_BLEND);
 
   glColor3f(1.f, 1.f, 1.f);
 
@@ -560,7 +579,7 @@ void CSystem_Debug::print(GLint x, GLint y, int set, const char* fmt, ...)
   glLoadIdentity();
 
   glTranslated(x, y, 0);
-  glBindTexture(GL_TEXTURE_2D, gSystem_Resources.GetTexture(__CSYSTEM_DEBUG_CONSOLE_FONT)->GetID());
+  gSystem_GL_State.BindTexture(GL_TEXTURE_2D, gSystem_Resources.GetTexture(__CSYSTEM_DEBUG_CONSOLE_FONT)->GetID());
   glListBase(base-32 + (128)*set);
 
   /*const char* SHADER_UNIF_PROJMAT              = "ProjMatrix";
@@ -740,6 +759,10 @@ void CSystem_Debug::Console_command__HELP(string arguments)
     console_msg("-----------------------------------------------------------------------");
     console_msg("system_time_setscale:                Set current time scale.");
     console_msg("system_userinput_show_joysticks:     Show current joysticks connected to the system.");
+    console_msg("system_scheduler_show:               Show update systems and their dependencies.");
+    console_msg("system_transform_benchmark:          Compare SIMD transform kernels with glm.");
+    console_msg("system_memory_show:                  Show instance arena usage.");
+    console_msg("system_spatial_show:                 Show spatial index stats.");
 
 
   }
@@ -771,6 +794,15 @@ void CSystem_Debug::Console_command__HELP(string arguments)
 
     console_msg("r_draw_transform:               Draws transform component for each game object (X, Y, Z Local axis).");
     console_msg("r_draw_grid:                    Draws a world grid.");
+    console_msg("r_culling:                      Skips objects outside each camera frustum.");
+    console_msg("r_queue:                        Sorts draw calls by OpenGL state. Without arguments, shows last frame stats.");
+    console_msg("r_instancing:                   Draws repeated meshes with a single instanced draw call.");
+    console_msg("r_glstate:                      Shows OpenGL state changes made and skipped in the last frame.");
+    console_msg("r_stream:                       Shows dynamic vertex data written to the stream buffer in the last frame.");
+    console_msg("r_parallel <0 | 1>:             Records each camera's draw commands on worker threads.");
+    console_msg("r_pipelined <0 | 1>:            Draws each frame on a render thread while the next one is simulated.");
+    console_msg("r_occlusion:                    Shows last frame occlusion culling stats for each camera that uses it.");
+    console_msg("r_lod [0 | 1]:                  Draws distant meshes with simplified levels of detail. Without arguments, shows last frame stats.");
     console_msg("r_draw_sound:                   Draw sound radius (max and min) for each audio source.");
     console_msg("r_fps:                          Gets current frames per second.");
     console_msg("r_update_window:                Updates window's modified properties and applys them to the window.");
@@ -810,7 +842,7 @@ void CSystem_Debug::Console_command__LOG(string arguments)
 
 void CSystem_Debug::Console_command__SET_INT(string arguments)
 {
-  // Restricciones de variables del sistema? hmmm
+  // ¿Restricciones de variables del sistema? hmmm
   if(arguments == "?")
   {
     console_warning_msg("Format is: set_int <identifier> [value]");
@@ -1096,7 +1128,7 @@ void CSystem_Debug::Console_command__CLEAR(string arguments)
     return;
   }
 
-  // No se limpia el buffer de comandos (por comodidad, bsicamente); solo el de resultados.
+  // No se limpia el buffer de comandos (por comodidad, básicamente); solo el de resultados.
   console_buffer.clear();
   current_line_buffered = 0;
 }
@@ -1269,6 +1301,64 @@ void CSystem_Debug::Console_command__SYSTEM_USERINPUT_SHOW_JOYSTICKS(string argu
 
 }
 
+void CSystem_Debug::Console_command__SYSTEM_SCHEDULER_SHOW(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: system_scheduler_show");
+    return;
+  }
+
+  gSystem_Scheduler.PrintGraph();
+}
+
+void CSystem_Debug::Console_command__SYSTEM_TRANSFORM_BENCHMARK(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: system_transform_benchmark [count]");
+    return;
+  }
+
+  stringstream ss(arguments);
+  string val;
+  ss >> val;
+
+  int count = 10000;
+  if(val != "")
+    count = atoi(val.c_str());
+
+  if(count <= 0)
+  {
+    console_warning_msg("Format is: system_transform_benchmark [count]");
+    return;
+  }
+
+  SIMD::Benchmark(count);
+}
+
+void CSystem_Debug::Console_command__SYSTEM_MEMORY_SHOW(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: system_memory_show");
+    return;
+  }
+
+  gSystem_Memory.PrintStats();
+}
+
+void CSystem_Debug::Console_command__SYSTEM_SPATIAL_SHOW(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: system_spatial_show");
+    return;
+  }
+
+  gSystem_Spatial.PrintStats();
+}
+
 // Game Objects
 void CSystem_Debug::Console_command__AUX__GO_SHOW_TREE_print_element(CGameObject* go, map<string, void*>& list, int level)
 {
@@ -1278,7 +1368,7 @@ void CSystem_Debug::Console_command__AUX__GO_SHOW_TREE_print_element(CGameObject
   string c = "";
   c.resize(level*2, ' ');
 
-  // Se mostrarn hijos que no pertenezcan al manager de padres que s pertenezca, recursivamente.
+  // Se mostrarán hijos que no pertenezcan al manager de padres que sí pertenezca, recursivamente.
 
   if(go->GetName()[0] != '_' && go->GetName()[1] != '_')
   {
@@ -1297,8 +1387,8 @@ void CSystem_Debug::Console_command__AUX__GO_SHOW_TREE_print_element(CGameObject
   /*uint num_child = go->GetNumChildren();
   for(uint i = 0; i < num_child && num_child != 0; i++)
     print_element(go->GetChild(i), list, level+1);*/
-  for(map<string, CGameObject*>::iterator it = go->children.begin(); it != go->children.end(); ++it)
-    Console_command__AUX__GO_SHOW_TREE_print_element(it->second, list, level+1);
+  for(vector<CGameObject*>::iterator it = go->children.begin(); it != go->children.end(); ++it)
+    Console_command__AUX__GO_SHOW_TREE_print_element((*it), list, level+1);
 }
 
 void CSystem_Debug::Console_command__GO_SHOW_TREE(string arguments)
@@ -1320,7 +1410,7 @@ void CSystem_Debug::Console_command__GO_SHOW_TREE(string arguments)
     gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "Hierarchy of current game objects");
     gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "---------------------------------");
 
-    for(map<string, CGameObject*>::iterator it = gSystem_GameObject_Manager.gameObjects.begin(); it != gSystem_GameObject_Manager.gameObjects.end(); ++it)
+    for(map<string, CGameObject*>::iterator it = gSystem_GameObject_Manager.gameObjects_names.begin(); it != gSystem_GameObject_Manager.gameObjects_names.end(); ++it)
       if(game_objects.find(it->first) == game_objects.end() && it->second->GetParent() == NULL)
         Console_command__AUX__GO_SHOW_TREE_print_element(it->second, game_objects);
   }
@@ -1571,9 +1661,12 @@ void CSystem_Debug::Console_command__GO_COMPONENT_GET(string arguments)
 
   if(component == "")
   {
-    for(map<int, CComponent*>::iterator it = go->components.begin(); it != go->components.end(); ++it)
+    for(int i = 0; i < Components::__component_not_defined; i++)
     {
-      it->second->printDebug();
+      if(!go->components[i])
+        continue;
+
+      go->components[i]->printDebug();
       console_warning_msg("");
     }
 
@@ -1809,6 +1902,204 @@ void CSystem_Debug::Console_command__R_DRAW_GRID(string arguments)
   }
 }
 
+void CSystem_Debug::Console_command__R_CULLING(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: r_culling <0 | 1>");
+    return;
+  }
+
+  stringstream ss(arguments);
+  int val = -1;
+  ss >> val;
+
+  if(val < 0 or val > 1)
+    console_warning_msg("Format is: r_culling <0 | 1>");
+  else
+  {
+    gSystem_Data_Storage.SetInt("__RENDER_FRUSTUM_CULLING", val);
+    if(val) console_msg("Frustum culling enabled.");
+    else    console_msg("Frustum culling disabled.");
+  }
+}
+
+void CSystem_Debug::Console_command__R_QUEUE(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: r_queue [0 | 1]");
+    return;
+  }
+
+  if(arguments == "")
+  {
+    const CRender_Queue::stats_t& stats = gSystem_Render.render_queue.Stats();
+    console_msg("Render queue %s. Last camera: %u items, %u mesh draws (%u instanced, %u multi-draw), %u program changes, %u texture changes, %u mesh changes.",
+        gSystem_Data_Storage.GetInt("__RENDER_QUEUE") ? "enabled" : "disabled", stats.items, stats.draws, stats.instanced, stats.multidraws, stats.programs, stats.textures, stats.meshes);
+    return;
+  }
+
+  stringstream ss(arguments);
+  int val = -1;
+  ss >> val;
+
+  if(val < 0 or val > 1)
+    console_warning_msg("Format is: r_queue [0 | 1]");
+  else
+  {
+    gSystem_Data_Storage.SetInt("__RENDER_QUEUE", val);
+    if(val) console_msg("Render queue enabled.");
+    else    console_msg("Render queue disabled.");
+  }
+}
+
+void CSystem_Debug::Console_command__R_INSTANCING(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: r_instancing <0 | 1>");
+    return;
+  }
+
+  stringstream ss(arguments);
+  int val = -1;
+  ss >> val;
+
+  if(val < 0 or val > 1)
+    console_warning_msg("Format is: r_instancing <0 | 1>");
+  else
+  {
+    gSystem_Data_Storage.SetInt("__RENDER_INSTANCING", val);
+    if(val) console_msg("Instancing enabled.");
+    else    console_msg("Instancing disabled.");
+  }
+}
+
+void CSystem_Debug::Console_command__R_GLSTATE(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: r_glstate");
+    return;
+  }
+
+  gSystem_GL_State.PrintStats();
+}
+
+void CSystem_Debug::Console_command__R_STREAM(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: r_stream");
+    return;
+  }
+
+  const CSystem_Stream_Buffer::stats_t& stats = gSystem_Stream_Buffer.Stats();
+  console_msg("Stream buffer (%s): %u writes, %u bytes, %u wraps, %u waits.", gSystem_Stream_Buffer.Persistent() ? "persistent" : "orphaning",
+      stats.writes, stats.bytes, stats.wraps, stats.waits);
+}
+
+void CSystem_Debug::Console_command__R_PARALLEL(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: r_parallel <0 | 1>");
+    return;
+  }
+
+  stringstream ss(arguments);
+  int val = -1;
+  ss >> val;
+
+  if(val < 0 or val > 1)
+    console_warning_msg("Format is: r_parallel <0 | 1>");
+  else
+  {
+    gSystem_Data_Storage.SetInt("__RENDER_PARALLEL_RECORDING", val);
+    if(val) console_msg("Parallel recording enabled.");
+    else    console_msg("Parallel recording disabled.");
+  }
+}
+
+void CSystem_Debug::Console_command__R_PIPELINED(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: r_pipelined <0 | 1>");
+    return;
+  }
+
+  stringstream ss(arguments);
+  int val = -1;
+  ss >> val;
+
+  if(val < 0 or val > 1)
+    console_warning_msg("Format is: r_pipelined <0 | 1>");
+  else
+  {
+    gSystem_Data_Storage.SetInt("__RENDER_PIPELINED", val);
+    if(val) console_msg("Pipelined rendering enabled. It starts when the console is closed.");
+    else    console_msg("Pipelined rendering disabled.");
+  }
+}
+
+void CSystem_Debug::Console_command__R_OCCLUSION(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: r_occlusion");
+    return;
+  }
+
+  bool found = false;
+  for(uint i = 0; i < gSystem_Render.camera_list.size(); i++)
+  {
+    CComponent_Camera* cam = gSystem_Render.camera_list[i]->GetComponent<CComponent_Camera>();
+    if(!cam->occlusion_culling or i >= gSystem_Render.occlusion_culling.size())
+      continue;
+
+    const COcclusion_Culling::stats_t& stats = gSystem_Render.occlusion_culling[i]->Stats();
+    console_msg("Camera %s: %u meshes tested, %u occluded, %u queries, %u near plane, %u tracked.", gSystem_Render.camera_list[i]->GetName().c_str(),
+        stats.tested, stats.occluded, stats.queries, stats.near_plane, gSystem_Render.occlusion_culling[i]->Size());
+    found = true;
+  }
+
+  if(!found)
+    console_msg("No camera uses occlusion culling. Enable it with \"go_component_set <camera> camera occlusion_culling 1\" (it needs r_queue).");
+}
+
+void CSystem_Debug::Console_command__R_LOD(string arguments)
+{
+  if(arguments == "?")
+  {
+    console_warning_msg("Format is: r_lod [0 | 1]");
+    return;
+  }
+
+  if(arguments == "")
+  {
+    const CRender_Queue::stats_t& stats = gSystem_Render.render_queue.Stats();
+    console_msg("Levels of detail %s (max error %f pixels). Last camera: %u mesh triangles drawn, %u meshes simplified.",
+        gSystem_Data_Storage.GetInt("__RENDER_LOD") ? "enabled" : "disabled", gSystem_Data_Storage.GetFloat("__RENDER_LOD_PIXEL_ERROR"),
+        stats.triangles, stats.reduced);
+    return;
+  }
+
+  stringstream ss(arguments);
+  int val = -1;
+  ss >> val;
+
+  if(val < 0 or val > 1)
+    console_warning_msg("Format is: r_lod [0 | 1]");
+  else
+  {
+    gSystem_Data_Storage.SetInt("__RENDER_LOD", val);
+    if(val) console_msg("Levels of detail enabled.");
+    else    console_msg("Levels of detail disabled.");
+  }
+}
+
 void CSystem_Debug::Console_command__R_FPS(string arguments)
 {
   if(arguments == "?")
@@ -0,0 +1,212 @@
+#include "systems/_gl_state.h"
+#include "systems/_debug.h"
+
+#include <cstring>
+
+using namespace std;
+
+CSystem_GL_State gSystem_GL_State;
+CSystem_GL_State& gGLState = gSystem_GL_State;
+
+static const char* changes_s[] = {"capability", "blend_func", "depth_mask", "active_texture", "texture", "program", "vertex_array", "not_defined"};
+
+// Capacidades que se guardan. Las demás se cambian siempre
+static const GLenum capabilities_e[] = {GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_SCISSOR_TEST, GL_TEXTURE_2D, GL_MULTISAMPLE, GL_POLYGON_OFFSET_FILL, GL_STENCIL_TEST};
+
+const char* GL_State::change_to_string(change_t c)
+{
+  if(c < capability or c >= __change_not_defined)
+    c = __change_not_defined;
+
+  return changes_s[c];
+}
+
+bool CSystem_GL_State::Init()
+{
+  if(enabled) return true;
+
+  // El estado inicial lo fija CSystem_Render::Init() antes de crear la caché, así que no se conoce
+  Invalidate();
+  ClearStats();
+
+  CSystem::Init();
+
+  return true;
+}
+
+void CSystem_GL_State::Close()
+{
+  if(!enabled) return;
+
+  Invalidate();
+
+  CSystem::Close();
+}
+
+bool CSystem_GL_State::Reset()
+{
+  Invalidate();
+
+  return true;
+}
+
+void CSystem_GL_State::OnFrame()
+{
+  last_stats = stats;
+  memset(&stats, 0, sizeof(stats));
+}
+
+void CSystem_GL_State::ClearStats()
+{
+  memset(&stats, 0, sizeof(stats));
+  memset(&last_stats, 0, sizeof(last_stats));
+}
+
+void CSystem_GL_State::Invalidate()
+{
+  for(uint i = 0; i < sizeof(capabilities)/sizeof(capabilities[0]); i++)
+    capabilities[i] = -1;
+
+  blend_src = blend_dst = -1;
+  depth = -1;
+  active_unit = -1;
+
+  for(uint i = 0; i < __GL_STATE_TEXTURE_UNITS; i++)
+    textures[i] = -1;
+
+  current_program = -1;
+  current_vertex_array = -1;
+}
+
+int CSystem_GL_State::CapabilityIndex(GLenum cap)
+{
+  for(uint i = 0; i < sizeof(capabilities_e)/sizeof(capabilities_e[0]); i++)
+    if(capabilities_e[i] == cap)
+      return i;
+
+  return -1;
+}
+
+bool CSystem_GL_State::SetCapability(GLenum cap, bool state)
+{
+  int index = CapabilityIndex(cap);
+
+  if(index >= 0)
+  {
+    if(capabilities[index] == (int)state)
+      return Skipped(GL_State::capability);
+
+    capabilities[index] = state;
+  }
+
+  if(state) glEnable(cap);
+  else      glDisable(cap);
+
+  return Changed(GL_State::capability);
+}
+
+bool CSystem_GL_State::BlendFunc(GLenum src, GLenum dst)
+{
+  if(blend_src == (GLint)src and blend_dst == (GLint)dst)
+    return Skipped(GL_State::blend_func);
+
+  glBlendFunc(src, dst);
+  blend_src = src;
+  blend_dst = dst;
+
+  return Changed(GL_State::blend_func);
+}
+
+bool CSystem_GL_State::DepthMask(bool state)
+{
+  if(depth == (int)state)
+    return Skipped(GL_State::depth_mask);
+
+  glDepthMask(state ? GL_TRUE : GL_FALSE);
+  depth = state;
+
+  return Changed(GL_State::depth_mask);
+}
+
+bool CSystem_GL_State::ActiveTexture(GLenum unit)
+{
+  GLint index = unit - GL_TEXTURE0;
+  if(index == active_unit)
+    return Skipped(GL_State::active_texture);
+
+  glActiveTexture(unit);
+  active_unit = index;
+
+  return Changed(GL_State::active_texture);
+}
+
+bool CSystem_GL_State::BindTexture(GLenum target, GLuint texture)
+{
+  bool cached = (target == GL_TEXTURE_2D and active_unit >= 0 and active_unit < __GL_STATE_TEXTURE_UNITS);
+
+  if(cached and textures[active_unit] == (GLint)texture)
+    return Skipped(GL_State::texture);
+
+  glBindTexture(target, texture);
+  if(cached)
+    textures[active_unit] = texture;
+
+  return Changed(GL_State::texture);
+}
+
+bool CSystem_GL_State::UseProgram(GLuint program)
+{
+  if(current_program == (GLint)program)
+    return Skipped(GL_State::program);
+
+  glUseProgram(program);
+  current_program = program;
+
+  return Changed(GL_State::program);
+}
+
+bool CSystem_GL_State::BindVertexArray(GLuint vertex_array)
+{
+  if(current_vertex_array == (GLint)vertex_array)
+    return Skipped(GL_State::vertex_array);
+
+  glBindVertexArray(vertex_array);
+  current_vertex_array = vertex_array;
+
+  return Changed(GL_State::vertex_array);
+}
+
+void CSystem_GL_State::TextureDeleted(GLuint texture)
+{
+  for(uint i = 0; i < __GL_STATE_TEXTURE_UNITS; i++)
+    if(textures[i] == (GLint)texture)
+      textures[i] = 0;
+}
+
+void CSystem_GL_State::VertexArrayDeleted(GLuint vertex_array)
+{
+  if(current_vertex_array == (GLint)vertex_array)
+    current_vertex_array = 0;
+}
+
+void CSystem_GL_State::ProgramDeleted(GLuint program)
+{
+  // Un programa activo no se borra hasta que deja de estarlo, así que no se sabe qué hay activo
+  if(current_program == (GLint)program)
+    current_program = -1;
+}
+
+void CSystem_GL_State::PrintStats()
+{
+  uint changes = 0, skipped = 0;
+
+  gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "OpenGL state (last frame)");
+  gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "-------------------------");
+  for(uint i = 0; i < GL_State::__change_not_defined; i++)
+  {
+    gSystem_Debug.console_msg(" %-16s %6u changes, %6u skipped", GL_State::change_to_string((GL_State::change_t)i), last_stats.changes[i], last_stats.skipped[i]);
+    changes += last_stats.changes[i];
+    skipped += last_stats.skipped[i];
+  }
+  gSystem_Debug.console_msg(" %-16s %6u changes, %6u skipped", "total", changes, skipped);
+}
@@ -40,7 +40,7 @@ void CSystem_UserInput::CKey::OnInput(const CSystem_UserInput& input = gSystem_U
 
 void CSystem_UserInput::CKeyAxis::OnInput(const CSystem_UserInput& input = gSystem_UserInput)
 {
-  // ---- Para los ejes, usamos mquinas de estado para alternar entre los estados unpressed, keydown, key_pressed y keyup.
+  // ---- Para los ejes, usamos máquinas de estado para alternar entre los estados unpressed, keydown, key_pressed y keyup.
   // - Up
   if((v_up.state == key_keyup or v_up.state == key_unpressed) and input.keyboard[v_up.key])
   {
@@ -278,7 +278,7 @@ bool CSystem_UserInput::RebuildJoysticks()
     joysticks.resize(njoy);
     for(vector<CJoystick>::iterator it = joysticks.begin(); it != joysticks.end(); ++it)
     {
-      int index = it - joysticks.begin(); // Truco sencillo para sacar el ndice de un iterador
+      int index = it - joysticks.begin(); // Truco sencillo para sacar el índice de un iterador
       if(!(*it).Init(index))
       {
         gSystem_Debug.console_error_msg("Error loading joystick %d", index);
@@ -499,13 +499,13 @@ void CSystem_UserInput::CJoystick::Close()
 
 }*/
 
-// ->NOTA Al parecer, la estructura de joysticks de SDL2 es un poco inestable, por lo que desconectar un mando en medio de la ejecucin puede hacer que la aplicacin crashee. Tal vez lo arreglen con el tiempo...
+// ->NOTA Al parecer, la estructura de joysticks de SDL2 es un poco inestable, por lo que desconectar un mando en medio de la ejecución puede hacer que la aplicación crashee. Tal vez lo arreglen con el tiempo...
 void CSystem_UserInput::CJoystick::OnInput()
 {
   // Evitar problemas, o algo
   //SDL_JoystickUpdate();
 
-  // Suponemos operaciones atmicas, por lo que solo comprobamos al principio.
+  // Suponemos operaciones atómicas, por lo que solo comprobamos al principio.
   if(SDL_JoystickGetAttached(joystick) == SDL_FALSE)
     return;
 
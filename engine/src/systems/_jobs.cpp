@@ -0,0 +1,260 @@
+#include "systems/_jobs.h"
+#include "systems/_data.h"
+#include "systems/_debug.h"
+
+using namespace std;
+
+CSystem_Jobs gSystem_Jobs;
+CSystem_Jobs& gJobs = gSystem_Jobs;
+
+bool CSystem_Jobs::Init()
+{
+  CSystem::Init();
+
+  int num_threads = __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_JOBS_NUMBER_THREADS;
+  if(gSystem_Data_Storage.ExistsInt("__JOBS_NUMBER_THREADS"))
+    num_threads = gSystem_Data_Storage.GetInt("__JOBS_NUMBER_THREADS");
+
+  if(num_threads <= 0)
+    num_threads = SDL_GetCPUCount();
+  if(num_threads <= 0)
+    num_threads = 1;
+
+  semaphore = SDL_CreateSemaphore(0);
+  tls_worker = SDL_TLSCreate();
+  SDL_AtomicSet(&quit, 0);
+
+  if(!semaphore or !tls_worker)
+  {
+    gSystem_Debug.error("From CSystem_Jobs: Could not create sync objects: %s", SDL_GetError());
+    return false;
+  }
+
+  for(int i = 0; i < num_threads; i++)
+  {
+    worker_t* worker = new worker_t;
+    worker->mutex = SDL_CreateMutex();
+    worker->thread = NULL;
+    worker->index = i;
+    workers.push_back(worker);
+  }
+
+  // El hilo principal es el trabajador 0
+  SDL_TLSSet(tls_worker, workers[0], NULL);
+
+  for(uint i = 1; i < workers.size(); i++)
+  {
+    workers[i]->thread = SDL_CreateThread(&CSystem_Jobs::WorkerThread, "go-engine worker", workers[i]);
+    if(!workers[i]->thread)
+    {
+      gSystem_Debug.error("From CSystem_Jobs: Could not create worker thread: %s", SDL_GetError());
+      Close();
+      return false;
+    }
+  }
+
+  gSystem_Debug.log("From CSystem_Jobs: Using %d threads", (int)workers.size());
+
+  return true;
+}
+
+void CSystem_Jobs::Close()
+{
+  SDL_AtomicSet(&quit, 1);
+
+  for(uint i = 1; i < workers.size(); i++)
+    SDL_SemPost(semaphore);
+
+  for(uint i = 1; i < workers.size(); i++)
+    if(workers[i]->thread)
+      SDL_WaitThread(workers[i]->thread, NULL);
+
+  // El hilo que cierra (el principal) apunta al trabajador 0: sin esto, CurrentWorker() devolvería memoria ya liberada
+  if(tls_worker)
+    SDL_TLSSet(tls_worker, NULL, NULL);
+
+  for(vector<worker_t*>::iterator it = workers.begin(); it != workers.end(); ++it)
+  {
+    SDL_DestroyMutex((*it)->mutex);
+    delete (*it);
+  }
+  workers.clear();
+
+  if(semaphore)
+    SDL_DestroySemaphore(semaphore);
+  semaphore = NULL;
+
+  CSystem::Close();
+}
+
+int CSystem_Jobs::WorkerThread(void* data)
+{
+  worker_t* worker = (worker_t*)data;
+  SDL_TLSSet(gSystem_Jobs.tls_worker, worker, NULL);
+
+  while(!SDL_AtomicGet(&gSystem_Jobs.quit))
+  {
+    if(!gSystem_Jobs.RunPending(worker))
+      SDL_SemWait(gSystem_Jobs.semaphore);
+  }
+
+  return 0;
+}
+
+CSystem_Jobs::worker_t* CSystem_Jobs::CurrentWorker()
+{
+  worker_t* worker = (worker_t*)SDL_TLSGet(tls_worker);
+
+  // Hilos que no pertenecen al sistema (o el sistema aún no iniciado)
+  if(!worker and workers.size())
+    worker = workers[0];
+
+  return worker;
+}
+
+uint CSystem_Jobs::CurrentThread()
+{
+  worker_t* worker = (worker_t*)SDL_TLSGet(tls_worker);
+  return worker ? worker->index : 0;
+}
+
+void CSystem_Jobs::Push(worker_t* worker, const job_t& job)
+{
+  SDL_LockMutex(worker->mutex);
+  worker->jobs.push_back(job);
+  SDL_UnlockMutex(worker->mutex);
+
+  SDL_SemPost(semaphore);
+}
+
+bool CSystem_Jobs::Pop(worker_t* worker, job_t& job)
+{
+  bool found = false;
+
+  SDL_LockMutex(worker->mutex);
+  if(!worker->jobs.empty())
+  {
+    job = worker->jobs.back();
+    worker->jobs.pop_back();
+    found = true;
+  }
+  SDL_UnlockMutex(worker->mutex);
+
+  return found;
+}
+
+bool CSystem_Jobs::Steal(worker_t* thief, job_t& job)
+{
+  // Se empieza por el siguiente hilo, para no robar siempre al mismo
+  for(uint i = 1; i < workers.size(); i++)
+  {
+    worker_t* victim = workers[(thief->index + i) % workers.size()];
+    bool found = false;
+
+    if(SDL_TryLockMutex(victim->mutex) != 0)
+      continue;
+
+    if(!victim->jobs.empty())
+    {
+      job = victim->jobs.front();
+      victim->jobs.pop_front();
+      found = true;
+    }
+    SDL_UnlockMutex(victim->mutex);
+
+    if(found)
+      return true;
+  }
+
+  return false;
+}
+
+bool CSystem_Jobs::RunPending(worker_t* worker)
+{
+  job_t job;
+  if(Pop(worker, job) or Steal(worker, job))
+  {
+    Execute(job);
+    return true;
+  }
+
+  return false;
+}
+
+void CSystem_Jobs::Execute(const job_t& job)
+{
+  job.function(job.data, job.begin, job.end);
+
+  if(job.counter)
+    SDL_AtomicAdd(job.counter, -1);
+}
+
+void CSystem_Jobs::Run(job_function_t function, void* data, uint begin, uint end, job_counter_t* counter)
+{
+  job_t job = {function, data, begin, end, counter};
+
+  if(counter)
+    SDL_AtomicAdd(counter, 1);
+
+  worker_t* worker = CurrentWorker();
+
+  // Sin hilos, se ejecuta directamente
+  if(workers.size() <= 1)
+  {
+    Execute(job);
+    return;
+  }
+
+  Push(worker, job);
+}
+
+void CSystem_Jobs::Wait(job_counter_t* counter)
+{
+  worker_t* worker = CurrentWorker();
+
+  while(SDL_AtomicGet(counter) > 0)
+  {
+    if(!worker or !RunPending(worker))
+      SDL_Delay(0);
+  }
+}
+
+bool CSystem_Jobs::Help()
+{
+  worker_t* worker = CurrentWorker();
+  if(!worker)
+    return false;
+
+  return RunPending(worker);
+}
+
+void CSystem_Jobs::ParallelFor(job_function_t function, void* data, uint begin, uint end, uint grain)
+{
+  if(begin >= end)
+    return;
+
+  uint count = end - begin;
+
+  // Varios bloques por hilo, para que el robo de tareas pueda equilibrar la carga
+  if(!grain)
+    grain = count / (NumThreads() * 4);
+  if(!grain)
+    grain = 1;
+
+  if(workers.size() <= 1 or count <= grain)
+  {
+    function(data, begin, end);
+    return;
+  }
+
+  job_counter_t counter;
+  SDL_AtomicSet(&counter, 0);
+
+  // El primer bloque lo ejecuta este hilo directamente
+  for(uint i = begin + grain; i < end; i += grain)
+    Run(function, data, i, (end - i > grain) ? i + grain : end, &counter);
+
+  function(data, begin, begin + grain);
+
+  Wait(&counter);
+}
@@ -1,5 +1,6 @@
 #include "systems/_manager.h"
 #include "systems/_debug.h"
+#include "systems/_jobs.h"
 
 using namespace std;
 
@@ -11,11 +12,90 @@ bool CSystem_GameObject_Manager::Init()
   if(enabled) return true;
   CSystem::Init();
 
-  last_ID = 0;
+  ClearSlots();
+
+  for(uint i = 0; i < gSystem_Jobs.NumThreads(); i++)
+    command_buffers.push_back(new CCommand_Buffer);
 
   return true;
 }
 
+gameObject_handle_t CSystem_GameObject_Manager::AllocSlot(CGameObject* go)
+{
+  int index;
+  if(free_slots.size())
+  {
+    index = free_slots.back();
+    free_slots.pop_back();
+  }
+  else
+  {
+    gameObject_slot_t slot;
+    slot.go = NULL;
+    slot.dense_index = -1;
+    slot.generation = 0;
+
+    index = slots.size();
+    slots.push_back(slot);
+  }
+
+  slots[index].go = go;
+  slots[index].dense_index = gameObjects.size();
+  gameObjects.push_back(go);
+
+  gameObjects_names.insert(pair<string, CGameObject*>(go->GetName(), go));
+  go->Register(index, slots[index].generation);
+
+  return go->GetHandle();
+}
+
+void CSystem_GameObject_Manager::FreeSlot(CGameObject* go)
+{
+  int index = go->GetID();
+  if(index < 0 or index >= (int)slots.size() or slots[index].go != go)
+    return;
+
+  // Se mueve el último objeto del array denso al hueco que deja el actual
+  int dense_index = slots[index].dense_index;
+  CGameObject* last = gameObjects.back();
+  gameObjects[dense_index] = last;
+  slots[last->GetID()].dense_index = dense_index;
+  gameObjects.pop_back();
+
+  slots[index].go = NULL;
+  slots[index].dense_index = -1;
+  slots[index].generation++;
+  free_slots.push_back(index);
+
+  // Si el objeto ya se ha cerrado, su nombre está vacío y hay que buscarlo en el índice
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(go->GetName());
+  if(it == gameObjects_names.end() or it->second != go)
+    for(it = gameObjects_names.begin(); it != gameObjects_names.end() and it->second != go; ++it);
+
+  if(it != gameObjects_names.end())
+    gameObjects_names.erase(it);
+
+  go->Register(-1);
+}
+
+void CSystem_GameObject_Manager::ClearSlots()
+{
+  // Se conservan las generaciones para invalidar los handles anteriores
+  free_slots.clear();
+  for(int i = slots.size() - 1; i >= 0; i--)
+  {
+    if(slots[i].go)
+      slots[i].generation++;
+
+    slots[i].go = NULL;
+    slots[i].dense_index = -1;
+    free_slots.push_back(i);
+  }
+
+  gameObjects.clear();
+  gameObjects_names.clear();
+}
+
 /*void CSystem_GameObject_Manager::SaveGameObjects(string file)
 {
   ofstream os;
@@ -90,16 +170,23 @@ void CSystem_GameObject_Manager::Close()
   if(!enabled) return;
   CSystem::Close();
 
+  for(vector<CCommand_Buffer*>::iterator it = command_buffers.begin(); it != command_buffers.end(); ++it)
+    delete (*it);
+  command_buffers.clear();
+
   DeleteAll();
 }
 
 bool CSystem_GameObject_Manager::Reset()
 {
+  for(vector<CCommand_Buffer*>::iterator it = command_buffers.begin(); it != command_buffers.end(); ++it)
+    (*it)->Clear();
+
   DeleteAll_NonPreserved();
 
-  for(map<string, CGameObject*>::iterator it = gameObjects.begin(); it != gameObjects.end(); ++it)
+  for(uint i = 0; i < gameObjects.size(); i++)
   {
-    CComponent_Audio_Source* c_go = it->second->GetComponent<CComponent_Audio_Source>();
+    CComponent_Audio_Source* c_go = gameObjects[i]->GetComponent<CComponent_Audio_Source>();
     if(c_go)
     {
       c_go->UnBind();
@@ -111,20 +198,20 @@ bool CSystem_GameObject_Manager::Reset()
 
 void CSystem_GameObject_Manager::InitGameObjects()
 {
-  for(map<string, CGameObject*>::iterator it = gameObjects.begin(); it != gameObjects.end(); ++it)
-    it->second->Init();
+  for(uint i = 0; i < gameObjects.size(); i++)
+    gameObjects[i]->Init();
 }
 
 void CSystem_GameObject_Manager::CloseGameObjects()
 {
-  for(map<string, CGameObject*>::iterator it = gameObjects.begin(); it != gameObjects.end(); ++it)
-    it->second->Close();
+  for(uint i = 0; i < gameObjects.size(); i++)
+    gameObjects[i]->Close();
 }
 
 void CSystem_GameObject_Manager::InitGameObject(string name)
 {
-  map<string, CGameObject*>::iterator it = gameObjects.find(name);
-  if(it != gameObjects.end())
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(name);
+  if(it != gameObjects_names.end())
     it->second->Init();
   else
     gSystem_Debug.console_warning_msg("Error from Manager::InitGameObject: Could not find objet \"%s\"", name.c_str());
@@ -132,8 +219,8 @@ void CSystem_GameObject_Manager::InitGameObject(string name)
 
 void CSystem_GameObject_Manager::CloseGameObject(string name)
 {
-  map<string, CGameObject*>::iterator it = gameObjects.find(name);
-  if(it != gameObjects.end())
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(name);
+  if(it != gameObjects_names.end())
     it->second->Close();
   else
     gSystem_Debug.console_warning_msg("Error from Manager::CloseGameObject: Could not find objet \"%s\"", name.c_str());
@@ -148,25 +235,15 @@ CGameObject* CSystem_GameObject_Manager::Add(std::string name, gameObject_type t
     return NULL;
   }
 
-  map<string, CGameObject*>::iterator it = gameObjects.find(name);
-  if(it == gameObjects.end())
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(name);
+  if(it == gameObjects_names.end())
   {
     CGameObject* go =new CGameObject(name);
-    gameObjects.insert(pair<string, CGameObject*>(name, go));
+    AllocSlot(go);
 
-    it = gameObjects.find(name);
+    if(init) go->Init();
 
-    it->second->Register(last_ID);
-    last_ID++;
-    if(last_ID == INT_MAX)
-    {
-      if(!RebuildIndex())
-        return NULL;//return -1;
-    }
-
-    if(init) it->second->Init();
-
-    return it->second;//return it->second->GetID();
+    return go;//return go->GetID();
   }
 
   gSystem_Debug.console_error_msg("Error from Manager: Invalid game object name \"%s\": Already exists.", name.c_str());
@@ -184,8 +261,8 @@ CGameObject* CSystem_GameObject_Manager::Add(CGameObject* go, bool init)
     return NULL;
   }
 
-  map<string, CGameObject*>::iterator it = gameObjects.find(go->GetName());
-  if(it != gameObjects.end() || go == NULL) // Solo lo colocamos si no existe otro o si go no es NULL
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(go->GetName());
+  if(it != gameObjects_names.end() || go == NULL) // Solo lo colocamos si no existe otro o si go no es NULL
   {
     gSystem_Debug.console_error_msg("Error from Manager: Invalid game object name \"%s\": Already exists.", go->GetName().c_str());
     gSystem_Debug.error("Error from Manager: Invalid game object name \"%s\": Already exists.", go->GetName().c_str());
@@ -193,27 +270,18 @@ CGameObject* CSystem_GameObject_Manager::Add(CGameObject* go, bool init)
     return NULL;//return -1;
   }
 
-  gameObjects.insert(pair<string, CGameObject*>(go->GetName(), go));
-  it = gameObjects.find(go->GetName());
+  AllocSlot(go);
 
-  it->second->Register(last_ID);
-  last_ID++;
-  if(last_ID == INT_MAX)
-  {
-    if(!RebuildIndex())
-      return NULL;//return -1;
-  }
+  if(init) go->Init();
 
-  if(init) it->second->Init();
-
-  return it->second;//return it->second->GetID();
+  return go;//return go->GetID();
 }
 
 bool CSystem_GameObject_Manager::Delete(string nombre, bool remove_children)
 {
   // Borrar solo si se encuentra
-  map<string, CGameObject*>::iterator it = gameObjects.find(nombre);
-  if(it != gameObjects.end())
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(nombre);
+  if(it != gameObjects_names.end())
   {
     int num_hijos = it->second->GetNumChildren();
     if(remove_children)
@@ -221,13 +289,13 @@ bool CSystem_GameObject_Manager::Delete(string nombre, bool remove_children)
         Delete(it->second->GetChild(0)->GetName(), true);
     // num_hijos-1-i
     else
-      for(int i = 0; i < num_hijos && num_hijos != 0; i++)
-        it->second->GetChild(i)->UnParent();
+      it->second->RemoveChildren();
 
     if(it->second->GetParent()) it->second->GetParent()->RemoveChild(nombre);
 
-    delete it->second;
-    gameObjects.erase(it);
+    CGameObject* go = it->second;
+    FreeSlot(go);
+    delete go;
 
     return true;
   }
@@ -239,10 +307,10 @@ bool CSystem_GameObject_Manager::Delete(string nombre, bool remove_children)
 
 bool CSystem_GameObject_Manager::Remove(string str, bool remove_children)
 {
-  map<string, CGameObject*>::iterator it = gameObjects.find(str);
-  if(it != gameObjects.end())
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(str);
+  if(it != gameObjects_names.end())
   {
-    //Borrarlos? naa, muy hardcore
+    //¿Borrarlos? naa, muy hardcore
     int num_hijos = it->second->GetNumChildren();
     if(!remove_children)
       for(int i = 0; i < num_hijos && num_hijos != 0; i++)
@@ -251,9 +319,9 @@ bool CSystem_GameObject_Manager::Remove(string str, bool remove_children)
       for(int i = 0; i < num_hijos && num_hijos != 0; i++)
         Remove(it->second->GetChild(0)->GetName(), remove_children);
 
-    it->second->Register(-1);
-    it->second->UnParent();
-    gameObjects.erase(it);
+    CGameObject* go = it->second;
+    go->UnParent();
+    FreeSlot(go);
 
     return true;
   }
@@ -263,29 +331,14 @@ bool CSystem_GameObject_Manager::Remove(string str, bool remove_children)
   return false;
 }
 
-bool CSystem_GameObject_Manager::RebuildIndex()
-{
-  map<string, CGameObject*>::iterator it;
-  last_ID = 0;
-  for(it = gameObjects.begin(); it != gameObjects.end(); ++it)
-  {
-    it->second->Register(last_ID);
-    last_ID ++;
-  }
-  if(last_ID == INT_MAX) // Si est llena, no se pueden colocar ms objetos
-    return false;
-
-  return true;
-}
-
 vector<CGameObject*> CSystem_GameObject_Manager::Search(string prefix)
 {
   vector<CGameObject*> output;
 
-  map<string, CGameObject*>::iterator it = gameObjects.lower_bound(prefix);
-  if (it != gameObjects.end())
+  map<string, CGameObject*>::iterator it = gameObjects_names.lower_bound(prefix);
+  if (it != gameObjects_names.end())
   {
-    for( ; it != gameObjects.end(); ++it)
+    for( ; it != gameObjects_names.end(); ++it)
     {
       if (it->first.compare(0, prefix.size(), prefix) == 0)
         output.push_back(it->second);
@@ -323,40 +376,33 @@ bool CSystem_GameObject_Manager::Rename(std::string name, std::string new_name)
     return NULL;
   }
 
-  map<string, CGameObject*>::iterator it1 = gameObjects.find(name);
-  map<string, CGameObject*>::iterator it2 = gameObjects.find(new_name);
+  map<string, CGameObject*>::iterator it1 = gameObjects_names.find(name);
+  map<string, CGameObject*>::iterator it2 = gameObjects_names.find(new_name);
 
-  if(it1 == gameObjects.end()) // No existe el nombre del objeto
+  if(it1 == gameObjects_names.end()) // No existe el nombre del objeto
   {
     gSystem_Debug.console_error_msg("From CSystem_GameObject_Manager::RenameGameObject: Object \"%s\" does not exists", name.c_str());
     return false;
   }
-  if(it2 != gameObjects.end()) // Ya existe el futuro objeto
+  if(it2 != gameObjects_names.end()) // Ya existe el futuro objeto
   {
     gSystem_Debug.console_error_msg("From CSystem_GameObject_Manager::RenameGameObject: Object \"%s\" already exists", new_name.c_str());
     return false;
   }
 
   CGameObject* current_go = it1->second;
-  gameObjects.erase(it1);
-  gameObjects.insert(pair<string, CGameObject*>(new_name, current_go));
+  gameObjects_names.erase(it1);
+  gameObjects_names.insert(pair<string, CGameObject*>(new_name, current_go));
 
-  it1 = gameObjects.find(new_name);
+  it1 = gameObjects_names.find(new_name);
   it1->second->name = new_name;
 
-  // Renombrar hijo en la lista de hijos del padre.
-  if(it1->second->GetParent())
-  {
-    it1->second->GetParent()->children.erase(new_name);
-    it1->second->GetParent()->children.insert(pair<string, CGameObject*>(new_name, current_go));
-  }
-
   return true;
 }
 
 bool CSystem_GameObject_Manager::Rename(CGameObject* go, std::string new_name)
 {
-  // Debera llamar a la funcin anterior, o al revs
+  // Debería llamar a la función anterior, o al revés
   if(!Utils::validateIdentifier(new_name))
   {
     gSystem_Debug.console_error_msg("Invalid game object name \"%s\": Can only contain alphanumerics or underscores.", new_name.c_str());
@@ -366,69 +412,63 @@ bool CSystem_GameObject_Manager::Rename(CGameObject* go, std::string new_name)
 
   if(!go) return false;
 
-  map<string, CGameObject*>::iterator it1 = gameObjects.find(go->GetName());
-  map<string, CGameObject*>::iterator it2 = gameObjects.find(new_name);
+  map<string, CGameObject*>::iterator it1 = gameObjects_names.find(go->GetName());
+  map<string, CGameObject*>::iterator it2 = gameObjects_names.find(new_name);
 
-  if(it1 == gameObjects.end())
+  if(it1 == gameObjects_names.end())
   {
     gSystem_Debug.console_error_msg("From CSystem_GameObject_Manager::RenameGameObject: Object \"%s\" does not exists", go->GetName().c_str());
     return false;
   }
-  if(it2 != gameObjects.end())
+  if(it2 != gameObjects_names.end())
   {
     gSystem_Debug.console_error_msg("From CSystem_GameObject_Manager::RenameGameObject: Object \"%s\" already exists", new_name.c_str());
     return false;
   }
 
-  gameObjects.erase(it1);
-  gameObjects.insert(pair<string, CGameObject*>(new_name, go));
+  gameObjects_names.erase(it1);
+  gameObjects_names.insert(pair<string, CGameObject*>(new_name, go));
 
-  it1 = gameObjects.find(new_name);
+  it1 = gameObjects_names.find(new_name);
   it1->second->name = new_name;
-
-  // Renombrar hijo en la lista de hijos del padre.
-  if(it1->second->GetParent())
-  {
-    it1->second->GetParent()->children.erase(new_name);
-    it1->second->GetParent()->children.insert(pair<string, CGameObject*>(new_name, go));
-  }
   return true;
 }
 
 void CSystem_GameObject_Manager::DeleteAll()
 {
-  for(map<string, CGameObject*>::iterator it = gameObjects.begin(); it != gameObjects.end(); ++it)
+  for(uint i = 0; i < gameObjects.size(); i++)
   {
-    it->second->Close();
-    delete it->second;
+    gameObjects[i]->Close();
+    delete gameObjects[i];
   }
 
-  gameObjects.clear();
+  ClearSlots();
 }
 
 void CSystem_GameObject_Manager::DeleteAll_NonPreserved()
 {
-  for(map<string, CGameObject*>::iterator it = gameObjects.begin(); it != gameObjects.end();)
+  // Primero se liberan los slots (Close() borra el nombre del objeto y de sus hijos), y luego se borran los objetos
+  vector<CGameObject*> to_delete;
+  for(int i = gameObjects.size() - 1; i >= 0; i--)
   {
-    if(!it->second->IsPreserved())
-    {
-      it->second->Close();
-      delete it->second;
-
-      gameObjects.erase(it++);
-      //it--;
-    }
-    else
+    if(!gameObjects[i]->IsPreserved())
     {
-      ++it;
+      to_delete.push_back(gameObjects[i]);
+      FreeSlot(gameObjects[i]);
     }
   }
+
+  for(vector<CGameObject*>::iterator it = to_delete.begin(); it != to_delete.end(); ++it)
+  {
+    (*it)->Close();
+    delete (*it);
+  }
 }
 
 CGameObject* CSystem_GameObject_Manager::Get(string nombre)
 {
-  map<string, CGameObject*>::iterator it = gameObjects.find(nombre);
-  if(it != gameObjects.end())
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(nombre);
+  if(it != gameObjects_names.end())
     return it->second;
 //  else
 //    gSystem_Debug.console_warning_msg("From CSystem_GameObject_Manager::GetGameObject: Could not find objet \"%s\"", nombre.c_str());
@@ -436,10 +476,23 @@ CGameObject* CSystem_GameObject_Manager::Get(string nombre)
   return NULL;
 }
 
+CGameObject* CSystem_GameObject_Manager::Get(gameObject_handle_t handle)
+{
+  if(IsValid(handle))
+    return slots[handle.index].go;
+
+  return NULL;
+}
+
+bool CSystem_GameObject_Manager::IsValid(gameObject_handle_t handle)
+{
+  return handle.index >= 0 and handle.index < (int)slots.size() and slots[handle.index].go != NULL and slots[handle.index].generation == handle.generation;
+}
+
 CGameObject* CSystem_GameObject_Manager::operator[](string nombre)
 {
-  map<string, CGameObject*>::iterator it = gameObjects.find(nombre);
-  if(it != gameObjects.end())
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(nombre);
+  if(it != gameObjects_names.end())
     return it->second;
 //  else
 //    gSystem_Debug.console_warning_msg("From CSystem_GameObject_Manager::operator[]: Could not find objet \"%s\"", nombre.c_str());
@@ -449,8 +502,8 @@ CGameObject* CSystem_GameObject_Manager::operator[](string nombre)
 
 void CSystem_GameObject_Manager::DisableGameObject(string name, bool recursive)
 {
-  map<string, CGameObject*>::iterator it = gameObjects.find(name);
-  if(it != gameObjects.end())
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(name);
+  if(it != gameObjects_names.end())
     it->second->Disable(recursive);
 //  else
 //    gSystem_Debug.console_warning_msg("From CSystem_GameObject_Manager::DisableGameObject: Could not find objet \"%s\"", name.c_str());
@@ -458,8 +511,8 @@ void CSystem_GameObject_Manager::DisableGameObject(string name, bool recursive)
 
 void CSystem_GameObject_Manager::EnableGameObject(string name, bool recursive)
 {
-  map<string, CGameObject*>::iterator it = gameObjects.find(name);
-  if(it != gameObjects.end())
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(name);
+  if(it != gameObjects_names.end())
     it->second->Enable(recursive);
   else
     gSystem_Debug.console_warning_msg("From CSystem_GameObject_Manager::EnableGameObject: Could not find objet \"%s\"", name.c_str());
@@ -467,8 +520,8 @@ void CSystem_GameObject_Manager::EnableGameObject(string name, bool recursive)
 
 void CSystem_GameObject_Manager::SetGameObjectState(string name, bool state, bool recursive)
 {
-  map<string, CGameObject*>::iterator it = gameObjects.find(name);
-  if(it != gameObjects.end())
+  map<string, CGameObject*>::iterator it = gameObjects_names.find(name);
+  if(it != gameObjects_names.end())
     it->second->SetState(state, recursive);
   else
     gSystem_Debug.console_warning_msg("From CSystem_GameObject_Manager::SetGameObject: Could not find objet \"%s\"", name.c_str());
@@ -476,37 +529,196 @@ void CSystem_GameObject_Manager::SetGameObjectState(string name, bool state, boo
 
 void CSystem_GameObject_Manager::EnableGameObjects()
 {
-  for(map<string, CGameObject*>::iterator it = gameObjects.begin(); it != gameObjects.end(); ++it)
-    it->second->Enable();
+  for(uint i = 0; i < gameObjects.size(); i++)
+    gameObjects[i]->Enable();
 }
 
 void CSystem_GameObject_Manager::DisableGameObjects()
 {
-  for(map<string, CGameObject*>::iterator it = gameObjects.begin(); it != gameObjects.end(); ++it)
-    it->second->Disable();
+  for(uint i = 0; i < gameObjects.size(); i++)
+    gameObjects[i]->Disable();
 }
 
 void CSystem_GameObject_Manager::SetGameObjects(bool state)
 {
-  for(map<string, CGameObject*>::iterator it = gameObjects.begin(); it != gameObjects.end(); ++it)
-    it->second->SetState(state);
+  for(uint i = 0; i < gameObjects.size(); i++)
+    gameObjects[i]->SetState(state);
+}
+
+void CSystem_GameObject_Manager::SnapshotHandles()
+{
+  iteration.resize(gameObjects.size());
+  for(uint i = 0; i < gameObjects.size(); i++)
+    iteration[i] = gameObjects[i]->GetHandle();
 }
 
 void CSystem_GameObject_Manager::OnEvent()
 {
-  for(map<string, CGameObject*>::iterator it = gameObjects.begin(); it != gameObjects.end(); ++it)
-    it->second->OnEvent();
+  SnapshotHandles();
+  for(uint i = 0; i < iteration.size(); i++)
+  {
+    CGameObject* go = Get(iteration[i]);
+    if(go)
+      go->OnEvent();
+  }
 }
 
 void CSystem_GameObject_Manager::OnInput()
 {
-  for(map<string, CGameObject*>::iterator it = gameObjects.begin(); it != gameObjects.end(); ++it)
-    it->second->OnInput();
+  SnapshotHandles();
+  for(uint i = 0; i < iteration.size(); i++)
+  {
+    CGameObject* go = Get(iteration[i]);
+    if(go)
+      go->OnInput();
+  }
+}
+
+CCommand_Buffer& CSystem_GameObject_Manager::Commands()
+{
+  uint thread = gSystem_Jobs.CurrentThread();
+
+  // Hasta que se inicie el sistema (o con hilos ajenos), se usa un buffer extra
+  if(thread >= command_buffers.size())
+  {
+    if(command_buffers.empty())
+      command_buffers.push_back(new CCommand_Buffer);
+    thread = 0;
+  }
+
+  return *command_buffers[thread];
+}
+
+void CSystem_GameObject_Manager::ApplyCommands()
+{
+  uint num_commands = 0, num_spawns = 0, num_ignored = 0;
+  for(vector<CCommand_Buffer*>::iterator b = command_buffers.begin(); b != command_buffers.end(); ++b)
+  {
+    num_commands += (*b)->Size();
+    num_spawns += (*b)->num_spawns;
+    num_ignored += (*b)->num_ignored;
+    (*b)->num_ignored = 0;
+  }
+
+  if(num_ignored)
+    gSystem_Debug.console_warning_msg("From Manager: Ignored %u commands over game objects that were not registered nor spawned in the same buffer", num_ignored);
+
+  if(!num_commands)
+    return;
+
+  vector<CGameObject*> discarded;
+
+  // Creaciones, reservando espacio para todas a la vez
+  if(num_spawns)
+  {
+    gameObjects.reserve(gameObjects.size() + num_spawns);
+    slots.reserve(slots.size() + num_spawns);
+
+    for(vector<CCommand_Buffer*>::iterator b = command_buffers.begin(); b != command_buffers.end(); ++b)
+      for(vector<CCommand_Buffer::command_t>::iterator it = (*b)->commands.begin(); it != (*b)->commands.end(); ++it)
+        if(it->type == CCommand_Buffer::spawn and !Add(it->go, false))
+          discarded.push_back(it->go);
+  }
+
+  // Jerarquía y componentes
+  vector<gameObject_handle_t> destroyed;
+  vector<bool> destroyed_children;
+
+  for(vector<CCommand_Buffer*>::iterator b = command_buffers.begin(); b != command_buffers.end(); ++b)
+  {
+    for(vector<CCommand_Buffer::command_t>::iterator it = (*b)->commands.begin(); it != (*b)->commands.end(); ++it)
+    {
+      if(it->type == CCommand_Buffer::spawn)
+        continue;
+
+      // Los objetos borrados desde que se pidió el cambio ya no tienen un handle válido
+      CGameObject* go = (*b)->Resolve(it->target);
+      if(!go)
+        continue;
+
+      switch(it->type)
+      {
+        case CCommand_Buffer::reparent:
+        {
+          CGameObject* parent = (*b)->Resolve(it->other);
+          bool has_parent = it->other.spawn >= 0 or it->other.handle.index >= 0;
+          if(has_parent and !parent)
+            break;
+
+          if(go->GetParent())
+            go->RemoveParent();
+          if(parent and !parent->AddChild(go))
+            gSystem_Debug.console_warning_msg("From Manager: Could not set \"%s\" as parent of \"%s\"", parent->GetName().c_str(), go->GetName().c_str());
+        }
+        break;
+
+        case CCommand_Buffer::add_component:
+          if(!go->components[it->component])
+            go->SetComponent(it->component, it->creator(go));
+        break;
+
+        case CCommand_Buffer::remove_component:
+          if(it->component != Components::transform and go->components[it->component])
+          {
+            delete go->components[it->component];
+            go->ClearComponent(it->component);
+          }
+        break;
+
+        case CCommand_Buffer::destroy:
+          destroyed.push_back(go->GetHandle());
+          destroyed_children.push_back(it->flag);
+        break;
+
+        default:
+        break;
+      }
+    }
+
+    // Los objetos creados ya pertenecen al gestor (o se han descartado)
+    for(vector<CCommand_Buffer::command_t>::iterator it = (*b)->commands.begin(); it != (*b)->commands.end(); ++it)
+      if(it->type == CCommand_Buffer::spawn)
+        it->go = NULL;
+    (*b)->Clear();
+  }
+
+  // Borrados. Por handle, ya que borrar un padre puede haber borrado ya a sus hijos
+  for(uint i = 0; i < destroyed.size(); i++)
+  {
+    CGameObject* go = Get(destroyed[i]);
+    if(go)
+      Delete(go->GetName(), destroyed_children[i]);
+  }
+
+  for(vector<CGameObject*>::iterator it = discarded.begin(); it != discarded.end(); ++it)
+    delete (*it);
+}
+
+void CSystem_GameObject_Manager::ParallelLoop(void* data, uint begin, uint end)
+{
+  CGameObject** objects = (CGameObject**)data;
+  for(uint i = begin; i < end; i++)
+    objects[i]->OnLoop(~gSystem_GameObject_Manager.scheduled_components);
 }
 
 void CSystem_GameObject_Manager::OnLoop()
 {
-  for(map<string, CGameObject*>::iterator it = gameObjects.begin(); it != gameObjects.end(); ++it)
-    it->second->OnLoop();
+  // Primero los objetos paralelos, que no pueden cambiar "gameObjects"
+  parallel_objects.clear();
+  for(uint i = 0; i < gameObjects.size(); i++)
+    if(gameObjects[i]->parallel)
+      parallel_objects.push_back(gameObjects[i]);
+
+  if(parallel_objects.size())
+    gSystem_Jobs.ParallelFor(&CSystem_GameObject_Manager::ParallelLoop, &parallel_objects[0], 0, parallel_objects.size());
+
+  // Los objetos borrados por otro durante la iteración no se actualizan
+  SnapshotHandles();
+  for(uint i = 0; i < iteration.size(); i++)
+  {
+    CGameObject* go = Get(iteration[i]);
+    if(go and !go->parallel)
+      go->OnLoop(~scheduled_components);
+  }
 }
 
@@ -0,0 +1,283 @@
+#include "systems/_memory.h"
+#include "systems/_debug.h"
+
+using namespace std;
+
+CSystem_Memory gSystem_Memory;
+CSystem_Memory& gMemory = gSystem_Memory;
+
+// Arena
+CMemory_Arena::CMemory_Arena(): lock(0), used_bytes(0), reserved_bytes(0), num_allocations(0)
+{
+  // 16, 32, 48, 64, y después 4 clases por potencia de 2 (80, 96, 112, 128, 160...) hasta 1 MB
+  size_t sizes[4] = {16, 32, 48, 64};
+  for(uint i = 0; i < 4; i++)
+  {
+    size_class_t c = {sizes[i], NULL, NULL, 0};
+    classes.push_back(c);
+  }
+
+  for(size_t base = 64; base < 1024*1024; base *= 2)
+  {
+    for(uint step = 1; step <= 4; step++)
+    {
+      size_class_t c = {base + step * base / 4, NULL, NULL, 0};
+      classes.push_back(c);
+    }
+  }
+}
+
+CMemory_Arena::~CMemory_Arena()
+{
+  for(map<char*, page_t*>::iterator it = pages.begin(); it != pages.end(); ++it)
+  {
+    delete[] it->second->memory;
+    delete it->second;
+  }
+}
+
+int CMemory_Arena::SizeClass(size_t size)
+{
+  // Búsqueda binaria de la primera clase en la que cabe
+  uint low = 0, high = classes.size();
+  while(low < high)
+  {
+    uint mid = (low + high) / 2;
+    if(classes[mid].block_size < size)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  return (low < classes.size()) ? (int)low : -1;
+}
+
+CMemory_Arena::page_t* CMemory_Arena::FindPage(void* p)
+{
+  map<char*, page_t*>::iterator it = pages.upper_bound((char*)p);
+  if(it == pages.begin())
+    return NULL;
+
+  --it;
+  page_t* page = it->second;
+  if((char*)p >= page->memory + page->size)
+    return NULL;
+
+  return page;
+}
+
+CMemory_Arena::page_t* CMemory_Arena::AddPage(size_t size, int size_class)
+{
+  page_t* page = new page_t;
+  page->memory = new char[size];
+  page->size = size;
+  page->size_class = size_class;
+  page->used = 0;
+
+  pages.insert(pair<char*, page_t*>(page->memory, page));
+  reserved_bytes += size;
+
+  return page;
+}
+
+void CMemory_Arena::DeletePage(page_t* page)
+{
+  if(page->size_class >= 0 and classes[page->size_class].current == page)
+    classes[page->size_class].current = NULL;
+
+  pages.erase(page->memory);
+  reserved_bytes -= page->size;
+
+  delete[] page->memory;
+  delete page;
+}
+
+void* CMemory_Arena::Allocate(size_t size)
+{
+  if(size == 0)
+    size = 1;
+
+  SDL_AtomicLock(&lock);
+
+  int c = SizeClass(size);
+  if(c < 0)
+  {
+    // Bloque grande: página propia
+    size = (size + 15) & ~(size_t)15;
+    page_t* page = AddPage(size, -1);
+    page->used = 1;
+    used_bytes += size;
+    num_allocations++;
+
+    SDL_AtomicUnlock(&lock);
+    return page->memory;
+  }
+
+  size_class_t& sc = classes[c];
+  void* p = NULL;
+  page_t* page = NULL;
+
+  if(sc.free_list)
+  {
+    p = sc.free_list;
+    sc.free_list = *(void**)p;
+    page = FindPage(p);
+  }
+  else
+  {
+    if(!sc.current or sc.offset + sc.block_size > sc.current->size)
+    {
+      size_t page_size = __MEMORY_ARENA_PAGE_SIZE;
+      if(page_size < sc.block_size)
+        page_size = sc.block_size;
+      page_size -= page_size % sc.block_size;
+
+      sc.current = AddPage(page_size, c);
+      sc.offset = 0;
+    }
+
+    page = sc.current;
+    p = page->memory + sc.offset;
+    sc.offset += sc.block_size;
+  }
+
+  page->used++;
+  used_bytes += sc.block_size;
+  num_allocations++;
+
+  SDL_AtomicUnlock(&lock);
+
+  return p;
+}
+
+bool CMemory_Arena::Free(void* p, size_t size)
+{
+  if(!p)
+    return true;
+
+  SDL_AtomicLock(&lock);
+
+  page_t* page = FindPage(p);
+  if(!page)
+  {
+    SDL_AtomicUnlock(&lock);
+    return false;
+  }
+
+  page->used--;
+  num_allocations--;
+
+  if(page->size_class < 0)
+  {
+    used_bytes -= page->size;
+    DeletePage(page);
+  }
+  else
+  {
+    size_class_t& sc = classes[page->size_class];
+    used_bytes -= sc.block_size;
+
+    *(void**)p = sc.free_list;
+    sc.free_list = p;
+  }
+
+  SDL_AtomicUnlock(&lock);
+
+  return true;
+}
+
+size_t CMemory_Arena::Release()
+{
+  SDL_AtomicLock(&lock);
+
+  size_t released = reserved_bytes;
+
+  // Caso normal: no queda nada vivo, se devuelve todo de una vez
+  if(num_allocations == 0)
+  {
+    for(map<char*, page_t*>::iterator it = pages.begin(); it != pages.end(); ++it)
+    {
+      delete[] it->second->memory;
+      delete it->second;
+    }
+    pages.clear();
+
+    for(vector<size_class_t>::iterator it = classes.begin(); it != classes.end(); ++it)
+    {
+      it->free_list = NULL;
+      it->current = NULL;
+      it->offset = 0;
+    }
+
+    reserved_bytes = 0;
+    used_bytes = 0;
+
+    SDL_AtomicUnlock(&lock);
+    return released;
+  }
+
+  // Quedan bloques vivos: sólo se liberan las páginas vacías, quitando antes sus bloques de las listas libres
+  vector<page_t*> empty;
+  for(map<char*, page_t*>::iterator it = pages.begin(); it != pages.end(); ++it)
+    if(it->second->used == 0)
+      empty.push_back(it->second);
+
+  if(!empty.empty())
+  {
+    for(vector<size_class_t>::iterator it = classes.begin(); it != classes.end(); ++it)
+    {
+      void** link = &it->free_list;
+      while(*link)
+      {
+        page_t* page = FindPage(*link);
+        if(page->used == 0)
+          *link = *(void**)*link;
+        else
+          link = (void**)*link;
+      }
+    }
+
+    for(vector<page_t*>::iterator it = empty.begin(); it != empty.end(); ++it)
+      DeletePage(*it);
+  }
+
+  released -= reserved_bytes;
+
+  SDL_AtomicUnlock(&lock);
+  return released;
+}
+
+// Sistema
+bool CSystem_Memory::Init()
+{
+  if(enabled) return true;
+  CSystem::Init();
+
+  return true;
+}
+
+void CSystem_Memory::Close()
+{
+  if(!enabled) return;
+
+  instance_arena.Release();
+
+  CSystem::Close();
+}
+
+bool CSystem_Memory::Reset()
+{
+  instance_arena.Release();
+
+  return true;
+}
+
+void CSystem_Memory::PrintStats()
+{
+  gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "Instance arena");
+  gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "-------------------");
+  gSystem_Debug.console_msg(" Used:        %u KB", (uint)(instance_arena.Used() / 1024));
+  gSystem_Debug.console_msg(" Reserved:    %u KB", (uint)(instance_arena.Reserved() / 1024));
+  gSystem_Debug.console_msg(" Allocations: %u", instance_arena.NumAllocations());
+  gSystem_Debug.console_msg(" Pages:       %u", instance_arena.NumPages());
+}
@@ -0,0 +1,75 @@
+#include "systems/_mesh_buffer.h"
+#include "systems/_resource.h"
+#include "systems/_gl_state.h"
+#include "systems/_debug.h"
+
+using namespace std;
+
+CMesh_Buffer::CMesh_Buffer(flags_t f, GLenum type, GLsizei size): m_VBO(0), m_IBO(0), m_VAO(0), format(f), index_type(type), vertex_size(size),
+  max_vertices(0), max_indices(0), num_vertices(0), num_indices(0), users(0)
+{
+  index_size = (index_type == GL_UNSIGNED_SHORT) ? sizeof(GLushort) : sizeof(GLuint);
+}
+
+CMesh_Buffer::~CMesh_Buffer()
+{
+  glDeleteBuffers(1, &m_VBO);
+  glDeleteBuffers(1, &m_IBO);
+
+  gSystem_GL_State.VertexArrayDeleted(m_VAO);
+  glDeleteVertexArrays(1, &m_VAO);
+}
+
+bool CMesh_Buffer::Create(uint vertices, uint indices)
+{
+  if(!vertices or !indices)
+    return false;
+
+  glGenVertexArrays(1, &m_VAO);
+  glGenBuffers(1, &m_VBO);
+  glGenBuffers(1, &m_IBO);
+  if(!m_VAO or !m_VBO or !m_IBO)
+  {
+    gSystem_Debug.error("From CMesh_Buffer: Could not generate shared mesh buffers.");
+    return false;
+  }
+
+  gSystem_GL_State.BindVertexArray(m_VAO);
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+  glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertices * vertex_size, NULL, GL_STATIC_DRAW);
+  CResource_Mesh::SetVertexAttributes(format, vertex_size);
+
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IBO);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)indices * index_size, NULL, GL_STATIC_DRAW);
+
+  gSystem_GL_State.BindVertexArray(0);
+
+  max_vertices = vertices;
+  max_indices = indices;
+
+  return true;
+}
+
+bool CMesh_Buffer::Add(const void* vertex_data, uint vertices, const void* index_data, uint indices, GLint& base_vertex, GLuint& first_index)
+{
+  if(!m_VAO or num_vertices + vertices > max_vertices or num_indices + indices > max_indices)
+    return false;
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+  glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)num_vertices * vertex_size, (GLsizeiptr)vertices * vertex_size, vertex_data);
+
+  // El IBO se enlaza con el VAO activo: se activa el propio para no cambiar el de otro
+  gSystem_GL_State.BindVertexArray(m_VAO);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IBO);
+  glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)num_indices * index_size, (GLsizeiptr)indices * index_size, index_data);
+  gSystem_GL_State.BindVertexArray(0);
+
+  base_vertex = num_vertices;
+  first_index = num_indices;
+
+  num_vertices += vertices;
+  num_indices += indices;
+
+  return true;
+}
@@ -0,0 +1,315 @@
+#include "systems/_mesh_optimizer.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace MeshOptimizer
+{
+  // Puntuación de un vértice (Forsyth): más si está al principio de la caché y si le quedan pocos triángulos
+  static inline float VertexScore(int cache_position, uint valence)
+  {
+    if(!valence)
+      return -1.f;
+
+    float score = 0.f;
+    if(cache_position >= 0)
+    {
+      // Los tres del último triángulo valen algo menos, para no seguir siempre la misma tira
+      if(cache_position < 3)
+        score = 0.75f;
+      else
+        score = pow(1.f - (cache_position - 3) / (float)(__MESH_OPTIMIZER_CACHE_SIZE - 3), 1.5f);
+    }
+
+    return score + 2.f / sqrt((float)valence);
+  }
+
+  void OptimizeVertexCache(vector<uint>& indices, uint num_vertices)
+  {
+    uint num_triangles = indices.size() / 3;
+    if(num_triangles < 2)
+      return;
+
+    // Triángulos de cada vértice, en adjacency[offsets[v]] a adjacency[offsets[v] + valence[v]]: los que aún no se han emitido
+    vector<uint> offsets(num_vertices + 1, 0);
+    for(uint i = 0; i < indices.size(); i++)
+      offsets[indices[i] + 1]++;
+    for(uint v = 0; v < num_vertices; v++)
+      offsets[v + 1] += offsets[v];
+
+    vector<uint> adjacency(indices.size());
+    vector<uint> valence(num_vertices, 0);
+    for(uint i = 0; i < indices.size(); i++)
+    {
+      uint v = indices[i];
+      adjacency[offsets[v] + valence[v]++] = i / 3;
+    }
+
+    vector<int> position(num_vertices, -1);
+    vector<float> vertex_score(num_vertices);
+    for(uint v = 0; v < num_vertices; v++)
+      vertex_score[v] = VertexScore(-1, valence[v]);
+
+    vector<float> triangle_score(num_triangles);
+    for(uint t = 0; t < num_triangles; t++)
+      triangle_score[t] = vertex_score[indices[t*3]] + vertex_score[indices[t*3 + 1]] + vertex_score[indices[t*3 + 2]];
+
+    vector<bool> emitted(num_triangles, false);
+    vector<uint> out;
+    out.reserve(indices.size());
+
+    uint cache[__MESH_OPTIMIZER_CACHE_SIZE + 3];
+    uint cache_count = 0;
+
+    // Si ningún triángulo de la caché queda por emitir, se sigue por el siguiente del orden original
+    uint cursor = 0;
+    int best = -1;
+
+    while(out.size() < indices.size())
+    {
+      if(best < 0)
+      {
+        while(emitted[cursor])
+          cursor++;
+
+        best = cursor;
+      }
+
+      const uint* triangle = &indices[best*3];
+      emitted[best] = true;
+
+      for(uint c = 0; c < 3; c++)
+      {
+        uint v = triangle[c];
+        out.push_back(v);
+
+        // Quitar el triángulo de la lista del vértice
+        uint* list = &adjacency[offsets[v]];
+        for(uint i = 0; i < valence[v]; i++)
+        {
+          if(list[i] == (uint)best)
+          {
+            list[i] = list[valence[v] - 1];
+            break;
+          }
+        }
+        valence[v]--;
+      }
+
+      // Caché LRU: el triángulo al principio, y detrás los que ya estaban
+      uint new_cache[__MESH_OPTIMIZER_CACHE_SIZE + 3];
+      uint new_count = 0;
+
+      for(uint c = 0; c < 3; c++)
+        new_cache[new_count++] = triangle[c];
+
+      for(uint i = 0; i < cache_count; i++)
+      {
+        uint v = cache[i];
+        if(v != triangle[0] and v != triangle[1] and v != triangle[2])
+          new_cache[new_count++] = v;
+      }
+
+      // Los que se salen de la caché también cambian de puntuación
+      for(uint i = 0; i < new_count; i++)
+      {
+        uint v = new_cache[i];
+        position[v] = (i < __MESH_OPTIMIZER_CACHE_SIZE) ? (int)i : -1;
+        vertex_score[v] = VertexScore(position[v], valence[v]);
+      }
+
+      best = -1;
+      float best_score = -1.f;
+
+      for(uint i = 0; i < new_count; i++)
+      {
+        uint v = new_cache[i];
+
+        for(uint j = 0; j < valence[v]; j++)
+        {
+          uint t = adjacency[offsets[v] + j];
+          float score = vertex_score[indices[t*3]] + vertex_score[indices[t*3 + 1]] + vertex_score[indices[t*3 + 2]];
+          triangle_score[t] = score;
+
+          if(i < __MESH_OPTIMIZER_CACHE_SIZE and score > best_score)
+          {
+            best_score = score;
+            best = t;
+          }
+        }
+      }
+
+      cache_count = min(new_count, (uint)__MESH_OPTIMIZER_CACHE_SIZE);
+      for(uint i = 0; i < cache_count; i++)
+        cache[i] = new_cache[i];
+    }
+
+    indices.swap(out);
+  }
+
+  // Simulación de una caché FIFO: timestamps[v] es el instante en el que entró v, y sigue dentro mientras no hayan entrado otros __MESH_OPTIMIZER_FIFO_SIZE
+  static inline uint Misses(const uint* triangle, vector<uint>& timestamps, uint& time)
+  {
+    uint misses = 0;
+
+    for(uint c = 0; c < 3; c++)
+    {
+      uint v = triangle[c];
+      if(time - timestamps[v] > __MESH_OPTIMIZER_FIFO_SIZE)
+      {
+        timestamps[v] = time++;
+        misses++;
+      }
+    }
+
+    return misses;
+  }
+
+  float ACMR(const vector<uint>& indices, uint num_vertices)
+  {
+    uint num_triangles = indices.size() / 3;
+    if(!num_triangles)
+      return 0.f;
+
+    vector<uint> timestamps(num_vertices, 0);
+    uint time = __MESH_OPTIMIZER_FIFO_SIZE + 1;
+    uint misses = 0;
+
+    for(uint t = 0; t < num_triangles; t++)
+      misses += Misses(&indices[t*3], timestamps, time);
+
+    return misses / (float)num_triangles;
+  }
+
+  void OptimizeOverdraw(vector<uint>& indices, const vector<glm::vec3>& positions, float threshold)
+  {
+    uint num_triangles = indices.size() / 3;
+    if(num_triangles < 2)
+      return;
+
+    uint num_vertices = positions.size();
+    vector<uint> timestamps(num_vertices, 0);
+    uint time = __MESH_OPTIMIZER_FIFO_SIZE + 1;
+
+    // Cortes que no cuestan nada: triángulos con los tres vértices fuera de la caché
+    vector<uint> hard;
+    for(uint t = 0; t < num_triangles; t++)
+      if(Misses(&indices[t*3], timestamps, time) == 3)
+        hard.push_back(t);
+
+    if(hard.empty() or hard[0] != 0)
+      hard.insert(hard.begin(), 0);
+    hard.push_back(num_triangles);
+
+    // Dentro de cada uno, se corta donde lo que va de grupo no está más de threshold por encima de la media del grupo entero
+    vector<uint> clusters;
+    for(uint h = 0; h + 1 < hard.size(); h++)
+    {
+      uint start = hard[h], end = hard[h + 1];
+
+      time += __MESH_OPTIMIZER_FIFO_SIZE + 1;
+      uint misses = 0;
+      for(uint t = start; t < end; t++)
+        misses += Misses(&indices[t*3], timestamps, time);
+
+      float limit = misses / (float)(end - start) * threshold;
+
+      time += __MESH_OPTIMIZER_FIFO_SIZE + 1;
+      uint cluster_start = start;
+      uint cluster_misses = 0;
+      clusters.push_back(start);
+
+      for(uint t = start; t < end; t++)
+      {
+        cluster_misses += Misses(&indices[t*3], timestamps, time);
+
+        if(t + 1 < end and cluster_misses <= limit * (t + 1 - cluster_start))
+        {
+          clusters.push_back(t + 1);
+          cluster_start = t + 1;
+          cluster_misses = 0;
+          time += __MESH_OPTIMIZER_FIFO_SIZE + 1;
+        }
+      }
+    }
+    clusters.push_back(num_triangles);
+
+    // Centro del modelo, ponderado por el área de los triángulos
+    glm::vec3 mesh_center(0.f);
+    float mesh_area = 0.f;
+    for(uint t = 0; t < num_triangles; t++)
+    {
+      const glm::vec3& a = positions[indices[t*3]];
+      const glm::vec3& b = positions[indices[t*3 + 1]];
+      const glm::vec3& c = positions[indices[t*3 + 2]];
+
+      float area = glm::length(glm::cross(b - a, c - a));
+      mesh_center += (a + b + c) * (area / 3.f);
+      mesh_area += area;
+    }
+    if(mesh_area > 0.f)
+      mesh_center /= mesh_area;
+
+    // Cuánto mira cada grupo hacia fuera del modelo
+    vector<pair<float, uint> > order;
+    order.reserve(clusters.size() - 1);
+
+    for(uint k = 0; k + 1 < clusters.size(); k++)
+    {
+      glm::vec3 center(0.f), normal(0.f);
+      float area = 0.f;
+
+      for(uint t = clusters[k]; t < clusters[k + 1]; t++)
+      {
+        const glm::vec3& a = positions[indices[t*3]];
+        const glm::vec3& b = positions[indices[t*3 + 1]];
+        const glm::vec3& c = positions[indices[t*3 + 2]];
+
+        glm::vec3 n = glm::cross(b - a, c - a);
+        float triangle_area = glm::length(n);
+
+        center += (a + b + c) * (triangle_area / 3.f);
+        normal += n;
+        area += triangle_area;
+      }
+
+      float key = 0.f;
+      float normal_length = glm::length(normal);
+      if(area > 0.f and normal_length > 0.f)
+        key = glm::dot(center / area - mesh_center, normal / normal_length);
+
+      // Orden descendente y estable
+      order.push_back(make_pair(-key, k));
+    }
+
+    sort(order.begin(), order.end());
+
+    vector<uint> out;
+    out.reserve(indices.size());
+    for(uint i = 0; i < order.size(); i++)
+    {
+      uint k = order[i].second;
+      out.insert(out.end(), indices.begin() + clusters[k]*3, indices.begin() + clusters[k + 1]*3);
+    }
+
+    indices.swap(out);
+  }
+
+  uint OptimizeVertexFetch(vector<uint>& indices, uint num_vertices, vector<uint>& remap)
+  {
+    remap.assign(num_vertices, (uint)-1);
+    uint count = 0;
+
+    for(uint i = 0; i < indices.size(); i++)
+    {
+      uint& v = remap[indices[i]];
+      if(v == (uint)-1)
+        v = count++;
+
+      indices[i] = v;
+    }
+
+    return count;
+  }
+}
@@ -0,0 +1,342 @@
+#include "systems/_mesh_simplifier.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <cstring>
+
+using namespace std;
+
+// Cuádrica del plano n·x + d = 0, con peso w
+static inline void AddPlane(double* a, double& w, const glm::vec3& n, float d, float weight)
+{
+  a[0] += weight * n.x * n.x;  a[1] += weight * n.x * n.y;  a[2] += weight * n.x * n.z;  a[3] += weight * n.x * d;
+  a[4] += weight * n.y * n.y;  a[5] += weight * n.y * n.z;  a[6] += weight * n.y * d;
+  a[7] += weight * n.z * n.z;  a[8] += weight * n.z * d;
+  a[9] += weight * d * d;
+
+  w += weight;
+}
+
+// Suma de distancias cuadráticas de p a los planos de las dos cuádricas, dividida por la suma de sus pesos
+static inline float Evaluate(const double* a, const double* b, double w, const glm::vec3& p)
+{
+  double q[10];
+  for(int i = 0; i < 10; i++)
+    q[i] = a[i] + b[i];
+
+  double x = p.x, y = p.y, z = p.z;
+  double e = q[0]*x*x + 2*q[1]*x*y + 2*q[2]*x*z + 2*q[3]*x
+           + q[4]*y*y + 2*q[5]*y*z + 2*q[6]*y
+           + q[7]*z*z + 2*q[8]*z
+           + q[9];
+
+  return (w > 0.0) ? (float)max(e / w, 0.0) : 0.f;
+}
+
+static inline Uint64 EdgeKey(uint a, uint b)
+{
+  return (a < b) ? ((Uint64)a << 32) | b : ((Uint64)b << 32) | a;
+}
+
+CMesh_Simplifier::CMesh_Simplifier(const vector<glm::vec3>& p, const vector<uint>& i): positions(p), indices(i), error(0.f)
+{
+  Weld();
+  InitQuadrics();
+}
+
+void CMesh_Simplifier::Weld()
+{
+  // Los vértices con la misma posición (bit a bit) son el mismo en la topología
+  uint n = positions.size();
+  weld.resize(n);
+
+  struct hash_t
+  {
+    size_t operator()(const glm::vec3& v) const
+    {
+      Uint32 h[3];
+      memcpy(h, &v, sizeof(h));
+      return (h[0] * 73856093u) ^ (h[1] * 19349663u) ^ (h[2] * 83492791u);
+    }
+  };
+
+  unordered_map<glm::vec3, uint, hash_t> first;
+  first.reserve(n);
+
+  for(uint v = 0; v < n; v++)
+  {
+    unordered_map<glm::vec3, uint, hash_t>::iterator it = first.find(positions[v]);
+    if(it == first.end())
+    {
+      first[positions[v]] = v;
+      weld[v] = v;
+    }
+    else
+      weld[v] = it->second;
+  }
+}
+
+void CMesh_Simplifier::InitQuadrics()
+{
+  uint n = positions.size();
+
+  quadric_t zero;
+  memset(&zero, 0, sizeof(zero));
+  quadrics.assign(n, zero);
+  locked.assign(n, false);
+
+  unordered_map<Uint64, uint> edges;
+  edges.reserve(indices.size());
+  for(uint t = 0; t < indices.size(); t += 3)
+    for(uint e = 0; e < 3; e++)
+      edges[EdgeKey(weld[indices[t + e]], weld[indices[t + (e + 1) % 3]])]++;
+
+  for(uint t = 0; t < indices.size(); t += 3)
+  {
+    uint v[3] = {weld[indices[t]], weld[indices[t + 1]], weld[indices[t + 2]]};
+
+    glm::vec3 normal = glm::cross(positions[v[1]] - positions[v[0]], positions[v[2]] - positions[v[0]]);
+    float area = glm::length(normal);
+    if(area <= 0.f)
+      continue;
+
+    normal /= area;
+    float d = -glm::dot(normal, positions[v[0]]);
+
+    for(uint c = 0; c < 3; c++)
+      AddPlane(quadrics[v[c]].a, quadrics[v[c]].w, normal, d, area * 0.5f);
+
+    // Bordes abiertos: plano perpendicular al triángulo que pasa por la arista, para que los vértices no se alejen de ella
+    for(uint e = 0; e < 3; e++)
+    {
+      uint a = v[e], b = v[(e + 1) % 3];
+      uint count = edges[EdgeKey(a, b)];
+
+      if(count > 2)
+        locked[a] = locked[b] = true;
+
+      if(count != 1)
+        continue;
+
+      glm::vec3 edge = positions[b] - positions[a];
+      glm::vec3 side = glm::cross(edge, normal);
+      float length = glm::length(side);
+      if(length <= 0.f)
+        continue;
+
+      side /= length;
+      float side_d = -glm::dot(side, positions[a]);
+      float weight = glm::length2(edge) * __MESH_SIMPLIFIER_BORDER_WEIGHT;
+
+      AddPlane(quadrics[a].a, quadrics[a].w, side, side_d, weight);
+      AddPlane(quadrics[b].a, quadrics[b].w, side, side_d, weight);
+    }
+  }
+}
+
+bool CMesh_Simplifier::CanCollapse(uint from, uint to, const vector<uint>& collapse)
+{
+  const glm::vec3& target = positions[to];
+
+  for(uint i = offsets[from]; i < offsets[from + 1]; i++)
+  {
+    uint t = adjacency[i];
+    uint v[3] = {weld[indices[t]], weld[indices[t + 1]], weld[indices[t + 2]]};
+
+    // Un vecino ya se mueve en esta pasada: la comprobación de abajo no valdría
+    if(collapse[v[0]] != (uint)-1 or collapse[v[1]] != (uint)-1 or collapse[v[2]] != (uint)-1)
+      return false;
+
+    // Los triángulos con la arista desaparecen
+    if(v[0] == to or v[1] == to or v[2] == to)
+      continue;
+
+    glm::vec3 p[3] = {positions[v[0]], positions[v[1]], positions[v[2]]};
+    glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+
+    for(uint c = 0; c < 3; c++)
+      if(v[c] == from)
+        p[c] = target;
+
+    glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+
+    float length2 = glm::length2(before) * glm::length2(after);
+    if(length2 <= 0.f or glm::dot(before, after) < __MESH_SIMPLIFIER_MIN_NORMAL_DOT * sqrt(length2))
+      return false;
+  }
+
+  return true;
+}
+
+bool CMesh_Simplifier::Pass(uint target_triangles)
+{
+  uint n = positions.size();
+  uint triangles = indices.size() / 3;
+
+  // Aristas de la topología actual: las de un solo triángulo son bordes abiertos
+  unordered_map<Uint64, uint> edges;
+  edges.reserve(indices.size());
+  for(uint t = 0; t < indices.size(); t += 3)
+    for(uint e = 0; e < 3; e++)
+      edges[EdgeKey(weld[indices[t + e]], weld[indices[t + (e + 1) % 3]])]++;
+
+  vector<bool> border(n, false);
+  for(unordered_map<Uint64, uint>::iterator it = edges.begin(); it != edges.end(); ++it)
+  {
+    uint a = (uint)(it->first >> 32), b = (uint)(it->first & 0xFFFFFFFF);
+
+    if(it->second == 1)
+      border[a] = border[b] = true;
+    else if(it->second > 2)
+      locked[a] = locked[b] = true;
+  }
+
+  // Triángulos de cada vértice
+  offsets.assign(n + 1, 0);
+  for(uint i = 0; i < indices.size(); i++)
+    offsets[weld[indices[i]] + 1]++;
+  for(uint v = 0; v < n; v++)
+    offsets[v + 1] += offsets[v];
+
+  adjacency.resize(indices.size());
+  vector<uint> fill(offsets.begin(), offsets.end() - 1);
+  for(uint i = 0; i < indices.size(); i++)
+    adjacency[fill[weld[indices[i]]]++] = i - i % 3;
+
+  // Candidatos, en los dos sentidos de cada arista
+  vector<collapse_t> candidates;
+  candidates.reserve(indices.size() * 2);
+
+  for(uint t = 0; t < indices.size(); t += 3)
+  {
+    for(uint e = 0; e < 3; e++)
+    {
+      uint a = weld[indices[t + e]], b = weld[indices[t + (e + 1) % 3]];
+      if(a == b)
+        continue;
+
+      bool border_edge = (edges[EdgeKey(a, b)] == 1);
+
+      for(uint s = 0; s < 2; s++)
+      {
+        uint from = s ? b : a;
+        uint to = s ? a : b;
+
+        // Los vértices del borde sólo se mueven por el borde
+        if(locked[from] or (border[from] and !border_edge))
+          continue;
+
+        collapse_t c;
+        c.from = from;
+        c.to = to;
+        c.cost = Evaluate(quadrics[from].a, quadrics[to].a, quadrics[from].w + quadrics[to].w, positions[to]);
+        candidates.push_back(c);
+      }
+    }
+  }
+
+  sort(candidates.begin(), candidates.end());
+
+  vector<uint> collapse(n, (uint)-1);
+  vector<bool> touched(n, false);
+  uint removed = 0;
+  uint collapses = 0;
+
+  for(vector<collapse_t>::iterator it = candidates.begin(); it != candidates.end() and triangles - removed > target_triangles; ++it)
+  {
+    if(touched[it->from] or touched[it->to] or !CanCollapse(it->from, it->to, collapse))
+      continue;
+
+    collapse[it->from] = it->to;
+    collapses++;
+    error = max(error, it->cost);
+
+    // Nadie más toca la vecindad del vértice en esta pasada
+    for(uint i = offsets[it->from]; i < offsets[it->from + 1]; i++)
+    {
+      uint t = adjacency[i];
+      bool shared = false;
+
+      for(uint c = 0; c < 3; c++)
+      {
+        uint v = weld[indices[t + c]];
+        touched[v] = true;
+        shared = shared or (v == it->to);
+      }
+
+      if(shared)
+        removed++;
+    }
+  }
+
+  if(!collapses)
+    return false;
+
+  // Cada vértice colapsado pasa al vértice del destino con el que comparte un triángulo (así conserva la normal y las UV de su lado de la costura)
+  vector<uint> target(n, (uint)-1);
+  for(uint t = 0; t < indices.size(); t += 3)
+  {
+    for(uint c = 0; c < 3; c++)
+    {
+      uint x = indices[t + c];
+      if(collapse[weld[x]] == (uint)-1 or target[x] != (uint)-1)
+        continue;
+
+      for(uint o = 1; o < 3; o++)
+      {
+        uint y = indices[t + (c + o) % 3];
+        if(weld[y] == collapse[weld[x]])
+        {
+          target[x] = y;
+          break;
+        }
+      }
+    }
+  }
+
+  uint out = 0;
+  for(uint t = 0; t < indices.size(); t += 3)
+  {
+    uint v[3];
+    for(uint c = 0; c < 3; c++)
+    {
+      uint x = indices[t + c];
+      if(collapse[weld[x]] != (uint)-1)
+        x = (target[x] != (uint)-1) ? target[x] : collapse[weld[x]];
+
+      v[c] = x;
+    }
+
+    // Triángulos sin área en la topología
+    if(weld[v[0]] == weld[v[1]] or weld[v[1]] == weld[v[2]] or weld[v[0]] == weld[v[2]])
+      continue;
+
+    indices[out++] = v[0];
+    indices[out++] = v[1];
+    indices[out++] = v[2];
+  }
+  indices.resize(out);
+
+  for(uint v = 0; v < n; v++)
+  {
+    if(collapse[v] == (uint)-1)
+      continue;
+
+    quadric_t& q = quadrics[collapse[v]];
+    for(uint i = 0; i < 10; i++)
+      q.a[i] += quadrics[v].a[i];
+    q.w += quadrics[v].w;
+  }
+
+  return true;
+}
+
+float CMesh_Simplifier::Simplify(uint target_triangles, vector<uint>& out)
+{
+  while(indices.size() / 3 > target_triangles)
+    if(!Pass(target_triangles))
+      break;
+
+  out = indices;
+  return sqrt(error);
+}
@@ -0,0 +1,214 @@
+#include "systems/_occlusion.h"
+#include "systems/_shader.h"
+#include "systems/_gl_state.h"
+#include "systems/_debug.h"
+
+#include <cstring>
+
+using namespace std;
+
+GLuint COcclusion_Culling::m_BoxVBOVertices = 0;
+GLuint COcclusion_Culling::m_BoxVAO = 0;
+
+bool COcclusion_Culling::InitRenderVBO()
+{
+  // Cubo unidad, de (0, 0, 0) a (1, 1, 1), en triángulos
+  const GLfloat box_vertices[][3]
+  {
+    {0.f, 0.f, 0.f}, {1.f, 0.f, 0.f}, {1.f, 1.f, 0.f}, {0.f, 0.f, 0.f}, {1.f, 1.f, 0.f}, {0.f, 1.f, 0.f},
+    {0.f, 0.f, 1.f}, {1.f, 1.f, 1.f}, {1.f, 0.f, 1.f}, {0.f, 0.f, 1.f}, {0.f, 1.f, 1.f}, {1.f, 1.f, 1.f},
+    {0.f, 0.f, 0.f}, {0.f, 1.f, 1.f}, {0.f, 0.f, 1.f}, {0.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, 1.f, 1.f},
+    {1.f, 0.f, 0.f}, {1.f, 0.f, 1.f}, {1.f, 1.f, 1.f}, {1.f, 0.f, 0.f}, {1.f, 1.f, 1.f}, {1.f, 1.f, 0.f},
+    {0.f, 0.f, 0.f}, {0.f, 0.f, 1.f}, {1.f, 0.f, 1.f}, {0.f, 0.f, 0.f}, {1.f, 0.f, 1.f}, {1.f, 0.f, 0.f},
+    {0.f, 1.f, 0.f}, {1.f, 1.f, 1.f}, {0.f, 1.f, 1.f}, {0.f, 1.f, 0.f}, {1.f, 1.f, 0.f}, {1.f, 1.f, 1.f}
+  };
+
+  glGenVertexArrays(1, &m_BoxVAO);
+  if(!m_BoxVAO)
+  {
+    gSystem_Debug.error("From COcclusion_Culling: Could not generate box VAO.");
+    return false;
+  }
+
+  glGenBuffers(1, &m_BoxVBOVertices);
+  if(!m_BoxVBOVertices)
+  {
+    gSystem_Debug.error("From COcclusion_Culling: Could not generate box VBO.");
+    return false;
+  }
+
+  gSystem_GL_State.BindVertexArray(m_BoxVAO);
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_BoxVBOVertices);
+  glBufferData(GL_ARRAY_BUFFER, 36*3*sizeof(GLfloat), box_vertices, GL_STATIC_DRAW);
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+  glEnableVertexAttribArray(0);
+
+  gSystem_GL_State.BindVertexArray(0);
+
+  return true;
+}
+
+void COcclusion_Culling::CloseRenderVBO()
+{
+  glDeleteBuffers(1, &m_BoxVBOVertices);
+
+  gSystem_GL_State.VertexArrayDeleted(m_BoxVAO);
+  glDeleteVertexArrays(1, &m_BoxVAO);
+
+  m_BoxVBOVertices = m_BoxVAO = 0;
+}
+
+void COcclusion_Culling::Clear()
+{
+  for(map<gameObject_handle_t, entry_t>::iterator it = entries.begin(); it != entries.end(); ++it)
+    if(it->second.query)
+      glDeleteQueries(1, &it->second.query);
+
+  entries.clear();
+}
+
+void COcclusion_Culling::SetOwner(const void* o)
+{
+  if(o == owner)
+    return;
+
+  Clear();
+  ClearStats();
+  owner = o;
+}
+
+void COcclusion_Culling::ClearStats()
+{
+  memset(&stats, 0, sizeof(stats));
+  memset(&last_stats, 0, sizeof(last_stats));
+}
+
+void COcclusion_Culling::BeginFrame()
+{
+  frame++;
+
+  last_stats = stats;
+  memset(&stats, 0, sizeof(stats));
+
+  for(map<gameObject_handle_t, entry_t>::iterator it = entries.begin(); it != entries.end(); )
+  {
+    entry_t& entry = it->second;
+
+    if(entry.pending)
+    {
+      // Sin esperar: si la GPU aún no ha llegado a la consulta, se mantiene el resultado anterior
+      GLuint available = GL_FALSE;
+      glGetQueryObjectuiv(entry.query, GL_QUERY_RESULT_AVAILABLE, &available);
+
+      if(available)
+      {
+        GLuint passed = GL_FALSE;
+        glGetQueryObjectuiv(entry.query, GL_QUERY_RESULT, &passed);
+
+        entry.visible = (passed != GL_FALSE);
+        entry.pending = false;
+      }
+    }
+
+    // Objetos que ya no se dibujan con esta cámara (o que ya no existen)
+    if(frame - entry.last_frame > __OCCLUSION_MAX_UNSEEN)
+    {
+      if(entry.query)
+        glDeleteQueries(1, &entry.query);
+
+      entries.erase(it++);
+    }
+    else
+      ++it;
+  }
+}
+
+bool COcclusion_Culling::Visible(const gameObject_handle_t& key)
+{
+  stats.tested++;
+
+  map<gameObject_handle_t, entry_t>::iterator it = entries.find(key);
+  if(it == entries.end())
+    return true;
+
+  // El resultado sólo vale si el objeto se comprobó en la iteración anterior: si no, la cámara o el objeto pueden haberse movido mucho
+  entry_t& entry = it->second;
+  bool stale = (entry.last_frame + 1 != frame);
+  entry.last_frame = frame;
+
+  if(stale or entry.visible)
+    return true;
+
+  stats.occluded++;
+  return false;
+}
+
+void COcclusion_Culling::BeginQueries(const glm::mat4& projMatrix)
+{
+  CShader* shader = gSystem_Shader_Manager.GetShader("__flatShader");
+  gSystem_GL_State.UseProgram(shader->GetProgram());
+  glUniformMatrix4fv(shader->GetUniform(Shader::proj_matrix), 1, GL_FALSE, glm::value_ptr(projMatrix));
+  box_modelview = shader->GetUniform(Shader::modelview_matrix);
+
+  // Las cajas no cambian la imagen ni el depth buffer; sólo cuentan fragmentos
+  glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+  gSystem_GL_State.DepthMask(false);
+
+  // La cámara puede estar dentro de la caja de un objeto oculto: se cuentan también las caras traseras
+  cull_face = glIsEnabled(GL_CULL_FACE);
+  gSystem_GL_State.Disable(GL_CULL_FACE);
+
+  gSystem_GL_State.BindVertexArray(m_BoxVAO);
+}
+
+void COcclusion_Culling::Query(const gameObject_handle_t& key, const glm::mat4& modelViewMatrix, const Culling::aabb_t& box, const glm::mat4& projMatrix)
+{
+  entry_t& entry = entries[key];
+  if(!entry.query)
+  {
+    glGenQueries(1, &entry.query);
+    entry.visible = true;
+    entry.pending = false;
+  }
+
+  entry.last_frame = frame;
+
+  // Aún no ha llegado el resultado de la última
+  if(entry.pending or box.Empty())
+    return;
+
+  glm::vec3 margin = box.Extents() * __OCCLUSION_BOX_MARGIN + glm::vec3(1e-4f);
+  glm::vec3 box_min = box.min - margin;
+  glm::vec3 box_max = box.max + margin;
+
+  // Plano cercano en espacio de vista (z negativa), a partir de la proyección: vale para perspectiva y ortográfica
+  float near_z = -(projMatrix[3][2] + projMatrix[3][3]) / (projMatrix[2][2] + projMatrix[2][3]);
+  if(Culling::aabb_t(box_min, box_max).Transform(modelViewMatrix).max.z >= near_z)
+  {
+    entry.visible = true;
+    stats.near_plane++;
+    return;
+  }
+
+  glm::mat4 box_matrix = glm::scale(glm::translate(modelViewMatrix, box_min), box_max - box_min);
+  glUniformMatrix4fv(box_modelview, 1, GL_FALSE, glm::value_ptr(box_matrix));
+
+  glBeginQuery(GL_ANY_SAMPLES_PASSED, entry.query);
+  glDrawArrays(GL_TRIANGLES, 0, 36);
+  glEndQuery(GL_ANY_SAMPLES_PASSED);
+
+  entry.pending = true;
+  stats.queries++;
+}
+
+void COcclusion_Culling::EndQueries()
+{
+  glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  gSystem_GL_State.DepthMask(true);
+
+  if(cull_face)
+    gSystem_GL_State.Enable(GL_CULL_FACE);
+
+  gSystem_GL_State.BindVertexArray(0);
+}
@@ -2,6 +2,7 @@
 
 #include "components/_component_camera.h"
 #include "components/_component_transform.h"
+#include "components/_component_mesh_render.h"
 
 #include "systems/_render.h"
 #include "systems/_debug.h"
@@ -9,6 +10,10 @@
 #include "systems/_manager.h"
 #include "systems/_resource.h"
 #include "systems/_shader.h"
+#include "systems/_gl_state.h"
+#include "systems/_stream_buffer.h"
+#include "systems/_spatial.h"
+#include "systems/_jobs.h"
 
 #include "engine/_engine.h"
 
@@ -147,6 +152,9 @@ bool CSystem_Render::Init()
     return false;
   }
 
+  // A partir de aquí, el estado de OpenGL se cambia a través de la caché
+  gSystem_GL_State.Init();
+
   // ->PorHacer Hay que tener en cuenta los detalles de la compatibilidad de opengl (y extensiones de GLEW).
   if (!GLEW_ARB_instanced_arrays)
   {
@@ -154,6 +162,21 @@ bool CSystem_Render::Init()
     return false;
   }
 
+  // Los shaders por defecto leen la proyección de la cámara de un uniform block (véase __SHADER_CAMERA_BLOCK)
+  if(!GLEW_ARB_uniform_buffer_object)
+  {
+    gSystem_Debug.error("From CSystem_Render: GLEW error: GL_ARB_uniform_buffer_object NOT supported!");
+    return false;
+  }
+
+  // Sin GL_ANY_SAMPLES_PASSED no hay descarte por oclusión: las cámaras que lo piden dibujan todo
+  if(!COcclusion_Culling::Supported())
+    gSystem_Debug.log("From CSystem_Render: GL_ARB_occlusion_query2 NOT supported, occlusion culling disabled.");
+
+  // Los modelos de un CMesh_Buffer se dibujan con glDrawElementsBaseVertex(): sin él, cada modelo tiene sus propios buffers
+  if(!GLEW_ARB_draw_elements_base_vertex and gSystem_Data_Storage.GetInt("__RENDER_SHARED_MESH_BUFFERS"))
+    gSystem_Debug.log("From CSystem_Render: GL_ARB_draw_elements_base_vertex NOT supported, shared mesh buffers disabled.");
+
   /*if(!glewIsSupported("GL_multitexture"))
   {
     gSystem_Debug.error("From CSystem_Render: GLEW error: GL_multitexture NOT supported!");
@@ -166,6 +189,9 @@ bool CSystem_Render::Init()
     return false;
   }*/
 
+  // Buffer circular para los vértices que cambian en cada iteración (partículas, GUI, instancias)
+  if(!gSystem_Stream_Buffer.Init()) return false;
+
   if(!InitSkyboxVBO() or !InitGridVBO()) return false;
 
   current_camera = -1;
@@ -186,6 +212,7 @@ bool CSystem_Render::Init()
 
   // Other renders
   if(!CComponent_Transform::InitRenderVBO() or !CComponent_Particle_Emitter::InitRenderVBO() or !CComponent_GUI_Texture::InitRenderVBO()) return false;
+  if(!COcclusion_Culling::InitRenderVBO()) return false;
 
   CSystem::Init();
 
@@ -265,7 +292,7 @@ bool CSystem_Render::InitSkyboxVBO()
     return false;
   }
 
-  glBindVertexArray(m_SkyboxVAO);
+  gSystem_GL_State.BindVertexArray(m_SkyboxVAO);
 
   glBindBuffer( GL_ARRAY_BUFFER, m_SkyboxVBOVertices );
   glBufferData( GL_ARRAY_BUFFER, m_nSkyboxVertexCount*3*sizeof(GLfloat), m_pVertices, GL_STATIC_DRAW );
@@ -289,6 +316,7 @@ bool CSystem_Render::InitGridVBO()
   //glBindVertexArray(m_GridVAO);
 
   m_GridVBOVertices = m_GridVBOColors = m_GridVAO = 0;
+  m_GridVBO_size = 0;
 
   glGenBuffers( 1, &m_GridVBOVertices );
   glGenBuffers( 1, &m_GridVBOColors );
@@ -355,14 +383,22 @@ void CSystem_Render::UpdateGridVBO(int ncols, int nrows)
       }
     }
 
-    glBindVertexArray(m_GridVAO);
+    gSystem_GL_State.BindVertexArray(m_GridVAO);
+
+    // La rejilla sólo cambia con las opciones, así que no pasa por el buffer circular: si cabe, se sobrescribe sin volver a reservar
+    GLsizeiptr size = nLines*2*3*sizeof(GLfloat);
+    bool realloc = (size > m_GridVBO_size);
+    if(realloc)
+      m_GridVBO_size = size;
 
     glBindBuffer( GL_ARRAY_BUFFER, m_GridVBOVertices );
-    glBufferData( GL_ARRAY_BUFFER, nLines*2*3*sizeof(GLfloat), pVertices, GL_DYNAMIC_DRAW );
+    if(realloc) glBufferData( GL_ARRAY_BUFFER, size, pVertices, GL_DYNAMIC_DRAW );
+    else        glBufferSubData( GL_ARRAY_BUFFER, 0, size, pVertices );
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
 
     glBindBuffer( GL_ARRAY_BUFFER, m_GridVBOColors );
-    glBufferData( GL_ARRAY_BUFFER, nLines*2*3*sizeof(GLfloat), pColors, GL_DYNAMIC_DRAW );
+    if(realloc) glBufferData( GL_ARRAY_BUFFER, size, pColors, GL_DYNAMIC_DRAW );
+    else        glBufferSubData( GL_ARRAY_BUFFER, 0, size, pColors );
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
   }
 }
@@ -372,6 +408,9 @@ void CSystem_Render::Close()
   if(!enabled) return;
   CSystem::Close();
 
+  // El resto se cierra con el contexto en este hilo
+  StopPipeline();
+
   //Destroy VBOs
   glDeleteBuffers(1, &m_SkyboxVBOTexCoords);
   glDeleteBuffers(1, &m_SkyboxVBOVertices);
@@ -381,24 +420,54 @@ void CSystem_Render::Close()
   glDeleteBuffers(1, &m_GridVBOColors);
   glDeleteVertexArrays(1, &m_GridVAO);
 
+  render_queue.Close();
+
+  for(uint f = 0; f < 2; f++)
+  {
+    for(vector<camera_record_t*>::iterator it = frames[f].cameras.begin(); it != frames[f].cameras.end(); ++it)
+    {
+      for(vector<CRender_Queue*>::iterator it2 = (*it)->chunks.begin(); it2 != (*it)->chunks.end(); ++it2)
+      {
+        (*it2)->Close();
+        delete (*it2);
+      }
+
+      delete (*it);
+    }
+
+    frames[f].cameras.clear();
+    frames[f].gui_textures.clear();
+    frames[f].gui.clear();
+  }
+
+  for(vector<COcclusion_Culling*>::iterator it = occlusion_culling.begin(); it != occlusion_culling.end(); ++it)
+    delete (*it);
+  occlusion_culling.clear();
+
   // Other renders
   CComponent_Transform::CloseRenderVBO();
   CComponent_Particle_Emitter::CloseRenderVBO();
   CComponent_GUI_Texture::CloseRenderVBO();
+  COcclusion_Culling::CloseRenderVBO();
 
   CSystem::Close();
 
   gluDeleteQuadric(quadratic);
 
+  gSystem_Stream_Buffer.Close();
+  gSystem_GL_State.Close();
+
   SDL_GL_DeleteContext(GLcontext);
   SDL_DestroyWindow(window);
 
   camera_list.clear();
 }
 
-// En principio, solo hay que liberar las cmaras.
-// ->NOTA estara bien aadir una opcin para que CSystem_Render::Reset() reiniciase la ventana, no solo las cmaras.
+// En principio, solo hay que liberar las cámaras.
+// ->NOTA estaría bien añadir una opción para que CSystem_Render::Reset() reiniciase la ventana, no solo las cámaras.
 bool CSystem_Render::Reset() {
+  StopPipeline();
+
   for(vector<CGameObject*>::iterator it = camera_list.begin(); it != camera_list.end(); ) {
     if(!(*it)->IsPreserved())
       camera_list.erase(it);
@@ -426,7 +495,7 @@ void CSystem_Render::SetMainCamera(const std::string& camera)
   if(!cam)
     return;
 
-  // ?
+  // ¿?
   vector<CGameObject*>::iterator it = camera_list.begin();
   camera_list.insert(it, cam);
   cam->Camera()->ApplyChanges();
@@ -498,80 +567,317 @@ void CSystem_Render::OnLoop()
     //gSystem_Debug.msg_box(debug::error, ERROR_RENDER, "From CSystem_Render: OpenGL error: %s", gluErrorString(error) );
     gSystem_Debug.console_error_msg("From CSystem_Render: OpenGL error %d: %s", error, gluErrorString(error));
   }*/
+
+  // El contexto está en el hilo de render
+  if(Pipelined())
+    return;
+
   __GL_CHECK_ERRORS();
 }
 
+void CSystem_Render::SetUpFrame(frame_t* frame)
+{
+  frame->queue = gSystem_Data_Storage.GetInt("__RENDER_QUEUE");
+  frame->instancing = gSystem_Data_Storage.GetInt("__RENDER_INSTANCING");
+  frame->width = gSystem_Data_Storage.GetInt("__RENDER_RESOLUTION_WIDTH");
+  frame->height = gSystem_Data_Storage.GetInt("__RENDER_RESOLUTION_HEIGHT");
+
+  frame->grid = gSystem_Data_Storage.GetInt("__RENDER_TRANSFORM_GRID");
+  frame->grid_cols = gSystem_Data_Storage.GetInt("__RENDER_TRANSFORM_GRID_COLS");
+  frame->grid_rows = gSystem_Data_Storage.GetInt("__RENDER_TRANSFORM_GRID_ROWS");
+  frame->grid_cols_scale = gSystem_Data_Storage.GetFloat("__RENDER_TRANSFORM_GRID_COLS_SCALE");
+  frame->grid_rows_scale = gSystem_Data_Storage.GetFloat("__RENDER_TRANSFORM_GRID_ROWS_SCALE");
+
+  while(frame->cameras.size() < camera_list.size())
+    frame->cameras.push_back(new camera_record_t);
+
+  for(uint i = 0; i < frame->cameras.size(); i++)
+  {
+    frame->cameras[i]->draw = frame->cameras[i]->recorded = false;
+    frame->cameras[i]->index = i;
+  }
+}
+
+void CSystem_Render::SetUpRecord(camera_record_t* record, CComponent_Camera* cam, bool culling, bool parallel)
+{
+  record->camera = cam;
+  record->draw = true;
+  record->projMatrix = cam->projMatrix;
+  record->modelViewMatrix = cam->modelViewMatrix;
+  record->normalMatrix = cam->NormalMatrix();
+
+  // Frustum en espacio de mundo: vale para perspectiva, ortho y ortho_screen, ya que sale de la propia matriz de proyección
+  record->frustum = Culling::frustum_t(cam->projMatrix * cam->modelViewMatrix);
+  record->culling = culling;
+  record->parallel = parallel;
+  record->occlusion = cam->occlusion_culling;
+  record->lod_height = cam->viewport.height * gSystem_Data_Storage.GetInt("__RENDER_RESOLUTION_HEIGHT");
+  record->lod_error = gSystem_Data_Storage.GetInt("__RENDER_LOD") ? gSystem_Data_Storage.GetFloat("__RENDER_LOD_PIXEL_ERROR") : 0.f;
+
+  record->viewport = cam->viewport;
+  record->clear = cam->clear;
+  record->background_color = cam->background_color;
+  record->skybox_texture = (cam->skybox_texture != "") ? gSystem_Resources.GetTexture(cam->skybox_texture)->GetID() : 0;
+  record->position = cam->gameObject->Transform()->Position().to_glm();
+}
+
+void CSystem_Render::SetUpGUI(frame_t* frame)
+{
+  CComponent_Camera* cam = GUI_Camera->Camera();
+  cam->SetUp();
+
+  frame->gui_viewport = cam->viewport;
+  frame->gui_projMatrix = cam->projMatrix;
+  frame->gui_modelViewMatrix = cam->modelViewMatrix;
+  frame->gui_normalMatrix = cam->NormalMatrix();
+
+  frame->gui.clear();
+  for(vector<CComponent_GUI_Texture*>::iterator it = frame->gui_textures.begin(); it != frame->gui_textures.end(); ++it)
+  {
+    CComponent_GUI_Texture::draw_t draw;
+    if((*it)->gameObject->enabled and (*it)->GetDraw(frame->gui_modelViewMatrix, draw))
+      frame->gui.push_back(draw);
+  }
+}
+
+void CSystem_Render::PrepareRecord()
+{
+  CComponent_Transform::UpdateWorldMatrices();
+
+  // Sólo recalcula los volúmenes cuyo modelo o matriz de mundo han cambiado
+  CComponent_Pool<CComponent_Mesh_Render>& mesh_renders = CComponent_Mesh_Render::Pool();
+  for(uint i = 0; i < mesh_renders.Capacity(); i++)
+  {
+    CComponent_Mesh_Render* mesh_render = mesh_renders.At(i);
+    if(mesh_render and mesh_render->GetGameObject() and mesh_render->GetGameObject()->Transform())
+      mesh_render->WorldBounds();
+  }
+}
+
+void CSystem_Render::RecordCamera(void* data, uint begin, uint end)
+{
+  camera_record_t* record = (camera_record_t*)data;
+
+  // Con culling, sólo se recorren los objetos que el índice espacial encuentra dentro del frustum (más los que no tienen volumen)
+  record->objects = &gSystem_GameObject_Manager.gameObjects;
+  if(record->culling)
+  {
+    record->visible.clear();
+    gSystem_Spatial.QueryVisible(record->frustum, record->visible);
+    record->objects = &record->visible;
+  }
+
+  uint count = record->objects->size();
+  record->num_chunks = (count + __RENDER_RECORD_CHUNK - 1) / __RENDER_RECORD_CHUNK;
+
+  while(record->chunks.size() < record->num_chunks)
+    record->chunks.push_back(new CRender_Queue);
+
+  if(record->parallel)
+    gSystem_Jobs.ParallelFor(&CSystem_Render::RecordChunk, record, 0, count, __RENDER_RECORD_CHUNK);
+  else
+    RecordChunk(record, 0, count);
+}
+
+void CSystem_Render::RecordChunk(void* data, uint begin, uint end)
+{
+  camera_record_t* record = (camera_record_t*)data;
+  const Culling::frustum_t* culling = record->culling ? &record->frustum : NULL;
+
+  // ParallelFor() puede juntar varios bloques en una sola llamada (con un solo hilo, todos)
+  for(uint first = begin; first < end; first += __RENDER_RECORD_CHUNK)
+  {
+    uint last = min(first + __RENDER_RECORD_CHUNK, end);
+
+    CRender_Queue* queue = record->chunks[first / __RENDER_RECORD_CHUNK];
+    queue->Clear();
+    queue->SetView(record->index, record->projMatrix, record->lod_height, record->lod_error);
+
+    for(uint i = first; i < last; i++)
+    {
+      CGameObject* go = (*record->objects)[i];
+
+      // Sólo se lee la caché: varios bloques y cámaras comparten los mismos padres (véase PrepareRecord())
+      glm::mat4 local_modelViewMatrix = record->modelViewMatrix * go->Transform()->CachedWorldMatrix();
+      go->OnRender(record->projMatrix, local_modelViewMatrix, culling, queue);
+    }
+  }
+}
+
+void CSystem_Render::CollectGUI(void* data, uint begin, uint end)
+{
+  frame_t* frame = (frame_t*)data;
+
+  // La GUI no depende de las cámaras, así que no pasa por el índice espacial
+  for(vector<CGameObject*>::iterator it = gSystem_GameObject_Manager.gameObjects.begin(); it != gSystem_GameObject_Manager.gameObjects.end(); ++it)
+  {
+    //CComponent_GUI_Font* gui_font = (*it)->GetComponent<CComponent_GUI_Font>();
+    CComponent_GUI_Texture* gui_texture = (*it)->GetComponent<CComponent_GUI_Texture>();
+
+    if(gui_texture)
+      frame->gui_textures.push_back(gui_texture);
+    //if(gui_font)
+      //gui_textures.push_back(gui_font);
+  }
+}
+
+bool CSystem_Render::CanPipeline(frame_t* frame)
+{
+  for(uint i = 0; i < camera_list.size(); i++)
+  {
+    camera_record_t* record = frame->cameras[i];
+    if(!camera_list[i]->IsEnabled())
+      continue;
+
+    // Las cámaras con callbacks se graban al llegar su turno
+    if(!record->recorded)
+      return false;
+
+    for(uint c = 0; c < record->num_chunks; c++)
+      if(record->chunks[c]->HasCallbacks())
+        return false;
+  }
+
+  return true;
+}
+
 void CSystem_Render::OnRender()
 {
-  Clear();
+  frame_t* frame = &frames[current_frame];
+  SetUpFrame(frame);
 
   current_camera = 0;
-  // Usar un vector para guardar los objetos GUI que se vayan encontrando en la primera iteracin.
-  // vector<CGameObject*> gui_texts;
-  vector<CComponent_GUI_Texture*> gui_textures;
 
-  for(vector<CGameObject*>::iterator it = camera_list.begin(); it < camera_list.end(); ++it)
+  bool culling = gSystem_Data_Storage.GetInt("__RENDER_FRUSTUM_CULLING");
+  bool parallel = frame->queue and gSystem_Data_Storage.GetInt("__RENDER_PARALLEL_RECORDING");
+
+  // Los dibujos de depuración y la consola leen la escena y usan OpenGL desde el hilo principal
+  bool pipelined = frame->queue and gSystem_Data_Storage.GetInt("__RENDER_PIPELINED") and !gSystem_Debug.IsConsole()
+                   and !gSystem_Data_Storage.GetInt("__RENDER_SOUND_RADIUS") and !gSystem_Data_Storage.GetInt("__RENDER_TRANSFORM");
+
+  job_counter_t counter;
+  SDL_AtomicSet(&counter, 0);
+
+  PrepareRecord();
+
+  // Usar un vector para guardar los objetos GUI que se vayan encontrando en la primera iteración.
+  frame->gui_textures.clear();
+  if(!camera_list.empty() and camera_list[0]->IsEnabled())
   {
-    // Disabled camera
-    if(!(*it)->IsEnabled())
-      continue;
+    if(parallel)
+      gSystem_Jobs.Run(&CSystem_Render::CollectGUI, frame, 0, 0, &counter);
+    else
+      CollectGUI(frame, 0, 0);
+  }
 
-    CComponent_Camera* cam = (*it)->GetComponent<CComponent_Camera>();
+  // Grabar antes de dibujar todas las cámaras que no tienen callbacks: sus matrices no cambian hasta que se dibujan.
+  // Las que los tienen se graban al llegar su turno, después de before_render, que puede mover la escena
+  for(uint i = 0; i < camera_list.size(); i++)
+  {
+    CComponent_Camera* cam = camera_list[i]->GetComponent<CComponent_Camera>();
+    if(!(parallel or pipelined) or !camera_list[i]->IsEnabled() or cam->before_render or cam->after_render)
+      continue;
 
-    cam->BeforeRender();
-    cam->SetViewport();
+    current_camera = i;
     cam->SetUp();
-    cam->Clear();
 
-    //glm::mat4& projMatrix = cam->projMatrix;
+    SetUpRecord(frame->cameras[i], cam, culling, parallel);
+    frame->cameras[i]->recorded = true;
+  }
 
+  // SetUp() puede recalcular transformaciones, así que no se lanza ninguna tarea hasta tener todas las cámaras preparadas
+  for(uint i = 0; i < camera_list.size(); i++)
+  {
+    if(!frame->cameras[i]->recorded)
+      continue;
 
-    // Draw Skybox
-    RenderSkybox(cam);
-    if(gSystem_Data_Storage.GetInt("__RENDER_TRANSFORM_GRID") )
-      RenderGrid(cam);
+    if(parallel)
+      gSystem_Jobs.Run(&CSystem_Render::RecordCamera, frame->cameras[i], 0, 0, &counter);
+    else
+      RecordCamera(frame->cameras[i], 0, 0);
+  }
 
-    /*glMatrixMode(GL_PROJECTION);
-    glLoadMatrixf( glm::value_ptr(cam->projMatrix) );
+  // Ningún callback de usuario se ejecuta mientras haya tareas grabando
+  gSystem_Jobs.Wait(&counter);
 
-    glMatrixMode(GL_MODELVIEW);
-    glLoadMatrixf(glm::value_ptr(cam->modelViewMatrix));*/
+  // Toda la iteración está en "frame": el hilo de render la dibuja mientras la simulación sigue con la siguiente
+  if(pipelined and CanPipeline(frame) and (Pipelined() or StartPipeline()))
+  {
+    current_camera = -1;
+    SetUpGUI(frame);
 
-	  for(map<string, CGameObject*>::iterator it2 = gSystem_GameObject_Manager.gameObjects.begin(); it2 != gSystem_GameObject_Manager.gameObjects.end(); it2++)
-	  {
-      //glColor3f(1.f, 1.f, 1.f);
-      glBindTexture(GL_TEXTURE_2D, 0);
+    Publish(frame);
+    current_frame = 1 - current_frame;
 
-      glm::mat4 local_modelViewMatrix = it2->second->Transform()->ApplyTransform(cam->modelViewMatrix);
-	    it2->second->OnRender(cam->projMatrix, local_modelViewMatrix);
+    return;
+  }
 
-	    //CComponent_GUI_Font* gui_font = it2->second->GetComponent<CComponent_GUI_Font>();
-	    CComponent_GUI_Texture* gui_texture = it2->second->GetComponent<CComponent_GUI_Texture>();
+  // Los callbacks y la consola usan OpenGL, así que necesitan el contexto en este hilo
+  StopPipeline();
 
-	    if(current_camera == 0 && gui_texture)
-	      gui_textures.push_back(gui_texture);
-      //if(current_camera == 0 && gui_font)
-        //gui_textures.push_back(gui_font);
-	  }
+  gSystem_GL_State.OnFrame();
+
+  Clear(frame);
+
+  for(vector<CGameObject*>::iterator it = camera_list.begin(); it < camera_list.end(); ++it)
+  {
+    // Las cámaras desactivadas también cuentan, para que GetCurrentCamera() devuelva la que se está dibujando
+    current_camera = it - camera_list.begin();
+
+    // Disabled camera
+    if(!(*it)->IsEnabled())
+      continue;
+
+    CComponent_Camera* cam = (*it)->GetComponent<CComponent_Camera>();
+    camera_record_t* record = frame->cameras[current_camera];
+
+    if(!record->recorded)
+    {
+      cam->BeforeRender();
+      cam->SetUp();
+
+      // before_render puede haber movido la escena
+      PrepareRecord();
+
+      SetUpRecord(record, cam, culling, parallel);
+      if(frame->queue)
+        RecordCamera(record, 0, 0);
+      else
+      {
+        // Sin la cola, los objetos se dibujan según se recorren
+        record->objects = &gSystem_GameObject_Manager.gameObjects;
+        if(culling)
+        {
+          record->visible.clear();
+          gSystem_Spatial.QueryVisible(record->frustum, record->visible);
+          record->objects = &record->visible;
+        }
+      }
+    }
+
+    DrawCamera(frame, record);
 
 	  // Other renders
     if(gSystem_Data_Storage.GetInt("__RENDER_SOUND_RADIUS"))
     {
       glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-      glBindTexture(GL_TEXTURE_2D, 0);
+      gSystem_GL_State.BindTexture(GL_TEXTURE_2D, 0);
 
       CShader* simpleShader = gSystem_Shader_Manager.UseShader("__simpleGLUShader");
-      glUniformMatrix4fv(simpleShader->GetUniformIndex("ProjMatrix") , 1, GL_FALSE, glm::value_ptr(cam->projMatrix));
-      glUniform4f(simpleShader->GetUniformIndex("in_Color"), 1.0, 1.0, 0.0, 1.0);
+      glUniformMatrix4fv(simpleShader->GetUniform(Shader::proj_matrix) , 1, GL_FALSE, glm::value_ptr(cam->projMatrix));
+      glUniform4f(simpleShader->GetUniform(Shader::color), 1.0, 1.0, 0.0, 1.0);
 
-      for(map<string, CGameObject*>::iterator it2 = gSystem_GameObject_Manager.gameObjects.begin(); it2 != gSystem_GameObject_Manager.gameObjects.end(); it2++)
+      // Se recorre el pool de fuentes de audio en vez de todos los objetos
+      CComponent_Pool<CComponent_Audio_Source>& audio_sources = CComponent_Audio_Source::Pool();
+      for(uint i = 0; i < audio_sources.Capacity(); i++)
       {
-        if(it2->second->GetComponent<CComponent_Audio_Source>())
-        {
-          glm::mat4 local_modelViewMatrix = it2->second->Transform()->ApplyTransform(cam->modelViewMatrix);
-          glUniformMatrix4fv(simpleShader->GetUniformIndex("ModelViewMatrix") , 1, GL_FALSE, glm::value_ptr(local_modelViewMatrix));
-          it2->second->AudioSource()->OnRender(cam->projMatrix, cam->modelViewMatrix);
-        }
+        CComponent_Audio_Source* source = audio_sources.At(i);
+        if(!source or !source->GetGameObject() or source->GetGameObject()->GetID() < 0)
+          continue;
+
+        glm::mat4 local_modelViewMatrix = source->GetGameObject()->Transform()->ApplyTransform(cam->modelViewMatrix);
+        glUniformMatrix4fv(simpleShader->GetUniform(Shader::modelview_matrix) , 1, GL_FALSE, glm::value_ptr(local_modelViewMatrix));
+        source->OnRender(cam->projMatrix, cam->modelViewMatrix);
       }
 
       glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
@@ -580,79 +886,290 @@ void CSystem_Render::OnRender()
 	  if(gSystem_Data_Storage.GetInt("__RENDER_TRANSFORM"))
 	  {
 	    glClear(GL_DEPTH_BUFFER_BIT);
-      glBindTexture(GL_TEXTURE_2D, 0);
+      gSystem_GL_State.BindTexture(GL_TEXTURE_2D, 0);
 
       CShader* simpleShader = gSystem_Shader_Manager.UseShader("__flatShader");
-      glUniformMatrix4fv(simpleShader->GetUniformIndex("ProjMatrix") , 1, GL_FALSE, glm::value_ptr(cam->projMatrix));
+      glUniformMatrix4fv(simpleShader->GetUniform(Shader::proj_matrix) , 1, GL_FALSE, glm::value_ptr(cam->projMatrix));
 
-      glBindVertexArray(CComponent_Transform::m_TransformVAO);
+      gSystem_GL_State.BindVertexArray(CComponent_Transform::m_TransformVAO);
       glEnableVertexAttribArray(0);
       glEnableVertexAttribArray(1);
 
       glBindBuffer( GL_ARRAY_BUFFER, CComponent_Transform::m_TransformVBOVertices );
       glBindBuffer( GL_ARRAY_BUFFER, CComponent_Transform::m_TransformVBOColors );
 
-	    for(map<string, CGameObject*>::iterator it2 = gSystem_GameObject_Manager.gameObjects.begin(); it2 != gSystem_GameObject_Manager.gameObjects.end(); it2++)
-	    {
-        glm::mat4 local_modelViewMatrix = it2->second->Transform()->ApplyTransform(cam->modelViewMatrix);
-	      glUniformMatrix4fv(simpleShader->GetUniformIndex("ModelViewMatrix") , 1, GL_FALSE, glm::value_ptr(local_modelViewMatrix));
+      // Se recorren los datos SoA de las transformaciones, bloque a bloque
+      CComponent_Transform_Data& transforms = CComponent_Transform::Data();
+      for(uint c = 0; c < transforms.NumChunks(); c++)
+      {
+        CComponent_Transform** owners = transforms.Owners(c);
+        for(uint i = 0; i < __COMPONENT_POOL_CHUNK_SIZE; i++)
+        {
+          if(!owners[i] or !owners[i]->GetGameObject() or owners[i]->GetGameObject()->GetID() < 0)
+            continue;
+
+          glm::mat4 local_modelViewMatrix = owners[i]->ApplyTransform(cam->modelViewMatrix);
+          glUniformMatrix4fv(simpleShader->GetUniform(Shader::modelview_matrix) , 1, GL_FALSE, glm::value_ptr(local_modelViewMatrix));
 
-	      it2->second->Transform()->OnRender(local_modelViewMatrix, cam->projMatrix);
-	    }
+          owners[i]->OnRender(local_modelViewMatrix, cam->projMatrix);
+        }
+      }
 
       glDisableVertexAttribArray(0);
       glDisableVertexAttribArray(1);
-      glBindVertexArray(0);
+      gSystem_GL_State.BindVertexArray(0);
 	  }
 
     cam->AfterRender();
-    current_camera++;
   }
   current_camera = -1;
 
+  // Las texturas de la GUI se leen después de los callbacks de las cámaras, que pueden cambiarlas
+  SetUpGUI(frame);
+  DrawGUI(frame);
+
+  gSystem_Stream_Buffer.OnFrame();
+}
+
+void CSystem_Render::DrawFrame(frame_t* frame)
+{
+  gSystem_GL_State.OnFrame();
+
+  Clear(frame);
+
+  for(uint i = 0; i < frame->cameras.size(); i++)
+    if(frame->cameras[i]->draw)
+      DrawCamera(frame, frame->cameras[i]);
+
+  DrawGUI(frame);
+
+  gSystem_Stream_Buffer.OnFrame();
+}
+
+void CSystem_Render::DrawCamera(frame_t* frame, camera_record_t* record)
+{
+  const viewportf_t& viewport = record->viewport;
+  glViewport(viewport.x*frame->width, viewport.y*frame->height, viewport.width*frame->width, viewport.height*frame->height);
+  glScissor(viewport.x*frame->width, viewport.y*frame->height, viewport.width*frame->width, viewport.height*frame->height);
+
+  if(record->clear)
+  {
+    glClearColor(record->background_color.r, record->background_color.g, record->background_color.b, record->background_color.a);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  }
+
+  // Datos constantes durante toda la cámara, para los shaders con el bloque "CameraData"
+  gSystem_Shader_Manager.SetCamera(record->projMatrix, record->modelViewMatrix, record->normalMatrix);
+
+  // Draw Skybox
+  RenderSkybox(record);
+  if(frame->grid)
+    RenderGrid(frame, record);
+
+  // Con la cola, los objetos ya están grabados en los bloques, y se dibujan ordenados por estado de OpenGL y profundidad
+  if(frame->queue)
+  {
+    render_queue.Clear();
+    for(uint i = 0; i < record->num_chunks; i++)
+      render_queue.Append(*record->chunks[i]);
+
+    render_queue.Sort();
+
+    COcclusion_Culling* occlusion = GetOcclusion(record);
+    if(occlusion)
+      occlusion->BeginFrame();
+
+    render_queue.Submit(record->projMatrix, record->normalMatrix, frame->instancing, occlusion);
+  }
+  else
+  {
+    const Culling::frustum_t* frustum = record->culling ? &record->frustum : NULL;
+
+    for(vector<CGameObject*>::iterator it = record->objects->begin(); it != record->objects->end(); it++)
+    {
+      gSystem_GL_State.BindTexture(GL_TEXTURE_2D, 0);
+
+      glm::mat4 local_modelViewMatrix = (*it)->Transform()->ApplyTransform(record->modelViewMatrix);
+      (*it)->OnRender(record->projMatrix, local_modelViewMatrix, frustum, NULL);
+    }
+  }
+}
+
+COcclusion_Culling* CSystem_Render::GetOcclusion(camera_record_t* record)
+{
+  // Al desactivarla se olvida todo: al volver a activarla, los resultados serían de hace muchas iteraciones
+  if(!record->occlusion or !COcclusion_Culling::Supported())
+  {
+    if(record->index < occlusion_culling.size() and occlusion_culling[record->index]->Size())
+      occlusion_culling[record->index]->Clear();
+
+    return NULL;
+  }
+
+  while(occlusion_culling.size() <= record->index)
+    occlusion_culling.push_back(new COcclusion_Culling);
+
+  // Si la posición ahora es de otra cámara, los resultados de la anterior no sirven
+  COcclusion_Culling* occlusion = occlusion_culling[record->index];
+  occlusion->SetOwner(record->camera);
+
+  return occlusion;
+}
+
+void CSystem_Render::DrawGUI(frame_t* frame)
+{
   // Render GUI
   glClear(GL_DEPTH_BUFFER_BIT);
   //glDisable(GL_DEPTH_TEST);
 
-  GUI_Camera->Camera()->SetViewport();
-  GUI_Camera->Camera()->SetUp();
+  const viewportf_t& viewport = frame->gui_viewport;
+  glViewport(viewport.x*frame->width, viewport.y*frame->height, viewport.width*frame->width, viewport.height*frame->height);
+  glScissor(viewport.x*frame->width, viewport.y*frame->height, viewport.width*frame->width, viewport.height*frame->height);
+
+  gSystem_Shader_Manager.SetCamera(frame->gui_projMatrix, frame->gui_modelViewMatrix, frame->gui_normalMatrix);
+
+  for(vector<CComponent_GUI_Texture::draw_t>::iterator it = frame->gui.begin(); it != frame->gui.end(); ++it)
+    CComponent_GUI_Texture::Draw(*it, frame->gui_projMatrix);
+
+  //glEnable(GL_DEPTH_TEST);
+}
+
+bool CSystem_Render::StartPipeline()
+{
+  frame_ready = SDL_CreateSemaphore(0);
+  frame_done = SDL_CreateSemaphore(0);
+  SDL_AtomicSet(&thread_quit, 0);
+  SDL_AtomicSet(&thread_ok, 0);
 
-  for(vector<CComponent_GUI_Texture*>::iterator it = gui_textures.begin(); it != gui_textures.end(); ++it)
+  if(!frame_ready or !frame_done)
   {
-    if((*it)->gameObject->enabled)
-      (*it)->OnRender(GUI_Camera->Camera()->modelViewMatrix, GUI_Camera->Camera()->projMatrix);
+    gSystem_Debug.console_error_msg("From CSystem_Render: Could not create render thread semaphores: %s", SDL_GetError());
+    StopPipeline();
+    gSystem_Data_Storage.SetInt("__RENDER_PIPELINED", 0);
+
+    return false;
   }
 
-  //glEnable(GL_DEPTH_TEST);
+  // Un contexto sólo puede estar activo en un hilo
+  SDL_GL_MakeCurrent(window, NULL);
+
+  render_thread = SDL_CreateThread(&CSystem_Render::RenderThread, "go-engine render", this);
+  if(render_thread)
+  {
+    // El hilo avisa por frame_done en cuanto ha intentado tomar el contexto
+    SDL_SemWait(frame_done);
+    if(SDL_AtomicGet(&thread_ok))
+    {
+      SDL_SemPost(frame_done);
+      return true;
+    }
+  }
+  else
+    gSystem_Debug.console_error_msg("From CSystem_Render: Could not create render thread: %s", SDL_GetError());
+
+  // Sin hilo, se vuelve a dibujar desde el hilo principal
+  StopPipeline();
+  gSystem_Data_Storage.SetInt("__RENDER_PIPELINED", 0);
+
+  return false;
+}
+
+void CSystem_Render::StopPipeline()
+{
+  if(!render_thread and !frame_ready and !frame_done)
+    return;
+
+  if(render_thread)
+  {
+    // Si el hilo no pudo tomar el contexto, ya ha terminado
+    if(SDL_AtomicGet(&thread_ok))
+      SDL_SemWait(frame_done);
+
+    SDL_AtomicSet(&thread_quit, 1);
+    SDL_SemPost(frame_ready);
+
+    SDL_WaitThread(render_thread, NULL);
+    render_thread = NULL;
+  }
+
+  // StartPipeline() suelta el contexto antes de crear el hilo
+  SDL_GL_MakeCurrent(window, GLcontext);
+
+  if(frame_ready) SDL_DestroySemaphore(frame_ready);
+  if(frame_done)  SDL_DestroySemaphore(frame_done);
+
+  frame_ready = frame_done = NULL;
+  pending_frame = NULL;
+}
+
+void CSystem_Render::Publish(frame_t* frame)
+{
+  // La iteración anterior tiene que estar dibujada: después, su frame_t se vuelve a grabar
+  SDL_SemWait(frame_done);
+
+  pending_frame = frame;
+  SDL_SemPost(frame_ready);
+}
+
+int CSystem_Render::RenderThread(void* data)
+{
+  CSystem_Render* render = (CSystem_Render*)data;
+
+  if(SDL_GL_MakeCurrent(render->window, render->GLcontext) < 0)
+  {
+    gSystem_Debug.error("From CSystem_Render: Render thread could not take the OpenGL context: %s", SDL_GetError());
+    SDL_SemPost(render->frame_done);
+
+    return -1;
+  }
+
+  SDL_AtomicSet(&render->thread_ok, 1);
+  SDL_SemPost(render->frame_done);
+
+  while(true)
+  {
+    SDL_SemWait(render->frame_ready);
+    if(SDL_AtomicGet(&render->thread_quit))
+      break;
+
+    render->DrawFrame(render->pending_frame);
+    render->RenderToScreen();
+
+    SDL_SemPost(render->frame_done);
+  }
+
+  SDL_GL_MakeCurrent(render->window, NULL);
+
+  return 0;
 }
 
 // http://www.opengl.org/wiki/Tutorial1:_Rendering_shapes_with_glDrawRangeElements,_VAO,_VBO,_shaders_(C%2B%2B_/_freeGLUT)
 // http://www.opengl.org/wiki/Tutorial2:_VAOs,_VBOs,_Vertex_and_Fragment_Shaders_(C_/_SDL)
 // !! http://www.opengl.org/sdk/docs/tutorials/ClockworkCoders/attributes.php
 
-void CSystem_Render::RenderGrid(CComponent_Camera* cam)
+void CSystem_Render::RenderGrid(frame_t* frame, camera_record_t* record)
 {
-  GLfloat cols_scale = gSystem_Data_Storage.GetFloat("__RENDER_TRANSFORM_GRID_COLS_SCALE");
-  GLfloat rows_scale = gSystem_Data_Storage.GetFloat("__RENDER_TRANSFORM_GRID_ROWS_SCALE");
+  GLfloat cols_scale = frame->grid_cols_scale;
+  GLfloat rows_scale = frame->grid_rows_scale;
 
-  GLint ncols = gSystem_Data_Storage.GetInt("__RENDER_TRANSFORM_GRID_COLS");
-  GLint nrows = gSystem_Data_Storage.GetInt("__RENDER_TRANSFORM_GRID_ROWS");
+  GLint ncols = frame->grid_cols;
+  GLint nrows = frame->grid_rows;
 
   if((GLuint)ncols != m_GridVBO_numcols or (GLuint)nrows != m_GridVBO_numrows)
     UpdateGridVBO(ncols, nrows);
 
-  glm::mat4 local_modelViewMatrix = cam->modelViewMatrix;
+  glm::mat4 local_modelViewMatrix = record->modelViewMatrix;
   local_modelViewMatrix = glm::translate(local_modelViewMatrix, glm::vec3((-ncols*cols_scale)/2.f, 0.f, (-nrows*rows_scale)/2.f));
   local_modelViewMatrix = glm::scale(local_modelViewMatrix, glm::vec3(rows_scale, 0.f, cols_scale));
 
   CShader* simpleShader = gSystem_Shader_Manager.UseShader("__flatShader");
 
-  glUniformMatrix4fv(simpleShader->GetUniformIndex("ProjMatrix") , 1, GL_FALSE, glm::value_ptr(cam->projMatrix));
-  glUniformMatrix4fv(simpleShader->GetUniformIndex("ModelViewMatrix") , 1, GL_FALSE, glm::value_ptr(local_modelViewMatrix));
+  glUniformMatrix4fv(simpleShader->GetUniform(Shader::proj_matrix) , 1, GL_FALSE, glm::value_ptr(record->projMatrix));
+  glUniformMatrix4fv(simpleShader->GetUniform(Shader::modelview_matrix) , 1, GL_FALSE, glm::value_ptr(local_modelViewMatrix));
 
-  glBindTexture(GL_TEXTURE_2D, 0);
+  gSystem_GL_State.BindTexture(GL_TEXTURE_2D, 0);
 
-  glBindVertexArray(m_GridVAO);
+  gSystem_GL_State.BindVertexArray(m_GridVAO);
   glEnableVertexAttribArray(0);
   glEnableVertexAttribArray(1);
 
@@ -665,39 +1182,38 @@ void CSystem_Render::RenderGrid(CComponent_Camera* cam)
   glDisableVertexAttribArray(0);
   glDisableVertexAttribArray(1);
 
-  glBindVertexArray(0);
+  gSystem_GL_State.BindVertexArray(0);
   //glUseProgram(0);
 }
 
 
-bool CSystem_Render::RenderSkybox(CComponent_Camera* cam)
+bool CSystem_Render::RenderSkybox(camera_record_t* record)
 {
-  if(!cam or cam->skybox_texture == "")
+  if(!record or !record->skybox_texture)
     return false;
 
-  // Idea sencilla: dibujamos un cubo de tamao 1x1 sin depth_test justo donde esta la cmara.
-  // Todo lo dems se dibujar encima, por lo que crear un efecto de "tamao inmenso".
+  // Idea sencilla: dibujamos un cubo de tamaño 1x1 sin depth_test justo donde esta la cámara.
+  // Todo lo demás se dibujará encima, por lo que creará un efecto de "tamaño inmenso".
   // http://content.gpwiki.org/index.php/Sky_Box
 
   //glColor3f(1.f, 1.f, 1.f);
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, gSystem_Resources.GetTexture(cam->skybox_texture )->GetID());
+  gSystem_GL_State.ActiveTexture(GL_TEXTURE0);
+  gSystem_GL_State.BindTexture(GL_TEXTURE_2D, record->skybox_texture);
 
-  vector3f position = cam->gameObject->Transform()->Position();
-  glm::mat4 local_modelViewMatrix = cam->modelViewMatrix;//glTranslatef(position.x, position.y, position.z);
-  local_modelViewMatrix = glm::translate(local_modelViewMatrix, position.to_glm());
+  glm::mat4 local_modelViewMatrix = record->modelViewMatrix;//glTranslatef(position.x, position.y, position.z);
+  local_modelViewMatrix = glm::translate(local_modelViewMatrix, record->position);
 
   uint m_nSkyboxVertexCount = 24;
 
   CShader* simpleShader = gSystem_Shader_Manager.UseShader("__textureShader");
 
-  glUniformMatrix4fv(simpleShader->GetUniformIndex("ProjMatrix") , 1, GL_FALSE, glm::value_ptr(cam->projMatrix));
-  glUniformMatrix4fv(simpleShader->GetUniformIndex("ModelViewMatrix") , 1, GL_FALSE, glm::value_ptr(local_modelViewMatrix));
-  glUniform1i(simpleShader->GetUniformIndex("texture"), 0);
-  glUniform1f(simpleShader->GetUniformIndex("textureFlag"), 1.0f);
-  glUniform4f(simpleShader->GetUniformIndex("in_Color"), 1.0, 1.0, 1.0, 1.0);
+  glUniformMatrix4fv(simpleShader->GetUniform(Shader::proj_matrix) , 1, GL_FALSE, glm::value_ptr(record->projMatrix));
+  glUniformMatrix4fv(simpleShader->GetUniform(Shader::modelview_matrix) , 1, GL_FALSE, glm::value_ptr(local_modelViewMatrix));
+  glUniform1i(simpleShader->GetUniform(Shader::texture), 0);
+  glUniform1f(simpleShader->GetUniform(Shader::texture_flag), 1.0f);
+  glUniform4f(simpleShader->GetUniform(Shader::color), 1.0, 1.0, 1.0, 1.0);
 
-  glBindVertexArray(m_SkyboxVAO);
+  gSystem_GL_State.BindVertexArray(m_SkyboxVAO);
   glEnableVertexAttribArray(0);
   glEnableVertexAttribArray(1);
 
@@ -716,9 +1232,9 @@ bool CSystem_Render::RenderSkybox(CComponent_Camera* cam)
   return true;
 }
 
-void CSystem_Render::Clear()
+void CSystem_Render::Clear(frame_t* frame)
 {
-  glScissor(0, 0, gSystem_Data_Storage.GetInt("__RENDER_RESOLUTION_WIDTH"), gSystem_Data_Storage.GetInt("__RENDER_RESOLUTION_HEIGHT"));
+  glScissor(0, 0, frame->width, frame->height);
 
   glClearColor(0, 0, 0, 1);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -0,0 +1,524 @@
+#include "systems/_render_queue.h"
+#include "systems/_resource.h"
+#include "systems/_shader.h"
+#include "systems/_gl_state.h"
+#include "systems/_stream_buffer.h"
+#include "systems/_occlusion.h"
+#include "systems/_mesh_buffer.h"
+#include "_object.h"
+#include "_components.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace RenderQueue
+{
+  // Profundidad a 24 bits: para floats positivos, el orden de sus bits coincide con el de su valor, así que basta con quitar los 7 bits más bajos de la mantisa
+  static inline Uint64 QuantizeDepth(float depth)
+  {
+    if(!(depth > 0.f)) // También descarta NaN
+      return 0;
+
+    Uint32 bits;
+    memcpy(&bits, &depth, sizeof(bits));
+
+    return (bits >> 7) & 0xFFFFFF;
+  }
+
+  key_t Key(pass_t pass, bool translucent, uint shader, uint texture, uint mesh, float depth)
+  {
+    Uint64 p = (Uint64)(pass & 0x3);
+    Uint64 s = (Uint64)(shader & 0xFF);
+    Uint64 t = (Uint64)(texture & 0xFFF);
+    Uint64 m = (Uint64)(mesh & 0xFFF);
+    Uint64 d = QuantizeDepth(depth);
+
+    if(!translucent)
+      return (p << 62) | (s << 54) | (t << 42) | (m << 30) | (d << 5);
+    else
+      return (p << 62) | ((Uint64)1 << 61) | ((0xFFFFFF - d) << 37) | (s << 29) | (t << 17) | (m << 5);
+  }
+
+  // Después de todos los modelos opacos (shader, textura y modelo al máximo), y en orden de llegada en los bits de profundidad
+  static inline key_t CustomKey(uint index)
+  {
+    return ((Uint64)scene << 62) | ((Uint64)0xFF << 54) | ((Uint64)0xFFF << 42) | ((Uint64)0xFFF << 30) | ((Uint64)(index & 0xFFFFFF) << 5);
+  }
+}
+
+void CRender_Queue::Clear()
+{
+  items.clear();
+  order.clear();
+  particle_data.clear();
+  num_custom = num_callbacks = 0;
+
+  texture_shader = gSystem_Shader_Manager.GetShader("__textureShader");
+}
+
+void CRender_Queue::Close()
+{
+  instances.clear();
+  commands.clear();
+  indirect_data.clear();
+  particle_data.clear();
+}
+
+void CRender_Queue::SetView(uint camera, const glm::mat4& projMatrix, float viewport_height, float max_error)
+{
+  lod_camera = camera;
+  lod_projMatrix = projMatrix;
+  lod_height = viewport_height;
+  lod_error = max_error;
+}
+
+void CRender_Queue::Add(CComponent_Mesh_Render* mesh_render, const glm::mat4& modelViewMatrix)
+{
+  if(!mesh_render or !mesh_render->GetState())
+    return;
+
+  item_t item;
+  item.type = mesh_item;
+  item.gameObject = mesh_render->GetGameObject();
+  item.handle = item.gameObject->GetHandle();
+  item.mesh_render = mesh_render;
+  item.particle_emitter = NULL;
+  item.modelViewMatrix = modelViewMatrix;
+
+  item.shader = gSystem_Shader_Manager.GetShader(mesh_render->shader_name);
+  item.mesh = gSystem_Resources.GetMesh(mesh_render->mesh_name);
+  item.error_mesh = (item.mesh == gSystem_Resources.GetMesh("__MDL_ERROR"));
+  item.texture = gSystem_Resources.GetTexture(item.error_mesh ? "__TEXTURE_WHITE" : mesh_render->material_name)->GetID();
+  item.translucent = (mesh_render->color.a != 1.0);
+  item.callbacks = (mesh_render->before_render or mesh_render->after_render);
+  item.instanceable = (item.shader == texture_shader and !item.callbacks);
+  item.lod = mesh_render->SelectLOD(item.mesh, lod_camera, lod_projMatrix, modelViewMatrix, lod_height, lod_error);
+
+  item.normalMatrix = item.gameObject->Transform()->CachedNormalMatrix();
+  mesh_render->GetColor(item.error_mesh, item.color, item.texture_flag);
+  item.particle_data = item.particle_count = 0;
+
+  if(item.callbacks)
+    num_callbacks++;
+
+  // Distancia a la cámara del centro del modelo
+  float depth = -(modelViewMatrix * glm::vec4(item.mesh->Bounds().sphere.center, 1.f)).z;
+
+  // Los niveles de detalle de un modelo, juntos
+  item.key = RenderQueue::Key(RenderQueue::scene, item.translucent, item.shader ? item.shader->GetProgram() : 0, item.texture, (item.mesh->ID() << 2) | item.lod, depth);
+  items.push_back(item);
+}
+
+void CRender_Queue::Add(CComponent_Particle_Emitter* particle_emitter, const glm::mat4& modelViewMatrix)
+{
+  if(!particle_emitter or !particle_emitter->GetState())
+    return;
+
+  item_t item;
+  item.type = particles_item;
+  item.gameObject = particle_emitter->GetGameObject();
+  item.handle = item.gameObject->GetHandle();
+  item.mesh_render = NULL;
+  item.particle_emitter = particle_emitter;
+  item.modelViewMatrix = modelViewMatrix;
+
+  item.shader = NULL;
+  item.mesh = NULL;
+  item.error_mesh = false;
+  item.texture = particle_emitter->GetTexture();
+  item.translucent = true;
+  item.instanceable = false;
+  item.callbacks = false;
+  item.lod = 0;
+  item.texture_flag = 1.f;
+
+  // Se copian las partículas de esta iteración: el emisor las puede cambiar antes de que se dibuje la cola
+  item.particle_count = particle_emitter->particles.size();
+  item.particle_data = particle_data.size();
+  particle_data.insert(particle_data.end(), particle_emitter->v_ParticlePosition_data.begin(), particle_emitter->v_ParticlePosition_data.begin() + item.particle_count * 3);
+  particle_data.insert(particle_data.end(), particle_emitter->v_ParticlesAngleScale_data.begin(), particle_emitter->v_ParticlesAngleScale_data.begin() + item.particle_count * 2);
+  particle_data.insert(particle_data.end(), particle_emitter->v_ParticlesColor_data.begin(), particle_emitter->v_ParticlesColor_data.begin() + item.particle_count * 4);
+
+  float depth = -modelViewMatrix[3].z;
+
+  item.key = RenderQueue::Key(RenderQueue::scene, true, 0, 0, 0, depth);
+  items.push_back(item);
+}
+
+void CRender_Queue::AddCustom(CGameObject* go, const glm::mat4& modelViewMatrix)
+{
+  if(!go)
+    return;
+
+  item_t item;
+  item.type = custom_item;
+  item.gameObject = go;
+  item.handle = go->GetHandle();
+  item.mesh_render = NULL;
+  item.particle_emitter = NULL;
+  item.modelViewMatrix = modelViewMatrix;
+
+  item.shader = NULL;
+  item.mesh = NULL;
+  item.error_mesh = false;
+  item.texture = 0;
+  item.translucent = false;
+  item.instanceable = false;
+  item.callbacks = true;
+  item.lod = 0;
+  item.particle_data = item.particle_count = 0;
+
+  item.key = RenderQueue::CustomKey(num_custom++);
+  num_callbacks++;
+
+  items.push_back(item);
+}
+
+void CRender_Queue::Append(const CRender_Queue& other)
+{
+  items.reserve(items.size() + other.items.size());
+
+  uint particle_base = particle_data.size();
+  particle_data.insert(particle_data.end(), other.particle_data.begin(), other.particle_data.end());
+  num_callbacks += other.num_callbacks;
+
+  for(vector<item_t>::const_iterator it = other.items.begin(); it != other.items.end(); ++it)
+  {
+    items.push_back(*it);
+    items.back().particle_data += particle_base;
+
+    // Los dummys y callbacks se numeran de nuevo, para que se dibujen en el orden de las colas y, dentro de cada una, en el de llegada
+    if(it->type == custom_item)
+      items.back().key = RenderQueue::CustomKey(num_custom++);
+  }
+}
+
+void CRender_Queue::Sort()
+{
+  uint n = items.size();
+
+  order.resize(n);
+  scratch.resize(n);
+
+  for(uint i = 0; i < n; i++)
+  {
+    order[i].key = items[i].key;
+    order[i].index = i;
+  }
+
+  if(n < 2)
+    return;
+
+  // Radix LSD: estable, así que los elementos con la misma clave mantienen el orden en que se añadieron
+  for(uint shift = 0; shift < 64; shift += 8)
+  {
+    uint count[256] = {0};
+    for(uint i = 0; i < n; i++)
+      count[(order[i].key >> shift) & 0xFF]++;
+
+    // Todas las claves tienen el mismo byte: la pasada no cambiaría nada
+    if(count[(order[0].key >> shift) & 0xFF] == n)
+      continue;
+
+    uint offset = 0;
+    for(uint b = 0; b < 256; b++)
+    {
+      uint c = count[b];
+      count[b] = offset;
+      offset += c;
+    }
+
+    for(uint i = 0; i < n; i++)
+      scratch[count[(order[i].key >> shift) & 0xFF]++] = order[i];
+
+    order.swap(scratch);
+  }
+}
+
+void CRender_Queue::SetShader(CShader* shader, const glm::mat4& projMatrix)
+{
+  gSystem_GL_State.UseProgram(shader->GetProgram());
+
+  // Los uniforms de la cámara ya están puestos: basta con que el programa siga activo
+  if(shader == current_shader)
+    return;
+
+  // Los shaders con el bloque "CameraData" ya tienen la proyección de la cámara
+  if(!shader->HasCameraBlock())
+    glUniformMatrix4fv(shader->GetUniform(Shader::proj_matrix), 1, GL_FALSE, glm::value_ptr(projMatrix));
+  glUniform1i(shader->GetUniform(Shader::texture), 0);
+
+  current_shader = shader;
+  stats.programs++;
+}
+
+void CRender_Queue::SetState(const item_t& item)
+{
+  if(item.translucent)
+  {
+    gSystem_GL_State.BlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    gSystem_GL_State.DepthMask(false);
+  }
+  else
+    gSystem_GL_State.DepthMask(true);
+
+  gSystem_GL_State.ActiveTexture(GL_TEXTURE0);
+  if(gSystem_GL_State.BindTexture(GL_TEXTURE_2D, item.texture))
+    stats.textures++;
+
+  if(gSystem_GL_State.VertexArray() != (GLint)item.mesh->GetVAO())
+  {
+    item.mesh->Bind();
+    stats.meshes++;
+  }
+}
+
+uint CRender_Queue::Batch(uint first)
+{
+  const item_t& item = items[order[first].index];
+  if(!item.instanceable)
+    return 1;
+
+  // Con glMultiDrawElementsIndirect(), también los otros modelos de su buffer compartido
+  CMesh_Buffer* shared = multidraw ? item.mesh->Shared() : NULL;
+
+  uint last = first + 1;
+  while(last < order.size() and last - first < __RENDER_QUEUE_MAX_INSTANCES)
+  {
+    const item_t& next = items[order[last].index];
+    if(!next.instanceable or next.texture != item.texture or next.translucent != item.translucent)
+      break;
+
+    if(shared ? next.mesh->Shared() != shared : (next.mesh != item.mesh or next.lod != item.lod))
+      break;
+
+    last++;
+  }
+
+  return last - first;
+}
+
+void CRender_Queue::SetInstanceAttributes(GLintptr offset)
+{
+  // Los atributos de instancia se guardan en el VAO del modelo, que ya está activo
+  for(uint c = 0; c < 4; c++)
+  {
+    glVertexAttribPointer(3 + c, 4, GL_FLOAT, GL_FALSE, sizeof(instance_t), (GLvoid*)(offset + c * sizeof(glm::vec4)));
+    glVertexAttribDivisor(3 + c, 1);
+    glEnableVertexAttribArray(3 + c);
+  }
+
+  glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(instance_t), (GLvoid*)(offset + sizeof(glm::mat4)));
+  glVertexAttribDivisor(7, 1);
+  glEnableVertexAttribArray(7);
+
+  glVertexAttribPointer(8, 1, GL_FLOAT, GL_FALSE, sizeof(instance_t), (GLvoid*)(offset + sizeof(glm::mat4) + sizeof(glm::vec4)));
+  glVertexAttribDivisor(8, 1);
+  glEnableVertexAttribArray(8);
+}
+
+bool CRender_Queue::DrawInstanced(uint first, uint count, const glm::mat4& projMatrix)
+{
+  const item_t& item = items[order[first].index];
+
+  // Un comando por cada modelo y nivel de detalle seguidos (sólo hay varios en los grupos de un buffer compartido)
+  instances.resize(count);
+  commands.clear();
+  for(uint i = 0; i < count; i++)
+  {
+    const item_t& copy = items[order[first + i].index];
+
+    instances[i].modelViewMatrix = copy.modelViewMatrix * copy.mesh->DequantizeMatrix();
+    instances[i].color = copy.color;
+    instances[i].texture_flag = copy.texture_flag;
+
+    if(i > 0)
+    {
+      const item_t& previous = items[order[first + i - 1].index];
+      if(copy.mesh == previous.mesh and copy.lod == previous.lod)
+      {
+        commands.back().instance_count++;
+        continue;
+      }
+    }
+
+    indirect_t command;
+    command.count = copy.mesh->IndexCount(copy.lod);
+    command.instance_count = 1;
+    command.first_index = copy.mesh->FirstIndex(copy.lod);
+    command.base_vertex = copy.mesh->BaseVertex();
+    command.base_instance = i;
+    commands.push_back(command);
+  }
+
+  SetShader(gSystem_Shader_Manager.GetShader("__textureInstancedShader"), projMatrix);
+  SetState(item);
+
+  // Si no caben en el buffer circular, se dibujan una a una
+  GLintptr offset;
+  if(commands.size() == 1)
+    offset = gSystem_Stream_Buffer.Write(&instances[0], count * sizeof(instance_t));
+  else
+  {
+    // Una sola escritura: si el buffer da la vuelta entre dos, la primera se podría perder
+    GLsizeiptr instance_bytes = count * sizeof(instance_t);
+    indirect_data.resize(instance_bytes + commands.size() * sizeof(indirect_t));
+    memcpy(&indirect_data[0], &instances[0], instance_bytes);
+    memcpy(&indirect_data[instance_bytes], &commands[0], commands.size() * sizeof(indirect_t));
+
+    offset = gSystem_Stream_Buffer.Write(&indirect_data[0], indirect_data.size());
+  }
+
+  if(offset < 0)
+    return false;
+
+  SetInstanceAttributes(offset);
+
+  if(commands.size() == 1)
+    item.mesh->DrawInstanced(count, item.lod);
+  else
+  {
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gSystem_Stream_Buffer.Buffer());
+    glMultiDrawElementsIndirect(GL_TRIANGLES, item.mesh->IndexType(), (GLvoid*)(offset + count * sizeof(instance_t)), commands.size(), 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    stats.multidraws++;
+  }
+
+  // Para que el VAO siga sirviendo a los shaders sin instancias
+  for(uint a = 3; a <= 8; a++)
+    glDisableVertexAttribArray(a);
+
+  stats.draws++;
+  stats.instanced++;
+  for(uint i = 0; i < count; i++)
+  {
+    const item_t& copy = items[order[first + i].index];
+    stats.triangles += copy.mesh->Triangles(copy.lod);
+    if(copy.lod)
+      stats.reduced++;
+  }
+
+  return true;
+}
+
+void CRender_Queue::Submit(const glm::mat4& projMatrix, const glm::mat4& normalMatrix, bool instancing, COcclusion_Culling* occlusion)
+{
+  stats.items = items.size();
+  stats.draws = stats.instanced = stats.programs = stats.textures = stats.meshes = stats.multidraws = stats.triangles = stats.reduced = 0;
+
+  // Grupos de modelos distintos de un mismo CMesh_Buffer
+  multidraw = instancing and GLEW_ARB_multi_draw_indirect and GLEW_ARB_base_instance;
+
+  // Sin Sort(), en el orden en que se añadieron
+  if(order.size() != items.size())
+  {
+    order.resize(items.size());
+    for(uint i = 0; i < items.size(); i++)
+      order[i].index = i;
+  }
+
+  // Se quitan del orden los modelos ocultos en la iteración anterior, manteniendo el de los demás (y con él, los grupos instanciados)
+  if(occlusion)
+  {
+    uint visible = 0;
+    for(uint i = 0; i < order.size(); i++)
+    {
+      const item_t& item = items[order[i].index];
+      if(item.type == mesh_item and !occlusion->Visible(item.handle))
+        continue;
+
+      order[visible++] = order[i];
+    }
+
+    order.resize(visible);
+  }
+
+  // El estado de OpenGL lo recuerda CSystem_GL_State, que descarta los cambios redundantes
+  current_shader = NULL;
+
+  for(uint i = 0; i < order.size(); )
+  {
+    item_t& item = items[order[i].index];
+
+    if(item.type == mesh_item)
+    {
+      uint count = instancing ? Batch(i) : 1;
+      if(count >= __RENDER_QUEUE_MIN_INSTANCES and DrawInstanced(i, count, projMatrix))
+      {
+        i += count;
+        continue;
+      }
+
+      CComponent_Mesh_Render* mesh_render = item.mesh_render;
+
+      SetShader(item.shader, projMatrix);
+      // Las posiciones de 16 bits vuelven al espacio del modelo en la matriz de modelo-vista
+      CComponent_Mesh_Render::SetUniforms(item.shader, item.modelViewMatrix * item.mesh->DequantizeMatrix(), normalMatrix * item.normalMatrix, item.color, item.texture_flag);
+
+      // Los callbacks pueden cambiar el estado sin pasar por la caché. El programa que deje before_render se respeta, como antes de la cola
+      if(item.callbacks and mesh_render->before_render)
+      {
+        mesh_render->before_render(item.gameObject);
+        gSystem_GL_State.Invalidate();
+      }
+
+      SetState(item);
+      item.mesh->Draw(item.lod);
+      stats.draws++;
+      stats.triangles += item.mesh->Triangles(item.lod);
+      if(item.lod)
+        stats.reduced++;
+
+      if(item.callbacks and mesh_render->after_render)
+      {
+        mesh_render->after_render(item.gameObject);
+        gSystem_GL_State.Invalidate();
+        current_shader = NULL;
+      }
+    }
+    else
+    {
+      // Los emisores y los dummys usan su propio estado, y esperan que no haya ningún VAO activo ni escritura en el depth buffer desactivada
+      gSystem_GL_State.BindVertexArray(0);
+      gSystem_GL_State.DepthMask(true);
+
+      if(item.type == particles_item)
+      {
+        uint count = item.particle_count;
+        if(count)
+        {
+          const GLfloat* data = &particle_data[item.particle_data];
+          CComponent_Particle_Emitter::Draw(projMatrix, item.modelViewMatrix, item.texture, data, data + count * 3, data + count * 5, count);
+        }
+      }
+      else
+      {
+        gSystem_GL_State.BindTexture(GL_TEXTURE_2D, 0);
+        item.gameObject->OnRenderCallbacks(projMatrix, item.modelViewMatrix);
+      }
+
+      current_shader = NULL;
+    }
+
+    i++;
+  }
+
+  // Con el depth buffer ya completo, se consultan todos los modelos (también los ocultos, para saber cuándo vuelven a verse)
+  if(occlusion)
+  {
+    occlusion->BeginQueries(projMatrix);
+
+    for(vector<item_t>::iterator it = items.begin(); it != items.end(); ++it)
+      if(it->type == mesh_item)
+        occlusion->Query(it->handle, it->modelViewMatrix, it->mesh->Bounds().box, projMatrix);
+
+    occlusion->EndQueries();
+    current_shader = NULL;
+  }
+
+  gSystem_GL_State.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  gSystem_GL_State.DepthMask(true);
+  gSystem_GL_State.BindVertexArray(0);
+}
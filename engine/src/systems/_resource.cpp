@@ -2,6 +2,11 @@
 #include "systems/_debug.h"
 #include "systems/_mixer.h"
 #include "systems/_shader.h"
+#include "systems/_gl_state.h"
+#include "systems/_mesh_simplifier.h"
+#include "systems/_mesh_optimizer.h"
+#include "systems/_mesh_buffer.h"
+#include "systems/_data.h"
 
 CSystem_Resources gSystem_Resources;
 CSystem_Resources& gResources = gSystem_Resources;
@@ -20,6 +25,46 @@ CResource::~CResource()
 
 /** Mesh **/
 
+uint CResource_Mesh::next_id = 1;
+
+// Valor entre -1 y 1, a 16 bits con signo normalizado
+static inline GLshort QuantizeSnorm16(float v)
+{
+  v = std::max(-1.f, std::min(v, 1.f));
+  return (GLshort)(v * 32767.f + (v >= 0.f ? 0.5f : -0.5f));
+}
+
+// Valor entre 0 y 1, a 16 bits sin signo normalizado
+static inline GLushort QuantizeUnorm16(float v)
+{
+  v = std::max(0.f, std::min(v, 1.f));
+  return (GLushort)(v * 65535.f + 0.5f);
+}
+
+// Normal unitaria a coordenadas octaédricas, entre -1 y 1: se proyecta en el octaedro |x| + |y| + |z| = 1, y la mitad de z negativa se dobla hacia fuera
+static inline glm::vec2 EncodeOctahedral(const glm::vec3& n)
+{
+  float l1 = fabs(n.x) + fabs(n.y) + fabs(n.z);
+  if(l1 <= 0.f)
+    return glm::vec2(0.f);
+
+  glm::vec2 e(n.x / l1, n.y / l1);
+  if(n.z < 0.f)
+    e = glm::vec2((1.f - fabs(e.y)) * (e.x >= 0.f ? 1.f : -1.f), (1.f - fabs(e.x)) * (e.y >= 0.f ? 1.f : -1.f));
+
+  return e;
+}
+
+// Inversa de EncodeOctahedral()
+static inline glm::vec3 DecodeOctahedral(const glm::vec2& e)
+{
+  glm::vec3 n(e.x, e.y, 1.f - fabs(e.x) - fabs(e.y));
+  if(n.z < 0.f)
+    n = glm::vec3((1.f - fabs(e.y)) * (e.x >= 0.f ? 1.f : -1.f), (1.f - fabs(e.x)) * (e.y >= 0.f ? 1.f : -1.f), n.z);
+
+  return glm::normalize(n);
+}
+
 bool CResource_Mesh::LoadFile(string file, string arguments)
 {
   // http://nickthecoder.wordpress.com/2013/01/20/mesh-loading-with-assimp/
@@ -32,10 +77,25 @@ bool CResource_Mesh::LoadFile(string file, string arguments)
     return false;
   }
 
+  // Argumentos: "[índice del modelo en el fichero] [nolod] [quantize]"
   stringstream ss(arguments);
   int index = 0;
   ss >> index;
 
+  bool lod = true;
+  bool quantize = false;
+
+  string option;
+  while(ss >> option)
+  {
+    if(option == "nolod")
+      lod = false;
+    else if(option == "quantize")
+      quantize = true;
+    else
+      gSystem_Debug.console_warning_msg("From Resource %s: Unknown mesh option \"%s\".", file.c_str(), option.c_str());
+  }
+
   if(index >= scene->mNumMeshes)
   {
     gSystem_Debug.console_error_msg("From Resource %s: No mesh (%d) detected, file only has %d meshes", file.c_str(), index, scene->mNumMeshes);
@@ -67,95 +127,355 @@ bool CResource_Mesh::LoadFile(string file, string arguments)
     texCoords.push_back(vector3f(pTexCoord->x, pTexCoord->y, pTexCoord->z));
   }*/
 
-  // -----
-  // OLD
-  // -----
+  if(!mesh->HasPositions())
+  {
+    gSystem_Debug.console_error_msg("From Resource %s: Mesh (%d) has no vertices.", file.c_str(), index);
+    return false;
+  }
 
-  float *vertexArray, *normalArray, *uvArray;
+  uint num_vertices = mesh->mNumVertices;
+  vector<glm::vec3> positions(num_vertices);
+  for(uint i = 0; i < num_vertices; i++)
+    positions[i] = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
 
-  // ->BUG Problema aqu. (numTriangles = mesh->nNumFaces*3).
-  // Hay que usar una mejor estructura para cargar modelos. Esta es BASURA.
-  numTriangles = mesh->mNumFaces*3;
-  numUvCoords = mesh->GetNumUVChannels();
+  vector<glm::vec2> uvs;
+  if(mesh->HasTextureCoords(0))
+  {
+    uvs.resize(num_vertices);
+    for(uint i = 0; i < num_vertices; i++)
+      uvs[i] = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
+  }
 
-  vertexArray = new float[mesh->mNumFaces*3*3];
-  normalArray = new float[mesh->mNumFaces*3*3];
-  uvArray =     new float[mesh->mNumFaces*3*2];
+  vector<glm::vec3> normals;
+  if(mesh->HasNormals())
+  {
+    normals.resize(num_vertices);
+    for(uint i = 0; i < num_vertices; i++)
+      normals[i] = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
+  }
 
-  for(unsigned int i=0;i<mesh->mNumFaces;i++)
+  // Triángulos del modelo, con los índices de Assimp (los vértices repetidos ya están unidos)
+  vector<uint> indices;
+  indices.reserve(mesh->mNumFaces*3);
+  for(unsigned int i = 0; i < mesh->mNumFaces; i++)
   {
     const aiFace& face = mesh->mFaces[i];
+    if(face.mNumIndices != 3)
+      continue;
 
-    //foreach index
-    for(int j = 0; j < face.mNumIndices; j++)//assume all faces are triangulated
+    indices.push_back(face.mIndices[0]);
+    indices.push_back(face.mIndices[1]);
+    indices.push_back(face.mIndices[2]);
+  }
+
+  rc_file = file;
+  numUvCoords = mesh->GetNumUVChannels();
+
+  return LoadFromMemory(positions, uvs, normals, indices, lod, quantize);
+}
+
+bool CResource_Mesh::LoadFromMemory(const vector<glm::vec3>& positions, const vector<glm::vec2>& uvs, const vector<glm::vec3>& normals, const vector<uint>& indices, bool lod, bool quantize)
+{
+  uint num_vertices = positions.size();
+  if(!num_vertices or (!uvs.empty() and uvs.size() != num_vertices) or (!normals.empty() and normals.size() != num_vertices))
+  {
+    gSystem_Debug.console_error_msg("From Resource %s: Invalid mesh data.", rc_file.c_str());
+    return false;
+  }
+
+  // Volumen envolvente
+  bounds = Culling::bounds_t();
+  for(uint i = 0; i < num_vertices; i++)
+    bounds.box.Extend(positions[i]);
+
+  glm::vec3 bounds_center = bounds.box.Center();
+  float radius2 = 0.f;
+  for(uint i = 0; i < num_vertices; i++)
+    radius2 = std::max(radius2, glm::distance2(bounds_center, positions[i]));
+
+  bounds.sphere = Culling::sphere_t(bounds_center, sqrt(radius2));
+
+  // Niveles de detalle, de más a menos triángulos. Todos usan los vértices del modelo original
+  vector< vector<uint> > lod_indices(1, indices);
+  vector<float> lod_errors(1, 0.f);
+
+  uint triangles = indices.size() / 3;
+  if(lod and triangles >= __MESH_LOD_MIN_TRIANGLES)
+  {
+    CMesh_Simplifier simplifier(positions, indices);
+    for(uint l = 1; l < __MESH_LOD_LEVELS; l++)
     {
-      if (mesh->HasTextureCoords(0))
-      {
-        aiVector3D uv = mesh->mTextureCoords[0][face.mIndices[j]];
-        memcpy(uvArray,&uv,sizeof(float)*2);
-        uvArray+=2;
-      }
+      vector<uint> simplified;
+      float error = simplifier.Simplify(triangles >> l, simplified);
 
-      if (mesh->HasNormals())
-      {
-        aiVector3D normal = mesh->mNormals[face.mIndices[j]];
-        memcpy(normalArray,&normal,sizeof(float)*3);
-        normalArray+=3;
-      }
+      // Si apenas se ha podido simplificar, los siguientes tampoco
+      if(simplified.size() > lod_indices.back().size() * __MESH_LOD_MIN_REDUCTION)
+        break;
 
-      if (mesh->HasPositions())
+      lod_indices.push_back(simplified);
+      lod_errors.push_back(error);
+    }
+  }
+
+  if(indices.empty())
+  {
+    gSystem_Debug.console_error_msg("From Resource %s: Mesh has no triangles.", rc_file.c_str());
+    return false;
+  }
+
+  // Todos los niveles seguidos en el mismo IBO, cada uno ordenado para la caché de vértices y luego para el overdraw
+  lods.clear();
+  vector<uint> all_indices;
+  for(uint l = 0; l < lod_indices.size(); l++)
+  {
+    MeshOptimizer::OptimizeVertexCache(lod_indices[l], num_vertices);
+    MeshOptimizer::OptimizeOverdraw(lod_indices[l], positions, __MESH_OVERDRAW_THRESHOLD);
+
+    lod_t level;
+    level.first = all_indices.size();
+    level.count = lod_indices[l].size();
+    level.error = lod_errors[l];
+    lods.push_back(level);
+
+    all_indices.insert(all_indices.end(), lod_indices[l].begin(), lod_indices[l].end());
+  }
+
+  // Vértices en el orden en que los lee el modelo original (los niveles simplificados sólo usan vértices suyos), sin los que no usa ningún triángulo
+  vector<uint> remap;
+  uint used_vertices = MeshOptimizer::OptimizeVertexFetch(all_indices, num_vertices, remap);
+
+  numTriangles = lods[0].count;
+
+  // Formato de los vértices: normales siempre en 2 x 16 bits, UV en 16 bits si caben, y posiciones en 16 bits si se pide
+  format = Resources::mesh_float;
+  if(quantize)
+    format |= Resources::mesh_position_16;
+
+  if(!uvs.empty())
+  {
+    bool unit = true;
+    for(uint v = 0; v < num_vertices and unit; v++)
+    {
+      const glm::vec2& uv = uvs[v];
+      unit = (uv.x >= 0.f and uv.x <= 1.f and uv.y >= 0.f and uv.y <= 1.f);
+    }
+
+    if(unit)
+      format |= Resources::mesh_uv_16;
+  }
+
+  GLsizei position_size = (format & Resources::mesh_position_16) ? 4*sizeof(GLshort) : 3*sizeof(GLfloat);
+  GLsizei uv_size = (format & Resources::mesh_uv_16) ? 2*sizeof(GLushort) : 2*sizeof(GLfloat);
+  vertex_size = position_size + uv_size + 2*sizeof(GLshort);
+
+  // Las posiciones de 16 bits van de -1 a 1 dentro de la caja envolvente
+  glm::vec3 center = bounds.box.Center();
+  glm::vec3 extents = glm::max(bounds.box.Extents(), glm::vec3(1e-6f));
+  dequantize = (format & Resources::mesh_position_16) ? glm::scale(glm::translate(glm::mat4(1.f), center), extents) : glm::mat4(1.f);
+
+  vector<Uint8> vertexArray(used_vertices*vertex_size, 0);
+
+  for(uint v = 0; v < num_vertices; v++)
+  {
+    if(remap[v] == (uint)-1)
+      continue;
+
+    Uint8* vertex = &vertexArray[remap[v]*vertex_size];
+
+    if(format & Resources::mesh_position_16)
+    {
+      glm::vec3 position = (positions[v] - center) / extents;
+      GLshort* out = (GLshort*)vertex;
+      out[0] = QuantizeSnorm16(position.x);
+      out[1] = QuantizeSnorm16(position.y);
+      out[2] = QuantizeSnorm16(position.z);
+      out[3] = 32767;
+    }
+    else
+      memcpy(vertex, &positions[v], sizeof(float)*3);
+
+    if(!uvs.empty())
+    {
+      const glm::vec2& uv = uvs[v];
+      if(format & Resources::mesh_uv_16)
       {
-        aiVector3D pos = mesh->mVertices[face.mIndices[j]];
-        memcpy(vertexArray,&pos,sizeof(float)*3);
-        vertexArray+=3;
+        GLushort* out = (GLushort*)(vertex + position_size);
+        out[0] = QuantizeUnorm16(uv.x);
+        out[1] = QuantizeUnorm16(uv.y);
       }
+      else
+        memcpy(vertex + position_size, &uv, sizeof(float)*2);
+    }
+
+    if(!normals.empty())
+    {
+      glm::vec2 octahedral = EncodeOctahedral(normals[v]);
+      GLshort* out = (GLshort*)(vertex + position_size + uv_size);
+      out[0] = QuantizeSnorm16(octahedral.x);
+      out[1] = QuantizeSnorm16(octahedral.y);
     }
   }
 
-  if (mesh->HasTextureCoords(0))  uvArray     -= mesh->mNumFaces*3*2;
-  if (mesh->HasNormals())         normalArray -= mesh->mNumFaces*3*3;
-  if (mesh->HasPositions())       vertexArray -= mesh->mNumFaces*3*3;
+  // Con menos de 65536 vértices, los índices caben en 16 bits
+  data_vertices = used_vertices;
+  data_indices = all_indices.size();
+  if(used_vertices <= 0xFFFF)
+  {
+    index_type = GL_UNSIGNED_SHORT;
+    index_size = sizeof(GLushort);
+    index_data.resize(data_indices * index_size);
 
+    GLushort* out = (GLushort*)&index_data[0];
+    for(uint i = 0; i < data_indices; i++)
+      out[i] = all_indices[i];
+  }
+  else
+  {
+    index_type = GL_UNSIGNED_INT;
+    index_size = sizeof(GLuint);
+    index_data.resize(data_indices * index_size);
+    memcpy(&index_data[0], &all_indices[0], data_indices * index_size);
+  }
+
+  vertex_data.swap(vertexArray);
+
+  // CSystem_Resources lo sube junto con los demás modelos del fichero
+  if(defer_upload)
+    return true;
+
+  return Upload();
+}
+
+bool CResource_Mesh::Upload()
+{
   glGenVertexArrays(1, &m_ModelVAO);
   if(!m_ModelVAO)
   {
-    gSystem_Debug.error("From CResource_Mesh: Could not generate Mesh VAO for \"%s\".", file.c_str());
+    gSystem_Debug.error("From CResource_Mesh: Could not generate Mesh VAO for \"%s\".", rc_file.c_str());
     return false;
   }
 
   glGenBuffers( 1, &m_ModelVBOVertices );
-  glGenBuffers( 1, &m_ModelVBONormals );
-  glGenBuffers( 1, &m_ModelVBOTexCoords );
-  if(!m_ModelVBOVertices or !m_ModelVBONormals or !m_ModelVBOTexCoords)
+  glGenBuffers( 1, &m_ModelIBO );
+  if(!m_ModelVBOVertices or !m_ModelIBO)
   {
-    gSystem_Debug.error("From CResource_Mesh: Could not generate Mesh VBO for \"%s\".", file.c_str());
+    gSystem_Debug.error("From CResource_Mesh: Could not generate Mesh VBO for \"%s\".", rc_file.c_str());
     return false;
   }
-  glBindVertexArray(m_ModelVAO);
+  gSystem_GL_State.BindVertexArray(m_ModelVAO);
 
-  glBindBuffer( GL_ARRAY_BUFFER, m_ModelVBOVertices  );
-  glBufferData( GL_ARRAY_BUFFER, numTriangles*3*sizeof(GLfloat), vertexArray, GL_STATIC_DRAW );
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+  glBindBuffer( GL_ARRAY_BUFFER, m_ModelVBOVertices );
+  glBufferData( GL_ARRAY_BUFFER, vertex_data.size(), &vertex_data[0], GL_STATIC_DRAW );
+  SetVertexAttributes(format, vertex_size);
 
-  glBindBuffer( GL_ARRAY_BUFFER, m_ModelVBOTexCoords );
-  glBufferData( GL_ARRAY_BUFFER, numTriangles*2*sizeof(GLfloat), uvArray, GL_STATIC_DRAW );
-  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, 0);
+  // El IBO se guarda en el VAO
+  glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_ModelIBO );
+  glBufferData( GL_ELEMENT_ARRAY_BUFFER, index_data.size(), &index_data[0], GL_STATIC_DRAW );
 
-  glBindBuffer( GL_ARRAY_BUFFER, m_ModelVBONormals );
-  glBufferData( GL_ARRAY_BUFFER, numTriangles*3*sizeof(GLfloat), normalArray, GL_STATIC_DRAW );
-  // ->BUG el fallo aparenta estar aqu, y tiene que ver con la carga de modelos de assimp. Voy a tener que meterle mano...
-  glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, 0);
+  gSystem_GL_State.BindVertexArray(0);
 
+  FreeData();
 
-  if(vertexArray) delete vertexArray;
-  if(normalArray) delete normalArray;
-  if(uvArray)     delete uvArray;
+  return true;
+}
 
-  rc_file = file;
+void CResource_Mesh::SetShared(CMesh_Buffer* buffer, GLint base, GLuint first)
+{
+  shared = buffer;
+  shared->AddUser();
+  base_vertex = base;
+  index_offset = first;
+
+  FreeData();
+}
+
+void CResource_Mesh::FreeData()
+{
+  vector<Uint8>().swap(vertex_data);
+  vector<Uint8>().swap(index_data);
+}
+
+void CResource_Mesh::SetVertexAttributes(flags_t format, GLsizei vertex_size)
+{
+  GLsizei position_size = (format & Resources::mesh_position_16) ? 4*sizeof(GLshort) : 3*sizeof(GLfloat);
+  GLsizei uv_size = (format & Resources::mesh_uv_16) ? 2*sizeof(GLushort) : 2*sizeof(GLfloat);
+
+  if(format & Resources::mesh_position_16)
+    glVertexAttribPointer(0, 4, GL_SHORT, GL_TRUE, vertex_size, 0);
+  else
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, vertex_size, 0);
+
+  if(format & Resources::mesh_uv_16)
+    glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, vertex_size, (GLvoid*)(size_t)position_size);
+  else
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, vertex_size, (GLvoid*)(size_t)position_size);
+
+  glVertexAttribPointer(2, 2, GL_SHORT, GL_TRUE, vertex_size, (GLvoid*)(size_t)(position_size + uv_size));
+}
+
+bool CResource_Mesh::GetGeometry(vector<glm::vec3>& positions, vector<glm::vec2>& uvs, vector<glm::vec3>& normals, vector<uint>& indices, uint lod)
+{
+  GLuint vbo = shared ? shared->GetVBO() : m_ModelVBOVertices;
+  GLuint ibo = shared ? shared->GetIBO() : m_ModelIBO;
+  if(!vbo or !ibo or lods.empty())
+    return false;
+
+  const lod_t& level = lods[std::min(lod, (uint)lods.size() - 1)];
+
+  // Los dos se leen desde GL_ARRAY_BUFFER, que no forma parte del VAO activo (GL_ELEMENT_ARRAY_BUFFER sí), y no necesita GL_ARB_copy_buffer
+  vector<Uint8> vertices(data_vertices * vertex_size);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glGetBufferSubData(GL_ARRAY_BUFFER, (GLintptr)base_vertex * vertex_size, vertices.size(), &vertices[0]);
+
+  vector<Uint8> index_bytes(level.count * index_size);
+  glBindBuffer(GL_ARRAY_BUFFER, ibo);
+  glGetBufferSubData(GL_ARRAY_BUFFER, (GLintptr)(index_offset + level.first) * index_size, index_bytes.size(), &index_bytes[0]);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  indices.resize(level.count);
+  for(int i = 0; i < level.count; i++)
+    indices[i] = (index_type == GL_UNSIGNED_SHORT) ? ((GLushort*)&index_bytes[0])[i] : ((GLuint*)&index_bytes[0])[i];
+
+  GLsizei position_size = (format & Resources::mesh_position_16) ? 4*sizeof(GLshort) : 3*sizeof(GLfloat);
+  GLsizei uv_size = (format & Resources::mesh_uv_16) ? 2*sizeof(GLushort) : 2*sizeof(GLfloat);
+
+  positions.resize(data_vertices);
+  uvs.resize(data_vertices);
+  normals.resize(data_vertices);
+
+  for(uint v = 0; v < data_vertices; v++)
+  {
+    const Uint8* vertex = &vertices[v * vertex_size];
+
+    if(format & Resources::mesh_position_16)
+    {
+      const GLshort* in = (const GLshort*)vertex;
+      glm::vec4 position(std::max(in[0] / 32767.f, -1.f), std::max(in[1] / 32767.f, -1.f), std::max(in[2] / 32767.f, -1.f), 1.f);
+      positions[v] = glm::vec3(dequantize * position);
+    }
+    else
+      memcpy(&positions[v], vertex, sizeof(float)*3);
+
+    if(format & Resources::mesh_uv_16)
+    {
+      const GLushort* in = (const GLushort*)(vertex + position_size);
+      uvs[v] = glm::vec2(in[0] / 65535.f, in[1] / 65535.f);
+    }
+    else
+      memcpy(&uvs[v], vertex + position_size, sizeof(float)*2);
+
+    const GLshort* in = (const GLshort*)(vertex + position_size + uv_size);
+    normals[v] = DecodeOctahedral(glm::vec2(std::max(in[0] / 32767.f, -1.f), std::max(in[1] / 32767.f, -1.f)));
+  }
 
   return true;
 }
 
+GLuint CResource_Mesh::GetVAO()
+{
+  return shared ? shared->GetVAO() : m_ModelVAO;
+}
+
 void CResource_Mesh::Clear()
 {
   /*vertexArray.clear();
@@ -163,34 +483,72 @@ void CResource_Mesh::Clear()
   uvArray.clear();*/
 
   numTriangles = 0;
+  lods.clear();
+  bounds = Culling::bounds_t();
+  format = Resources::mesh_float;
+  dequantize = glm::mat4(1.f);
+  data_vertices = data_indices = 0;
+  FreeData();
+
+  // El buffer compartido se borra con el último modelo que lo usa
+  if(shared)
+  {
+    if(shared->Release())
+      delete shared;
+
+    shared = NULL;
+    base_vertex = 0;
+    index_offset = 0;
+  }
 
   glDeleteBuffers(1, &m_ModelVBOVertices);
-  glDeleteBuffers(1, &m_ModelVBONormals);
-  glDeleteBuffers(1, &m_ModelVBOTexCoords);
+  glDeleteBuffers(1, &m_ModelIBO);
 
+  gSystem_GL_State.VertexArrayDeleted(m_ModelVAO);
   glDeleteVertexArrays(1, &m_ModelVAO);
+
+  m_ModelVBOVertices = m_ModelIBO = m_ModelVAO = 0;
 }
 
-void CResource_Mesh::Render()
+void CResource_Mesh::Render(uint lod)
 {
   //http://nickthecoder.wordpress.com/2013/01/20/mesh-loading-with-assimp/
   // Tal vez es conveniente no llamar a todas estas de golpe
 
-  glBindVertexArray(m_ModelVAO);
+  Bind();
+  Draw(lod);
+
+  glDisableVertexAttribArray(0);
+  glDisableVertexAttribArray(1);
+  glDisableVertexAttribArray(2);
+  gSystem_GL_State.BindVertexArray(0);
+}
+
+void CResource_Mesh::Bind()
+{
+  // Los atributos activos se guardan en el propio VAO
+  gSystem_GL_State.BindVertexArray(GetVAO());
   glEnableVertexAttribArray(0);
   glEnableVertexAttribArray(1);
   glEnableVertexAttribArray(2);
+}
 
-  glBindBuffer( GL_ARRAY_BUFFER, m_ModelVBOVertices );
-  glBindBuffer( GL_ARRAY_BUFFER, m_ModelVBOTexCoords );
-  glBindBuffer( GL_ARRAY_BUFFER, m_ModelVBONormals );
+uint CResource_Mesh::SelectLOD(float pixels_per_unit, float max_error, uint current)
+{
+  if(lods.empty())
+    return 0;
 
-  glDrawArrays(GL_TRIANGLES, 0, numTriangles);
+  // El nivel actual se mantiene mientras su error no pase de max_error * (1 + H) píxeles, y sólo se pasa a uno más simple si el error de
+  // este queda por debajo de max_error * (1 - H). Así, un objeto a una distancia cercana al umbral no cambia de nivel en cada iteración
+  uint lod = min(current, (uint)lods.size() - 1);
 
-  glDisableVertexAttribArray(0);
-  glDisableVertexAttribArray(1);
-  glDisableVertexAttribArray(2);
-  glBindVertexArray(0);
+  while(lod > 0 and lods[lod].error * pixels_per_unit > max_error * (1.f + __MESH_LOD_HYSTERESIS))
+    lod--;
+
+  while(lod + 1 < lods.size() and lods[lod + 1].error * pixels_per_unit <= max_error * (1.f - __MESH_LOD_HYSTERESIS))
+    lod++;
+
+  return lod;
 }
 
 /** Texture **/
@@ -223,7 +581,7 @@ bool CResource_Texture::LoadFile(string file, string arguments)
     return false;
   }
 
-  glBindTexture(GL_TEXTURE_2D, ID);
+  gSystem_GL_State.BindTexture(GL_TEXTURE_2D, ID);
   switch(flags)
   {
     case texture_linear:
@@ -244,7 +602,7 @@ bool CResource_Texture::LoadFile(string file, string arguments)
     default: break;
   }
 
-  glBindTexture(GL_TEXTURE_2D, 0);
+  gSystem_GL_State.BindTexture(GL_TEXTURE_2D, 0);
   rc_file = file;
 
   return true;
@@ -266,7 +624,7 @@ bool CResource_Texture::LoadFromMemory(GLuint* data, uint w, uint h, uint n_ch,
     return false;
   }
 
-  glBindTexture(GL_TEXTURE_2D, ID);
+  gSystem_GL_State.BindTexture(GL_TEXTURE_2D, ID);
   switch(flags)
   {
     case texture_linear:
@@ -292,6 +650,7 @@ bool CResource_Texture::LoadFromMemory(GLuint* data, uint w, uint h, uint n_ch,
 
 void CResource_Texture::Clear()
 {
+  gSystem_GL_State.TextureDeleted(ID);
   glDeleteTextures(1, &ID);
   ID = 0;
 }
@@ -368,7 +727,7 @@ void CResource_Sound::Clear()
 
 /** Resources System **/
 
-CSystem_Resources::CSystem_Resources(): CSystem()
+CSystem_Resources::CSystem_Resources(): CSystem(), share_meshes(false)
 {
 
 }
@@ -483,6 +842,9 @@ bool CSystem_Resources::LoadResourceFile(string rc_file)
     return false;
   }
 
+  // Los modelos se suben a la GPU al final, todos juntos. Se dibujan con glDrawElementsBaseVertex() (véase CSystem_Render::Init())
+  share_meshes = gSystem_Data_Storage.GetInt("__RENDER_SHARED_MESH_BUFFERS") and GLEW_ARB_draw_elements_base_vertex;
+
   while(getline(is, line, '\n'))
   {
     //gSystem_Debug.log("Linea: %s", line.c_str());
@@ -519,15 +881,78 @@ bool CSystem_Resources::LoadResourceFile(string rc_file)
 
   is.close();
 
+  if(share_meshes)
+  {
+    BuildSharedBuffers();
+    share_meshes = false;
+  }
+
   return true;
 }
 
+void CSystem_Resources::BuildSharedBuffers()
+{
+  // Un buffer por formato de vértice y tipo de índice: el VAO sólo admite un formato, y los índices de cada modelo siguen empezando en 0
+  typedef pair<flags_t, GLenum> layout_t;
+  map<layout_t, vector<CResource_Mesh*> > groups;
+
+  for(vector<CResource_Mesh*>::iterator it = shared_meshes.begin(); it != shared_meshes.end(); ++it)
+    groups[layout_t((*it)->format, (*it)->index_type)].push_back(*it);
+
+  shared_meshes.clear();
+
+  for(map<layout_t, vector<CResource_Mesh*> >::iterator it = groups.begin(); it != groups.end(); ++it)
+  {
+    vector<CResource_Mesh*>& meshes = it->second;
+
+    uint vertices = 0, indices = 0;
+    for(uint i = 0; i < meshes.size(); i++)
+    {
+      vertices += meshes[i]->data_vertices;
+      indices += meshes[i]->data_indices;
+    }
+
+    CMesh_Buffer* buffer = NULL;
+    if(meshes.size() > 1)
+    {
+      buffer = new CMesh_Buffer(it->first.first, it->first.second, meshes[0]->vertex_size);
+      if(!buffer->Create(vertices, indices))
+      {
+        delete buffer;
+        buffer = NULL;
+      }
+    }
+
+    // Un modelo solo, o sin buffer compartido: cada uno con sus propios buffers
+    for(uint i = 0; i < meshes.size(); i++)
+    {
+      CResource_Mesh* mesh = meshes[i];
+      mesh->defer_upload = false;
+
+      GLint base_vertex;
+      GLuint first_index;
+      if(buffer and buffer->Add(&mesh->vertex_data[0], mesh->data_vertices, &mesh->index_data[0], mesh->data_indices, base_vertex, first_index))
+        mesh->SetShared(buffer, base_vertex, first_index);
+      else if(!mesh->Upload())
+        gSystem_Debug.error("From CSystem_Resources: Could not upload mesh: %s", mesh->File().c_str());
+    }
+
+    if(buffer)
+      gSystem_Debug.console_msg("Shared mesh buffer: %u meshes, %u vertices, %u indices (%u KB).", (uint)meshes.size(), vertices, indices, buffer->Bytes() / 1024);
+  }
+}
+
 bool CSystem_Resources::LoadResource(string name, string rc_file, Resources::types_t type, string arguments)
 {
   // Si ya existe, borrar y poner de nuevo. Si no, crear de 0
   map<string, CResource*>::iterator it = resource_list.find(name);
   if(it != resource_list.end())
+  {
+    if(it->second)
+      shared_meshes.erase(remove(shared_meshes.begin(), shared_meshes.end(), it->second), shared_meshes.end());
+
     ClearResource(name);
+  }
 
   CResource* new_rc = NULL;
   switch(type)
@@ -539,6 +964,10 @@ bool CSystem_Resources::LoadResource(string name, string rc_file, Resources::typ
     default: gSystem_Debug.error("From CSystem_Resources: From Resource %s: Invalid resource type.", name.c_str(), rc_file.c_str()); return false;
   }
 
+  // Con buffers compartidos, el modelo no se sube a la GPU hasta el final del fichero (véase BuildSharedBuffers())
+  if(type == Resources::mesh and share_meshes)
+    ((CResource_Mesh*)new_rc)->defer_upload = true;
+
   if(!new_rc->LoadFile(rc_file, arguments))
   {
     gSystem_Debug.error("From CSystem_Resources: Could not load file: %s", rc_file.c_str());
@@ -546,11 +975,29 @@ bool CSystem_Resources::LoadResource(string name, string rc_file, Resources::typ
     return false;
   }
 
+  if(type == Resources::mesh and share_meshes)
+    shared_meshes.push_back((CResource_Mesh*)new_rc);
+
   resource_list.insert(pair<string, CResource*>(name, new_rc));
 
   return true;
 }
 
+bool CSystem_Resources::AddResource(string name, CResource* resource)
+{
+  if(!resource)
+    return false;
+
+  // Si ya existe, borrar y poner de nuevo
+  map<string, CResource*>::iterator it = resource_list.find(name);
+  if(it != resource_list.end())
+    ClearResource(name);
+
+  resource_list.insert(pair<string, CResource*>(name, resource));
+
+  return true;
+}
+
 void CSystem_Resources::AddEmpty(string name)
 {
   // Si ya existe, borrar y poner de nuevo. Si no, crear de 0
@@ -563,7 +1010,7 @@ void CSystem_Resources::AddEmpty(string name)
   resource_list.insert(pair<string, CResource*>(name, new_rc));
 }
 
-// ->xPorHacer Hay que testear la funcin CSystem_Resources::ClearNonEngineResources().
+// ->xPorHacer Hay que testear la función CSystem_Resources::ClearNonEngineResources().
 void CSystem_Resources::ClearNonEngineResources()
 {
   for(map<string, CResource*>::iterator it = resource_list.begin(); it != resource_list.end(); )
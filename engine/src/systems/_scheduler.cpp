@@ -0,0 +1,374 @@
+#include "systems/_scheduler.h"
+#include "systems/_jobs.h"
+#include "systems/_manager.h"
+#include "systems/_debug.h"
+#include "systems/_input.h"
+#include "systems/_mixer.h"
+#include "systems/_render.h"
+#include "systems/_spatial.h"
+#include "systems/_other.h"
+
+using namespace std;
+
+CSystem_Scheduler gSystem_Scheduler;
+CSystem_Scheduler& gScheduler = gSystem_Scheduler;
+
+// Sistemas del motor
+static void Scheduler_Input(void* data)
+{
+  gSystem_UserInput.OnLoop();
+}
+
+static void Scheduler_Time(void* data)
+{
+  gSystem_Time.OnLoop();
+}
+
+static void Scheduler_Behaviours(void* data)
+{
+  gSystem_GameObject_Manager.OnLoop();
+}
+
+static void Scheduler_Transforms(void* data)
+{
+  CComponent_Transform::UpdateWorldMatrices();
+}
+
+static void Scheduler_Spatial(void* data)
+{
+  gSystem_Spatial.OnLoop();
+}
+
+static void Scheduler_Mixer(void* data)
+{
+  gSystem_Mixer.OnLoop();
+}
+
+static void Scheduler_Render(void* data)
+{
+  gSystem_Render.OnLoop();
+}
+
+static void Scheduler_Component(CGameObject* go, void* data)
+{
+  go->GetComponent((Components::components_t)(size_t)data)->OnLoop();
+}
+
+bool CSystem_Scheduler::Init()
+{
+  if(enabled) return true;
+  CSystem::Init();
+
+  main_mutex = SDL_CreateMutex();
+  if(!main_mutex)
+  {
+    gSystem_Debug.error("From CSystem_Scheduler: Could not create mutex: %s", SDL_GetError());
+    return false;
+  }
+
+  AddDefaultSystems();
+
+  return true;
+}
+
+void CSystem_Scheduler::Close()
+{
+  for(vector<system_t*>::iterator it = systems.begin(); it != systems.end(); ++it)
+    delete (*it);
+  systems.clear();
+  main_queue.clear();
+  dirty = true;
+
+  gSystem_GameObject_Manager.SetScheduledComponents(0);
+
+  if(main_mutex)
+    SDL_DestroyMutex(main_mutex);
+  main_mutex = NULL;
+
+  CSystem::Close();
+}
+
+void CSystem_Scheduler::AddDefaultSystems()
+{
+  Scheduler::access_t all_components = 0;
+  for(int i = 0; i < Components::__component_not_defined; i++)
+    all_components |= Scheduler::bit((Components::components_t)i);
+
+  Add("input", &Scheduler_Input, NULL, 0, Scheduler::bit(Scheduler::input), Scheduler::main_thread);
+  Add("time", &Scheduler_Time, NULL, 0, Scheduler::bit(Scheduler::time));
+
+  // Los callbacks de usuario pueden hacer cualquier cosa (crear objetos, reproducir sonidos, cargar texturas...)
+  Add("behaviours", &Scheduler_Behaviours, NULL,
+      Scheduler::bit(Scheduler::input) | Scheduler::bit(Scheduler::time) | Scheduler::bit(Scheduler::render) | Scheduler::bit(Scheduler::spatial),
+      all_components | Scheduler::bit(Scheduler::gameobjects) | Scheduler::bit(Scheduler::audio) | Scheduler::bit(Scheduler::behaviours),
+      Scheduler::main_thread);
+
+  // Matrices de mundo, una vez por iteración. A partir de aquí, el resto de sistemas sólo leen la caché
+  Add("transforms", &Scheduler_Transforms, NULL,
+      Scheduler::bit(Scheduler::gameobjects),
+      Scheduler::bit(Components::transform));
+
+  AddQuery("particles", Components::bit(Components::particle_emitter), &Scheduler_Component, (void*)(size_t)Components::particle_emitter,
+           Scheduler::bit(Components::transform) | Scheduler::bit(Scheduler::time),
+           Scheduler::bit(Components::particle_emitter), Scheduler::parallel);
+
+  // Las fuentes y el mixer comparten el estado de error de OpenAL (alGetError) y las opciones de CSystem_Data_Storage: ambos escriben "audio",
+  // así que nunca se ejecutan a la vez
+  AddQuery("audio_sources", Components::bit(Components::audio_source), &Scheduler_Component, (void*)(size_t)Components::audio_source,
+           Scheduler::bit(Components::transform) | Scheduler::bit(Scheduler::time),
+           Scheduler::bit(Components::audio_source) | Scheduler::bit(Scheduler::audio));
+
+  // Índice espacial, con las matrices de mundo y las partículas de esta iteración. Escribe la caché de volúmenes de CComponent_Mesh_Render
+  Add("spatial", &Scheduler_Spatial, NULL,
+      Scheduler::bit(Components::transform) | Scheduler::bit(Components::particle_emitter) | Scheduler::bit(Components::dummy) |
+      Scheduler::bit(Scheduler::gameobjects),
+      Scheduler::bit(Components::mesh_render) | Scheduler::bit(Scheduler::spatial));
+
+  Add("mixer", &Scheduler_Mixer, NULL,
+      Scheduler::bit(Components::transform) | Scheduler::bit(Components::camera) | Scheduler::bit(Scheduler::render),
+      Scheduler::bit(Scheduler::audio));
+
+  Add("render", &Scheduler_Render, NULL,
+      all_components | Scheduler::bit(Scheduler::gameobjects) | Scheduler::bit(Scheduler::spatial),
+      Scheduler::bit(Scheduler::render), Scheduler::main_thread);
+
+  gSystem_GameObject_Manager.SetScheduledComponents(Components::bit(Components::particle_emitter) | Components::bit(Components::audio_source));
+}
+
+CSystem_Scheduler::system_t* CSystem_Scheduler::Find(const string& name)
+{
+  for(vector<system_t*>::iterator it = systems.begin(); it != systems.end(); ++it)
+    if((*it)->name == name)
+      return (*it);
+
+  return NULL;
+}
+
+bool CSystem_Scheduler::Add(system_t* system)
+{
+  if(Find(system->name))
+  {
+    gSystem_Debug.console_error_msg("From CSystem_Scheduler: System \"%s\" already exists.", system->name.c_str());
+    delete system;
+    return false;
+  }
+
+  system->num_dependencies = 0;
+  SDL_AtomicSet(&system->pending, 0);
+
+  systems.push_back(system);
+  dirty = true;
+
+  return true;
+}
+
+bool CSystem_Scheduler::Add(const string& name, scheduler_function_t function, void* data, Scheduler::access_t reads, Scheduler::access_t writes, flags_t flags)
+{
+  if(!function)
+    return false;
+
+  system_t* system = new system_t;
+  system->name = name;
+  system->function = function;
+  system->query_function = NULL;
+  system->query = 0;
+  system->data = data;
+  system->reads = reads;
+  system->writes = writes;
+  system->flags = flags;
+
+  return Add(system);
+}
+
+bool CSystem_Scheduler::AddQuery(const string& name, Components::signature_t query, scheduler_query_function_t function, void* data, Scheduler::access_t reads, Scheduler::access_t writes, flags_t flags)
+{
+  if(!function)
+    return false;
+
+  system_t* system = new system_t;
+  system->name = name;
+  system->function = NULL;
+  system->query_function = function;
+  system->query = query;
+  system->data = data;
+  system->reads = reads | Scheduler::bit(Scheduler::gameobjects); // Recorre la lista de objetos
+  system->writes = writes;
+  system->flags = flags;
+
+  return Add(system);
+}
+
+bool CSystem_Scheduler::Remove(const string& name)
+{
+  for(vector<system_t*>::iterator it = systems.begin(); it != systems.end(); ++it)
+  {
+    if((*it)->name == name)
+    {
+      delete (*it);
+      systems.erase(it);
+      dirty = true;
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool CSystem_Scheduler::SetAccess(const string& name, Scheduler::access_t reads, Scheduler::access_t writes)
+{
+  system_t* system = Find(name);
+  if(!system)
+    return false;
+
+  system->reads = reads;
+  if(system->query_function)
+    system->reads |= Scheduler::bit(Scheduler::gameobjects);
+  system->writes = writes;
+  dirty = true;
+
+  return true;
+}
+
+void CSystem_Scheduler::BuildGraph()
+{
+  for(vector<system_t*>::iterator it = systems.begin(); it != systems.end(); ++it)
+  {
+    (*it)->dependents.clear();
+    (*it)->num_dependencies = 0;
+  }
+
+  // Si dos sistemas acceden a lo mismo y uno lo escribe, se respeta el orden de registro
+  for(uint i = 0; i < systems.size(); i++)
+  {
+    system_t* a = systems[i];
+    for(uint j = i + 1; j < systems.size(); j++)
+    {
+      system_t* b = systems[j];
+      if((a->writes & (b->reads | b->writes)) or (b->writes & a->reads))
+      {
+        a->dependents.push_back(b);
+        b->num_dependencies++;
+      }
+    }
+  }
+
+  dirty = false;
+}
+
+void CSystem_Scheduler::OnLoop()
+{
+  if(systems.empty())
+    return;
+
+  if(dirty)
+    BuildGraph();
+
+  SDL_AtomicSet(&remaining, systems.size());
+  for(vector<system_t*>::iterator it = systems.begin(); it != systems.end(); ++it)
+    SDL_AtomicSet(&(*it)->pending, (*it)->num_dependencies);
+
+  for(vector<system_t*>::iterator it = systems.begin(); it != systems.end(); ++it)
+    if((*it)->num_dependencies == 0)
+      Launch(*it);
+
+  // El hilo principal ejecuta sus sistemas y, mientras tanto, ayuda con las tareas de los demás
+  while(SDL_AtomicGet(&remaining) > 0)
+  {
+    system_t* system = NULL;
+
+    SDL_LockMutex(main_mutex);
+    if(!main_queue.empty())
+    {
+      system = main_queue.front();
+      main_queue.erase(main_queue.begin());
+    }
+    SDL_UnlockMutex(main_mutex);
+
+    if(system)
+      Execute(system);
+    else if(!gSystem_Jobs.Help())
+      SDL_Delay(0);
+  }
+
+  // Punto de sincronización: cambios estructurales pedidos durante la iteración
+  gSystem_GameObject_Manager.ApplyCommands();
+}
+
+void CSystem_Scheduler::Launch(system_t* system)
+{
+  if(system->flags & Scheduler::main_thread)
+  {
+    SDL_LockMutex(main_mutex);
+    main_queue.push_back(system);
+    SDL_UnlockMutex(main_mutex);
+  }
+  else
+    gSystem_Jobs.Run(&CSystem_Scheduler::SystemJob, system, 0, 0, NULL);
+}
+
+void CSystem_Scheduler::SystemJob(void* data, uint begin, uint end)
+{
+  gSystem_Scheduler.Execute((system_t*)data);
+}
+
+void CSystem_Scheduler::Execute(system_t* system)
+{
+  if(system->function)
+    system->function(system->data);
+  else
+    ExecuteQuery(system);
+
+  for(vector<system_t*>::iterator it = system->dependents.begin(); it != system->dependents.end(); ++it)
+    if(SDL_AtomicAdd(&(*it)->pending, -1) == 1)
+      Launch(*it);
+
+  SDL_AtomicAdd(&remaining, -1);
+}
+
+void CSystem_Scheduler::QueryJob(void* data, uint begin, uint end)
+{
+  system_t* system = (system_t*)data;
+  for(uint i = begin; i < end; i++)
+    system->query_function(system->objects[i], system->data);
+}
+
+void CSystem_Scheduler::ExecuteQuery(system_t* system)
+{
+  vector<CGameObject*>& gameObjects = gSystem_GameObject_Manager.gameObjects;
+
+  system->objects.clear();
+  for(uint i = 0; i < gameObjects.size(); i++)
+    if(gameObjects[i]->IsEnabled() and gameObjects[i]->IsInited() and gameObjects[i]->HasComponents(system->query))
+      system->objects.push_back(gameObjects[i]);
+
+  if(system->objects.empty())
+    return;
+
+  if(system->flags & Scheduler::parallel)
+    gSystem_Jobs.ParallelFor(&CSystem_Scheduler::QueryJob, system, 0, system->objects.size());
+  else
+    QueryJob(system, 0, system->objects.size());
+}
+
+void CSystem_Scheduler::PrintGraph()
+{
+  if(dirty)
+    BuildGraph();
+
+  gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "Scheduler systems (%d threads)", gSystem_Jobs.NumThreads());
+  gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "-------------------");
+  gSystem_Debug.console_custom_msg(0.75f, 0.75f, 0.75f, 1.f, " <Name> [main/parallel] -> <Dependents>");
+
+  for(vector<system_t*>::iterator it = systems.begin(); it != systems.end(); ++it)
+  {
+    string deps = "";
+    for(vector<system_t*>::iterator d = (*it)->dependents.begin(); d != (*it)->dependents.end(); ++d)
+      deps += (*d)->name + " ";
+
+    gSystem_Debug.console_msg(" %s%s%s -> %s", (*it)->name.c_str(),
+                              ((*it)->flags & Scheduler::main_thread) ? " [main]" : "",
+                              ((*it)->flags & Scheduler::parallel) ? " [parallel]" : "",
+                              deps.c_str());
+  }
+}
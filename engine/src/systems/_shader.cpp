@@ -1,16 +1,32 @@
 #include "systems/_shader.h"
 #include "systems/_debug.h"
+#include "systems/_other.h"
+#include "systems/_gl_state.h"
 
 CSystem_Shader_Manager gSystem_Shader_Manager;
 CSystem_Shader_Manager& gShader = gSystem_Shader_Manager;
 
 using namespace std;
 
+static const char* uniforms_s[] = {"ProjMatrix", "ModelViewMatrix", "NormalMatrix", "in_Color", "texture", "textureFlag", "not_defined"};
+
+const char* Shader::uniform_to_string(uniform_t u)
+{
+  if(u < proj_matrix or u >= __uniform_not_defined)
+    u = __uniform_not_defined;
+
+  return uniforms_s[u];
+}
+
 CShader::CShader()
 {
   shader_variables.clear();
   VertexShader =  GeometricShader = FragmentShader = Program = 0;
   link_status = false;
+
+  for(uint i = 0; i < Shader::__uniform_not_defined; i++)
+    uniforms[i] = -1;
+  camera_block = false;
 }
 
 CShader::~CShader()
@@ -51,6 +67,17 @@ int CShader::GetVariableIndex(const string& varname, bool isUniform)
   return output;
 }
 
+void CShader::ResolveUniforms()
+{
+  for(uint i = 0; i < Shader::__uniform_not_defined; i++)
+    uniforms[i] = glGetUniformLocation(Program, Shader::uniform_to_string((Shader::uniform_t)i));
+
+  GLuint block = glGetUniformBlockIndex(Program, "CameraData");
+  camera_block = (block != GL_INVALID_INDEX);
+  if(camera_block)
+    glUniformBlockBinding(Program, block, __SHADER_CAMERA_BLOCK_BINDING);
+}
+
 // Shader manager
 /*class CSystem_Shader_Manager: public CSystem
 {
@@ -92,6 +119,18 @@ bool CSystem_Shader_Manager::Init()
   //CShader* theDefaultShader = new CShader();
   //shaders[DEFAULT_SHADER] = theDefaultShader;
 
+  glGenBuffers(1, &camera_ubo);
+  if(!camera_ubo)
+  {
+    gSystem_Debug.error("From Shader Manager: Could not generate camera UBO.");
+    return false;
+  }
+
+  glBindBuffer(GL_UNIFORM_BUFFER, camera_ubo);
+  glBufferData(GL_UNIFORM_BUFFER, sizeof(camera_block_t), NULL, GL_DYNAMIC_DRAW);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+  glBindBufferBase(GL_UNIFORM_BUFFER, __SHADER_CAMERA_BLOCK_BINDING, camera_ubo);
+
   CSystem::Init();
 
   return true;
@@ -184,7 +223,7 @@ bool CSystem_Shader_Manager::InitMainShaders()
   // http://stackoverflow.com/questions/6686741/fragment-shader-glsl-for-texture-color-and-texture-color
   const char* __textureShader_VertexCode[] =
   {
-    "uniform mat4 ProjMatrix;"
+    __SHADER_CAMERA_BLOCK
     "uniform mat4 ModelViewMatrix;"
     "uniform float textureFlag;"
     "uniform vec4 in_Color;"
@@ -231,6 +270,48 @@ bool CSystem_Shader_Manager::InitMainShaders()
   if(!gSystem_Shader_Manager.LinkShader("__textureShader"))
     return false;
 
+  // -----------------------------------------------------
+
+    // Texture shader, instanced
+  // Igual que __textureShader, pero la matriz de modelo-vista, el color y textureFlag vienen de cada instancia (véase CRender_Queue)
+  const char* __textureInstancedShader_VertexCode[] =
+  {
+    __SHADER_CAMERA_BLOCK
+
+    "attribute vec4 in_Position;"
+    "attribute vec2 in_TexCoords;"
+    "attribute mat4 in_ModelViewMatrix;"
+    "attribute vec4 in_Color;"
+    "attribute float in_TextureFlag;"
+
+    "varying vec2 frag_TexCoords;"
+    "varying vec4 frag_Color;"
+    "varying float frag_textureFlag;"
+
+    "void main(void)"
+    "{"
+        "mat4 MVPMatrix = ProjMatrix * in_ModelViewMatrix;"
+        "gl_Position = MVPMatrix * in_Position;"
+
+        "frag_TexCoords = in_TexCoords;"
+        "frag_Color = in_Color;"
+        "frag_textureFlag = in_TextureFlag;"
+    "}"
+  };
+
+  shader = gSystem_Shader_Manager.LoadShaderStr("__textureInstancedShader", __textureInstancedShader_VertexCode, __textureShader_FragmentCode);
+  if(!shader)
+    return false;
+
+  glBindAttribLocation(shader->GetProgram(), 0, "in_Position");
+  glBindAttribLocation(shader->GetProgram(), 1, "in_TexCoords");
+  glBindAttribLocation(shader->GetProgram(), 3, "in_ModelViewMatrix"); // Ocupa de la 3 a la 6
+  glBindAttribLocation(shader->GetProgram(), 7, "in_Color");
+  glBindAttribLocation(shader->GetProgram(), 8, "in_TextureFlag");
+
+  if(!gSystem_Shader_Manager.LinkShader("__textureInstancedShader"))
+    return false;
+
   // -----------------------------------------------------
 
     // Simple GLU shader
@@ -251,7 +332,7 @@ bool CSystem_Shader_Manager::InitMainShaders()
     "varying vec2 frag_TexCoords;"
     "varying float frag_textureFlag;"
 
-    // Recomiendo meter todas las funciones de transformacin en una nica que haga todas las cosas.
+    // Recomiendo meter todas las funciones de transformación en una única que haga todas las cosas.
 
     "mat4 translate(mat4 m, vec3 v)"
     "{"
@@ -392,6 +473,9 @@ void CSystem_Shader_Manager::Close()
     delete iter->second;
   }
   shaders.clear();
+
+  glDeleteBuffers(1, &camera_ubo);
+  camera_ubo = 0;
 }
 
 bool CSystem_Shader_Manager::Reset()
@@ -414,7 +498,7 @@ CShader* CSystem_Shader_Manager::UseShader(const string& name)
 {
   if(name == "")
   {
-    glUseProgram(0);
+    gSystem_GL_State.UseProgram(0);
     last_shader_used = name;
 
     return NULL;
@@ -424,9 +508,11 @@ CShader* CSystem_Shader_Manager::UseShader(const string& name)
     CShader* r_shader = GetShader(name);
     if(r_shader)
     {
+      // La caché de estado evita la llamada si el programa ya está activo, aunque se haya activado por otro camino
+      gSystem_GL_State.UseProgram(r_shader->GetProgram());
+
       if(name != last_shader_used)
       {
-        glUseProgram(r_shader->GetProgram());
         last_shader_used = name;
 
         if(r_shader == shaders[DEFAULT_SHADER] and name != DEFAULT_SHADER)
@@ -438,6 +524,19 @@ CShader* CSystem_Shader_Manager::UseShader(const string& name)
   }
 }
 
+void CSystem_Shader_Manager::SetCamera(const glm::mat4& projMatrix, const glm::mat4& viewMatrix, const glm::mat4& viewNormalMatrix)
+{
+  camera_block_t data;
+  data.projMatrix = projMatrix;
+  data.viewMatrix = viewMatrix;
+  data.viewNormalMatrix = viewNormalMatrix;
+  data.time = glm::vec4(gSystem_Time.GetTicks_s(), gSystem_Time.deltaTime_s(), 0.f, 0.f);
+
+  glBindBuffer(GL_UNIFORM_BUFFER, camera_ubo);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(camera_block_t), &data);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
 CShader* CSystem_Shader_Manager::LoadShader(const std::string& name, const std::string& vertFile, const std::string& fragFile, const std::string& geomFile)
 {
   CShader* r_shader = Load(name, vertFile, fragFile, geomFile);
@@ -489,6 +588,7 @@ CShader* CSystem_Shader_Manager::LinkShader(const string& name)
     }
 
     it->second->link_status = true;
+    it->second->ResolveUniforms();
     // the program has been loaded/linked successfully
 
     return it->second;
@@ -538,6 +638,7 @@ void CSystem_Shader_Manager::Clear(CShader* inShader)
 {
   if (inShader->GetProgram() != 0)
   {
+    gSystem_GL_State.ProgramDeleted(inShader->GetProgram());
     glDeleteProgram(inShader->GetProgram());
   }
 
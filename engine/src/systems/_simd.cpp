@@ -0,0 +1,597 @@
+#include "systems/_simd.h"
+#include "systems/_debug.h"
+
+#if (defined(__GNUC__) or defined(__clang__)) and (defined(__x86_64__) or defined(__i386__))
+  #define __SIMD_X86
+  #include <immintrin.h>
+
+  // Cada kernel se compila para su conjunto de instrucciones, sin cambiar las opciones del resto del motor
+  #define __SIMD_TARGET(set) __attribute__((target(set)))
+#endif
+
+using namespace std;
+
+static SIMD::instruction_set_t current_set = SIMD::__instruction_set_not_defined;
+
+const char* SIMD::instruction_set_to_string(instruction_set_t set)
+{
+  switch(set)
+  {
+    case scalar: return "scalar";
+    case sse:    return "sse";
+    case avx2:   return "avx2";
+    default:     return "not defined";
+  }
+}
+
+SIMD::instruction_set_t SIMD::Best()
+{
+#ifdef __SIMD_X86
+  #if SDL_VERSION_ATLEAST(2, 0, 4)
+  if(SDL_HasAVX2())
+    return avx2;
+  #endif
+  if(SDL_HasSSE2())
+    return sse;
+#endif
+
+  return scalar;
+}
+
+SIMD::instruction_set_t SIMD::Current()
+{
+  if(current_set == __instruction_set_not_defined)
+    current_set = Best();
+
+  return current_set;
+}
+
+SIMD::instruction_set_t SIMD::SetCurrent(instruction_set_t set)
+{
+  if(set < scalar or set > Best())
+    set = Best();
+
+  current_set = set;
+  return current_set;
+}
+
+/* ESCALAR */
+
+static void ComposeTRS_scalar(const vector3f* position, const glm::quat* angle, const vector3f* scale, glm::mat4* output, const uint* indices, uint count)
+{
+  for(uint n = 0; n < count; n++)
+  {
+    uint i = indices[n];
+    const glm::quat& q = angle[i];
+    float* m = &output[i][0][0];
+
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    m[0]  = (1.f - 2.f * (yy + zz)) * scale[i].x;
+    m[1]  = 2.f * (xy + wz) * scale[i].x;
+    m[2]  = 2.f * (xz - wy) * scale[i].x;
+    m[3]  = 0.f;
+
+    m[4]  = 2.f * (xy - wz) * scale[i].y;
+    m[5]  = (1.f - 2.f * (xx + zz)) * scale[i].y;
+    m[6]  = 2.f * (yz + wx) * scale[i].y;
+    m[7]  = 0.f;
+
+    m[8]  = 2.f * (xz + wy) * scale[i].z;
+    m[9]  = 2.f * (yz - wx) * scale[i].z;
+    m[10] = (1.f - 2.f * (xx + yy)) * scale[i].z;
+    m[11] = 0.f;
+
+    m[12] = position[i].x;
+    m[13] = position[i].y;
+    m[14] = position[i].z;
+    m[15] = 1.f;
+  }
+}
+
+static void MultiplyMatrices_scalar(const glm::mat4* const* left, const glm::mat4* const* right, glm::mat4* const* output, uint count)
+{
+  for(uint n = 0; n < count; n++)
+  {
+    const float* a = &(*left[n])[0][0];
+    const float* b = &(*right[n])[0][0];
+    float* o = &(*output[n])[0][0];
+
+    for(int j = 0; j < 4; j++)
+      for(int r = 0; r < 4; r++)
+        o[4*j + r] = a[r] * b[4*j] + a[4 + r] * b[4*j + 1] + a[8 + r] * b[4*j + 2] + a[12 + r] * b[4*j + 3];
+  }
+}
+
+static void NormalMatrices_scalar(const glm::mat4* const* input, glm::mat4* const* output, uint count)
+{
+  for(uint n = 0; n < count; n++)
+  {
+    const float* m = &(*input[n])[0][0];
+    float* o = &(*output[n])[0][0];
+
+    // Columnas de la parte 3x3 (a0, a1, a2) y traslación (t)
+    const float* a0 = m;
+    const float* a1 = m + 4;
+    const float* a2 = m + 8;
+    const float* t = m + 12;
+
+    // La inversa traspuesta de la parte 3x3 tiene por columnas a1 x a2, a2 x a0 y a0 x a1, entre el determinante
+    float c[3][3] =
+    {
+      {a1[1] * a2[2] - a1[2] * a2[1], a1[2] * a2[0] - a1[0] * a2[2], a1[0] * a2[1] - a1[1] * a2[0]},
+      {a2[1] * a0[2] - a2[2] * a0[1], a2[2] * a0[0] - a2[0] * a0[2], a2[0] * a0[1] - a2[1] * a0[0]},
+      {a0[1] * a1[2] - a0[2] * a1[1], a0[2] * a1[0] - a0[0] * a1[2], a0[0] * a1[1] - a0[1] * a1[0]}
+    };
+
+    float det = a0[0] * c[0][0] + a0[1] * c[0][1] + a0[2] * c[0][2];
+    float inv = (det != 0.f) ? 1.f / det : 0.f;
+
+    for(int i = 0; i < 3; i++)
+    {
+      o[4*i]     = c[i][0] * inv;
+      o[4*i + 1] = c[i][1] * inv;
+      o[4*i + 2] = c[i][2] * inv;
+      o[4*i + 3] = -(o[4*i] * t[0] + o[4*i + 1] * t[1] + o[4*i + 2] * t[2]);
+    }
+
+    o[12] = o[13] = o[14] = 0.f;
+    o[15] = 1.f;
+  }
+}
+
+#ifdef __SIMD_X86
+
+/* SSE: 4 objetos por lote */
+
+// Las variables a, b, c y d contienen la misma fila de 4 objetos. Se trasponen para guardar la columna "column" de cada objeto.
+__SIMD_TARGET("sse2") static inline void Store4(glm::mat4* output, const uint* indices, int column, __m128 a, __m128 b, __m128 c, __m128 d)
+{
+  _MM_TRANSPOSE4_PS(a, b, c, d);
+  _mm_storeu_ps(&output[indices[0]][column][0], a);
+  _mm_storeu_ps(&output[indices[1]][column][0], b);
+  _mm_storeu_ps(&output[indices[2]][column][0], c);
+  _mm_storeu_ps(&output[indices[3]][column][0], d);
+}
+
+__SIMD_TARGET("sse2") static inline void Store4(glm::mat4* const* output, int column, __m128 a, __m128 b, __m128 c, __m128 d)
+{
+  _MM_TRANSPOSE4_PS(a, b, c, d);
+  _mm_storeu_ps(&(*output[0])[column][0], a);
+  _mm_storeu_ps(&(*output[1])[column][0], b);
+  _mm_storeu_ps(&(*output[2])[column][0], c);
+  _mm_storeu_ps(&(*output[3])[column][0], d);
+}
+
+// Inverso de Store4(): carga la columna "column" de 4 matrices y la devuelve como 4 filas (x, y, z, w) de 4 objetos
+__SIMD_TARGET("sse2") static inline void Load4(const glm::mat4* const* input, int column, __m128& x, __m128& y, __m128& z, __m128& w)
+{
+  x = _mm_loadu_ps(&(*input[0])[column][0]);
+  y = _mm_loadu_ps(&(*input[1])[column][0]);
+  z = _mm_loadu_ps(&(*input[2])[column][0]);
+  w = _mm_loadu_ps(&(*input[3])[column][0]);
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+}
+
+__SIMD_TARGET("sse2") static void ComposeTRS_sse(const vector3f* position, const glm::quat* angle, const vector3f* scale, glm::mat4* output, const uint* indices, uint count)
+{
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 zero = _mm_setzero_ps();
+
+  uint n = 0;
+  for(; n + 4 <= count; n += 4)
+  {
+    const uint* id = indices + n;
+
+    __m128 qx = _mm_setr_ps(angle[id[0]].x, angle[id[1]].x, angle[id[2]].x, angle[id[3]].x);
+    __m128 qy = _mm_setr_ps(angle[id[0]].y, angle[id[1]].y, angle[id[2]].y, angle[id[3]].y);
+    __m128 qz = _mm_setr_ps(angle[id[0]].z, angle[id[1]].z, angle[id[2]].z, angle[id[3]].z);
+    __m128 qw = _mm_setr_ps(angle[id[0]].w, angle[id[1]].w, angle[id[2]].w, angle[id[3]].w);
+
+    __m128 sx = _mm_setr_ps(scale[id[0]].x, scale[id[1]].x, scale[id[2]].x, scale[id[3]].x);
+    __m128 sy = _mm_setr_ps(scale[id[0]].y, scale[id[1]].y, scale[id[2]].y, scale[id[3]].y);
+    __m128 sz = _mm_setr_ps(scale[id[0]].z, scale[id[1]].z, scale[id[2]].z, scale[id[3]].z);
+
+    __m128 px = _mm_setr_ps(position[id[0]].x, position[id[1]].x, position[id[2]].x, position[id[3]].x);
+    __m128 py = _mm_setr_ps(position[id[0]].y, position[id[1]].y, position[id[2]].y, position[id[3]].y);
+    __m128 pz = _mm_setr_ps(position[id[0]].z, position[id[1]].z, position[id[2]].z, position[id[3]].z);
+
+    __m128 x2 = _mm_add_ps(qx, qx), y2 = _mm_add_ps(qy, qy), z2 = _mm_add_ps(qz, qz);
+    __m128 xx = _mm_mul_ps(qx, x2), yy = _mm_mul_ps(qy, y2), zz = _mm_mul_ps(qz, z2);
+    __m128 xy = _mm_mul_ps(qx, y2), xz = _mm_mul_ps(qx, z2), yz = _mm_mul_ps(qy, z2);
+    __m128 wx = _mm_mul_ps(qw, x2), wy = _mm_mul_ps(qw, y2), wz = _mm_mul_ps(qw, z2);
+
+    Store4(output, id, 0,
+           _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx),
+           _mm_mul_ps(_mm_add_ps(xy, wz), sx),
+           _mm_mul_ps(_mm_sub_ps(xz, wy), sx),
+           zero);
+    Store4(output, id, 1,
+           _mm_mul_ps(_mm_sub_ps(xy, wz), sy),
+           _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy),
+           _mm_mul_ps(_mm_add_ps(yz, wx), sy),
+           zero);
+    Store4(output, id, 2,
+           _mm_mul_ps(_mm_add_ps(xz, wy), sz),
+           _mm_mul_ps(_mm_sub_ps(yz, wx), sz),
+           _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz),
+           zero);
+    Store4(output, id, 3, px, py, pz, one);
+  }
+
+  ComposeTRS_scalar(position, angle, scale, output, indices + n, count - n);
+}
+
+__SIMD_TARGET("sse2") static void MultiplyMatrices_sse(const glm::mat4* const* left, const glm::mat4* const* right, glm::mat4* const* output, uint count)
+{
+  for(uint n = 0; n < count; n++)
+  {
+    const float* a = &(*left[n])[0][0];
+    const float* b = &(*right[n])[0][0];
+    float* o = &(*output[n])[0][0];
+
+    __m128 a0 = _mm_loadu_ps(a);
+    __m128 a1 = _mm_loadu_ps(a + 4);
+    __m128 a2 = _mm_loadu_ps(a + 8);
+    __m128 a3 = _mm_loadu_ps(a + 12);
+
+    // Columna j del resultado: combinación de las columnas de "left" con los pesos de la columna j de "right"
+    for(int j = 0; j < 4; j++)
+    {
+      __m128 r = _mm_mul_ps(a0, _mm_set1_ps(b[4*j]));
+      r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b[4*j + 1])));
+      r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b[4*j + 2])));
+      r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b[4*j + 3])));
+      _mm_storeu_ps(o + 4*j, r);
+    }
+  }
+}
+
+__SIMD_TARGET("sse2") static void NormalMatrices_sse(const glm::mat4* const* input, glm::mat4* const* output, uint count)
+{
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 zero = _mm_setzero_ps();
+
+  uint n = 0;
+  for(; n + 4 <= count; n += 4)
+  {
+    __m128 a0x, a0y, a0z, a0w, a1x, a1y, a1z, a1w, a2x, a2y, a2z, a2w, tx, ty, tz, tw;
+    Load4(input + n, 0, a0x, a0y, a0z, a0w);
+    Load4(input + n, 1, a1x, a1y, a1z, a1w);
+    Load4(input + n, 2, a2x, a2y, a2z, a2w);
+    Load4(input + n, 3, tx, ty, tz, tw);
+
+    // c0 = a1 x a2, c1 = a2 x a0, c2 = a0 x a1
+    __m128 c0x = _mm_sub_ps(_mm_mul_ps(a1y, a2z), _mm_mul_ps(a1z, a2y));
+    __m128 c0y = _mm_sub_ps(_mm_mul_ps(a1z, a2x), _mm_mul_ps(a1x, a2z));
+    __m128 c0z = _mm_sub_ps(_mm_mul_ps(a1x, a2y), _mm_mul_ps(a1y, a2x));
+    __m128 c1x = _mm_sub_ps(_mm_mul_ps(a2y, a0z), _mm_mul_ps(a2z, a0y));
+    __m128 c1y = _mm_sub_ps(_mm_mul_ps(a2z, a0x), _mm_mul_ps(a2x, a0z));
+    __m128 c1z = _mm_sub_ps(_mm_mul_ps(a2x, a0y), _mm_mul_ps(a2y, a0x));
+    __m128 c2x = _mm_sub_ps(_mm_mul_ps(a0y, a1z), _mm_mul_ps(a0z, a1y));
+    __m128 c2y = _mm_sub_ps(_mm_mul_ps(a0z, a1x), _mm_mul_ps(a0x, a1z));
+    __m128 c2z = _mm_sub_ps(_mm_mul_ps(a0x, a1y), _mm_mul_ps(a0y, a1x));
+
+    __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0x, c0x), _mm_mul_ps(a0y, c0y)), _mm_mul_ps(a0z, c0z));
+    __m128 inv = _mm_and_ps(_mm_div_ps(one, det), _mm_cmpneq_ps(det, zero));
+
+    c0x = _mm_mul_ps(c0x, inv); c0y = _mm_mul_ps(c0y, inv); c0z = _mm_mul_ps(c0z, inv);
+    c1x = _mm_mul_ps(c1x, inv); c1y = _mm_mul_ps(c1y, inv); c1z = _mm_mul_ps(c1z, inv);
+    c2x = _mm_mul_ps(c2x, inv); c2y = _mm_mul_ps(c2y, inv); c2z = _mm_mul_ps(c2z, inv);
+
+    __m128 w0 = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0x, tx), _mm_mul_ps(c0y, ty)), _mm_mul_ps(c0z, tz)));
+    __m128 w1 = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(c1x, tx), _mm_mul_ps(c1y, ty)), _mm_mul_ps(c1z, tz)));
+    __m128 w2 = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(c2x, tx), _mm_mul_ps(c2y, ty)), _mm_mul_ps(c2z, tz)));
+
+    Store4(output + n, 0, c0x, c0y, c0z, w0);
+    Store4(output + n, 1, c1x, c1y, c1z, w1);
+    Store4(output + n, 2, c2x, c2y, c2z, w2);
+    Store4(output + n, 3, zero, zero, zero, one);
+  }
+
+  NormalMatrices_scalar(input + n, output + n, count - n);
+}
+
+/* AVX2: 8 objetos por lote */
+
+__SIMD_TARGET("avx2") static inline void Store8(glm::mat4* output, const uint* indices, int column, __m256 a, __m256 b, __m256 c, __m256 d)
+{
+  __m128 a_lo = _mm256_castps256_ps128(a), b_lo = _mm256_castps256_ps128(b), c_lo = _mm256_castps256_ps128(c), d_lo = _mm256_castps256_ps128(d);
+  __m128 a_hi = _mm256_extractf128_ps(a, 1), b_hi = _mm256_extractf128_ps(b, 1), c_hi = _mm256_extractf128_ps(c, 1), d_hi = _mm256_extractf128_ps(d, 1);
+
+  _MM_TRANSPOSE4_PS(a_lo, b_lo, c_lo, d_lo);
+  _MM_TRANSPOSE4_PS(a_hi, b_hi, c_hi, d_hi);
+
+  _mm_storeu_ps(&output[indices[0]][column][0], a_lo);
+  _mm_storeu_ps(&output[indices[1]][column][0], b_lo);
+  _mm_storeu_ps(&output[indices[2]][column][0], c_lo);
+  _mm_storeu_ps(&output[indices[3]][column][0], d_lo);
+  _mm_storeu_ps(&output[indices[4]][column][0], a_hi);
+  _mm_storeu_ps(&output[indices[5]][column][0], b_hi);
+  _mm_storeu_ps(&output[indices[6]][column][0], c_hi);
+  _mm_storeu_ps(&output[indices[7]][column][0], d_hi);
+}
+
+__SIMD_TARGET("avx2") static inline void Store8(glm::mat4* const* output, int column, __m256 a, __m256 b, __m256 c, __m256 d)
+{
+  __m128 a_lo = _mm256_castps256_ps128(a), b_lo = _mm256_castps256_ps128(b), c_lo = _mm256_castps256_ps128(c), d_lo = _mm256_castps256_ps128(d);
+  __m128 a_hi = _mm256_extractf128_ps(a, 1), b_hi = _mm256_extractf128_ps(b, 1), c_hi = _mm256_extractf128_ps(c, 1), d_hi = _mm256_extractf128_ps(d, 1);
+
+  _MM_TRANSPOSE4_PS(a_lo, b_lo, c_lo, d_lo);
+  _MM_TRANSPOSE4_PS(a_hi, b_hi, c_hi, d_hi);
+
+  _mm_storeu_ps(&(*output[0])[column][0], a_lo);
+  _mm_storeu_ps(&(*output[1])[column][0], b_lo);
+  _mm_storeu_ps(&(*output[2])[column][0], c_lo);
+  _mm_storeu_ps(&(*output[3])[column][0], d_lo);
+  _mm_storeu_ps(&(*output[4])[column][0], a_hi);
+  _mm_storeu_ps(&(*output[5])[column][0], b_hi);
+  _mm_storeu_ps(&(*output[6])[column][0], c_hi);
+  _mm_storeu_ps(&(*output[7])[column][0], d_hi);
+}
+
+__SIMD_TARGET("avx2") static inline void Load8(const glm::mat4* const* input, int column, __m256& x, __m256& y, __m256& z, __m256& w)
+{
+  __m128 x_lo = _mm_loadu_ps(&(*input[0])[column][0]), y_lo = _mm_loadu_ps(&(*input[1])[column][0]);
+  __m128 z_lo = _mm_loadu_ps(&(*input[2])[column][0]), w_lo = _mm_loadu_ps(&(*input[3])[column][0]);
+  __m128 x_hi = _mm_loadu_ps(&(*input[4])[column][0]), y_hi = _mm_loadu_ps(&(*input[5])[column][0]);
+  __m128 z_hi = _mm_loadu_ps(&(*input[6])[column][0]), w_hi = _mm_loadu_ps(&(*input[7])[column][0]);
+
+  _MM_TRANSPOSE4_PS(x_lo, y_lo, z_lo, w_lo);
+  _MM_TRANSPOSE4_PS(x_hi, y_hi, z_hi, w_hi);
+
+  x = _mm256_insertf128_ps(_mm256_castps128_ps256(x_lo), x_hi, 1);
+  y = _mm256_insertf128_ps(_mm256_castps128_ps256(y_lo), y_hi, 1);
+  z = _mm256_insertf128_ps(_mm256_castps128_ps256(z_lo), z_hi, 1);
+  w = _mm256_insertf128_ps(_mm256_castps128_ps256(w_lo), w_hi, 1);
+}
+
+__SIMD_TARGET("avx2") static void ComposeTRS_avx2(const vector3f* position, const glm::quat* angle, const vector3f* scale, glm::mat4* output, const uint* indices, uint count)
+{
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 zero = _mm256_setzero_ps();
+
+  uint n = 0;
+  for(; n + 8 <= count; n += 8)
+  {
+    const uint* id = indices + n;
+
+#define __SIMD_GATHER8(array, c) _mm256_setr_ps(array[id[0]].c, array[id[1]].c, array[id[2]].c, array[id[3]].c, \
+                                                array[id[4]].c, array[id[5]].c, array[id[6]].c, array[id[7]].c)
+    __m256 qx = __SIMD_GATHER8(angle, x), qy = __SIMD_GATHER8(angle, y), qz = __SIMD_GATHER8(angle, z), qw = __SIMD_GATHER8(angle, w);
+    __m256 sx = __SIMD_GATHER8(scale, x), sy = __SIMD_GATHER8(scale, y), sz = __SIMD_GATHER8(scale, z);
+    __m256 px = __SIMD_GATHER8(position, x), py = __SIMD_GATHER8(position, y), pz = __SIMD_GATHER8(position, z);
+#undef __SIMD_GATHER8
+
+    __m256 x2 = _mm256_add_ps(qx, qx), y2 = _mm256_add_ps(qy, qy), z2 = _mm256_add_ps(qz, qz);
+    __m256 xx = _mm256_mul_ps(qx, x2), yy = _mm256_mul_ps(qy, y2), zz = _mm256_mul_ps(qz, z2);
+    __m256 xy = _mm256_mul_ps(qx, y2), xz = _mm256_mul_ps(qx, z2), yz = _mm256_mul_ps(qy, z2);
+    __m256 wx = _mm256_mul_ps(qw, x2), wy = _mm256_mul_ps(qw, y2), wz = _mm256_mul_ps(qw, z2);
+
+    Store8(output, id, 0,
+           _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), sx),
+           _mm256_mul_ps(_mm256_add_ps(xy, wz), sx),
+           _mm256_mul_ps(_mm256_sub_ps(xz, wy), sx),
+           zero);
+    Store8(output, id, 1,
+           _mm256_mul_ps(_mm256_sub_ps(xy, wz), sy),
+           _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, zz)), sy),
+           _mm256_mul_ps(_mm256_add_ps(yz, wx), sy),
+           zero);
+    Store8(output, id, 2,
+           _mm256_mul_ps(_mm256_add_ps(xz, wy), sz),
+           _mm256_mul_ps(_mm256_sub_ps(yz, wx), sz),
+           _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, yy)), sz),
+           zero);
+    Store8(output, id, 3, px, py, pz, one);
+  }
+
+  ComposeTRS_sse(position, angle, scale, output, indices + n, count - n);
+}
+
+__SIMD_TARGET("avx2") static void MultiplyMatrices_avx2(const glm::mat4* const* left, const glm::mat4* const* right, glm::mat4* const* output, uint count)
+{
+  for(uint n = 0; n < count; n++)
+  {
+    const float* a = &(*left[n])[0][0];
+    const float* b = &(*right[n])[0][0];
+    float* o = &(*output[n])[0][0];
+
+    // Cada columna de "left" repetida en las dos mitades, para calcular 2 columnas del resultado a la vez
+    __m256 a0 = _mm256_broadcast_ps((const __m128*)a);
+    __m256 a1 = _mm256_broadcast_ps((const __m128*)(a + 4));
+    __m256 a2 = _mm256_broadcast_ps((const __m128*)(a + 8));
+    __m256 a3 = _mm256_broadcast_ps((const __m128*)(a + 12));
+
+    __m256 r[2];
+    for(int j = 0; j < 2; j++)
+    {
+      const float* b0 = b + 8*j;  // Columna 2j
+      const float* b1 = b0 + 4;   // Columna 2j + 1
+
+      r[j] = _mm256_mul_ps(a0, _mm256_setr_ps(b0[0], b0[0], b0[0], b0[0], b1[0], b1[0], b1[0], b1[0]));
+      r[j] = _mm256_add_ps(r[j], _mm256_mul_ps(a1, _mm256_setr_ps(b0[1], b0[1], b0[1], b0[1], b1[1], b1[1], b1[1], b1[1])));
+      r[j] = _mm256_add_ps(r[j], _mm256_mul_ps(a2, _mm256_setr_ps(b0[2], b0[2], b0[2], b0[2], b1[2], b1[2], b1[2], b1[2])));
+      r[j] = _mm256_add_ps(r[j], _mm256_mul_ps(a3, _mm256_setr_ps(b0[3], b0[3], b0[3], b0[3], b1[3], b1[3], b1[3], b1[3])));
+    }
+
+    _mm256_storeu_ps(o, r[0]);
+    _mm256_storeu_ps(o + 8, r[1]);
+  }
+}
+
+__SIMD_TARGET("avx2") static void NormalMatrices_avx2(const glm::mat4* const* input, glm::mat4* const* output, uint count)
+{
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 zero = _mm256_setzero_ps();
+
+  uint n = 0;
+  for(; n + 8 <= count; n += 8)
+  {
+    __m256 a0x, a0y, a0z, a0w, a1x, a1y, a1z, a1w, a2x, a2y, a2z, a2w, tx, ty, tz, tw;
+    Load8(input + n, 0, a0x, a0y, a0z, a0w);
+    Load8(input + n, 1, a1x, a1y, a1z, a1w);
+    Load8(input + n, 2, a2x, a2y, a2z, a2w);
+    Load8(input + n, 3, tx, ty, tz, tw);
+
+    __m256 c0x = _mm256_sub_ps(_mm256_mul_ps(a1y, a2z), _mm256_mul_ps(a1z, a2y));
+    __m256 c0y = _mm256_sub_ps(_mm256_mul_ps(a1z, a2x), _mm256_mul_ps(a1x, a2z));
+    __m256 c0z = _mm256_sub_ps(_mm256_mul_ps(a1x, a2y), _mm256_mul_ps(a1y, a2x));
+    __m256 c1x = _mm256_sub_ps(_mm256_mul_ps(a2y, a0z), _mm256_mul_ps(a2z, a0y));
+    __m256 c1y = _mm256_sub_ps(_mm256_mul_ps(a2z, a0x), _mm256_mul_ps(a2x, a0z));
+    __m256 c1z = _mm256_sub_ps(_mm256_mul_ps(a2x, a0y), _mm256_mul_ps(a2y, a0x));
+    __m256 c2x = _mm256_sub_ps(_mm256_mul_ps(a0y, a1z), _mm256_mul_ps(a0z, a1y));
+    __m256 c2y = _mm256_sub_ps(_mm256_mul_ps(a0z, a1x), _mm256_mul_ps(a0x, a1z));
+    __m256 c2z = _mm256_sub_ps(_mm256_mul_ps(a0x, a1y), _mm256_mul_ps(a0y, a1x));
+
+    __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a0x, c0x), _mm256_mul_ps(a0y, c0y)), _mm256_mul_ps(a0z, c0z));
+    __m256 inv = _mm256_and_ps(_mm256_div_ps(one, det), _mm256_cmp_ps(det, zero, _CMP_NEQ_OQ));
+
+    c0x = _mm256_mul_ps(c0x, inv); c0y = _mm256_mul_ps(c0y, inv); c0z = _mm256_mul_ps(c0z, inv);
+    c1x = _mm256_mul_ps(c1x, inv); c1y = _mm256_mul_ps(c1y, inv); c1z = _mm256_mul_ps(c1z, inv);
+    c2x = _mm256_mul_ps(c2x, inv); c2y = _mm256_mul_ps(c2y, inv); c2z = _mm256_mul_ps(c2z, inv);
+
+    __m256 w0 = _mm256_sub_ps(zero, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0x, tx), _mm256_mul_ps(c0y, ty)), _mm256_mul_ps(c0z, tz)));
+    __m256 w1 = _mm256_sub_ps(zero, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c1x, tx), _mm256_mul_ps(c1y, ty)), _mm256_mul_ps(c1z, tz)));
+    __m256 w2 = _mm256_sub_ps(zero, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c2x, tx), _mm256_mul_ps(c2y, ty)), _mm256_mul_ps(c2z, tz)));
+
+    Store8(output + n, 0, c0x, c0y, c0z, w0);
+    Store8(output + n, 1, c1x, c1y, c1z, w1);
+    Store8(output + n, 2, c2x, c2y, c2z, w2);
+    Store8(output + n, 3, zero, zero, zero, one);
+  }
+
+  NormalMatrices_sse(input + n, output + n, count - n);
+}
+
+#endif /* __SIMD_X86 */
+
+void SIMD::ComposeTRS(const vector3f* position, const glm::quat* angle, const vector3f* scale, glm::mat4* output, const uint* indices, uint count)
+{
+  switch(Current())
+  {
+#ifdef __SIMD_X86
+    case avx2: ComposeTRS_avx2(position, angle, scale, output, indices, count); break;
+    case sse:  ComposeTRS_sse(position, angle, scale, output, indices, count); break;
+#endif
+    default:   ComposeTRS_scalar(position, angle, scale, output, indices, count); break;
+  }
+}
+
+void SIMD::MultiplyMatrices(const glm::mat4* const* left, const glm::mat4* const* right, glm::mat4* const* output, uint count)
+{
+  switch(Current())
+  {
+#ifdef __SIMD_X86
+    case avx2: MultiplyMatrices_avx2(left, right, output, count); break;
+    case sse:  MultiplyMatrices_sse(left, right, output, count); break;
+#endif
+    default:   MultiplyMatrices_scalar(left, right, output, count); break;
+  }
+}
+
+void SIMD::NormalMatrices(const glm::mat4* const* input, glm::mat4* const* output, uint count)
+{
+  switch(Current())
+  {
+#ifdef __SIMD_X86
+    case avx2: NormalMatrices_avx2(input, output, count); break;
+    case sse:  NormalMatrices_sse(input, output, count); break;
+#endif
+    default:   NormalMatrices_scalar(input, output, count); break;
+  }
+}
+
+static float max_error(const vector<glm::mat4>& a, const vector<glm::mat4>& b)
+{
+  float error = 0.f;
+  for(uint i = 0; i < a.size(); i++)
+    for(int c = 0; c < 4; c++)
+      for(int r = 0; r < 4; r++)
+        error = max(error, std::abs(a[i][c][r] - b[i][c][r]));
+
+  return error;
+}
+
+static float random_float(float min, float max)
+{
+  return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+void SIMD::Benchmark(uint count, uint iterations)
+{
+  if(count == 0 or iterations == 0)
+    return;
+
+  vector<vector3f> position(count), scale(count);
+  vector<glm::quat> angle(count);
+  vector<glm::mat4> parent(count), local(count), world(count), normal(count);
+  vector<glm::mat4> world_glm(count), normal_glm(count);
+
+  vector<uint> indices(count);
+  vector<const glm::mat4*> parent_p(count), local_p(count), world_cp(count);
+  vector<glm::mat4*> world_p(count), normal_p(count);
+
+  for(uint i = 0; i < count; i++)
+  {
+    position[i] = vector3f(random_float(-100.f, 100.f), random_float(-100.f, 100.f), random_float(-100.f, 100.f));
+    scale[i] = vector3f(random_float(0.5f, 2.f), random_float(0.5f, 2.f), random_float(0.5f, 2.f));
+    angle[i] = glm::normalize(glm::quat(random_float(-1.f, 1.f), random_float(-1.f, 1.f), random_float(-1.f, 1.f), random_float(-1.f, 1.f)));
+
+    parent[i] = glm::translate(glm::mat4(1.0), glm::vec3(random_float(-10.f, 10.f), 0.f, 0.f)) * glm::toMat4(angle[(i * 7) % count]);
+
+    indices[i] = i;
+    parent_p[i] = &parent[i];
+    local_p[i] = &local[i];
+    world_cp[i] = &world[i];
+    world_p[i] = &world[i];
+    normal_p[i] = &normal[i];
+  }
+
+  double frequency = (double)SDL_GetPerformanceFrequency();
+
+  // Cálculo objeto a objeto con glm, como hacían CComponent_Transform::ApplyTransform() y CComponent_Mesh_Render::OnRender()
+  double glm_time = DBL_MAX;
+  for(uint it = 0; it < iterations; it++)
+  {
+    Uint64 start = SDL_GetPerformanceCounter();
+    for(uint i = 0; i < count; i++)
+    {
+      glm::mat4 m = glm::translate(glm::mat4(1.0), position[i].to_glm());
+      m = m * glm::toMat4(angle[i]);
+      m = glm::scale(m, scale[i].to_glm());
+
+      world_glm[i] = parent[i] * m;
+      normal_glm[i] = glm::transpose(glm::inverse(world_glm[i]));
+    }
+    glm_time = min(glm_time, (double)(SDL_GetPerformanceCounter() - start) / frequency);
+  }
+
+  gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "Transform benchmark (%d objects, best of %d)", count, iterations);
+  gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "-------------------");
+  gSystem_Debug.console_msg(" %-8s %10.2f ns/object", "glm", glm_time * 1e9 / count);
+
+  instruction_set_t previous = Current();
+
+  for(int set = scalar; set <= Best(); set++)
+  {
+    SetCurrent((instruction_set_t)set);
+
+    double time = DBL_MAX;
+    for(uint it = 0; it < iterations; it++)
+    {
+      Uint64 start = SDL_GetPerformanceCounter();
+      ComposeTRS(&position[0], &angle[0], &scale[0], &local[0], &indices[0], count);
+      MultiplyMatrices(&parent_p[0], &local_p[0], &world_p[0], count);
+      NormalMatrices(&world_cp[0], &normal_p[0], count);
+      time = min(time, (double)(SDL_GetPerformanceCounter() - start) / frequency);
+    }
+
+    gSystem_Debug.console_msg(" %-8s %10.2f ns/object  x%.2f  (max error: world %g, normal %g)", instruction_set_to_string((instruction_set_t)set),
+                              time * 1e9 / count, glm_time / time, max_error(world, world_glm), max_error(normal, normal_glm));
+  }
+
+  SetCurrent(previous);
+}
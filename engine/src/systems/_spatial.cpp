@@ -0,0 +1,664 @@
+#include "systems/_spatial.h"
+#include "systems/_jobs.h"
+#include "systems/_debug.h"
+#include "_object.h"
+#include "_components.h"
+
+using namespace std;
+
+CSystem_Spatial gSystem_Spatial;
+CSystem_Spatial& gSpatial = gSystem_Spatial;
+
+static Culling::aabb_t Union(const Culling::aabb_t& a, const Culling::aabb_t& b)
+{
+  Culling::aabb_t output = a;
+  output.Extend(b);
+
+  return output;
+}
+
+bool CSystem_Spatial::Init()
+{
+  if(enabled) return true;
+  CSystem::Init();
+
+  // CSystem_Jobs ya está iniciado
+  stacks.resize(gSystem_Jobs.NumThreads());
+
+  return true;
+}
+
+void CSystem_Spatial::Close()
+{
+  if(!enabled) return;
+
+  nodes.clear();
+  leaf_of.clear();
+  last_update.clear();
+  unbounded.clear();
+  stacks.clear();
+  root = free_node = -1;
+  num_leaves = 0;
+
+  CSystem::Close();
+}
+
+bool CSystem_Spatial::Reset()
+{
+  // Los objetos no preservados ya se han borrado, y con ellos sus hojas
+  num_updates = num_reinserts = 0;
+
+  return true;
+}
+
+// Nodos
+int CSystem_Spatial::AllocateNode()
+{
+  if(free_node < 0)
+  {
+    node_t node;
+    node.height = -1;
+    node.parent = -1;
+    nodes.push_back(node);
+    free_node = nodes.size() - 1;
+  }
+
+  int index = free_node;
+  free_node = nodes[index].parent;
+
+  node_t& node = nodes[index];
+  node.box.Clear();
+  node.parent = node.left = node.right = -1;
+  node.height = 0;
+  node.object = NULL;
+  node.bounds = Culling::bounds_t();
+  node.data_index = 0;
+  node.unbounded = -1;
+
+  return index;
+}
+
+void CSystem_Spatial::FreeNode(int index)
+{
+  nodes[index].height = -1;
+  nodes[index].object = NULL;
+  nodes[index].parent = free_node;
+  free_node = index;
+}
+
+// Árbol
+void CSystem_Spatial::InsertLeaf(int leaf)
+{
+  if(root < 0)
+  {
+    root = leaf;
+    nodes[leaf].parent = -1;
+    return;
+  }
+
+  // Buscar el mejor hermano: el que menos aumenta la superficie de los nodos, contando la que heredan los ancestros
+  Culling::aabb_t box = nodes[leaf].box;
+  int index = root;
+
+  while(!nodes[index].Leaf())
+  {
+    int left = nodes[index].left;
+    int right = nodes[index].right;
+
+    float area = nodes[index].box.Surface();
+    float combined_area = Union(nodes[index].box, box).Surface();
+
+    float cost = 2.f * combined_area;
+    float inheritance = 2.f * (combined_area - area);
+
+    float cost_left = Union(box, nodes[left].box).Surface() + inheritance;
+    if(!nodes[left].Leaf())
+      cost_left -= nodes[left].box.Surface();
+
+    float cost_right = Union(box, nodes[right].box).Surface() + inheritance;
+    if(!nodes[right].Leaf())
+      cost_right -= nodes[right].box.Surface();
+
+    if(cost < cost_left and cost < cost_right)
+      break;
+
+    index = (cost_left < cost_right) ? left : right;
+  }
+
+  int sibling = index;
+  int old_parent = nodes[sibling].parent;
+
+  // AllocateNode() puede mover "nodes", así que no se guardan referencias
+  int new_parent = AllocateNode();
+  nodes[new_parent].parent = old_parent;
+  nodes[new_parent].box = Union(box, nodes[sibling].box);
+  nodes[new_parent].height = nodes[sibling].height + 1;
+  nodes[new_parent].left = sibling;
+  nodes[new_parent].right = leaf;
+
+  if(old_parent >= 0)
+  {
+    if(nodes[old_parent].left == sibling)
+      nodes[old_parent].left = new_parent;
+    else
+      nodes[old_parent].right = new_parent;
+  }
+  else
+    root = new_parent;
+
+  nodes[sibling].parent = new_parent;
+  nodes[leaf].parent = new_parent;
+
+  Refit(nodes[leaf].parent);
+}
+
+void CSystem_Spatial::RemoveLeaf(int leaf)
+{
+  if(leaf == root)
+  {
+    root = -1;
+    return;
+  }
+
+  int parent = nodes[leaf].parent;
+  int grand_parent = nodes[parent].parent;
+  int sibling = (nodes[parent].left == leaf) ? nodes[parent].right : nodes[parent].left;
+
+  // El hermano ocupa el lugar del padre
+  if(grand_parent >= 0)
+  {
+    if(nodes[grand_parent].left == parent)
+      nodes[grand_parent].left = sibling;
+    else
+      nodes[grand_parent].right = sibling;
+
+    nodes[sibling].parent = grand_parent;
+    FreeNode(parent);
+
+    Refit(grand_parent);
+  }
+  else
+  {
+    root = sibling;
+    nodes[sibling].parent = -1;
+    FreeNode(parent);
+  }
+
+  nodes[leaf].parent = -1;
+}
+
+void CSystem_Spatial::Refit(int index)
+{
+  while(index >= 0)
+  {
+    index = Balance(index);
+
+    int left = nodes[index].left;
+    int right = nodes[index].right;
+
+    nodes[index].height = 1 + std::max(nodes[left].height, nodes[right].height);
+    nodes[index].box = Union(nodes[left].box, nodes[right].box);
+
+    index = nodes[index].parent;
+  }
+}
+
+// Rotación de "a" si uno de sus hijos es más de un nivel más alto que el otro. Devuelve el nodo que queda en su lugar
+int CSystem_Spatial::Balance(int a)
+{
+  if(nodes[a].Leaf() or nodes[a].height < 2)
+    return a;
+
+  int b = nodes[a].left;
+  int c = nodes[a].right;
+  int balance = nodes[c].height - nodes[b].height;
+
+  if(balance > 1)
+  {
+    // Subir "c"
+    int f = nodes[c].left;
+    int g = nodes[c].right;
+
+    nodes[c].left = a;
+    nodes[c].parent = nodes[a].parent;
+    nodes[a].parent = c;
+
+    if(nodes[c].parent >= 0)
+    {
+      if(nodes[nodes[c].parent].left == a)
+        nodes[nodes[c].parent].left = c;
+      else
+        nodes[nodes[c].parent].right = c;
+    }
+    else
+      root = c;
+
+    // El hijo más alto de "c" se queda con "c", el otro pasa a "a"
+    if(nodes[f].height > nodes[g].height)
+    {
+      nodes[c].right = f;
+      nodes[a].right = g;
+      nodes[g].parent = a;
+    }
+    else
+    {
+      nodes[c].right = g;
+      nodes[a].right = f;
+      nodes[f].parent = a;
+    }
+
+    nodes[a].box = Union(nodes[b].box, nodes[nodes[a].right].box);
+    nodes[a].height = 1 + std::max(nodes[b].height, nodes[nodes[a].right].height);
+    nodes[c].box = Union(nodes[a].box, nodes[nodes[c].right].box);
+    nodes[c].height = 1 + std::max(nodes[a].height, nodes[nodes[c].right].height);
+
+    return c;
+  }
+
+  if(balance < -1)
+  {
+    // Subir "b"
+    int d = nodes[b].left;
+    int e = nodes[b].right;
+
+    nodes[b].left = a;
+    nodes[b].parent = nodes[a].parent;
+    nodes[a].parent = b;
+
+    if(nodes[b].parent >= 0)
+    {
+      if(nodes[nodes[b].parent].left == a)
+        nodes[nodes[b].parent].left = b;
+      else
+        nodes[nodes[b].parent].right = b;
+    }
+    else
+      root = b;
+
+    if(nodes[d].height > nodes[e].height)
+    {
+      nodes[b].right = d;
+      nodes[a].left = e;
+      nodes[e].parent = a;
+    }
+    else
+    {
+      nodes[b].right = e;
+      nodes[a].left = d;
+      nodes[d].parent = a;
+    }
+
+    nodes[a].box = Union(nodes[nodes[a].left].box, nodes[c].box);
+    nodes[a].height = 1 + std::max(nodes[nodes[a].left].height, nodes[c].height);
+    nodes[b].box = Union(nodes[a].box, nodes[nodes[b].right].box);
+    nodes[b].height = 1 + std::max(nodes[a].height, nodes[nodes[b].right].height);
+
+    return b;
+  }
+
+  return a;
+}
+
+// Objetos
+void CSystem_Spatial::SetUnbounded(int leaf, bool state)
+{
+  node_t& node = nodes[leaf];
+
+  if(state and node.unbounded < 0)
+  {
+    node.unbounded = unbounded.size();
+    unbounded.push_back(leaf);
+  }
+  else if(!state and node.unbounded >= 0)
+  {
+    // Quitar moviendo la última a su lugar
+    int last = unbounded.back();
+    unbounded[node.unbounded] = last;
+    nodes[last].unbounded = node.unbounded;
+    unbounded.pop_back();
+    node.unbounded = -1;
+  }
+}
+
+void CSystem_Spatial::Update(uint data_index)
+{
+  CComponent_Transform_Data& data = CComponent_Transform::Data();
+  if(data_index >= data.Capacity())
+    return;
+
+  CComponent_Transform* transform = data.owner(data_index);
+  CGameObject* go = transform ? transform->GetGameObject() : NULL;
+  if(!go)
+  {
+    Remove(data_index);
+    return;
+  }
+
+  // Volumen del objeto: unión de los de sus componentes, o su posición
+  Culling::bounds_t bounds;
+  int sources = 0;
+
+  CComponent_Mesh_Render* mesh_render = go->GetComponent<CComponent_Mesh_Render>();
+  if(mesh_render)
+  {
+    const Culling::bounds_t& b = mesh_render->WorldBounds();
+    if(!b.Empty())
+    {
+      bounds = b;
+      sources++;
+    }
+  }
+
+  CComponent_Particle_Emitter* particle_emitter = go->GetComponent<CComponent_Particle_Emitter>();
+  if(particle_emitter)
+  {
+    Culling::bounds_t b = particle_emitter->WorldBounds();
+    if(!b.Empty())
+    {
+      if(sources)
+      {
+        Culling::aabb_t box = bounds.box;
+        box.Extend(b.box);
+        bounds = Culling::bounds_t(box);
+      }
+      else
+        bounds = b;
+
+      sources++;
+    }
+  }
+
+  if(!sources)
+  {
+    const glm::mat4& world = transform->WorldMatrix();
+    glm::vec3 position(world[3]);
+
+    bounds.box = Culling::aabb_t(position, position);
+    bounds.sphere = Culling::sphere_t(position, 0.f);
+  }
+
+  if(leaf_of.size() <= data_index)
+    leaf_of.resize(data.Capacity(), -1);
+
+  int leaf = leaf_of[data_index];
+  bool reinsert = (leaf < 0);
+
+  if(leaf < 0)
+  {
+    leaf = AllocateNode();
+    leaf_of[data_index] = leaf;
+    nodes[leaf].data_index = data_index;
+    num_leaves++;
+  }
+  else if(!nodes[leaf].box.Contains(bounds.box))
+  {
+    RemoveLeaf(leaf);
+    reinsert = true;
+    num_reinserts++;
+  }
+
+  node_t& node = nodes[leaf];
+  node.object = go;
+  node.bounds = bounds;
+
+  if(reinsert)
+  {
+    glm::vec3 size = bounds.box.max - bounds.box.min;
+    node.box = bounds.box;
+    node.box.Inflate(__SPATIAL_MIN_MARGIN + __SPATIAL_MARGIN * std::max(size.x, std::max(size.y, size.z)));
+
+    InsertLeaf(leaf);
+  }
+
+  SetUnbounded(leaf, go->HasComponents(Components::bit(Components::dummy)) or go->HasRenderFunction());
+  num_updates++;
+}
+
+void CSystem_Spatial::Remove(uint data_index)
+{
+  if(data_index >= leaf_of.size() or leaf_of[data_index] < 0)
+    return;
+
+  int leaf = leaf_of[data_index];
+  leaf_of[data_index] = -1;
+
+  SetUnbounded(leaf, false);
+  RemoveLeaf(leaf);
+  FreeNode(leaf);
+  num_leaves--;
+}
+
+void CSystem_Spatial::OnLoop()
+{
+  CComponent_Transform_Data& data = CComponent_Transform::Data();
+  data.TakeMoved(moved);
+
+  // El volumen de los emisores cambia con sus partículas, aunque no se muevan
+  CComponent_Pool<CComponent_Particle_Emitter>& emitters = CComponent_Particle_Emitter::Pool();
+  for(uint i = 0; i < emitters.Capacity(); i++)
+  {
+    CComponent_Particle_Emitter* emitter = emitters.At(i);
+    if(emitter and emitter->GetGameObject() and emitter->GetGameObject()->Transform())
+      moved.push_back(emitter->GetGameObject()->Transform()->GetDataIndex());
+  }
+
+  frame++;
+  if(last_update.size() < data.Capacity())
+    last_update.resize(data.Capacity(), 0);
+
+  for(vector<uint>::iterator it = moved.begin(); it != moved.end(); ++it)
+  {
+    if(*it >= last_update.size() or last_update[*it] == frame)
+      continue;
+
+    last_update[*it] = frame;
+    Update(*it);
+  }
+}
+
+// Consultas
+vector<int>& CSystem_Spatial::Stack()
+{
+  uint thread = gSystem_Jobs.CurrentThread();
+  return stacks[thread < stacks.size() ? thread : 0];
+}
+
+bool CSystem_Spatial::Accept(int leaf, Components::signature_t components)
+{
+  CGameObject* go = nodes[leaf].object;
+  return go and go->GetID() >= 0 and (go->GetSignature() & components) == components;
+}
+
+uint CSystem_Spatial::QueryFrustum(const Culling::frustum_t& frustum, vector<CGameObject*>& output, Components::signature_t components)
+{
+  if(root < 0)
+    return 0;
+
+  uint begin = output.size();
+
+  // El signo del índice indica si el nodo ya se sabe que está dentro
+  vector<int>& stack = Stack();
+  stack.clear();
+  stack.push_back(root + 1);
+
+  while(!stack.empty())
+  {
+    int entry = stack.back();
+    stack.pop_back();
+
+    bool inside = (entry < 0);
+    int index = inside ? -entry - 1 : entry - 1;
+    node_t& node = nodes[index];
+
+    if(!inside)
+    {
+      Culling::frustum_t::classify_t c = frustum.Classify(node.box);
+      if(c == Culling::frustum_t::outside)
+        continue;
+
+      inside = (c == Culling::frustum_t::inside);
+    }
+
+    if(node.Leaf())
+    {
+      if((inside or frustum.Intersects(node.bounds)) and Accept(index, components))
+        output.push_back(node.object);
+
+      continue;
+    }
+
+    stack.push_back(inside ? -node.left - 1 : node.left + 1);
+    stack.push_back(inside ? -node.right - 1 : node.right + 1);
+  }
+
+  return output.size() - begin;
+}
+
+uint CSystem_Spatial::QueryVisible(const Culling::frustum_t& frustum, vector<CGameObject*>& output)
+{
+  uint begin = output.size();
+  QueryFrustum(frustum, output);
+
+  // Los objetos sin volumen ya encontrados se quitan, para no dibujarlos dos veces
+  uint size = begin;
+  for(uint i = begin; i < output.size(); i++)
+  {
+    int leaf = leaf_of[output[i]->Transform()->GetDataIndex()];
+    if(nodes[leaf].unbounded < 0)
+      output[size++] = output[i];
+  }
+  output.resize(size);
+
+  for(vector<int>::iterator it = unbounded.begin(); it != unbounded.end(); ++it)
+    if(Accept(*it, 0))
+      output.push_back(nodes[*it].object);
+
+  return output.size() - begin;
+}
+
+uint CSystem_Spatial::QuerySphere(const glm::vec3& center, float radius, vector<CGameObject*>& output, Components::signature_t components)
+{
+  if(root < 0 or radius < 0.f)
+    return 0;
+
+  uint begin = output.size();
+  float radius2 = radius * radius;
+
+  vector<int>& stack = Stack();
+  stack.clear();
+  stack.push_back(root);
+
+  while(!stack.empty())
+  {
+    node_t& node = nodes[stack.back()];
+    int index = stack.back();
+    stack.pop_back();
+
+    if(node.box.Distance2(center) > radius2)
+      continue;
+
+    if(node.Leaf())
+    {
+      if(node.bounds.box.Distance2(center) <= radius2 and Accept(index, components))
+        output.push_back(node.object);
+
+      continue;
+    }
+
+    stack.push_back(node.left);
+    stack.push_back(node.right);
+  }
+
+  return output.size() - begin;
+}
+
+uint CSystem_Spatial::QueryAABB(const Culling::aabb_t& box, vector<CGameObject*>& output, Components::signature_t components)
+{
+  if(root < 0 or box.Empty())
+    return 0;
+
+  uint begin = output.size();
+
+  vector<int>& stack = Stack();
+  stack.clear();
+  stack.push_back(root);
+
+  while(!stack.empty())
+  {
+    node_t& node = nodes[stack.back()];
+    int index = stack.back();
+    stack.pop_back();
+
+    if(!node.box.Intersects(box))
+      continue;
+
+    if(node.Leaf())
+    {
+      if(node.bounds.box.Intersects(box) and Accept(index, components))
+        output.push_back(node.object);
+
+      continue;
+    }
+
+    stack.push_back(node.left);
+    stack.push_back(node.right);
+  }
+
+  return output.size() - begin;
+}
+
+CGameObject* CSystem_Spatial::Raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance, float* distance, Components::signature_t components)
+{
+  if(root < 0)
+    return NULL;
+
+  glm::vec3 inv_direction(1.f / direction.x, 1.f / direction.y, 1.f / direction.z);
+  CGameObject* output = NULL;
+  float best = max_distance;
+
+  vector<int>& stack = Stack();
+  stack.clear();
+  stack.push_back(root);
+
+  while(!stack.empty())
+  {
+    node_t& node = nodes[stack.back()];
+    int index = stack.back();
+    stack.pop_back();
+
+    // Los nodos más lejos que el objeto más cercano encontrado hasta ahora se descartan
+    float t;
+    if(!node.box.Raycast(origin, inv_direction, best, t))
+      continue;
+
+    if(node.Leaf())
+    {
+      if(node.bounds.box.Raycast(origin, inv_direction, best, t) and Accept(index, components))
+      {
+        output = node.object;
+        best = t;
+      }
+
+      continue;
+    }
+
+    stack.push_back(node.left);
+    stack.push_back(node.right);
+  }
+
+  if(output and distance)
+    *distance = best;
+
+  return output;
+}
+
+void CSystem_Spatial::PrintStats()
+{
+  gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "Spatial index");
+  gSystem_Debug.console_custom_msg(0.15f, 0.7f, 1.f, 1.f, "-------------------");
+  gSystem_Debug.console_msg(" Objects:    %u (%u without bounds)", num_leaves, (uint)unbounded.size());
+  gSystem_Debug.console_msg(" Nodes:      %u", (uint)nodes.size());
+  gSystem_Debug.console_msg(" Height:     %d", root >= 0 ? nodes[root].height : 0);
+  gSystem_Debug.console_msg(" Updates:    %u", num_updates);
+  gSystem_Debug.console_msg(" Reinserts:  %u", num_reinserts);
+}
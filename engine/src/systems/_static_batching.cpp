@@ -0,0 +1,288 @@
+#include "systems/_static_batching.h"
+#include "systems/_manager.h"
+#include "systems/_resource.h"
+#include "systems/_data.h"
+#include "systems/_debug.h"
+#include "_components.h"
+
+#include <cstdio>
+#include <cmath>
+#include <map>
+
+using namespace std;
+
+CSystem_Static_Batching gSystem_Static_Batching;
+CSystem_Static_Batching& gStaticBatching = gSystem_Static_Batching;
+
+namespace
+{
+  // Objetos que se dibujan igual, en la misma celda
+  struct group_key_t
+  {
+    int x, y, z;
+    string shader, material;
+    glm::vec4 color;
+    float color_apply_force;
+
+    bool operator<(const group_key_t& k) const
+    {
+      if(x != k.x) return x < k.x;
+      if(y != k.y) return y < k.y;
+      if(z != k.z) return z < k.z;
+      if(shader != k.shader) return shader < k.shader;
+      if(material != k.material) return material < k.material;
+      for(uint i = 0; i < 4; i++)
+        if(color[i] != k.color[i]) return color[i] < k.color[i];
+
+      return color_apply_force < k.color_apply_force;
+    }
+  };
+}
+
+bool CSystem_Static_Batching::Init()
+{
+  if(enabled) return true;
+
+  batches.clear();
+  num_baked = num_sources = 0;
+
+  CSystem::Init();
+
+  return true;
+}
+
+void CSystem_Static_Batching::Close()
+{
+  if(!enabled) return;
+  CSystem::Close();
+
+  batches.clear();
+  num_baked = num_sources = 0;
+}
+
+bool CSystem_Static_Batching::Reset()
+{
+  for(uint i = 0; i < batches.size(); i++)
+    Unbake(i);
+
+  batches.clear();
+  num_baked = num_sources = 0;
+
+  return true;
+}
+
+uint CSystem_Static_Batching::Bake()
+{
+  if(!gSystem_Data_Storage.GetInt("__RENDER_STATIC_BATCHING"))
+    return 0;
+
+  float cell_size = gSystem_Data_Storage.GetFloat("__RENDER_STATIC_BATCHING_CELL_SIZE");
+  if(cell_size <= 0.f)
+    cell_size = __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_STATIC_BATCHING_CELL_SIZE;
+
+  CResource_Mesh* error_mesh = gSystem_Resources.GetMesh("__MDL_ERROR");
+  map<group_key_t, vector<CGameObject*> > groups;
+
+  vector<CGameObject*>& objects = gSystem_GameObject_Manager.gameObjects;
+  for(vector<CGameObject*>::iterator it = objects.begin(); it != objects.end(); ++it)
+  {
+    CGameObject* go = *it;
+    if(!go->IsStatic() or !go->IsEnabled())
+      continue;
+
+    CComponent_Mesh_Render* mesh_render = go->GetComponent<CComponent_Mesh_Render>();
+    if(!mesh_render or !mesh_render->GetState() or mesh_render->static_batch >= 0 or mesh_render->before_render or mesh_render->after_render)
+      continue;
+
+    // Los transparentes se ordenan por distancia, objeto a objeto
+    if(mesh_render->color.a != 1.f or gSystem_Resources.GetMesh(mesh_render->mesh_name) == error_mesh)
+      continue;
+
+    glm::vec3 center = mesh_render->WorldBounds().sphere.center;
+
+    group_key_t key;
+    key.x = (int)floor(center.x / cell_size);
+    key.y = (int)floor(center.y / cell_size);
+    key.z = (int)floor(center.z / cell_size);
+    key.shader = mesh_render->shader_name;
+    key.material = mesh_render->material_name;
+    key.color = glm::vec4(mesh_render->color.r, mesh_render->color.g, mesh_render->color.b, mesh_render->color.a);
+    key.color_apply_force = mesh_render->color_apply_force;
+
+    groups[key].push_back(go);
+  }
+
+  uint created = 0, merged = 0;
+  for(map<group_key_t, vector<CGameObject*> >::iterator it = groups.begin(); it != groups.end(); ++it)
+  {
+    vector<CGameObject*>& group = it->second;
+    if(group.size() < __STATIC_BATCHING_MIN_OBJECTS)
+      continue;
+
+    // Se parte en modelos de como mucho __STATIC_BATCHING_MAX_VERTICES vértices
+    vector<CGameObject*> chunk;
+    uint vertices = 0;
+
+    for(uint i = 0; i <= group.size(); i++)
+    {
+      uint mesh_vertices = 0;
+      if(i < group.size())
+      {
+        mesh_vertices = gSystem_Resources.GetMesh(group[i]->MeshRender()->mesh_name)->Vertices();
+        if(mesh_vertices > __STATIC_BATCHING_MAX_VERTICES)
+          continue;
+      }
+
+      if(i == group.size() or vertices + mesh_vertices > __STATIC_BATCHING_MAX_VERTICES)
+      {
+        if(chunk.size() >= __STATIC_BATCHING_MIN_OBJECTS and BakeGroup(chunk))
+        {
+          created++;
+          merged += chunk.size();
+        }
+
+        chunk.clear();
+        vertices = 0;
+      }
+
+      if(i < group.size())
+      {
+        chunk.push_back(group[i]);
+        vertices += mesh_vertices;
+      }
+    }
+  }
+
+  if(created)
+    gSystem_Debug.console_msg("Static batching: %u objects merged into %u meshes.", merged, created);
+
+  return created;
+}
+
+bool CSystem_Static_Batching::BakeGroup(const vector<CGameObject*>& objects)
+{
+  vector<glm::vec3> positions, normals;
+  vector<glm::vec2> uvs;
+  vector<uint> indices;
+
+  for(uint i = 0; i < objects.size(); i++)
+  {
+    CComponent_Mesh_Render* mesh_render = objects[i]->MeshRender();
+    CResource_Mesh* mesh = gSystem_Resources.GetMesh(mesh_render->mesh_name);
+
+    vector<glm::vec3> mesh_positions, mesh_normals;
+    vector<glm::vec2> mesh_uvs;
+    vector<uint> mesh_indices;
+    if(!mesh->GetGeometry(mesh_positions, mesh_uvs, mesh_normals, mesh_indices))
+      return false;
+
+    // Todo a espacio de mundo: el objeto combinado no tiene transformación
+    const glm::mat4& world = objects[i]->Transform()->WorldMatrix();
+    const glm::mat4& normal = objects[i]->Transform()->NormalMatrix();
+
+    uint base = positions.size();
+    for(uint v = 0; v < mesh_positions.size(); v++)
+    {
+      positions.push_back(glm::vec3(world * glm::vec4(mesh_positions[v], 1.f)));
+      normals.push_back(glm::normalize(glm::vec3(normal * glm::vec4(mesh_normals[v], 0.f))));
+    }
+    uvs.insert(uvs.end(), mesh_uvs.begin(), mesh_uvs.end());
+
+    // Una escala negativa invierte el sentido de los triángulos
+    bool mirrored = glm::determinant(glm::mat3(world)) < 0.f;
+    for(uint t = 0; t + 2 < mesh_indices.size(); t += 3)
+    {
+      indices.push_back(base + mesh_indices[t]);
+      indices.push_back(base + mesh_indices[t + (mirrored ? 2 : 1)]);
+      indices.push_back(base + mesh_indices[t + (mirrored ? 1 : 2)]);
+    }
+  }
+
+  // Nombre libre para el objeto y el modelo. Sin "__", para que se borren al cambiar de estancia
+  char name[32];
+  do
+    snprintf(name, sizeof(name), "static_batch_%u", next_name++);
+  while(gSystem_GameObject_Manager.Get(name));
+
+  // En float: en 16 bits, la precisión se repartiría por toda la caja del grupo, mucho mayor que la de cada objeto
+  CResource_Mesh* mesh = new CResource_Mesh;
+  if(!mesh->LoadFromMemory(positions, uvs, normals, indices, false, false))
+  {
+    delete mesh;
+    return false;
+  }
+
+  gSystem_Resources.AddResource(name, mesh);
+
+  CGameObject* go = gSystem_GameObject_Manager.Add(name);
+  if(!go)
+    return false;
+
+  int index = batches.size();
+  batches.push_back(batch_t());
+  batch_t& batch = batches.back();
+  batch.gameObject = go->GetHandle();
+  batch.baked = true;
+
+  // Se dibuja como el primero: todos tienen el mismo shader, textura y color
+  CComponent_Mesh_Render* first = objects[0]->MeshRender();
+  CComponent_Mesh_Render* mesh_render = go->MeshRender();
+  mesh_render->mesh_name = name;
+  mesh_render->material_name = first->material_name;
+  mesh_render->shader_name = first->shader_name;
+  mesh_render->color = first->color;
+  mesh_render->color_apply_force = first->color_apply_force;
+  mesh_render->static_batch = index;
+
+  go->SetStatic(true);
+  go->Transform()->BoundsChanged();
+
+  for(uint i = 0; i < objects.size(); i++)
+  {
+    CComponent_Mesh_Render* source = objects[i]->MeshRender();
+    source->SetState(false);
+    source->static_batch = index;
+
+    batch.sources.push_back(objects[i]->GetHandle());
+  }
+
+  num_baked++;
+  num_sources += objects.size();
+
+  return true;
+}
+
+void CSystem_Static_Batching::Unbake(int index)
+{
+  if(index < 0 or index >= (int)batches.size() or !batches[index].baked)
+    return;
+
+  batch_t& batch = batches[index];
+  batch.baked = false;
+
+  // Los objetos ya borrados no tienen un handle válido, y el que se está borrando ya no apunta al grupo
+  for(uint i = 0; i < batch.sources.size(); i++)
+  {
+    CGameObject* go = gSystem_GameObject_Manager.Get(batch.sources[i]);
+    CComponent_Mesh_Render* mesh_render = go ? go->GetComponent<CComponent_Mesh_Render>() : NULL;
+
+    if(mesh_render and mesh_render->static_batch == index)
+    {
+      mesh_render->static_batch = -1;
+      mesh_render->SetState(true);
+    }
+  }
+
+  // No se borra aquí: se puede estar borrando otro objeto, o aplicando los comandos de CSystem_GameObject_Manager
+  CGameObject* go = gSystem_GameObject_Manager.Get(batch.gameObject);
+  CComponent_Mesh_Render* mesh_render = go ? go->GetComponent<CComponent_Mesh_Render>() : NULL;
+
+  if(mesh_render and mesh_render->static_batch == index)
+  {
+    mesh_render->static_batch = -1;
+    mesh_render->SetState(false);
+  }
+
+  num_baked--;
+  num_sources -= batch.sources.size();
+}
@@ -0,0 +1,222 @@
+#include "systems/_stream_buffer.h"
+#include "systems/_data.h"
+#include "systems/_debug.h"
+
+#include <cstring>
+
+using namespace std;
+
+CSystem_Stream_Buffer gSystem_Stream_Buffer;
+CSystem_Stream_Buffer& gStreamBuffer = gSystem_Stream_Buffer;
+
+bool CSystem_Stream_Buffer::Init()
+{
+  if(enabled) return true;
+
+  // Los ficheros de configuración anteriores no tienen la opción
+  size = gSystem_Data_Storage.GetInt("__RENDER_STREAM_BUFFER_SIZE");
+  if(size <= 0)
+    size = __CSYSTEM_DATA_STORAGE_DEFAULTOPTIONS_RENDER_STREAM_BUFFER_SIZE;
+
+  // El mapeo persistente necesita las barreras de ARB_sync para no escribir donde la GPU está leyendo
+  bool persistent = GLEW_ARB_buffer_storage and GLEW_ARB_sync;
+  if(!persistent or !Create(true))
+  {
+    if(persistent)
+      gSystem_Debug.log("From CSystem_Stream_Buffer: Could not map stream buffer, using buffer orphaning instead.");
+
+    if(!Create(false))
+    {
+      gSystem_Debug.error("From CSystem_Stream_Buffer: Could not generate stream buffer.");
+      return false;
+    }
+  }
+
+  ClearStats();
+
+  CSystem::Init();
+
+  return true;
+}
+
+void CSystem_Stream_Buffer::Close()
+{
+  if(!enabled) return;
+
+  Destroy();
+
+  CSystem::Close();
+}
+
+bool CSystem_Stream_Buffer::Reset()
+{
+  // Los datos sólo duran una iteración: no hay nada que reiniciar
+  return true;
+}
+
+bool CSystem_Stream_Buffer::Create(bool persistent)
+{
+  glGenBuffers(1, &buffer);
+  if(!buffer)
+    return false;
+
+  glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+  if(persistent)
+  {
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glBufferStorage(GL_ARRAY_BUFFER, size, NULL, flags);
+    mapped = (GLubyte*)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+
+    if(!mapped)
+    {
+      glBindBuffer(GL_ARRAY_BUFFER, 0);
+      Destroy();
+      return false;
+    }
+  }
+  else
+    glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  head = pending = 0;
+
+  return true;
+}
+
+void CSystem_Stream_Buffer::Destroy()
+{
+  for(deque<fence_t>::iterator it = fences.begin(); it != fences.end(); ++it)
+    glDeleteSync(it->sync);
+  fences.clear();
+
+  if(mapped)
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    mapped = NULL;
+  }
+
+  if(buffer)
+    glDeleteBuffers(1, &buffer);
+
+  buffer = 0;
+  head = pending = 0;
+}
+
+void CSystem_Stream_Buffer::Fence()
+{
+  if(head <= pending)
+    return;
+
+  fence_t fence;
+  fence.sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  fence.start = pending;
+  fence.end = head;
+  fences.push_back(fence);
+
+  pending = head;
+}
+
+void CSystem_Stream_Buffer::Wait(GLintptr start, GLintptr end)
+{
+  // Las barreras se ponen en el orden en que se recorre el buffer, y al dar la vuelta se quitan las que cubren el final que se salta (véase Write()).
+  // Así, la más antigua es siempre la siguiente por delante de head: si no se solapa, las demás tampoco
+  while(!fences.empty())
+  {
+    fence_t& fence = fences.front();
+    if(fence.start >= end or fence.end <= start)
+      break;
+
+    WaitFront();
+  }
+}
+
+void CSystem_Stream_Buffer::WaitFront()
+{
+  fence_t& fence = fences.front();
+
+  GLenum result = glClientWaitSync(fence.sync, 0, 0);
+  if(result == GL_TIMEOUT_EXPIRED)
+  {
+    stats.waits++;
+    do
+      result = glClientWaitSync(fence.sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+    while(result == GL_TIMEOUT_EXPIRED);
+  }
+
+  if(result == GL_WAIT_FAILED)
+    gSystem_Debug.console_error_msg("From CSystem_Stream_Buffer: Could not wait for stream buffer fence.");
+
+  glDeleteSync(fence.sync);
+  fences.pop_front();
+}
+
+void CSystem_Stream_Buffer::OnFrame()
+{
+  if(mapped)
+    Fence();
+
+  last_stats = stats;
+  memset(&stats, 0, sizeof(stats));
+}
+
+void CSystem_Stream_Buffer::ClearStats()
+{
+  memset(&stats, 0, sizeof(stats));
+  memset(&last_stats, 0, sizeof(last_stats));
+}
+
+GLintptr CSystem_Stream_Buffer::Write(const void* data, GLsizeiptr bytes)
+{
+  if(!buffer or bytes <= 0)
+    return -1;
+
+  GLsizeiptr aligned = (bytes + __STREAM_BUFFER_ALIGNMENT - 1) & ~(GLsizeiptr)(__STREAM_BUFFER_ALIGNMENT - 1);
+  if(aligned > size)
+  {
+    gSystem_Debug.console_error_msg("From CSystem_Stream_Buffer: %d bytes do not fit in the stream buffer (__RENDER_STREAM_BUFFER_SIZE = %d).", (int)bytes, (int)size);
+    return -1;
+  }
+
+  glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+  // No cabe al final: se vuelve al principio
+  if(head + aligned > size)
+  {
+    // Con el mapeo persistente, lo escrito en esta iteración también se puede estar leyendo. Sin él, se deja huérfano el buffer entero
+    if(mapped)
+    {
+      // Las barreras de la vuelta anterior que quedan por delante de head cubren el final que se salta. Nunca se solaparían con las escrituras
+      // desde el principio, y dejarían detrás a las barreras nuevas de esa zona
+      while(!fences.empty() and fences.front().start >= head)
+        WaitFront();
+
+      Fence();
+    }
+    else
+      glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW);
+
+    head = pending = 0;
+    stats.wraps++;
+  }
+
+  if(mapped)
+    Wait(head, head + aligned);
+
+  GLintptr offset = head;
+  head += aligned;
+
+  if(mapped)
+    memcpy(mapped + offset, data, bytes);
+  else
+    glBufferSubData(GL_ARRAY_BUFFER, offset, bytes, data);
+
+  stats.writes++;
+  stats.bytes += bytes;
+
+  return offset;
+}
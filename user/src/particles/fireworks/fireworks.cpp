@@ -51,14 +51,19 @@ void Firework_Manager_Input(CGameObject* gameObject)
     gSystem_Data_Storage.SetFloat("firework_timer_id"+value, gTime.GetTicks_s());
     gSystem_Data_Storage.SetInt("firework_exploded_id" + value, 0);
 
-    CGameObject* firework = gGameObjects.Add("firework_id"+value);
-    CGameObject* explosion = gGameObjects.Add("firework_explosion_id"+value);
-    CGameObject* trail = gGameObjects.Add("firework_trail_id"+value);
+    CCommand_Buffer& cmd = gGameObjects.Commands();
 
-    firework->AddChild(explosion);
-    firework->AddChild(trail);
+    CGameObject* firework = cmd.Spawn("firework_id"+value);
+    CGameObject* explosion = cmd.Spawn("firework_explosion_id"+value);
+    CGameObject* trail = cmd.Spawn("firework_trail_id"+value);
 
-    firework->Preserve(true);
+    cmd.Reparent(explosion, firework);
+    cmd.Reparent(trail, firework);
+
+    // Los hijos aún no están emparentados, así que se preservan uno a uno
+    firework->Preserve();
+    explosion->Preserve();
+    trail->Preserve();
 
     firework->Transform()->position = gMath.random_point(vector3f(50, 0, 0), vector3f(-25, 0, 0));
 
@@ -166,7 +171,7 @@ void Firework_Manager_Behaviour(CGameObject* gameObject)
       gSystem_Data_Storage.RemoveFloat("firework_exploded_id"+value);
 
       // Clear vectors
-      gGameObjects.Delete(current_firework->GetName(), true);
+      gGameObjects.Commands().Destroy(current_firework, true);
     }
   }
 }
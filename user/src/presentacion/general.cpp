@@ -16,7 +16,7 @@ int diapositiva_actual = 0;
 
 bool Presentacion_Init()
 {
-  // Iniciar cmara
+  // Iniciar cámara
   CGameObject* camara_main = gGameObjects["camara_main"];
 
   if(!camara_main)
@@ -31,7 +31,7 @@ bool Presentacion_Init()
   }
   camara_main->Camera()->skybox_texture = "skybox3";
 
-  // Cmara de marca de agua
+  // Cámara de marca de agua
   CGameObject* marca_agua = gGameObjects["marca_agua"];
 
   if(!marca_agua)
@@ -51,7 +51,7 @@ bool Presentacion_Init()
   diapositivas_funcs_init.resize(NUM_DIAPOSITIVAS, NULL);
   diapositivas_funcs_close.resize(NUM_DIAPOSITIVAS, NULL);
 
-  // Gestor de eventos para mover la cmara (y tal)
+  // Gestor de eventos para mover la cámara (y tal)
   CGameObject* gestor_entrada = gGameObjects.Add("gestor_entrada");
   gestor_entrada->SetInputFunction(&Gestor_Entrada_Input);
 
@@ -97,7 +97,7 @@ bool Presentacion_Init()
 
 bool Slide1_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide1_titulo");
   //slide1_titulo->Transform()->position.y += 10;
   titulo->Transform()->Translate(0, 0.6, 4);
@@ -105,6 +105,7 @@ bool Slide1_Init()
   titulo->MeshRender()->material_name = "__TEXTURE_WHITE";
   titulo->MeshRender()->mesh_name = "mdl_slide1_title";
   titulo->MeshRender()->color = COLOR_TITULO;
+  titulo->SetStatic(true);
 
   // Engranaje que gira
   /*CGameObject* engranaje = gGameObjects.Add("slide1_engranaje");
@@ -125,13 +126,14 @@ bool Slide1_Close()
 
 bool Slide2_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide2_titulo");
   titulo->Transform()->Translate(-6, 1.4, 0);
   titulo->Transform()->Rotate(0, 90, 0);
   titulo->MeshRender()->material_name = "__TEXTURE_WHITE";
   titulo->MeshRender()->mesh_name = "mdl_slide2_title";
   titulo->MeshRender()->color = COLOR_TITULO;
+  titulo->SetStatic(true);
 
   // Texto
   CGameObject* texto = gGameObjects.Add("slide2_texto");
@@ -140,6 +142,7 @@ bool Slide2_Init()
   texto->MeshRender()->material_name = "__TEXTURE_WHITE";
   texto->MeshRender()->mesh_name = "mdl_slide2_text";
   texto->MeshRender()->color = COLOR_TEXTO;
+  texto->SetStatic(true);
 
   // Crate
   CGameObject* crate = gGameObjects.Add("slide2_crate");
@@ -201,7 +204,7 @@ bool Slide2_Close()
 
 bool Slide3_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide3_titulo");
   titulo->Transform()->Translate(0, 2.6, -9);
   titulo->Transform()->Rotate(0, 0, 0);
@@ -262,7 +265,7 @@ bool Slide3_Close()
 
 bool Slide4_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide4_titulo");
   titulo->Transform()->Translate(10, 2.5, 0);
   titulo->Transform()->Rotate(0, 270, 0);
@@ -299,7 +302,7 @@ bool Slide4_Close()
 
 bool Slide5_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide5_titulo");
   titulo->Transform()->Translate(0, 2, 8);
   titulo->Transform()->Rotate(0, 180, 0);
@@ -463,7 +466,7 @@ bool Slide5_Close()
 
 bool Slide6_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide6_titulo");
   titulo->Transform()->Translate(-6, 1.5, 0);
   titulo->Transform()->Rotate(0, 90, 0);
@@ -492,7 +495,7 @@ bool Slide6_Close()
 
 bool Slide7_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide7_titulo");
   titulo->Transform()->Translate(0, 2.6, -9);
   titulo->Transform()->Rotate(0, 0, 0);
@@ -521,7 +524,7 @@ bool Slide7_Close()
 
 bool Slide8_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide8_titulo");
   titulo->Transform()->Translate(10, 2.5, 0);
   titulo->Transform()->Rotate(0, 270, 0);
@@ -558,11 +561,11 @@ bool Slide8_Close()
   return true;
 }
 
-/* Diapositivas extras aqu */
+/* Diapositivas extras aquí */
 
 bool Slide_Extra1_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide_extra1_titulo");
   titulo->Transform()->Translate(0, 2, 8);
   titulo->Transform()->Rotate(0, 180, 0);
@@ -591,7 +594,7 @@ bool Slide_Extra1_Close()
 
 bool Slide_Extra2_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide_extra2_titulo");
   titulo->Transform()->Translate(-6, 1.4, 0);
   titulo->Transform()->Rotate(0, 90, 0);
@@ -629,7 +632,7 @@ bool Slide_Extra2_Close()
 
 bool Slide_Extra3_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide_extra3_titulo");
   titulo->Transform()->Translate(0, 2.6, -9);
   titulo->Transform()->Rotate(0, 0, 0);
@@ -668,7 +671,7 @@ bool Slide_Extra3_Close()
 
 bool Slide_Extra4_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide_extra4_titulo");
   titulo->Transform()->Translate(10, 2.5, 0);
   titulo->Transform()->Rotate(0, 270, 0);
@@ -684,14 +687,14 @@ bool Slide_Extra4_Init()
   texto->MeshRender()->mesh_name = "mdl_slide_extra4_text";
   texto->MeshRender()->color = COLOR_TEXTO;
 
-  // Cono aqu (o algo)
+  // Cono aquí (o algo)
   CGameObject* cone1 = gGameObjects.Add("slide_extra4_cone1");
   cone1->Transform()->Translate(12, -0.3, -5);
   cone1->Transform()->Rotate(0, 30, 0);
   cone1->Transform()->Scale(2.f, 2.5f, 2.f);
   cone1->MeshRender()->material_name = "texture_mdl_traffic_cone";
   cone1->MeshRender()->mesh_name = "mdl_traffic_cone";
-  //cone1->SetBehaviourFunction(&Movimiento_Rotatorio); // ?
+  //cone1->SetBehaviourFunction(&Movimiento_Rotatorio); // ¿?
 
   return true;
 }
@@ -709,7 +712,7 @@ bool Slide_Extra4_Close()
 
 bool Slide9_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide9_titulo");
   titulo->Transform()->Translate(0, 2, 8);
   titulo->Transform()->Rotate(0, 180, 0);
@@ -739,7 +742,7 @@ bool Slide9_Close()
 
 bool Slide10_Init()
 {
-  // Ttulo
+  // Título
   CGameObject* titulo = gGameObjects.Add("slide10_titulo");
   titulo->Transform()->Translate(-8, 5, 0); // Elevado!
   titulo->Transform()->Rotate(45, 90, 0);
@@ -747,7 +750,7 @@ bool Slide10_Init()
   titulo->MeshRender()->mesh_name = "mdl_slide10_title";
   titulo->MeshRender()->color = COLOR_TITULO;
 
-  // Gestor de fuegos artificiales ->BUG Crash sin razn aparente en el firework_manager de la presentacin.
+  // Gestor de fuegos artificiales ->BUG Crash sin razón aparente en el firework_manager de la presentación.
   CGameObject* firework_manager = gGameObjects.Add("firework_manager");
   //firework_manager->Preserve();
   firework_manager->SetBehaviourFunction(&Firework_Manager_Comportamiento);
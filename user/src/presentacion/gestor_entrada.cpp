@@ -38,7 +38,7 @@ void Gestor_Entrada_Input(CGameObject* gameObject)
       if(diapositiva_actual == NUM_DIAPOSITIVAS)
         gEngine.Exit();
 
-      // Rotar la cmara
+      // Rotar la cámara
       rotate_to.y -= 90;
       if(diapositiva_actual == NUM_DIAPOSITIVAS - 1)
       {
@@ -70,11 +70,11 @@ void Gestor_Entrada_Input(CGameObject* gameObject)
         diapositivas_funcs_init[diapositiva_actual - 1]();
       }
 
-      // Rotar la cmara
+      // Rotar la cámara
       rotate_to.y += 90;
       if(diapositiva_actual == NUM_DIAPOSITIVAS - 2)
       {
-        gGameObjects["firework_manager"]->Disable(); // ?
+        gGameObjects["firework_manager"]->Disable(); // ¿?
         rotate_to.x += 45;
       }
 
@@ -43,7 +43,7 @@ void Camara_main_input(CGameObject* gameObject)
     if(joys[0].buttons.size() > block_button and joys[0].buttons[block_button].State() == Input::button_buttondown)
       camara_bloqueada = !camara_bloqueada;
 
-    // No mover la cmara si est bloqueada
+    // No mover la cámara si está bloqueada
     if(camara_bloqueada)
         return;
 
@@ -127,13 +127,15 @@ void Firework_Manager_Crear(CGameObject* gameObject)
   gSystem_Data_Storage.SetFloat("firework_timer_id" + value, gTime.GetTicks_s());
   gSystem_Data_Storage.SetInt("firework_exploded_id" + value, 0);
 
-  CGameObject* firework = gGameObjects.Add("firework_id" + value);
+  CCommand_Buffer& cmd = gGameObjects.Commands();
 
-  CGameObject* explosion = gGameObjects.Add("firework_explosion_id" + value);
-  CGameObject* trail = gGameObjects.Add("firework_trail_id" + value);
+  CGameObject* firework = cmd.Spawn("firework_id" + value);
 
-  firework->AddChild(explosion);
-  firework->AddChild(trail);
+  CGameObject* explosion = cmd.Spawn("firework_explosion_id" + value);
+  CGameObject* trail = cmd.Spawn("firework_trail_id" + value);
+
+  cmd.Reparent(explosion, firework);
+  cmd.Reparent(trail, firework);
   firework->Transform()->position = gMath.random_point(vector3f(0, 0, 20), vector3f(0, 0, -10));
   firework->Transform()->position.x = -20;
 
@@ -243,7 +245,7 @@ void Firework_Manager_Comportamiento(CGameObject* gameObject)
       gSystem_Data_Storage.RemoveFloat("firework_exploded_id"+value);
 
       // Clear vectors
-      gGameObjects.Delete(current_firework->GetName(), true);
+      gGameObjects.Commands().Destroy(current_firework, true);
     }
   }
 }